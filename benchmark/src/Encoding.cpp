@@ -187,5 +187,89 @@ void BM_encoding_PackedCKKSPlaintext(benchmark::State &state) {
 
 BENCHMARK(BM_encoding_PackedCKKSPlaintext);
 
+static std::vector<std::vector<complex<double>>> CKKSBatchInputs(
+    size_t numVectors, size_t vecSize) {
+  std::vector<std::vector<complex<double>>> values(numVectors);
+  for (size_t j = 0; j < numVectors; j++) {
+    values[j].resize(vecSize);
+    for (size_t i = 0; i < vecSize; i++)
+      values[j][i] = static_cast<double>(rand() % 1024) / 1024;
+  }
+  return values;
+}
+
+// encodes state.range(0) vectors, one MakeCKKSPackedPlaintext call each
+void BM_encoding_PackedCKKSPlaintext_Loop(benchmark::State &state) {
+  usint m = 8192;
+  usint numPrimes = 3;
+  uint64_t p = 50;
+  usint relinWin = 0;
+  usint batch = 8;
+
+  auto cc = GenCryptoContextCKKS<DCRTPoly>(m, numPrimes, p, relinWin, batch,
+                                           MODE::OPTIMIZED, BV, APPROXRESCALE);
+  auto values = CKKSBatchInputs(state.range(0), batch);
+
+  while (state.KeepRunning()) {
+    for (size_t j = 0; j < values.size(); j++) {
+      Plaintext plaintext = cc->MakeCKKSPackedPlaintext(values[j]);
+      benchmark::DoNotOptimize(plaintext);
+    }
+  }
+}
+
+BENCHMARK(BM_encoding_PackedCKKSPlaintext_Loop)
+    ->Unit(benchmark::kMicrosecond)
+    ->Arg(1024);
+
+// encodes state.range(0) vectors with a single MakeCKKSPackedPlaintexts call
+void BM_encoding_PackedCKKSPlaintext_Batch(benchmark::State &state) {
+  usint m = 8192;
+  usint numPrimes = 3;
+  uint64_t p = 50;
+  usint relinWin = 0;
+  usint batch = 8;
+
+  auto cc = GenCryptoContextCKKS<DCRTPoly>(m, numPrimes, p, relinWin, batch,
+                                           MODE::OPTIMIZED, BV, APPROXRESCALE);
+  auto values = CKKSBatchInputs(state.range(0), batch);
+
+  while (state.KeepRunning()) {
+    auto plaintexts = cc->MakeCKKSPackedPlaintexts(values);
+    benchmark::DoNotOptimize(plaintexts);
+  }
+}
+
+BENCHMARK(BM_encoding_PackedCKKSPlaintext_Batch)
+    ->Unit(benchmark::kMicrosecond)
+    ->Arg(1024);
+
+// decrypts and decodes state.range(0) ciphertexts with a single Decrypt call
+void BM_decoding_PackedCKKSPlaintext_Batch(benchmark::State &state) {
+  usint m = 8192;
+  usint numPrimes = 3;
+  uint64_t p = 50;
+  usint relinWin = 0;
+  usint batch = 8;
+
+  auto cc = GenCryptoContextCKKS<DCRTPoly>(m, numPrimes, p, relinWin, batch,
+                                           MODE::OPTIMIZED, BV, APPROXRESCALE);
+  auto keyPair = cc->KeyGen();
+  auto plaintexts = cc->MakeCKKSPackedPlaintexts(
+      CKKSBatchInputs(state.range(0), batch));
+  std::vector<Ciphertext<DCRTPoly>> ciphertexts(plaintexts.size());
+  for (size_t j = 0; j < plaintexts.size(); j++)
+    ciphertexts[j] = cc->Encrypt(keyPair.publicKey, plaintexts[j]);
+
+  std::vector<Plaintext> results;
+  while (state.KeepRunning()) {
+    cc->Decrypt(keyPair.secretKey, ciphertexts, &results);
+  }
+}
+
+BENCHMARK(BM_decoding_PackedCKKSPlaintext_Batch)
+    ->Unit(benchmark::kMicrosecond)
+    ->Arg(1024);
+
 // execute the benchmarks
 BENCHMARK_MAIN();
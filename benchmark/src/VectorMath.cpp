@@ -46,6 +46,8 @@
 #include "math/nbtheory.cpp"
 #include "math/transfrm.cpp"
 
+#include "utils/cpufeatures.h"
+
 using namespace std;
 using namespace lbcrypto;
 
@@ -193,5 +195,94 @@ DO_VECTOR_BENCHMARK_TEMPLATE(BM_BigVec_Multeq, M4Vector)
 DO_VECTOR_BENCHMARK_TEMPLATE(BM_BigVec_Multeq, M6Vector)
 #endif
 
+/*
+ * Element-wise NativeVector arithmetic with the kernels restricted to each
+ * instruction set, against the per-element NativeInteger loops they replace;
+ * "simd" = -1 runs the loop, and sets the processor does not support are
+ * skipped
+ */
+static void NativeVectorSIMDArguments(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"n", "simd"});
+  for (int64_t n : {1024, 4096, 16384, 65536}) {
+    for (int64_t level = -1; level <= SIMD_AVX512; level++) {
+      b->Args({n, level});
+    }
+  }
+}
+
+enum NativeVectorOp { NV_ADD, NV_SUB, NV_MUL, NV_MUL_CONST };
+
+static void BM_NativeVec_SIMD(benchmark::State &state, NativeVectorOp op) {
+  usint n = state.range(0);
+  int64_t level = state.range(1);
+  if (level > CPUFeatures::GetSupportedSIMDLevel()) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+
+  NativeInteger q = FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, 2 * n);
+  DiscreteUniformGeneratorImpl<NativeVector> dug;
+  dug.SetModulus(q);
+  NativeVector a = dug.GenerateVector(n);
+  NativeVector b = dug.GenerateVector(n);
+  NativeInteger c = dug.GenerateInteger();
+  NativeInteger mu = q.ComputeMu();
+  NativeInteger cPrec = c.PrepModMulConst(q);
+
+  if (level < 0) {
+    state.SetLabel("loop");
+    while (state.KeepRunning()) {
+      switch (op) {
+        case NV_ADD:
+          for (usint i = 0; i < n; i++) a[i].ModAddFastEq(b[i], q);
+          break;
+        case NV_SUB:
+          for (usint i = 0; i < n; i++) a[i].ModSubFastEq(b[i], q);
+          break;
+        case NV_MUL:
+          for (usint i = 0; i < n; i++) a[i].ModMulFastEq(b[i], q, mu);
+          break;
+        case NV_MUL_CONST:
+          for (usint i = 0; i < n; i++) a[i].ModMulFastConstEq(c, q, cPrec);
+          break;
+      }
+    }
+    return;
+  }
+
+  CPUFeatures::SetSIMDLevel(static_cast<SIMDLevel>(level));
+  state.SetLabel(CPUFeatures::SIMDLevelToString(static_cast<SIMDLevel>(level)));
+  while (state.KeepRunning()) {
+    switch (op) {
+      case NV_ADD:
+        a.ModAddEq(b);
+        break;
+      case NV_SUB:
+        a.ModSubEq(b);
+        break;
+      case NV_MUL:
+        a.ModMulEq(b);
+        break;
+      case NV_MUL_CONST:
+        a.ModMulEq(c);
+        break;
+    }
+  }
+  CPUFeatures::SetSIMDLevel(CPUFeatures::GetSupportedSIMDLevel());
+}
+
+BENCHMARK_CAPTURE(BM_NativeVec_SIMD, ModAddEq, NV_ADD)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(NativeVectorSIMDArguments);
+BENCHMARK_CAPTURE(BM_NativeVec_SIMD, ModSubEq, NV_SUB)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(NativeVectorSIMDArguments);
+BENCHMARK_CAPTURE(BM_NativeVec_SIMD, ModMulEq_Barrett, NV_MUL)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(NativeVectorSIMDArguments);
+BENCHMARK_CAPTURE(BM_NativeVec_SIMD, ModMulEq_Shoup, NV_MUL_CONST)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(NativeVectorSIMDArguments);
+
 // execute the benchmarks
 BENCHMARK_MAIN();
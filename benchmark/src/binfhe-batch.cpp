@@ -0,0 +1,152 @@
+/*
+ * @file binfhe : library benchmark routines for batched FHEW gate evaluation
+ * @author TPOC: contact@palisade-crypto.org
+ *
+ * @copyright Copyright (c) 2019, Duality Technologies Inc.
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution. THIS SOFTWARE IS
+ * PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+/*
+ * This file benchmarks throughput (gates/s) of batched FHEW-GINX gate
+ * evaluation against evaluating the same gates one at a time
+ */
+
+#define PROFILE
+#include "benchmark/benchmark.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "binfhecontext.h"
+
+#include "utils/debug.h"
+
+using namespace std;
+using namespace lbcrypto;
+
+/*
+ * Context setup utility methods
+ */
+
+BinFHEContext GenerateFHEWContext(BINFHEPARAMSET set) {
+  auto cc = BinFHEContext();
+  cc.GenerateBinFHEContext(set, GINX);
+  return cc;
+}
+
+/*
+ * FHEW batch benchmarks
+ */
+
+// the number of gates in the batch is given by state.range(0)
+template <class ParamSet, class BinGate>
+void FHEW_BINGATE_SEQUENTIAL(benchmark::State &state, ParamSet param_set,
+                             BinGate bin_gate) {
+  BINGATE gate(bin_gate);
+  BINFHEPARAMSET param(param_set);
+  size_t batchSize = state.range(0);
+
+  BinFHEContext cc = GenerateFHEWContext(param);
+
+  LWEPrivateKey sk = cc.KeyGen();
+
+  cc.BTKeyGen(sk);
+
+  vector<LWECiphertext> ct1s(batchSize);
+  vector<LWECiphertext> ct2s(batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    ct1s[i] = cc.Encrypt(sk, i % 2);
+    ct2s[i] = cc.Encrypt(sk, 1);
+  }
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < batchSize; i++) {
+      LWECiphertext ct = cc.EvalBinGate(gate, ct1s[i], ct2s[i]);
+      benchmark::DoNotOptimize(ct);
+    }
+  }
+
+  state.counters["gates/s"] = benchmark::Counter(
+      state.iterations() * batchSize, benchmark::Counter::kIsRate);
+}
+
+template <class ParamSet, class BinGate>
+void FHEW_BINGATE_BATCH(benchmark::State &state, ParamSet param_set,
+                        BinGate bin_gate) {
+  BINGATE gate(bin_gate);
+  BINFHEPARAMSET param(param_set);
+  size_t batchSize = state.range(0);
+
+  BinFHEContext cc = GenerateFHEWContext(param);
+
+  LWEPrivateKey sk = cc.KeyGen();
+
+  cc.BTKeyGen(sk);
+
+  vector<BINGATE> gates(batchSize, gate);
+  vector<shared_ptr<const LWECiphertextImpl>> ct1s(batchSize);
+  vector<shared_ptr<const LWECiphertextImpl>> ct2s(batchSize);
+  for (size_t i = 0; i < batchSize; i++) {
+    ct1s[i] = cc.Encrypt(sk, i % 2);
+    ct2s[i] = cc.Encrypt(sk, 1);
+  }
+
+  for (auto _ : state) {
+    vector<LWECiphertext> cts = cc.EvalBinGates(gates, ct1s, ct2s);
+    benchmark::DoNotOptimize(cts);
+  }
+
+  state.counters["gates/s"] = benchmark::Counter(
+      state.iterations() * batchSize, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_SEQUENTIAL, MEDIUM_AND, MEDIUM, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, MEDIUM_AND, MEDIUM, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, MEDIUM_XOR, MEDIUM, XOR)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_SEQUENTIAL, STD128_AND, STD128, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_BATCH, STD128_AND, STD128, AND)
+    ->Unit(benchmark::kMillisecond)
+    ->Arg(16)
+    ->Arg(64)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -44,6 +44,7 @@
 #include "cryptocontextgen.h"
 #include "cryptocontexthelper.h"
 
+#include "utils/cpufeatures.h"
 #include "utils/debug.h"
 
 using namespace std;
@@ -92,6 +93,25 @@ CryptoContext<DCRTPoly> GenerateCKKSContext() {
   return cc;
 }
 
+CryptoContext<DCRTPoly> GenerateCKKSHybridContext(uint32_t numLargeDigits) {
+  uint32_t multDepth = 11;
+  uint32_t scaleFactorBits = 48;
+  uint32_t batchSize = 8;
+  SecurityLevel securityLevel = HEStd_128_classic;
+
+  // Hybrid key switching with numLargeDigits digits (dnum)
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextCKKS(
+          multDepth, scaleFactorBits, batchSize, securityLevel, 0,
+          APPROXRESCALE, HYBRID, numLargeDigits);
+
+  cc->Enable(PKESchemeFeature::ENCRYPTION);
+  cc->Enable(PKESchemeFeature::SHE);
+  cc->Enable(PKESchemeFeature::LEVELEDSHE);
+
+  return cc;
+}
+
 CryptoContext<DCRTPoly> GenerateBGVrnsContext() {
   // Set the main parameters
   int plaintextModulus = 65537;
@@ -295,6 +315,86 @@ void INTTTransformInPlace4096(benchmark::State &state) {
 
 BENCHMARK(INTTTransformInPlace4096)->Unit(benchmark::kMicrosecond);
 
+/*
+ * In-place NTT/INTT with the native lazy-reduction kernels restricted to each
+ * instruction set; sets the processor does not support are skipped
+ */
+static void NTTSIMDArguments(benchmark::internal::Benchmark *b) {
+  b->ArgNames({"n", "simd"});
+  for (int64_t phim : {1024, 4096, 16384, 65536}) {
+    for (int64_t level = SIMD_SCALAR; level <= SIMD_AVX512; level++) {
+      b->Args({phim, level});
+    }
+  }
+}
+
+void NTTTransformInPlaceSIMD(benchmark::State &state) {
+  usint phim = state.range(0);
+  usint m = 2 * phim;
+  SIMDLevel level = static_cast<SIMDLevel>(state.range(1));
+  if (level > CPUFeatures::GetSupportedSIMDLevel()) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+
+  NativeInteger modulusQ =
+      FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+  DiscreteUniformGeneratorImpl<NativeVector> dug;
+  dug.SetModulus(modulusQ);
+  NativeVector x = dug.GenerateVector(phim);
+
+  ChineseRemainderTransformFTT<NativeVector>::PreCompute(rootOfUnity, m,
+                                                         modulusQ);
+
+  CPUFeatures::SetSIMDLevel(level);
+  state.SetLabel(CPUFeatures::SIMDLevelToString(level));
+  while (state.KeepRunning()) {
+    ChineseRemainderTransformFTT<
+        NativeVector>::ForwardTransformToBitReverseInPlace(rootOfUnity, m, &x);
+  }
+  CPUFeatures::SetSIMDLevel(CPUFeatures::GetSupportedSIMDLevel());
+}
+
+BENCHMARK(NTTTransformInPlaceSIMD)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(NTTSIMDArguments);
+
+void INTTTransformInPlaceSIMD(benchmark::State &state) {
+  usint phim = state.range(0);
+  usint m = 2 * phim;
+  SIMDLevel level = static_cast<SIMDLevel>(state.range(1));
+  if (level > CPUFeatures::GetSupportedSIMDLevel()) {
+    state.SkipWithError("instruction set is not supported");
+    return;
+  }
+
+  NativeInteger modulusQ =
+      FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
+
+  DiscreteUniformGeneratorImpl<NativeVector> dug;
+  dug.SetModulus(modulusQ);
+  NativeVector x = dug.GenerateVector(phim);
+
+  ChineseRemainderTransformFTT<NativeVector>::PreCompute(rootOfUnity, m,
+                                                         modulusQ);
+
+  CPUFeatures::SetSIMDLevel(level);
+  state.SetLabel(CPUFeatures::SIMDLevelToString(level));
+  while (state.KeepRunning()) {
+    ChineseRemainderTransformFTT<
+        NativeVector>::InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                             &x);
+  }
+  CPUFeatures::SetSIMDLevel(CPUFeatures::GetSupportedSIMDLevel());
+}
+
+BENCHMARK(INTTTransformInPlaceSIMD)
+    ->Unit(benchmark::kMicrosecond)
+    ->Apply(NTTSIMDArguments);
+
 /*
  * BFVrns benchmarks
  */
@@ -834,6 +934,122 @@ void CKKS_EvalAtIndex(benchmark::State &state) {
 
 BENCHMARK(CKKS_EvalAtIndex)->Unit(benchmark::kMicrosecond);
 
+void CKKS_RelinHybrid(benchmark::State &state) {
+  CryptoContext<DCRTPoly> cc = GenerateCKKSHybridContext(state.range(0));
+
+  LPKeyPair<DCRTPoly> keyPair = cc->KeyGen();
+  cc->EvalMultKeyGen(keyPair.secretKey);
+
+  usint slots = cc->GetEncodingParams()->GetBatchSize();
+  std::vector<std::complex<double>> vectorOfInts(slots);
+  for (usint i = 0; i < slots; i++) {
+    vectorOfInts[i] = 1.001 * i;
+  }
+
+  auto plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+  auto ciphertext = cc->Encrypt(keyPair.publicKey, plaintext);
+  auto ciphertextMul = cc->EvalMultNoRelin(ciphertext, ciphertext);
+
+  while (state.KeepRunning()) {
+    auto ciphertext2 = cc->Relinearize(ciphertextMul);
+  }
+}
+
+BENCHMARK(CKKS_RelinHybrid)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgName("dnum")
+    ->DenseRange(2, 4);
+
+void CKKS_EvalAtIndexHybrid(benchmark::State &state) {
+  CryptoContext<DCRTPoly> cc = GenerateCKKSHybridContext(state.range(0));
+
+  LPKeyPair<DCRTPoly> keyPair = cc->KeyGen();
+  cc->EvalAtIndexKeyGen(keyPair.secretKey, {1});
+
+  usint slots = cc->GetEncodingParams()->GetBatchSize();
+  std::vector<std::complex<double>> vectorOfInts(slots);
+  for (usint i = 0; i < slots; i++) {
+    vectorOfInts[i] = 1.001 * i;
+  }
+
+  auto plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+  auto ciphertext = cc->Encrypt(keyPair.publicKey, plaintext);
+
+  while (state.KeepRunning()) {
+    auto ciphertext2 = cc->EvalAtIndex(ciphertext, 1);
+  }
+}
+
+BENCHMARK(CKKS_EvalAtIndexHybrid)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgName("dnum")
+    ->DenseRange(2, 4);
+
+void CKKS_EvalPoly(benchmark::State &state) {
+  CryptoContext<DCRTPoly> cc = GenerateCKKSHybridContext(3);
+
+  LPKeyPair<DCRTPoly> keyPair = cc->KeyGen();
+  cc->EvalMultKeyGen(keyPair.secretKey);
+
+  usint slots = cc->GetEncodingParams()->GetBatchSize();
+  std::vector<std::complex<double>> vectorOfInts(slots);
+  for (usint i = 0; i < slots; i++) {
+    vectorOfInts[i] = 0.9 * i / slots;
+  }
+
+  std::vector<double> coefficients(state.range(0) + 1);
+  for (size_t j = 0; j < coefficients.size(); j++) {
+    coefficients[j] = 1.0 / (j + 1);
+  }
+
+  auto plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+  auto ciphertext = cc->Encrypt(keyPair.publicKey, plaintext);
+
+  while (state.KeepRunning()) {
+    auto ciphertext2 = cc->EvalPoly(ciphertext, coefficients);
+  }
+}
+
+BENCHMARK(CKKS_EvalPoly)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgName("degree")
+    ->Arg(16)
+    ->Arg(60)
+    ->Arg(120);
+
+void CKKS_EvalChebyshevSeries(benchmark::State &state) {
+  CryptoContext<DCRTPoly> cc = GenerateCKKSHybridContext(3);
+
+  LPKeyPair<DCRTPoly> keyPair = cc->KeyGen();
+  cc->EvalMultKeyGen(keyPair.secretKey);
+
+  usint slots = cc->GetEncodingParams()->GetBatchSize();
+  std::vector<std::complex<double>> vectorOfInts(slots);
+  for (usint i = 0; i < slots; i++) {
+    vectorOfInts[i] = -4.0 + 8.0 * i / slots;
+  }
+
+  std::vector<double> coefficients(state.range(0) + 1);
+  for (size_t j = 0; j < coefficients.size(); j++) {
+    coefficients[j] = 1.0 / (j + 1);
+  }
+
+  auto plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+  auto ciphertext = cc->Encrypt(keyPair.publicKey, plaintext);
+
+  while (state.KeepRunning()) {
+    auto ciphertext2 =
+        cc->EvalChebyshevSeries(ciphertext, coefficients, -4.0, 4.0);
+  }
+}
+
+BENCHMARK(CKKS_EvalChebyshevSeries)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgName("degree")
+    ->Arg(16)
+    ->Arg(60)
+    ->Arg(120);
+
 /*
  * BGVrns benchmarks
  * */
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "fhew.h"
 #include "lwe.h"
@@ -228,6 +229,20 @@ class BinFHEContext : public Serializable {
   LWECiphertext EvalBinGate(const BINGATE gate, ConstLWECiphertext ct1,
                             ConstLWECiphertext ct2) const;
 
+  /**
+   * Evaluates a batch of independent binary gates, bootstrapping them in
+   * parallel; gate i is applied to ct1s[i] and ct2s[i]
+   *
+   * @param gates the gates; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param ct1s first ciphertexts
+   * @param ct2s second ciphertexts
+   * @return a vector of shared pointers to the resulting ciphertexts
+   */
+  std::vector<LWECiphertext> EvalBinGates(
+      const std::vector<BINGATE> &gates,
+      const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct1s,
+      const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct2s) const;
+
   /**
    * Bootstraps a ciphertext (without peforming any operation)
    *
@@ -41,6 +41,33 @@
 
 namespace lbcrypto {
 
+/**
+ * @brief Scratch polynomials used by the accumulator during bootstrapping.
+ * A workspace is reused across all accumulator steps and gates evaluated by
+ * the same thread, so it must not be shared between threads. All polynomials
+ * are allocated once by the constructor; the accumulator steps only overwrite
+ * their coefficients, so the bootstrapping loop does not touch the heap.
+ */
+class RingGSWACCWorkspace {
+ public:
+  /**
+   * Allocates the scratch polynomials for the given parameters
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   */
+  explicit RingGSWACCWorkspace(
+      const std::shared_ptr<RingGSWCryptoParams> params);
+
+  // copy of the current accumulator, decomposed in each step
+  std::vector<NativePoly> ct;
+  // signed digit decomposition of ct
+  std::vector<NativePoly> dct;
+  // inner products of dct with the two GINX bootstrapping keys
+  std::vector<NativePoly> sum;
+  // zero polynomial in COEFFICIENT format used to reset dct
+  NativePoly zero;
+};
+
 /**
  * @brief Ring GSW accumulator schemes described in
  * https://eprint.iacr.org/2014/816 and "Bootstrapping in FHEW-like
@@ -82,6 +109,26 @@ class RingGSWAccumulatorScheme {
       const std::shared_ptr<const LWECiphertextImpl> ct2,
       const std::shared_ptr<LWEEncryptionScheme> LWEscheme) const;
 
+  /**
+   * Evaluates a batch of independent binary gates; gate i is applied to
+   * ct1s[i] and ct2s[i]. The gates are bootstrapped concurrently, each thread
+   * reusing one accumulator workspace for all gates it evaluates.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gates the gates; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param &EK a shared pointer to the bootstrapping keys
+   * @param ct1s first ciphertexts
+   * @param ct2s second ciphertexts
+   * @param lwescheme a shared pointer to additive LWE scheme
+   * @return a vector of shared pointers to the resulting ciphertexts
+   */
+  std::vector<std::shared_ptr<LWECiphertextImpl>> EvalBinGates(
+      const std::shared_ptr<RingGSWCryptoParams> params,
+      const std::vector<BINGATE> &gates, const RingGSWEvalKey &EK,
+      const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct1s,
+      const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct2s,
+      const std::shared_ptr<LWEEncryptionScheme> LWEscheme) const;
+
   /**
    * Evaluates NOT gate
    *
@@ -171,10 +218,12 @@ class RingGSWAccumulatorScheme {
    * @param params a shared pointer to RingGSW scheme parameters
    * @param &input input ciphertext
    * @param acc previous value of the accumulator
+   * @param ws scratch polynomials of the calling thread
    */
   void AddToACCAP(const std::shared_ptr<RingGSWCryptoParams> params,
                   const RingGSWCiphertext &input,
-                  std::shared_ptr<RingGSWCiphertext> acc) const;
+                  std::shared_ptr<RingGSWCiphertext> acc,
+                  RingGSWACCWorkspace *ws) const;
                   
    /**
    * Main accumulator function used in bootstrapping - GINX variant
@@ -184,13 +233,15 @@ class RingGSWAccumulatorScheme {
    * @param &input2 input ciphertext 2
    * @param &a integer a in each step of GINX accumulation
    * @param acc previous value of the accumulator
+   * @param ws scratch polynomials of the calling thread
    */
 
   void AddToACCGINX(const std::shared_ptr<RingGSWCryptoParams> params,
                     const RingGSWCiphertext &input1,  
                     const RingGSWCiphertext &input2, 
                     const NativeInteger &a,
-                    std::shared_ptr<RingGSWCiphertext> acc) const;
+                    std::shared_ptr<RingGSWCiphertext> acc,
+                    RingGSWACCWorkspace *ws) const;
 
   /**
    * Takes an RLWE ciphertext input and outputs a vector of its digits, i.e., an
@@ -214,12 +265,35 @@ class RingGSWAccumulatorScheme {
    * @param &a first part of the input LWE ciphertext
    * @param &b second part of the input LWE ciphertext
    * @param lwescheme a shared pointer to additive LWE scheme
+   * @param ws scratch polynomials of the calling thread
    * @return the output RingLWE accumulator
    */
   std::shared_ptr<RingGSWCiphertext> BootstrapCore(
       const std::shared_ptr<RingGSWCryptoParams> params, const BINGATE gate,
       const RingGSWEvalKey &EK, const NativeVector &a, const NativeInteger &b,
-      const std::shared_ptr<LWEEncryptionScheme> LWEscheme) const;
+      const std::shared_ptr<LWEEncryptionScheme> LWEscheme,
+      RingGSWACCWorkspace *ws) const;
+
+  /**
+   * Evaluates a binary gate using the scratch polynomials of the calling
+   * thread
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param &EK a shared pointer to the bootstrapping keys
+   * @param ct1 first ciphertext
+   * @param ct2 second ciphertext
+   * @param lwescheme a shared pointer to additive LWE scheme
+   * @param ws scratch polynomials of the calling thread
+   * @return a shared pointer to the resulting ciphertext
+   */
+  std::shared_ptr<LWECiphertextImpl> EvalBinGate(
+      const std::shared_ptr<RingGSWCryptoParams> params, const BINGATE gate,
+      const RingGSWEvalKey &EK,
+      const std::shared_ptr<const LWECiphertextImpl> ct1,
+      const std::shared_ptr<const LWECiphertextImpl> ct2,
+      const std::shared_ptr<LWEEncryptionScheme> LWEscheme,
+      RingGSWACCWorkspace *ws) const;
 };
 
 }  // namespace lbcrypto
@@ -223,6 +223,14 @@ LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate,
                                       m_LWEscheme);
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalBinGates(
+    const std::vector<BINGATE> &gates,
+    const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct1s,
+    const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct2s) const {
+  return m_RingGSWscheme->EvalBinGates(m_params, gates, m_BTKey, ct1s, ct2s,
+                                       m_LWEscheme);
+}
+
 LWECiphertext BinFHEContext::Bootstrap(ConstLWECiphertext ct1) const {
   return m_RingGSWscheme->Bootstrap(m_params, m_BTKey, ct1, m_LWEscheme);
 }
@@ -35,8 +35,38 @@
 
 #include "fhew.h"
 
+#include <string>
+#include <vector>
+
 namespace lbcrypto {
 
+RingGSWACCWorkspace::RingGSWACCWorkspace(
+    const std::shared_ptr<RingGSWCryptoParams> params)
+    : ct(2), dct(params->GetDigitsG2()), sum(2) {
+  const shared_ptr<ILNativeParams> polyParams = params->GetPolyParams();
+  zero = NativePoly(polyParams, Format::COEFFICIENT, true);
+  for (uint32_t i = 0; i < ct.size(); i++) ct[i] = zero;
+  for (uint32_t i = 0; i < dct.size(); i++) dct[i] = zero;
+  for (uint32_t i = 0; i < sum.size(); i++) sum[i] = zero;
+}
+
+// out[k] = a[k] * b[k] mod Q for all N coefficients
+static inline void ModMulCoeffs(NativeInteger *out, const NativeInteger *a,
+                                const NativeInteger *b, uint32_t N,
+                                const NativeInteger &Q,
+                                const NativeInteger &mu) {
+  for (uint32_t k = 0; k < N; k++) out[k] = a[k].ModMulFast(b[k], Q, mu);
+}
+
+// acc[k] += a[k] * b[k] mod Q for all N coefficients
+static inline void ModMulAddCoeffs(NativeInteger *acc, const NativeInteger *a,
+                                   const NativeInteger *b, uint32_t N,
+                                   const NativeInteger &Q,
+                                   const NativeInteger &mu) {
+  for (uint32_t k = 0; k < N; k++)
+    acc[k].ModAddFastEq(a[k].ModMulFast(b[k], Q, mu), Q);
+}
+
 // Encryption as described in Section 5 of https://eprint.iacr.org/2014/816
 // skNTT corresponds to the secret key z
 std::shared_ptr<RingGSWCiphertext> RingGSWAccumulatorScheme::EncryptAP(
@@ -318,16 +348,20 @@ void RingGSWAccumulatorScheme::SignedDigitDecompose(
 void RingGSWAccumulatorScheme::AddToACCAP(
     const std::shared_ptr<RingGSWCryptoParams> params,
     const RingGSWCiphertext &input,
-    std::shared_ptr<RingGSWCiphertext> acc) const {
+    std::shared_ptr<RingGSWCiphertext> acc, RingGSWACCWorkspace *ws) const {
+  uint32_t N = params->GetLWEParams()->GetN();
   uint32_t digitsG2 = params->GetDigitsG2();
-  const shared_ptr<ILNativeParams> polyParams = params->GetPolyParams();
+  NativeInteger Q = params->GetLWEParams()->GetQ();
+  NativeInteger mu = Q.ComputeMu();
 
-  std::vector<NativePoly> ct = acc->GetElements()[0];
-  std::vector<NativePoly> dct(digitsG2);
+  // the workspace polynomials are already allocated, so the assignments
+  // below copy coefficients without reallocating
+  std::vector<NativePoly> &ct = ws->ct;
+  std::vector<NativePoly> &dct = ws->dct;
+  for (uint32_t i = 0; i < 2; i++) ct[i] = (*acc)[0][i];
 
   // initialize dct to zeros
-  for (uint32_t i = 0; i < digitsG2; i++)
-    dct[i] = NativePoly(polyParams, Format::COEFFICIENT, true);
+  for (uint32_t i = 0; i < digitsG2; i++) dct[i] = ws->zero;
 
   // calls 2 NTTs
   for (uint32_t i = 0; i < 2; i++) ct[i].SetFormat(Format::COEFFICIENT);
@@ -337,17 +371,13 @@ void RingGSWAccumulatorScheme::AddToACCAP(
   // calls digitsG2 NTTs
   for (uint32_t j = 0; j < digitsG2; j++) dct[j].SetFormat(Format::EVALUATION);
 
-  // acc = dct * input (matrix product);
-  // uses in-place * operators for the last call to dct[i] to gain performance
-  // improvement
+  // acc = dct * input (matrix product), accumulated in place so that no
+  // temporary polynomials are created
   for (uint32_t j = 0; j < 2; j++) {
-    (*acc)[0][j].SetValuesToZero();
-    for (uint32_t l = 0; l < digitsG2; l++) {
-      if (j == 0)
-        (*acc)[0][j] += dct[l] * input[l][j];
-      else
-        (*acc)[0][j] += (dct[l] *= input[l][j]);
-    }
+    NativeInteger *accj = &(*acc)[0][j][0];
+    ModMulCoeffs(accj, &dct[0][0], &input[0][j].GetValues()[0], N, Q, mu);
+    for (uint32_t l = 1; l < digitsG2; l++)
+      ModMulAddCoeffs(accj, &dct[l][0], &input[l][j].GetValues()[0], N, Q, mu);
   }
 }
 
@@ -359,19 +389,21 @@ void RingGSWAccumulatorScheme::AddToACCGINX(
     const std::shared_ptr<RingGSWCryptoParams> params,
     const RingGSWCiphertext &input1, const RingGSWCiphertext &input2, 
     const NativeInteger &a,
-    std::shared_ptr<RingGSWCiphertext> acc) const {
+    std::shared_ptr<RingGSWCiphertext> acc, RingGSWACCWorkspace *ws) const {
   // cycltomic order
-  uint32_t m = 2 * params->GetLWEParams()->GetN();
+  uint32_t N = params->GetLWEParams()->GetN();
+  uint32_t m = 2 * N;
   uint32_t digitsG2 = params->GetDigitsG2();
   int64_t q = params->GetLWEParams()->Getq().ConvertToInt();
-  const shared_ptr<ILNativeParams> polyParams = params->GetPolyParams();
+  NativeInteger Q = params->GetLWEParams()->GetQ();
+  NativeInteger mu = Q.ComputeMu();
 
-  std::vector<NativePoly> ct = acc->GetElements()[0];
-  std::vector<NativePoly> dct(digitsG2);
+  std::vector<NativePoly> &ct = ws->ct;
+  std::vector<NativePoly> &dct = ws->dct;
+  for (uint32_t i = 0; i < 2; i++) ct[i] = (*acc)[0][i];
 
   // initialize dct to zeros
-  for (uint32_t i = 0; i < digitsG2; i++)
-    dct[i] = NativePoly(polyParams, Format::COEFFICIENT, true);
+  for (uint32_t i = 0; i < digitsG2; i++) dct[i] = ws->zero;
 
   // calls 2 NTTs
   for (uint32_t i = 0; i < 2; i++) ct[i].SetFormat(Format::COEFFICIENT);
@@ -392,34 +424,30 @@ void RingGSWAccumulatorScheme::AddToACCGINX(
   const NativePoly &monomialNeg = params->GetMonomial(indexNeg);
 
   // acc = acc + dct * input1 * monomial + dct * input2 * negative_monomial;
-  // uses in-place * operators for the last call to dct[i] to gain performance
-  // improvement. Needs to be done using two loops for ternary secrets.
+  // both inner products are accumulated in place in the workspace and then
+  // folded into acc, so that no temporary polynomials are created
+  NativeInteger *sum1 = &ws->sum[0][0];
+  NativeInteger *sum2 = &ws->sum[1][0];
   for (uint32_t j = 0; j < 2; j++) {
-    NativePoly temp1 = (j < 1) ? dct[0] * input1[0][j]: (dct[0] * input1[0][j]);
+    ModMulCoeffs(sum1, &dct[0][0], &input1[0][j].GetValues()[0], N, Q, mu);
+    ModMulCoeffs(sum2, &dct[0][0], &input2[0][j].GetValues()[0], N, Q, mu);
     for (uint32_t l = 1; l < digitsG2; l++) {
-      if (j == 0)
-        temp1 += dct[l] * input1[l][j];
-      else
-        temp1 += (dct[l] * input1[l][j]);
+      ModMulAddCoeffs(sum1, &dct[l][0], &input1[l][j].GetValues()[0], N, Q,
+                      mu);
+      ModMulAddCoeffs(sum2, &dct[l][0], &input2[l][j].GetValues()[0], N, Q,
+                      mu);
     }
-    (*acc)[0][j] += (temp1 * monomial);
-  }
-  for (uint32_t j = 0; j < 2; j++) {
-    NativePoly temp1 = (j < 1) ? dct[0] * input2[0][j]: (dct[0] * input2[0][j]);
-    for (uint32_t l = 1; l < digitsG2; l++) {
-      if (j == 0)
-        temp1 += dct[l] * input2[l][j];
-      else
-        temp1 += (dct[l] * input2[l][j]);
-    }
-    (*acc)[0][j] += (temp1 * monomialNeg);
+    NativeInteger *accj = &(*acc)[0][j][0];
+    ModMulAddCoeffs(accj, sum1, &monomial.GetValues()[0], N, Q, mu);
+    ModMulAddCoeffs(accj, sum2, &monomialNeg.GetValues()[0], N, Q, mu);
   }
 }
 
 std::shared_ptr<RingGSWCiphertext> RingGSWAccumulatorScheme::BootstrapCore(
     const std::shared_ptr<RingGSWCryptoParams> params, const BINGATE gate,
     const RingGSWEvalKey &EK, const NativeVector &a, const NativeInteger &b,
-    const std::shared_ptr<LWEEncryptionScheme> LWEscheme) const {
+    const std::shared_ptr<LWEEncryptionScheme> LWEscheme,
+    RingGSWACCWorkspace *ws) const {
   if ((EK.BSkey == nullptr) || (EK.KSkey == nullptr)) {
     std::string errMsg =
         "Bootstrapping keys have not been generated. Please call BTKeyGen "
@@ -477,13 +505,14 @@ std::shared_ptr<RingGSWCiphertext> RingGSWAccumulatorScheme::BootstrapCore(
       for (uint32_t k = 0; k < digitsR.size();
            k++, aI /= NativeInteger(baseR)) {
         uint32_t a0 = (aI.Mod(baseR)).ConvertToInt();
-        if (a0) this->AddToACCAP(params, (*EK.BSkey)[i][a0][k], acc);
+        if (a0) this->AddToACCAP(params, (*EK.BSkey)[i][a0][k], acc, ws);
       }
     }
   } else {  // if GINX
     for (uint32_t i = 0; i < n; i++) {
       // handles -a*E(1) and handles -a*E(-1) = a*E(1)
-      this->AddToACCGINX(params, (*EK.BSkey)[0][0][i], (*EK.BSkey)[0][1][i], q.ModSub(a[i], q), acc);
+      this->AddToACCGINX(params, (*EK.BSkey)[0][0][i], (*EK.BSkey)[0][1][i],
+                         q.ModSub(a[i], q), acc, ws);
     }
   }
 
@@ -498,6 +527,63 @@ std::shared_ptr<LWECiphertextImpl> RingGSWAccumulatorScheme::EvalBinGate(
     const std::shared_ptr<const LWECiphertextImpl> ct1,
     const std::shared_ptr<const LWECiphertextImpl> ct2,
     const std::shared_ptr<LWEEncryptionScheme> LWEscheme) const {
+  RingGSWACCWorkspace ws(params);
+  return EvalBinGate(params, gate, EK, ct1, ct2, LWEscheme, &ws);
+}
+
+// Evaluates a batch of independent gates. Each thread allocates one
+// accumulator workspace and reuses it for all gates assigned to it; dynamic
+// scheduling lets idle threads pick up the remaining gates, which matters
+// because XOR/XNOR gates cost three bootstraps while the others cost one.
+std::vector<std::shared_ptr<LWECiphertextImpl>>
+RingGSWAccumulatorScheme::EvalBinGates(
+    const std::shared_ptr<RingGSWCryptoParams> params,
+    const std::vector<BINGATE> &gates, const RingGSWEvalKey &EK,
+    const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct1s,
+    const std::vector<std::shared_ptr<const LWECiphertextImpl>> &ct2s,
+    const std::shared_ptr<LWEEncryptionScheme> LWEscheme) const {
+  if ((gates.size() != ct1s.size()) || (gates.size() != ct2s.size())) {
+    std::string errMsg =
+        "ERROR: The numbers of gates and input ciphertexts do not match.";
+    PALISADE_THROW(config_error, errMsg);
+  }
+
+  // all checks that can throw are done here, outside of the parallel region
+  if ((EK.BSkey == nullptr) || (EK.KSkey == nullptr)) {
+    std::string errMsg =
+        "Bootstrapping keys have not been generated. Please call BTKeyGen "
+        "before calling bootstrapping.";
+    PALISADE_THROW(config_error, errMsg);
+  }
+  for (size_t i = 0; i < gates.size(); i++) {
+    if (ct1s[i] == ct2s[i]) {
+      std::string errMsg =
+          "ERROR: Please only use independent ciphertexts as inputs.";
+      PALISADE_THROW(config_error, errMsg);
+    }
+  }
+
+  std::vector<std::shared_ptr<LWECiphertextImpl>> result(gates.size());
+
+#pragma omp parallel
+  {
+    RingGSWACCWorkspace ws(params);
+#pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < gates.size(); i++)
+      result[i] =
+          EvalBinGate(params, gates[i], EK, ct1s[i], ct2s[i], LWEscheme, &ws);
+  }
+
+  return result;
+}
+
+std::shared_ptr<LWECiphertextImpl> RingGSWAccumulatorScheme::EvalBinGate(
+    const std::shared_ptr<RingGSWCryptoParams> params, const BINGATE gate,
+    const RingGSWEvalKey &EK,
+    const std::shared_ptr<const LWECiphertextImpl> ct1,
+    const std::shared_ptr<const LWECiphertextImpl> ct2,
+    const std::shared_ptr<LWEEncryptionScheme> LWEscheme,
+    RingGSWACCWorkspace *ws) const {
   NativeInteger q = params->GetLWEParams()->Getq();
   NativeInteger Q = params->GetLWEParams()->GetQ();
   uint32_t n = params->GetLWEParams()->Getn();
@@ -515,9 +601,9 @@ std::shared_ptr<LWECiphertextImpl> RingGSWAccumulatorScheme::EvalBinGate(
   if ((gate == XOR) || (gate == XNOR)) {
     auto ct1NOT = EvalNOT(params, ct1);
     auto ct2NOT = EvalNOT(params, ct2);
-    auto ctAND1 = EvalBinGate(params, AND, EK, ct1, ct2NOT, LWEscheme);
-    auto ctAND2 = EvalBinGate(params, AND, EK, ct1NOT, ct2, LWEscheme);
-    auto ctOR = EvalBinGate(params, OR, EK, ctAND1, ctAND2, LWEscheme);
+    auto ctAND1 = EvalBinGate(params, AND, EK, ct1, ct2NOT, LWEscheme, ws);
+    auto ctAND2 = EvalBinGate(params, AND, EK, ct1NOT, ct2, LWEscheme, ws);
+    auto ctOR = EvalBinGate(params, OR, EK, ctAND1, ctAND2, LWEscheme, ws);
     // NOT is free so there is not cost to do it an extra time for XNOR
     if (gate == XOR)
       return ctOR;
@@ -543,7 +629,7 @@ std::shared_ptr<LWECiphertextImpl> RingGSWAccumulatorScheme::EvalBinGate(
       b = ct1->GetB().ModAddFast(ct2->GetB(), q);
     }
 
-    auto acc = BootstrapCore(params, gate, EK, a, b, LWEscheme);
+    auto acc = BootstrapCore(params, gate, EK, a, b, LWEscheme, ws);
 
     NativeInteger bNew;
     NativeVector aNew(N, Q);
@@ -590,7 +676,8 @@ std::shared_ptr<LWECiphertextImpl> RingGSWAccumulatorScheme::Bootstrap(
   a = ct1->GetA();
   b = ct1->GetB().ModAddFast(q >> 2, q);
 
-  auto acc = BootstrapCore(params, AND, EK, a, b, LWEscheme);
+  RingGSWACCWorkspace ws(params);
+  auto acc = BootstrapCore(params, AND, EK, a, b, LWEscheme, &ws);
 
   NativeInteger bNew;
   NativeVector aNew(N, Q);
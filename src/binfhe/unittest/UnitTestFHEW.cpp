@@ -880,3 +880,73 @@ TEST(UnitTestFHEWGINX, XNOR_FAST) {
   EXPECT_EQ(0, result10) << failed;
   EXPECT_EQ(1, result00) << failed;
 }
+
+// Checks batched evaluation of independent gates against the expected truth
+// tables
+static void EvalBinGatesTest(BINFHEMETHOD method) {
+  auto cc = BinFHEContext();
+  cc.GenerateBinFHEContext(TOY, method);
+
+  auto sk = cc.KeyGen();
+
+  cc.BTKeyGen(sk);
+
+  std::vector<BINGATE> gateTypes = {AND, OR,   NAND,     NOR,
+                                    XOR, XNOR, XOR_FAST, XNOR_FAST};
+  std::vector<BINGATE> gates;
+  std::vector<std::shared_ptr<const LWECiphertextImpl>> ct1s;
+  std::vector<std::shared_ptr<const LWECiphertextImpl>> ct2s;
+  std::vector<LWEPlaintext> expected;
+
+  for (auto gate : gateTypes) {
+    for (LWEPlaintext m1 = 0; m1 < 2; m1++) {
+      for (LWEPlaintext m2 = 0; m2 < 2; m2++) {
+        gates.push_back(gate);
+        ct1s.push_back(cc.Encrypt(sk, m1));
+        ct2s.push_back(cc.Encrypt(sk, m2));
+        LWEPlaintext m;
+        switch (gate) {
+          case AND:
+            m = m1 & m2;
+            break;
+          case OR:
+            m = m1 | m2;
+            break;
+          case NAND:
+            m = 1 - (m1 & m2);
+            break;
+          case NOR:
+            m = 1 - (m1 | m2);
+            break;
+          case XOR:
+          case XOR_FAST:
+            m = m1 ^ m2;
+            break;
+          default:  // XNOR, XNOR_FAST
+            m = 1 - (m1 ^ m2);
+            break;
+        }
+        expected.push_back(m);
+      }
+    }
+  }
+
+  auto results = cc.EvalBinGates(gates, ct1s, ct2s);
+
+  ASSERT_EQ(gates.size(), results.size()) << "EvalBinGates failed";
+  for (size_t i = 0; i < results.size(); i++) {
+    LWEPlaintext result;
+    cc.Decrypt(sk, results[i], &result);
+    EXPECT_EQ(expected[i], result)
+        << "EvalBinGates failed for gate " << i / 4 << ", inputs "
+        << (i / 2) % 2 << " " << i % 2;
+  }
+
+  // mismatched input sizes are rejected
+  ct2s.pop_back();
+  EXPECT_THROW(cc.EvalBinGates(gates, ct1s, ct2s), config_error);
+}
+
+TEST(UnitTestFHEWAP, EvalBinGates) { EvalBinGatesTest(AP); }
+
+TEST(UnitTestFHEWGINX, EvalBinGates) { EvalBinGatesTest(GINX); }
@@ -33,6 +33,7 @@
 
 namespace lbcrypto {
 class EncodingParamsImpl;
+class PackedEncodingTables;
 
 typedef std::shared_ptr<EncodingParamsImpl> EncodingParams;
 typedef uint64_t PlaintextModulus;
@@ -80,6 +81,7 @@ class EncodingParamsImpl : public lbcrypto::Serializable {
     m_plaintextBigRootOfUnity = rhs.m_plaintextBigRootOfUnity;
     m_plaintextGenerator = rhs.m_plaintextGenerator;
     m_batchSize = rhs.m_batchSize;
+    SetPackedEncodingTables(rhs.GetPackedEncodingTables());
   }
 
   /**
@@ -94,6 +96,7 @@ class EncodingParamsImpl : public lbcrypto::Serializable {
     m_plaintextBigRootOfUnity = std::move(rhs.m_plaintextBigRootOfUnity);
     m_plaintextGenerator = std::move(rhs.m_plaintextGenerator);
     m_batchSize = rhs.m_batchSize;
+    SetPackedEncodingTables(rhs.GetPackedEncodingTables());
   }
 
   /**
@@ -109,6 +112,7 @@ class EncodingParamsImpl : public lbcrypto::Serializable {
     m_plaintextBigRootOfUnity = rhs.m_plaintextBigRootOfUnity;
     m_plaintextGenerator = rhs.m_plaintextGenerator;
     m_batchSize = rhs.m_batchSize;
+    SetPackedEncodingTables(rhs.GetPackedEncodingTables());
     return *this;
   }
 
@@ -206,6 +210,24 @@ class EncodingParamsImpl : public lbcrypto::Serializable {
    */
   void SetBatchSize(usint batchSize) { m_batchSize = batchSize; }
 
+  /**
+   * @brief Getter for the tables PackedEncoding precomputed for these
+   * parameters; safe to call concurrently with SetPackedEncodingTables.
+   * @return the tables, or nullptr if none were built yet.
+   */
+  std::shared_ptr<const PackedEncodingTables> GetPackedEncodingTables() const {
+    return std::atomic_load(&m_packedTables);
+  }
+
+  /**
+   * @brief Setter for the PackedEncoding tables; the tables are immutable and
+   * shared read-only by all plaintexts using these parameters.
+   */
+  void SetPackedEncodingTables(
+      std::shared_ptr<const PackedEncodingTables> tables) {
+    std::atomic_store(&m_packedTables, std::move(tables));
+  }
+
   // Operators
   /**
    * @brief output stream operator.
@@ -263,6 +285,8 @@ class EncodingParamsImpl : public lbcrypto::Serializable {
   uint32_t m_plaintextGenerator;
   // maximum batch size used by EvalSumKeyGen for packed encoding
   uint32_t m_batchSize;
+  // precomputed PackedEncoding tables; not serialized, rebuilt on demand
+  std::shared_ptr<const PackedEncodingTables> m_packedTables;
 
  public:
   template <class Archive>
@@ -42,6 +42,53 @@ namespace lbcrypto {
 // STL pair used as a key for some tables in PackedEncoding
 using ModulusM = std::pair<NativeInteger, uint64_t>;
 
+/**
+ * @class PackedEncodingTables
+ * @brief Precomputed roots of unity and slot permutations used by
+ * PackedEncoding for one plaintext modulus and cyclotomic order. The tables
+ * are immutable once built, so a single instance is shared read-only by all
+ * threads encoding with the same EncodingParams.
+ */
+class PackedEncodingTables {
+ public:
+  /**
+   * @brief Builds the tables; the roots of unity, big modulus and generator
+   * that params does not set yet are computed and stored in params.
+   * @param m the cyclotomic order.
+   * @param params the encoding parameters.
+   */
+  PackedEncodingTables(usint m, EncodingParams params);
+
+  usint GetCyclotomicOrder() const { return m_m; }
+
+  const NativeInteger &GetModulus() const { return m_modulus; }
+
+  const NativeInteger &GetInitRoot() const { return m_initRoot; }
+
+  const NativeInteger &GetBigModulus() const { return m_bigModulus; }
+
+  const NativeInteger &GetBigRoot() const { return m_bigRoot; }
+
+  usint GetAutomorphismGenerator() const { return m_automorphismGenerator; }
+
+  const std::vector<usint> &GetToCRTPerm() const { return m_toCRTPerm; }
+
+  const std::vector<usint> &GetFromCRTPerm() const { return m_fromCRTPerm; }
+
+ private:
+  usint m_m;
+  NativeInteger m_modulus;
+  // initial root of unity for plaintext space
+  NativeInteger m_initRoot;
+  // modulus and root of unity to be used for Arbitrary CRT
+  NativeInteger m_bigModulus;
+  NativeInteger m_bigRoot;
+  // primitive root used in packing
+  usint m_automorphismGenerator;
+  std::vector<usint> m_toCRTPerm;
+  std::vector<usint> m_fromCRTPerm;
+};
+
 /**
  * @class PackedEncoding
  * @brief Type used for representing IntArray types.
@@ -110,9 +157,7 @@ class PackedEncoding : public PlaintextImpl {
   PackedEncoding()
       : PlaintextImpl(shared_ptr<Poly::Params>(0), nullptr), value() {}
 
-  static usint GetAutomorphismGenerator(usint m) {
-    return m_automorphismGenerator[m];
-  }
+  static usint GetAutomorphismGenerator(usint m);
 
   bool Encode();
 
@@ -191,20 +236,20 @@ class PackedEncoding : public PlaintextImpl {
   }
 
  private:
-  // initial root of unity for plaintext space
-  static std::map<ModulusM, NativeInteger> m_initRoot;
-  // modulus and root of unity to be used for Arbitrary CRT
-  static std::map<ModulusM, NativeInteger> m_bigModulus;
-  static std::map<ModulusM, NativeInteger> m_bigRoot;
+  // tables built by SetParams, for plaintexts whose EncodingParams do not
+  // hold tables yet; only accessed under a lock, off the encoding hot path
+  static std::map<ModulusM, std::shared_ptr<const PackedEncodingTables>>
+      m_tables;
 
   // stores the list of primitive roots used in packing.
   static std::map<usint, usint> m_automorphismGenerator;
-  static std::map<usint, std::vector<usint>> m_toCRTPerm;
-  static std::map<usint, std::vector<usint>> m_fromCRTPerm;
 
-  static void SetParams_2n(usint m, const NativeInteger &modulusNI);
-
-  static void SetParams_2n(usint m, EncodingParams params);
+  /**
+   * @brief Returns the tables for cyclotomic order m and plaintext modulus
+   * modulusNI. Lock-free once the EncodingParams of this plaintext hold them.
+   */
+  std::shared_ptr<const PackedEncodingTables> GetTables(
+      usint m, const NativeInteger &modulusNI) const;
 
   /**
    * @brief Packs the slot values into aggregate plaintext space.
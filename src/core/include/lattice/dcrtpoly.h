@@ -34,6 +34,7 @@
 #include "utils/inttypes.h"
 
 #include "utils/exception.h"
+#include "utils/limbbuffer.h"
 
 #include "lattice/elemparams.h"
 #include "lattice/ildcrtparams.h"
@@ -276,6 +277,12 @@ class DCRTPolyImpl : public ILElement<DCRTPolyImpl<VecType>, VecType> {
         DCRTPolyImpl(std::make_shared<typename DCRTPolyImpl::Params>(params),
                      EVALUATION, false);
 
+    if (IsContiguousStorage() && AllTowersSet(startTower, endTower)) {
+      res.m_vectors = MakeContiguousTowers(res.m_params, EVALUATION,
+                                           &m_vectors, startTower);
+      return res;
+    }
+
     for (uint32_t i = startTower; i <= endTower; i++) {
       res.SetElementAtIndex(i - startTower, this->GetElementAtIndex(i));
     }
@@ -850,6 +857,34 @@ class DCRTPolyImpl : public ILElement<DCRTPolyImpl<VecType>, VecType> {
     m_vectors[index] = std::move(element);
   }
 
+  /**
+   * @brief Enables or disables contiguous storage: when enabled, new elements,
+   * copies, copy assignments and CloneTowers place the coefficients of all
+   * their towers in one 64-byte aligned LimbBuffer, tower after tower, instead
+   * of one allocation per tower. Disabled by default.
+   *
+   * The layout saves allocations only: every tower still owns its slice of
+   * the buffer, so copies and CloneTowers copy the coefficients, and the
+   * transforms and base conversions work tower by tower as before. Dropping
+   * half of the towers or more moves the remaining ones to a smaller buffer.
+   *
+   * @param enabled whether to use contiguous storage
+   */
+  static void SetContiguousStorage(bool enabled) {
+    LimbBuffer::SetEnabled(enabled);
+  }
+
+  /**
+   * @brief Returns true if contiguous storage is enabled.
+   */
+  static bool IsContiguousStorage() { return LimbBuffer::IsEnabled(); }
+
+  /**
+   * @brief Returns true if all towers of this element live in the same
+   * LimbBuffer.
+   */
+  bool IsContiguous() const;
+
   /**
    * @brief Sets all values of element to zero.
    */
@@ -937,6 +972,26 @@ class DCRTPolyImpl : public ILElement<DCRTPolyImpl<VecType>, VecType> {
    */
   PolyLargeType CRTInterpolate() const;
 
+  /**
+   * @brief Reconstructs the coefficients, centered in (-Q/2, Q/2], as doubles
+   * without any multiprecision arithmetic: the towers are converted to
+   * mixed-radix digits in native arithmetic and the digits are evaluated in
+   * long double.
+   *
+   * If numTowers is given, the values are first reconstructed from that many
+   * leading towers only, and the remaining towers are used to check the
+   * result; coefficients that do not pass the check fall back to all towers.
+   * This is much cheaper when the values are known to be small relative to
+   * the modulus, and exact either way.
+   *
+   * @param scale factor applied to every value before rounding it to double
+   * @param numTowers number of leading towers expected to determine the values;
+   * 0 means all towers
+   * @return the centered coefficients times scale
+   */
+  std::vector<double> CRTInterpolateToDouble(double scale = 1.0,
+                                             usint numTowers = 0) const;
+
   PolyType DecryptionCRTInterpolate(PlaintextModulus ptm) const;
 
   NativePoly ToNativePoly() const;
@@ -1071,6 +1126,36 @@ class DCRTPolyImpl : public ILElement<DCRTPolyImpl<VecType>, VecType> {
       const NativeInteger &t = 0,
       const vector<NativeInteger> &tModqPrecon = vector<NativeInteger>()) const;
 
+  /**
+   * @brief Computes the inner products of hybrid key switching:
+   * {sum_j c_j * b_j}_{Q_l,P} and {sum_j c_j * a_j}_{Q_l,P}.
+   * {Q_l} = {q_1,...,q_l}
+   * {Q} = {q_1,...,q_L}
+   * {P} = {p_1,...,p_k}
+   *
+   * The digits c_j are given over {Q_l,P} and the key components a_j, b_j
+   * over {Q,P}, all in evaluation representation. The products are
+   * accumulated in 128 bits and reduced once per coefficient; towers are
+   * processed in parallel.
+   *
+   * @param &digits the extended digits {c_j}_{Q_l,P}
+   * @param &bv the key components {b_j}_{Q,P}
+   * @param &av the key components {a_j}_{Q,P}
+   * @param sizeQ the number of towers of {Q}
+   * @param &modqBarrettMu 128-bit Barrett reduction precomputed values for
+   * q_i
+   * @param &modpBarrettMu 128-bit Barrett reduction precomputed values for
+   * p_j
+   * @param *sum0 the first inner product over {Q_l,P}
+   * @param *sum1 the second inner product over {Q_l,P}
+   */
+  static void KeySwitchInnerProduct(
+      const vector<DCRTPolyType> &digits, const vector<DCRTPolyType> &bv,
+      const vector<DCRTPolyType> &av, usint sizeQ,
+      const vector<DoubleNativeInt> &modqBarrettMu,
+      const vector<DoubleNativeInt> &modpBarrettMu, DCRTPolyType *sum0,
+      DCRTPolyType *sum1);
+
   /**
    * @brief Performs CRT basis switching:
    * {X}_{Q} -> {X}_{P}
@@ -1387,7 +1472,8 @@ class DCRTPolyImpl : public ILElement<DCRTPolyImpl<VecType>, VecType> {
 
   /**
    * @brief Convert from Coefficient to CRT or vice versa; calls FFT and inverse
-   * FFT.
+   * FFT. All towers are transformed together (see PolyImpl::SwitchFormat) so
+   * that the work is spread over the threads by tower and by block.
    */
   void SwitchFormat();
 
@@ -1645,6 +1731,24 @@ class DCRTPolyImpl : public ILElement<DCRTPolyImpl<VecType>, VecType> {
   static uint32_t SerializedVersion() { return 1; }
 
  private:
+  // true if towers [first, last] all hold values
+  bool AllTowersSet(usint first, usint last) const {
+    for (usint i = first; i <= last; i++) {
+      if (m_vectors[i].IsEmpty()) return false;
+    }
+    return true;
+  }
+
+  // builds one tower per modulus of params, all placed in a single LimbBuffer;
+  // the towers are zero, or copies of (*src)[first], (*src)[first + 1], ...
+  static std::vector<PolyType> MakeContiguousTowers(
+      const shared_ptr<Params> params, Format format,
+      const std::vector<PolyType> *src = nullptr, usint first = 0);
+
+  // true if the towers left after dropping the last ones should be moved out
+  // of the shared buffer
+  bool RepackAfterDrop(size_t dropped) const;
+
   shared_ptr<Params> m_params;
 
   // array of vectors used for double-CRT presentation
@@ -25,10 +25,12 @@
 #ifndef LBCRYPTO_LATTICE_ILPARAMS_H
 #define LBCRYPTO_LATTICE_ILPARAMS_H
 
+#include <memory>
 #include <string>
 
 #include "lattice/elemparams.h"
 #include "math/backend.h"
+#include "math/bigintnat/nttnat.h"
 #include "math/nbtheory.h"
 #include "utils/inttypes.h"
 
@@ -94,6 +96,7 @@ class ILParamsImpl : public ElemParams<IntType> {
    */
   const ILParamsImpl &operator=(const ILParamsImpl &rhs) {
     ElemParams<IntType>::operator=(rhs);
+    SetNativeNTTTables(nullptr);
     return *this;
   }
 
@@ -123,6 +126,28 @@ class ILParamsImpl : public ElemParams<IntType> {
     return ElemParams<IntType>::operator==(rhs);
   }
 
+  /**
+   * @brief Gets the native transform tables last resolved for these
+   * parameters; the caller checks that they are still current.
+   *
+   * @return the cached tables or nullptr.
+   */
+  std::shared_ptr<const bigintnat::NativeNTTTables> GetNativeNTTTables()
+      const {
+    return std::atomic_load(&m_nativeNTTTables);
+  }
+
+  /**
+   * @brief Caches the native transform tables resolved for these parameters.
+   *
+   * @param tables the tables returned by
+   * ChineseRemainderTransformFTT::GetNativeTables().
+   */
+  void SetNativeNTTTables(
+      std::shared_ptr<const bigintnat::NativeNTTTables> tables) const {
+    std::atomic_store(&m_nativeNTTTables, tables);
+  }
+
  private:
   std::ostream &doprint(std::ostream &out) const {
     out << "ILParams ";
@@ -145,10 +170,16 @@ class ILParamsImpl : public ElemParams<IntType> {
                          " is from a later version of the library");
     }
     ar(::cereal::base_class<ElemParams<IntType>>(this));
+    SetNativeNTTTables(nullptr);
   }
 
   std::string SerializedObjectName() const { return "ILParms"; }
   static uint32_t SerializedVersion() { return 1; }
+
+ private:
+  // not serialized; copies start empty and the tables are resolved on first
+  // use
+  mutable std::shared_ptr<const bigintnat::NativeNTTTables> m_nativeNTTTables;
 };
 
 }  // namespace lbcrypto
@@ -92,6 +92,15 @@ class PolyImpl : public ILElement<PolyImpl<VecType>, VecType> {
            Format format = Format::EVALUATION,
            bool initializeElementToZero = false);
 
+  /**
+   * @brief Construct given parameters, format and the coefficient vector,
+   * which is taken over without a copy
+   * @param params - element parameters
+   * @param format - Format::EVALUATION or COEFFICIENT
+   * @param values - vector matching the ring dimension and modulus of params
+   */
+  PolyImpl(const shared_ptr<Params> params, Format format, VecType &&values);
+
   /**
    * @brief Construct given parameters and format
    * @param initializeElementToMax - if true, initializes entries in the vector
@@ -691,6 +700,19 @@ class PolyImpl : public ILElement<PolyImpl<VecType>, VecType> {
    */
   void SwitchFormat();
 
+  /**
+   * @brief Convert the elements in [first, last) of a vector from Coefficient
+   * to Format::EVALUATION or vice versa in one batched transform. Elements
+   * that do not share the format and power-of-two cyclotomic order of the
+   * first one are converted one by one.
+   *
+   * @param elements is the vector of elements, e.g. the towers of a DCRTPoly.
+   * @param first is the index of the first element to convert.
+   * @param last is one past the index of the last element to convert.
+   */
+  static void SwitchFormat(std::vector<PolyImpl> *elements, usint first,
+                           usint last);
+
   /**
    * @brief Make the element values sparse. Sets every index not equal to zero
    * mod the wFactor to zero.
@@ -35,6 +35,7 @@
 
 #include "math/interface.h"
 #include "utils/inttypes.h"
+#include "utils/limbbuffer.h"
 #include "utils/serializable.h"
 
 #include "utils/blockAllocator/xvector.h"
@@ -137,6 +138,18 @@ class NativeVector
    */
   NativeVector(usint length, const IntegerType &modulus);
 
+  /**
+   * Constructor that places the entries in a shared LimbBuffer; falls back to
+   * the heap if the buffer is exhausted.
+   *
+   * @param length is the length of the native vector, in terms of the number of
+   * entries.
+   * @param modulus is the modulus of the ring.
+   * @param buffer is the block the entries are carved out of.
+   */
+  NativeVector(usint length, const IntegerType &modulus,
+               std::shared_ptr<lbcrypto::LimbBuffer> buffer);
+
   /**
    * Basic constructor for copying a vector
    *
@@ -293,6 +306,19 @@ class NativeVector
    */
   size_t GetLength() const { return this->m_data.size(); }
 
+  /**
+   * Returns the LimbBuffer the entries live in, or nullptr for heap storage.
+   */
+#if BLOCK_VECTOR_ALLOCATION != 1
+  std::shared_ptr<lbcrypto::LimbBuffer> GetLimbBuffer() const {
+    return this->m_data.get_allocator().GetBuffer();
+  }
+#else
+  std::shared_ptr<lbcrypto::LimbBuffer> GetLimbBuffer() const {
+    return nullptr;
+  }
+#endif
+
   // MODULAR ARITHMETIC OPERATIONS
 
   /**
@@ -637,8 +663,10 @@ class NativeVector
  private:
   // m_data is a pointer to the vector
 
+  // the entries live in a LimbBuffer or come from the CoefficientPool, see
+  // LimbAllocator
 #if BLOCK_VECTOR_ALLOCATION != 1
-  std::vector<IntegerType> m_data;
+  std::vector<IntegerType, lbcrypto::LimbAllocator<IntegerType>> m_data;
 #else
   xvector<IntegerType> m_data;
 #endif
@@ -0,0 +1,165 @@
+// @file nttnat.h This file contains the lazy-reduction number theoretic
+// transform kernels for 64-bit native vectors.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef LBCRYPTO_MATH_BIGINTNAT_NTTNAT_H
+#define LBCRYPTO_MATH_BIGINTNAT_NTTNAT_H
+
+#include <cstdint>
+
+#include "utils/cpufeatures.h"
+#include "utils/inttypes.h"
+
+namespace bigintnat {
+
+/**
+ * @brief Raw words of the tables one tower needs for the native transforms.
+ *
+ * The pointers refer to the tables owned by ChineseRemainderTransformFTT and
+ * are only valid while its table generation equals #generation; they are
+ * cached on the ring parameters of each tower so that the batched transforms
+ * avoid the per-call map lookups.
+ */
+struct NativeNTTTables {
+  usint cycloOrder;
+  uint64_t modulus;
+  uint64_t rootOfUnity;
+  uint64_t generation;
+  const uint64_t* rootOfUnityTable;
+  const uint64_t* preconRootOfUnityTable;
+  const uint64_t* rootOfUnityInverseTable;
+  const uint64_t* preconRootOfUnityInverseTable;
+  uint64_t cycloOrderInv;
+  uint64_t preconCycloOrderInv;
+};
+
+/**
+ * @brief Negacyclic NTT over raw 64-bit words using Harvey's lazy butterflies
+ * (https://arxiv.org/pdf/1205.2926.pdf, Algorithms 3 and 4).
+ *
+ * Intermediate values are kept in [0, 4q) between stages and every twiddle
+ * multiplication uses Shoup's precomputed quotient, so a butterfly costs one
+ * high and two low word products plus a single conditional subtraction. The
+ * outputs are fully reduced to [0, q). The kernel is chosen at runtime from
+ * lbcrypto::CPUFeatures::GetSIMDLevel().
+ *
+ * The twiddle tables use the layout of
+ * ChineseRemainderTransformFTT::m_rootOfUnityReverseTableByModulus and the
+ * precomputations are those returned by NativeIntegerT::PrepModMulConst().
+ */
+class NativeNTT {
+ public:
+  /**
+   * Lazy reduction requires 4q to fit in a word.
+   *
+   * @param modulus is q.
+   * @return true if the kernels can be used with this modulus.
+   */
+  static bool IsSupportedModulus(uint64_t modulus) {
+    return modulus < (uint64_t(1) << 62);
+  }
+
+  /**
+   * In-place forward transform, bit-reversed output.
+   *
+   * @param[in,out] element is the input/output array of length n with entries
+   * in [0, q).
+   * @param n is the ring dimension, a power of two.
+   * @param modulus is the prime q with 2n | q-1.
+   * @param rootOfUnityTable holds the n powers of the 2n-th root of unity in
+   * bit-reversed order.
+   * @param preconRootOfUnityTable holds the Shoup precomputations of
+   * rootOfUnityTable.
+   */
+  static void ForwardTransformToBitReverseInPlace(
+      uint64_t* element, usint n, uint64_t modulus,
+      const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable);
+
+  /**
+   * In-place inverse transform, bit-reversed input.
+   *
+   * @param[in,out] element is the input/output array of length n with entries
+   * in [0, q).
+   * @param n is the ring dimension, a power of two.
+   * @param modulus is the prime q with 2n | q-1.
+   * @param rootOfUnityInverseTable holds the n powers of the inverse 2n-th
+   * root of unity in bit-reversed order.
+   * @param preconRootOfUnityInverseTable holds the Shoup precomputations of
+   * rootOfUnityInverseTable.
+   * @param cycloOrderInv is the inverse of n modulo q.
+   * @param preconCycloOrderInv is the Shoup precomputation of cycloOrderInv.
+   */
+  static void InverseTransformFromBitReverseInPlace(
+      uint64_t* element, usint n, uint64_t modulus,
+      const uint64_t* rootOfUnityInverseTable,
+      const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+      uint64_t preconCycloOrderInv);
+
+  /**
+   * In-place forward transforms of a batch of arrays of the same length, e.g.
+   * the towers of a DCRTPoly, on the threads of lbcrypto::ParallelFor.
+   *
+   * Work is split into (element, block) units: when there are fewer elements
+   * than threads, the first stages of each transform are cut into slices and
+   * the later stages, which only touch one block of coefficients, run
+   * independently per block.
+   *
+   * @param[in,out] elements are numElements arrays of length n.
+   * @param numElements is the number of arrays.
+   * @param n is the ring dimension, a power of two.
+   * @param moduli holds the modulus of each array.
+   * @param rootOfUnityTables holds the twiddle table of each array.
+   * @param preconRootOfUnityTables holds the Shoup precomputations of each
+   * twiddle table.
+   */
+  static void ForwardTransformToBitReverseInPlace(
+      uint64_t* const* elements, usint numElements, usint n,
+      const uint64_t* moduli, const uint64_t* const* rootOfUnityTables,
+      const uint64_t* const* preconRootOfUnityTables);
+
+  /**
+   * In-place inverse transforms of a batch of arrays of the same length, with
+   * the same scheduling as the batched forward transform.
+   *
+   * @param[in,out] elements are numElements arrays of length n.
+   * @param numElements is the number of arrays.
+   * @param n is the ring dimension, a power of two.
+   * @param moduli holds the modulus of each array.
+   * @param rootOfUnityInverseTables holds the inverse twiddle table of each
+   * array.
+   * @param preconRootOfUnityInverseTables holds the Shoup precomputations of
+   * each inverse twiddle table.
+   * @param cycloOrderInv holds the inverse of n modulo each modulus.
+   * @param preconCycloOrderInv holds the Shoup precomputations of
+   * cycloOrderInv.
+   */
+  static void InverseTransformFromBitReverseInPlace(
+      uint64_t* const* elements, usint numElements, usint n,
+      const uint64_t* moduli, const uint64_t* const* rootOfUnityInverseTables,
+      const uint64_t* const* preconRootOfUnityInverseTables,
+      const uint64_t* cycloOrderInv, const uint64_t* preconCycloOrderInv);
+};
+
+}  // namespace bigintnat
+
+#endif  // LBCRYPTO_MATH_BIGINTNAT_NTTNAT_H
@@ -0,0 +1,180 @@
+// @file simdnat.h This file contains the word and SIMD lane arithmetic shared
+// by the 64-bit native vector kernels.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef LBCRYPTO_MATH_BIGINTNAT_SIMDNAT_H
+#define LBCRYPTO_MATH_BIGINTNAT_SIMDNAT_H
+
+#include <cstdint>
+
+#include "config_core.h"
+#include "utils/cpufeatures.h"
+
+#ifdef PALISADE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+// These helpers are only meant to be included by the kernel translation units
+// (nttnat.cpp, vecopsnat.cpp); every function has internal linkage.
+
+namespace bigintnat {
+
+/// SCALAR
+
+static inline uint64_t MulHi64(uint64_t a, uint64_t b) {
+#if defined(HAVE_INT128)
+  return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+  uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+  uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+  uint64_t hilo = aHi * bLo, lohi = aLo * bHi;
+  uint64_t mid = ((aLo * bLo) >> 32) + (hilo & 0xFFFFFFFF) + (lohi & 0xFFFFFFFF);
+  return aHi * bHi + (hilo >> 32) + (lohi >> 32) + (mid >> 32);
+#endif
+}
+
+// w*y mod q in [0, 2q) for any word y (Shoup's multiplication without the
+// final correction)
+static inline uint64_t MulShoupLazy(uint64_t y, uint64_t w, uint64_t wPrecon,
+                                    uint64_t q) {
+  return w * y - MulHi64(y, wPrecon) * q;
+}
+
+#ifdef PALISADE_X86_SIMD
+
+/// AVX2
+// AVX2 has no 64x64-bit multiplier, so the products are assembled from
+// 32x32-bit partial products.
+
+PALISADE_TARGET_AVX2 static inline __m256i MulHi64AVX2(__m256i a, __m256i b) {
+  const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+  __m256i aHi = _mm256_srli_epi64(a, 32);
+  __m256i bHi = _mm256_srli_epi64(b, 32);
+  __m256i lolo = _mm256_mul_epu32(a, b);
+  __m256i hilo = _mm256_mul_epu32(aHi, b);
+  __m256i lohi = _mm256_mul_epu32(a, bHi);
+  __m256i hihi = _mm256_mul_epu32(aHi, bHi);
+  __m256i mid = _mm256_add_epi64(_mm256_srli_epi64(lolo, 32),
+                                 _mm256_and_si256(hilo, lowMask));
+  mid = _mm256_add_epi64(mid, _mm256_and_si256(lohi, lowMask));
+  __m256i hi = _mm256_add_epi64(hihi, _mm256_srli_epi64(hilo, 32));
+  hi = _mm256_add_epi64(hi, _mm256_srli_epi64(lohi, 32));
+  return _mm256_add_epi64(hi, _mm256_srli_epi64(mid, 32));
+}
+
+PALISADE_TARGET_AVX2 static inline __m256i MulLo64AVX2(__m256i a, __m256i b) {
+  __m256i lolo = _mm256_mul_epu32(a, b);
+  __m256i cross = _mm256_add_epi64(
+      _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+      _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(lolo, _mm256_slli_epi64(cross, 32));
+}
+
+// full 128-bit products a*b, split into high and low words
+PALISADE_TARGET_AVX2 static inline void MulWide64AVX2(__m256i a, __m256i b,
+                                                      __m256i* hi,
+                                                      __m256i* lo) {
+  const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+  __m256i aHi = _mm256_srli_epi64(a, 32);
+  __m256i bHi = _mm256_srli_epi64(b, 32);
+  __m256i lolo = _mm256_mul_epu32(a, b);
+  __m256i hilo = _mm256_mul_epu32(aHi, b);
+  __m256i lohi = _mm256_mul_epu32(a, bHi);
+  __m256i hihi = _mm256_mul_epu32(aHi, bHi);
+  __m256i mid = _mm256_add_epi64(_mm256_srli_epi64(lolo, 32),
+                                 _mm256_and_si256(hilo, lowMask));
+  mid = _mm256_add_epi64(mid, _mm256_and_si256(lohi, lowMask));
+  __m256i h = _mm256_add_epi64(hihi, _mm256_srli_epi64(hilo, 32));
+  h = _mm256_add_epi64(h, _mm256_srli_epi64(lohi, 32));
+  *hi = _mm256_add_epi64(h, _mm256_srli_epi64(mid, 32));
+  *lo = _mm256_add_epi64(
+      lolo, _mm256_slli_epi64(_mm256_add_epi64(hilo, lohi), 32));
+}
+
+PALISADE_TARGET_AVX2 static inline __m256i MulShoupLazyAVX2(__m256i y,
+                                                            __m256i w,
+                                                            __m256i wPrecon,
+                                                            __m256i q) {
+  __m256i quot = MulHi64AVX2(y, wPrecon);
+  return _mm256_sub_epi64(MulLo64AVX2(y, w), MulLo64AVX2(quot, q));
+}
+
+// x - bound if x >= bound. AVX2 only has a signed 64-bit compare, so both
+// sides are offset by 2^63 to compare lazy values at or above 2^63 correctly.
+PALISADE_TARGET_AVX2 static inline __m256i CondSubAVX2(__m256i x,
+                                                       __m256i bound) {
+  const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+  __m256i less = _mm256_cmpgt_epi64(_mm256_xor_si256(bound, sign),
+                                    _mm256_xor_si256(x, sign));
+  return _mm256_sub_epi64(x, _mm256_andnot_si256(less, bound));
+}
+
+/// AVX-512
+// AVX512DQ provides the low 64-bit product; the high half is still assembled
+// from 32x32-bit partial products.
+
+PALISADE_TARGET_AVX512 static inline __m512i MulHi64AVX512(__m512i a,
+                                                           __m512i b) {
+  const __m512i lowMask = _mm512_set1_epi64(0xFFFFFFFF);
+  __m512i aHi = _mm512_srli_epi64(a, 32);
+  __m512i bHi = _mm512_srli_epi64(b, 32);
+  __m512i lolo = _mm512_mul_epu32(a, b);
+  __m512i hilo = _mm512_mul_epu32(aHi, b);
+  __m512i lohi = _mm512_mul_epu32(a, bHi);
+  __m512i hihi = _mm512_mul_epu32(aHi, bHi);
+  __m512i mid = _mm512_add_epi64(_mm512_srli_epi64(lolo, 32),
+                                 _mm512_and_si512(hilo, lowMask));
+  mid = _mm512_add_epi64(mid, _mm512_and_si512(lohi, lowMask));
+  __m512i hi = _mm512_add_epi64(hihi, _mm512_srli_epi64(hilo, 32));
+  hi = _mm512_add_epi64(hi, _mm512_srli_epi64(lohi, 32));
+  return _mm512_add_epi64(hi, _mm512_srli_epi64(mid, 32));
+}
+
+// full 128-bit products a*b, split into high and low words
+PALISADE_TARGET_AVX512 static inline void MulWide64AVX512(__m512i a,
+                                                          __m512i b,
+                                                          __m512i* hi,
+                                                          __m512i* lo) {
+  *hi = MulHi64AVX512(a, b);
+  *lo = _mm512_mullo_epi64(a, b);
+}
+
+PALISADE_TARGET_AVX512 static inline __m512i MulShoupLazyAVX512(
+    __m512i y, __m512i w, __m512i wPrecon, __m512i q) {
+  __m512i quot = MulHi64AVX512(y, wPrecon);
+  return _mm512_sub_epi64(_mm512_mullo_epi64(y, w),
+                          _mm512_mullo_epi64(quot, q));
+}
+
+// x - bound if x >= bound
+PALISADE_TARGET_AVX512 static inline __m512i CondSubAVX512(__m512i x,
+                                                           __m512i bound) {
+  return _mm512_min_epu64(x, _mm512_sub_epi64(x, bound));
+}
+
+#endif  // PALISADE_X86_SIMD
+
+}  // namespace bigintnat
+
+#endif  // LBCRYPTO_MATH_BIGINTNAT_SIMDNAT_H
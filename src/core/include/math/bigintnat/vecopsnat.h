@@ -0,0 +1,106 @@
+// @file vecopsnat.h This file contains the element-wise modular arithmetic
+// kernels for 64-bit native vectors.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef LBCRYPTO_MATH_BIGINTNAT_VECOPSNAT_H
+#define LBCRYPTO_MATH_BIGINTNAT_VECOPSNAT_H
+
+#include <cstdint>
+
+#include "utils/cpufeatures.h"
+#include "utils/inttypes.h"
+
+namespace bigintnat {
+
+/**
+ * @brief Element-wise modular arithmetic over raw 64-bit words.
+ *
+ * All inputs must be in [0, q) and all outputs are fully reduced. Products of
+ * two vectors use Barrett reduction (HAC Algorithm 14.42 with base 2); products
+ * by a constant use Shoup's multiplication with the precomputation returned by
+ * NativeIntegerT::PrepModMulConst(). The kernel is chosen at runtime from
+ * lbcrypto::CPUFeatures::GetSIMDLevel().
+ */
+class NativeVectorOps {
+ public:
+  /**
+   * The Barrett remainder lies in [0, 3q), which must stay below 2^63 for the
+   * signed lane comparisons of the AVX2 kernels.
+   *
+   * @param modulus is q.
+   * @return true if the kernels can be used with this modulus.
+   */
+  static bool IsSupportedModulus(uint64_t modulus) {
+    return modulus > 1 && modulus < (uint64_t(1) << 61);
+  }
+
+  /**
+   * a[i] = a[i] + b[i] mod q
+   *
+   * @param[in,out] a is the input/output array of length n.
+   * @param b is the second operand, an array of length n.
+   * @param n is the length of the arrays.
+   * @param modulus is q.
+   */
+  static void ModAddEq(uint64_t* a, const uint64_t* b, usint n,
+                       uint64_t modulus);
+
+  /**
+   * a[i] = a[i] - b[i] mod q
+   *
+   * @param[in,out] a is the input/output array of length n.
+   * @param b is the second operand, an array of length n.
+   * @param n is the length of the arrays.
+   * @param modulus is q.
+   */
+  static void ModSubEq(uint64_t* a, const uint64_t* b, usint n,
+                       uint64_t modulus);
+
+  /**
+   * a[i] = a[i] * b[i] mod q, using Barrett reduction
+   *
+   * @param[in,out] a is the input/output array of length n.
+   * @param b is the second operand, an array of length n.
+   * @param n is the length of the arrays.
+   * @param modulus is q.
+   */
+  static void ModMulEq(uint64_t* a, const uint64_t* b, usint n,
+                       uint64_t modulus);
+
+  /**
+   * a[i] = a[i] * b mod q, using Shoup's multiplication
+   *
+   * @param[in,out] a is the input/output array of length n.
+   * @param n is the length of the array.
+   * @param modulus is q.
+   * @param b is the constant, in [0, q).
+   * @param bPrecon is the Shoup precomputation of b.
+   */
+  static void ModMulConstEq(uint64_t* a, usint n, uint64_t modulus, uint64_t b,
+                            uint64_t bPrecon);
+};
+
+}  // namespace bigintnat
+
+#endif  // LBCRYPTO_MATH_BIGINTNAT_VECOPSNAT_H
@@ -30,6 +30,7 @@
 #include <complex>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -43,6 +44,58 @@
 
 namespace lbcrypto {
 
+/**
+ * @brief Precomputed plan for the special FFT used in CKKS encoding, for one
+ * cyclotomic order m and number of slots nh. A plan is immutable once built,
+ * so it can be shared by any number of threads without locking.
+ */
+class FFTSpecialPlan {
+ public:
+  /**
+   * Builds the twiddle factors and the bit-reversal permutation.
+   *
+   * @param m is the cyclotomic order; it must be a multiple of 4 * nh.
+   * @param nh is the number of slots, a power of two.
+   */
+  FFTSpecialPlan(size_t m, size_t nh);
+
+  size_t GetCyclotomicOrder() const { return m_M; }
+
+  size_t GetSlots() const { return m_Nh; }
+
+  /**
+   * In-place FFT-like algorithm used in CKKS decoding; see
+   * DiscreteFourierTransform::FFTSpecial.
+   *
+   * @param vals is a vector of nh complex numbers.
+   */
+  void FFTSpecial(std::vector<std::complex<double>> &vals) const;
+
+  /**
+   * In-place FFT-like algorithm used in CKKS encoding; see
+   * DiscreteFourierTransform::FFTSpecialInv.
+   *
+   * @param vals is a vector of nh complex numbers.
+   */
+  void FFTSpecialInv(std::vector<std::complex<double>> &vals) const;
+
+ private:
+  size_t m_M;
+  size_t m_Nh;
+
+  // Twiddle factors in split real/imaginary storage; the factors of the
+  // stage with half-length lenh are stored at [lenh, 2 * lenh).
+  std::vector<double> m_twiddleRe;
+  std::vector<double> m_twiddleIm;
+  std::vector<double> m_twiddleInvRe;
+  std::vector<double> m_twiddleInvIm;
+
+  /// bit-reversal permutation of the nh slot indices
+  std::vector<uint32_t> m_bitReverse;
+
+  void BitReverse(std::vector<std::complex<double>> &vals) const;
+};
+
 /**
  * @brief Discrete Fourier Transform FFT implemetation.
  */
@@ -107,26 +160,25 @@ class DiscreteFourierTransform {
 
   static void PreComputeTable(uint32_t s);
 
+  /**
+   * Builds the special FFT plan for cyclotomic order m and nh slots ahead of
+   * its first use.
+   */
   static void Initialize(size_t m, size_t nh);
 
+  /**
+   * Returns the special FFT plan for cyclotomic order m and nh slots,
+   * building it on first use. Plans for different ring dimensions coexist;
+   * lookups of an already built plan do not take a lock.
+   *
+   * @param m is the cyclotomic order.
+   * @param nh is the number of slots.
+   * @return the shared, immutable plan.
+   */
+  static std::shared_ptr<const FFTSpecialPlan> GetPlan(size_t m, size_t nh);
+
  private:
   static std::complex<double> *rootOfUnityTable;
-
-  static size_t m_M;
-  static size_t m_Nh;
-
-  // flag that is set to false
-  // when initialization is in progress
-  static bool m_isInitialized;
-
-  /// precomputed rotation group indexes
-  static std::vector<uint32_t> m_rotGroup;
-  /// precomputed ksi powers
-  static std::vector<std::complex<double>> m_ksiPows;
-
-  static void FFTSpecialInvLazy(std::vector<std::complex<double>> &vals);
-
-  static void BitReverse(std::vector<std::complex<double>> &vals);
 };
 
 }  // namespace lbcrypto
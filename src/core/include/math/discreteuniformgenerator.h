@@ -26,8 +26,11 @@
 #ifndef LBCRYPTO_MATH_DISCRETEUNIFORMGENERATOR_H_
 #define LBCRYPTO_MATH_DISCRETEUNIFORMGENERATOR_H_
 
+#include <array>
 #include <limits>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include "math/backend.h"
 #include "math/distributiongenerator.h"
@@ -69,20 +72,48 @@ class DiscreteUniformGeneratorImpl : public DistributionGenerator<VecType> {
    */
   VecType GenerateVector(const usint size) const;
 
+  /**
+   * @brief Makes the generator draw its samples from a private PRNG seeded
+   * with the given value rather than from the thread-local PRNG. The same
+   * seed and modulus always reproduce the same sequence of samples, which is
+   * what allows uniform key components to be shipped as a seed.
+   * @param seed the 512-bit seed of the private PRNG
+   */
+  void SetSeed(const std::array<uint32_t, 16>& seed);
+
+  /**
+   * @brief Seeds the private PRNG with one stream of a short seed. Distinct
+   * (stream, domain) pairs yield independent sequences, so a single short
+   * seed can stand in for many uniformly random ring elements.
+   * @param seed a short seed, e.g., produced by GenerateSeed()
+   * @param stream index of the stream, e.g., the index of a ring element
+   * @param domain tag that separates unrelated uses of the same seed
+   */
+  void SetSeed(const std::vector<uint32_t>& seed, uint32_t stream,
+               uint32_t domain);
+
+  /**
+   * @brief Draws a fresh 256-bit seed from the thread-local PRNG.
+   */
+  static std::vector<uint32_t> GenerateSeed();
+
  private:
-  // discrete uniform generator relies on the built-in C++ generator for 32-bit
-  // unsigned integers the constants below set the parameters specific to 32-bit
-  // chunk configuration
-  static const usint CHUNK_MIN = 0;
+  // returns the seeded PRNG if one was set and the thread-local PRNG otherwise
+  PRNG& GetPRNG() const;
+
+  // private PRNG used when the generator was seeded explicitly
+  std::shared_ptr<PRNG> m_prng;
+
+  // discrete uniform generator assembles the samples from the 32-bit words of
+  // the PRNG
   static const usint CHUNK_WIDTH = std::numeric_limits<uint32_t>::digits;
-  static const usint CHUNK_MAX = std::numeric_limits<uint32_t>::max();
 
-  // number of 32-bit chunks in the modulus set for the discrete uniform
+  // number of full 32-bit chunks in the modulus set for the discrete uniform
   // generator object
   usint m_chunksPerValue;
 
-  // built-in generator for 32-bit unsigned integers
-  static std::uniform_int_distribution<uint32_t> m_distribution;
+  // mask of the bits of the modulus above the full chunks; 0 if there are none
+  uint32_t m_topChunkMask;
 
   /**
    * The modulus value that should be used to generate discrete values.
@@ -38,6 +38,7 @@
 #include "math/nbtheory.h"
 #include "utils/inttypes.h"
 #include "utils/memory.h"
+#include "utils/scheduler.h"
 #include "utils/utilities.h"
 using std::invalid_argument;
 
@@ -337,12 +338,11 @@ class Matrix : public Serializable {
    */
   Matrix<Element> ScalarMult(Element const& other) const {
     Matrix<Element> result(*this);
-#pragma omp parallel for
-    for (size_t col = 0; col < result.cols; ++col) {
+    ParallelFor(0, result.cols, [&](size_t col) {
       for (size_t row = 0; row < result.rows; ++row) {
         result.data[row][col] = result.data[row][col] * other;
       }
-    }
+    });
 
     return result;
   }
@@ -443,12 +443,11 @@ class Matrix : public Serializable {
                      "Addition operands have incompatible dimensions");
     }
     Matrix<Element> result(*this);
-#pragma omp parallel for
-    for (size_t j = 0; j < cols; ++j) {
+    ParallelFor(0, cols, [&](size_t j) {
       for (size_t i = 0; i < rows; ++i) {
         result.data[i][j] += other.data[i][j];
       }
-    }
+    });
     return result;
   }
 
@@ -482,12 +481,11 @@ class Matrix : public Serializable {
                      "Subtraction operands have incompatible dimensions");
     }
     Matrix<Element> result(allocZero, rows, other.cols);
-#pragma omp parallel for
-    for (size_t j = 0; j < cols; ++j) {
+    ParallelFor(0, cols, [&](size_t j) {
       for (size_t i = 0; i < rows; ++i) {
         result.data[i][j] = data[i][j] - other.data[i][j];
       }
-    }
+    });
 
     return result;
   }
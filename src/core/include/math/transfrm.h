@@ -26,16 +26,19 @@
 #define LBCRYPTO_MATH_TRANSFRM_H
 
 #include <time.h>
+#include <atomic>
 #include <chrono>
 #include <complex>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
 
 #include "math/backend.h"
+#include "math/bigintnat/nttnat.h"
 #include "math/nbtheory.h"
 #include "utils/utilities.h"
 
@@ -341,6 +344,89 @@ class ChineseRemainderTransformFTT {
                                                     const usint CycloOrder,
                                                     VecType* element);
 
+  /**
+   * In-place Forward Transform of several elements of the same length, each
+   * with its own modulus, e.g. the towers of a DCRTPoly. The twiddle tables of
+   * all elements are looked up once, before a single parallel pass that splits
+   * the work into (element, block) units.
+   *
+   * @param &rootOfUnity holds the 2n-th root of unity of each element.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param[in,out] &elements are the inputs/outputs of the transform, of
+   * length n.
+   * @see ForwardTransformToBitReverseInPlace()
+   */
+  static void ForwardTransformToBitReverseInPlace(
+      const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+      const std::vector<VecType*>& elements);
+
+  /**
+   * In-place Inverse Transform of several elements of the same length, each
+   * with its own modulus, e.g. the towers of a DCRTPoly. The twiddle tables of
+   * all elements are looked up once, before a single parallel pass that splits
+   * the work into (element, block) units.
+   *
+   * @param &rootOfUnity holds the 2n-th root of unity of each element.
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param[in,out] &elements are the inputs/outputs of the transform, of
+   * length n.
+   * @see InverseTransformFromBitReverseInPlace()
+   */
+  static void InverseTransformFromBitReverseInPlace(
+      const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+      const std::vector<VecType*>& elements);
+
+  /**
+   * Resolves the tables of one modulus for the native lazy-reduction kernels,
+   * precomputing them if needed. The result can be cached by the caller, e.g.
+   * on the ring parameters, as long as IsCurrent() holds.
+   *
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q.
+   * @param CycloOrder is 2n, a power of two.
+   * @param &modulus is q.
+   * @return the tables, or nullptr if the native kernels cannot be used for
+   * this vector type or modulus.
+   */
+  static std::shared_ptr<const bigintnat::NativeNTTTables> GetNativeTables(
+      const IntType& rootOfUnity, const usint CycloOrder,
+      const IntType& modulus);
+
+  /**
+   * @param &tables are tables returned by GetNativeTables().
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q.
+   * @param CycloOrder is 2n.
+   * @param &modulus is q.
+   * @return true if the tables were resolved for these arguments and were not
+   * invalidated since by Reset() or a recomputation.
+   */
+  static bool IsCurrent(const bigintnat::NativeNTTTables& tables,
+                        const IntType& rootOfUnity, const usint CycloOrder,
+                        const IntType& modulus);
+
+  /**
+   * In-place Forward Transform of several elements of the same length with
+   * tables already resolved by GetNativeTables(); no table lookup is done.
+   *
+   * @param &tables holds the current tables of each element.
+   * @param[in,out] &elements are the inputs/outputs of the transform.
+   */
+  static void ForwardTransformToBitReverseInPlace(
+      const std::vector<const bigintnat::NativeNTTTables*>& tables,
+      const std::vector<VecType*>& elements);
+
+  /**
+   * In-place Inverse Transform of several elements of the same length with
+   * tables already resolved by GetNativeTables(); no table lookup is done.
+   *
+   * @param &tables holds the current tables of each element.
+   * @param[in,out] &elements are the inputs/outputs of the transform.
+   */
+  static void InverseTransformFromBitReverseInPlace(
+      const std::vector<const bigintnat::NativeNTTTables*>& tables,
+      const std::vector<VecType*>& elements);
+
   /**
    * Precomputation of root of unity tables for transforms in the ring
    * Z_q[X]/(X^n+1)
@@ -395,6 +481,10 @@ class ChineseRemainderTransformFTT {
   /// map to store Shoup's precomputations of inverse rou for iNTT, with bits reversed, with modulus as a key
   static std::map<IntType, NativeVector> m_rootOfUnityInversePreconReverseTableByModulus;
 
+  /// bumped whenever a table above may be freed or reallocated, which
+  /// invalidates the raw pointers handed out by GetNativeTables()
+  static std::atomic<uint64_t> m_tablesGeneration;
+
 #ifdef WITH_INTEL_HEXL
   // Key is <modulus, CycloOrderHalf>
   static std::unordered_map<std::pair<uint64_t, uint64_t>, intel::hexl::NTT,
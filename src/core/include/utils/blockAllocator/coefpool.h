@@ -0,0 +1,115 @@
+// @file coefpool.h This file contains the thread-caching size-class pool used
+// for the coefficient buffers of native vectors
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#ifndef SRC_CORE_INCLUDE_UTILS_BLOCKALLOCATOR_COEFPOOL_H_
+#define SRC_CORE_INCLUDE_UTILS_BLOCKALLOCATOR_COEFPOOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Pool for the coefficient buffers of native vectors.
+ *
+ * Requests whose size is a power of two between MIN_BLOCK_SIZE and
+ * MAX_BLOCK_SIZE bytes (ring dimension x 8 bytes for one tower) are served
+ * from per-thread free lists, one per size, without any lock; all other sizes
+ * go straight to operator new. Blocks may be released on any thread, and every
+ * block is an ordinary operator new allocation of exactly the requested size,
+ * so the pool can be enabled or disabled at any time. Disabled by default.
+ *
+ * The free blocks of all threads together are limited to GetMaxCachedBytes();
+ * blocks released beyond that go back to the heap. A thread that has never
+ * allocated from the pool does not get a free list when it releases a block,
+ * as Deallocate cannot allocate.
+ */
+class CoefficientPool {
+ public:
+  static const size_t MIN_BLOCK_SIZE = size_t(1) << 12;
+  static const size_t MAX_BLOCK_SIZE = size_t(1) << 21;
+  static const size_t NUM_SIZE_CLASSES = 10;
+  // free blocks each thread keeps per size before returning them to the heap
+  static const size_t MAX_CACHED_BLOCKS = 32;
+  // default limit of the bytes held in the free lists of all threads
+  static const size_t DEFAULT_MAX_CACHED_BYTES = size_t(64) << 20;
+
+  /**
+   * Usage counters of one size class, summed over all threads
+   */
+  struct Stats {
+    size_t blockSize;
+    uint64_t allocations;
+    uint64_t hits;
+    uint64_t deallocations;
+    uint64_t releases;
+
+    double HitRate() const {
+      return allocations == 0 ? 0.0 : double(hits) / double(allocations);
+    }
+  };
+
+  static void *Allocate(size_t bytes);
+
+  static void Deallocate(void *p, size_t bytes) noexcept;
+
+  static bool IsEnabled();
+
+  static void SetEnabled(bool enabled);
+
+  /**
+   * Returns the free blocks of the calling thread to the heap at once, and
+   * those of the other threads the next time they use the pool
+   */
+  static void Trim();
+
+  /**
+   * @return the bytes currently held in the free lists of all threads
+   */
+  static size_t GetCachedBytes();
+
+  static size_t GetMaxCachedBytes();
+
+  /**
+   * Sets the limit of the bytes held in the free lists of all threads; a
+   * lower limit only takes effect as blocks are reused, see Trim()
+   */
+  static void SetMaxCachedBytes(size_t bytes);
+
+  /**
+   * @return the counters of every size class that has been used
+   */
+  static std::vector<Stats> GetStats();
+
+  /**
+   * Prints the counters and the hit rate of every size class that has been
+   * used, in the spirit of xalloc_stats()
+   */
+  static void PrintStats(std::ostream &os = std::cout);
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_INCLUDE_UTILS_BLOCKALLOCATOR_COEFPOOL_H_
@@ -0,0 +1,72 @@
+// @file cpufeatures.h This file contains the runtime detection and selection
+// of the SIMD instruction sets used by the native math kernels
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_CORE_INCLUDE_UTILS_CPUFEATURES_H_
+#define SRC_CORE_INCLUDE_UTILS_CPUFEATURES_H_
+
+#include <string>
+
+// x86-64 kernels are compiled with per-function target attributes, so they do
+// not require -mavx2/-march=native and are selected at runtime
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(__EMSCRIPTEN__)
+#define PALISADE_X86_SIMD
+#define PALISADE_TARGET_AVX2 __attribute__((target("avx2")))
+#define PALISADE_TARGET_AVX512 __attribute__((target("avx512f,avx512dq")))
+#endif
+
+namespace lbcrypto {
+
+/**
+ * @brief Instruction sets available to the native vector kernels, in
+ * increasing order of width
+ */
+enum SIMDLevel { SIMD_SCALAR = 0, SIMD_AVX2 = 1, SIMD_AVX512 = 2 };
+
+class CPUFeatures {
+ public:
+  /**
+   * Widest instruction set supported by both this build and the processor
+   */
+  static SIMDLevel GetSupportedSIMDLevel();
+
+  /**
+   * Instruction set currently used by the native kernels; defaults to
+   * GetSupportedSIMDLevel()
+   */
+  static SIMDLevel GetSIMDLevel();
+
+  /**
+   * Restricts the native kernels to the given instruction set. Requests above
+   * GetSupportedSIMDLevel() are capped to it.
+   * @return the level actually selected
+   */
+  static SIMDLevel SetSIMDLevel(SIMDLevel level);
+
+  static std::string SIMDLevelToString(SIMDLevel level);
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_INCLUDE_UTILS_CPUFEATURES_H_
@@ -0,0 +1,142 @@
+// @file indexedfile.h This file contains a read-only, memory-mapped container
+// of binary records indexed by integer id
+// @author TPOC: contact@palisade-crypto.org
+//
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#ifndef SRC_CORE_INCLUDE_UTILS_INDEXEDFILE_H_
+#define SRC_CORE_INCLUDE_UTILS_INDEXEDFILE_H_
+
+#include <cstdint>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Writer of an indexed container of binary records
+ *
+ * The container starts with a fixed magic string, a free-form header string
+ * and an index of (id, offset, length) entries, followed by the records. The
+ * index is written when the file is closed, so records can be serialized and
+ * appended one at a time.
+ */
+class IndexedFileWriter {
+ public:
+  /**
+   * Creates the file
+   * @param filename path of the file
+   * @param header free-form header, e.g., the tag of the stored keys
+   * @param numRecords number of records that will be appended
+   */
+  IndexedFileWriter(const std::string& filename, const std::string& header,
+                    size_t numRecords);
+
+  ~IndexedFileWriter();
+
+  /**
+   * Appends a record
+   * @param id id of the record
+   * @param record contents of the record
+   */
+  void Append(uint64_t id, const std::string& record);
+
+  /**
+   * Writes the index and closes the file
+   */
+  void Close();
+
+ private:
+  std::ofstream m_file;
+  uint64_t m_indexOffset;
+  size_t m_numRecords;
+  std::vector<uint64_t> m_index;
+};
+
+/**
+ * @brief Read-only view of a container written by IndexedFileWriter
+ *
+ * Only the index is parsed when the file is opened. On POSIX systems the file
+ * is memory-mapped, so records are paged in from disk when they are first
+ * accessed; elsewhere the file is read into memory.
+ */
+class IndexedFileReader {
+ public:
+  /**
+   * Opens the file; throws if it is missing or malformed
+   * @param filename path of the file
+   */
+  explicit IndexedFileReader(const std::string& filename);
+
+  ~IndexedFileReader();
+
+  IndexedFileReader(const IndexedFileReader&) = delete;
+  IndexedFileReader& operator=(const IndexedFileReader&) = delete;
+
+  const std::string& GetHeader() const { return m_header; }
+
+  /**
+   * @return ids of all records, in file order
+   */
+  const std::vector<uint64_t>& GetIds() const { return m_ids; }
+
+  bool Contains(uint64_t id) const {
+    return m_records.find(id) != m_records.end();
+  }
+
+  /**
+   * Zero-copy access to a record; throws if there is no such record
+   * @param id id of the record
+   * @return pointer to the record and its length
+   */
+  std::pair<const char*, size_t> GetRecord(uint64_t id) const;
+
+ private:
+  // unmaps or frees the contents of the file
+  void Release();
+
+  const char* m_data;
+  size_t m_size;
+  bool m_mapped;
+  std::string m_header;
+  std::vector<uint64_t> m_ids;
+  std::unordered_map<uint64_t, std::pair<uint64_t, uint64_t>> m_records;
+};
+
+/**
+ * @brief Input stream buffer over a read-only memory range, used to
+ * deserialize records in place
+ */
+class MemoryStreamBuf : public std::streambuf {
+ public:
+  MemoryStreamBuf(const char* data, size_t size) {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_INCLUDE_UTILS_INDEXEDFILE_H_
@@ -0,0 +1,158 @@
+// @file limbbuffer.h This file contains the aligned single-buffer storage used
+// for the towers of a DCRTPoly
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#ifndef SRC_CORE_INCLUDE_UTILS_LIMBBUFFER_H_
+#define SRC_CORE_INCLUDE_UTILS_LIMBBUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "utils/blockAllocator/coefpool.h"
+
+namespace lbcrypto {
+
+/**
+ * @brief One 64-byte aligned block of memory that holds the coefficients of
+ * all towers of a DCRTPoly, tower after tower (limb-major).
+ *
+ * Slices are handed out in order by LimbAllocator and are never returned
+ * individually; the block is freed when the last vector using it goes away.
+ * Dropping a tower therefore costs nothing, and the remaining towers stay
+ * where they are.
+ */
+class LimbBuffer {
+ public:
+  static const size_t ALIGNMENT = 64;
+
+  /**
+   * @param capacity is the size of the block in bytes.
+   */
+  explicit LimbBuffer(size_t capacity);
+
+  ~LimbBuffer();
+
+  LimbBuffer(const LimbBuffer &) = delete;
+  LimbBuffer &operator=(const LimbBuffer &) = delete;
+
+  /**
+   * Size of one slice of the given size, padded so the next slice is aligned
+   */
+  static size_t Stride(size_t bytes) {
+    return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+
+  /**
+   * Hands out the next aligned slice; safe to call concurrently.
+   * @return the slice, or nullptr if the block is exhausted
+   */
+  void *Allocate(size_t bytes);
+
+  /**
+   * @return true if p points into this block
+   */
+  bool Owns(const void *p) const {
+    const char *c = static_cast<const char *>(p);
+    return c >= m_begin && c < m_begin + m_capacity;
+  }
+
+  /**
+   * Whether DCRTPoly places the towers of new elements in a LimbBuffer;
+   * disabled by default
+   */
+  static bool IsEnabled();
+
+  static void SetEnabled(bool enabled);
+
+ private:
+  void *m_raw;
+  char *m_begin;
+  size_t m_capacity;
+  std::atomic<size_t> m_used;
+};
+
+/**
+ * @brief Standard allocator that carves vectors out of a shared LimbBuffer and
+ * falls back to the CoefficientPool when it has none or the buffer is
+ * exhausted.
+ *
+ * A copy of a vector never shares the buffer of the original, while moves and
+ * swaps carry the buffer along, so a LimbBuffer stays alive as long as any of
+ * the vectors placed in it.
+ */
+template <class T>
+class LimbAllocator {
+ public:
+  typedef T value_type;
+  typedef std::false_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  LimbAllocator() noexcept {}
+
+  explicit LimbAllocator(std::shared_ptr<LimbBuffer> buffer) noexcept
+      : m_buffer(std::move(buffer)) {}
+
+  template <class U>
+  LimbAllocator(const LimbAllocator<U> &other) noexcept
+      : m_buffer(other.GetBuffer()) {}
+
+  T *allocate(size_t n) {
+    if (m_buffer != nullptr) {
+      void *p = m_buffer->Allocate(n * sizeof(T));
+      if (p != nullptr) return static_cast<T *>(p);
+    }
+    if (n > size_t(-1) / sizeof(T)) throw std::bad_alloc();
+    return static_cast<T *>(CoefficientPool::Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_t n) noexcept {
+    if (m_buffer != nullptr && m_buffer->Owns(p)) return;
+    CoefficientPool::Deallocate(p, n * sizeof(T));
+  }
+
+  LimbAllocator select_on_container_copy_construction() const {
+    return LimbAllocator();
+  }
+
+  const std::shared_ptr<LimbBuffer> &GetBuffer() const { return m_buffer; }
+
+ private:
+  std::shared_ptr<LimbBuffer> m_buffer;
+};
+
+template <class T, class U>
+bool operator==(const LimbAllocator<T> &a, const LimbAllocator<U> &b) {
+  return a.GetBuffer() == b.GetBuffer();
+}
+
+template <class T, class U>
+bool operator!=(const LimbAllocator<T> &a, const LimbAllocator<U> &b) {
+  return !(a == b);
+}
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_INCLUDE_UTILS_LIMBBUFFER_H_
@@ -0,0 +1,117 @@
+// @file lrucache.h This file contains a thread-safe least-recently-used cache
+// @author TPOC: contact@palisade-crypto.org
+//
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#ifndef SRC_CORE_INCLUDE_UTILS_LRUCACHE_H_
+#define SRC_CORE_INCLUDE_UTILS_LRUCACHE_H_
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace lbcrypto {
+
+/**
+ * @brief Thread-safe cache that keeps at most a given number of entries and
+ * evicts the least recently used one first
+ *
+ * @tparam Key key type; must be hashable
+ * @tparam Value value type; should be cheap to copy, e.g., a shared_ptr
+ */
+template <typename Key, typename Value>
+class LRUCache {
+ public:
+  /**
+   * @param capacity maximum number of entries; 0 means unbounded
+   */
+  explicit LRUCache(size_t capacity = 0) : m_capacity(capacity) {}
+
+  /**
+   * Looks up an entry and marks it as the most recently used
+   * @param key key of the entry
+   * @param value receives the value of the entry if found
+   * @return true if the entry was found
+   */
+  bool Get(const Key& key, Value* value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) return false;
+    m_order.splice(m_order.begin(), m_order, it->second.second);
+    *value = it->second.first;
+    return true;
+  }
+
+  /**
+   * Adds or replaces an entry, evicting the least recently used entries if
+   * the cache is full
+   * @param key key of the entry
+   * @param value value of the entry
+   */
+  void Put(const Key& key, const Value& value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+      it->second.first = value;
+      m_order.splice(m_order.begin(), m_order, it->second.second);
+      return;
+    }
+    m_order.push_front(key);
+    m_entries.emplace(key, std::make_pair(value, m_order.begin()));
+    while (m_capacity > 0 && m_entries.size() > m_capacity) {
+      m_entries.erase(m_order.back());
+      m_order.pop_back();
+    }
+  }
+
+  /**
+   * Removes all entries
+   */
+  void Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_order.clear();
+  }
+
+  /**
+   * @return number of entries currently in the cache
+   */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+  }
+
+  size_t GetCapacity() const { return m_capacity; }
+
+ private:
+  size_t m_capacity;
+  mutable std::mutex m_mutex;
+  // keys from the most to the least recently used
+  std::list<Key> m_order;
+  std::unordered_map<Key,
+                     std::pair<Value, typename std::list<Key>::iterator>>
+      m_entries;
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_INCLUDE_UTILS_LRUCACHE_H_
@@ -0,0 +1,259 @@
+// @file scheduler.h This file contains the executors the parallel loops of
+// the lattice layer and the schemes run on
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_CORE_INCLUDE_UTILS_SCHEDULER_H_
+#define SRC_CORE_INCLUDE_UTILS_SCHEDULER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lbcrypto {
+
+/**
+ * @brief Interface of the executors that the parallel loops of the library
+ * (DCRTPoly tower and coefficient loops, batched NTTs, Matrix, key
+ * generation, ...) run on.
+ *
+ * A few OpenMP loops do not go through an executor: MatrixStrassen, the
+ * lattice trapdoor samplers and binfhe. They use the OpenMP settings of the
+ * thread that starts them.
+ */
+class ParallelExecutor {
+ public:
+  virtual ~ParallelExecutor() {}
+
+  /**
+   * Calls body(i) for every i in [begin, end), possibly in parallel, and
+   * returns once all calls have completed. The first exception thrown by body
+   * is rethrown to the caller. body may itself call ParallelFor.
+   */
+  virtual void ParallelFor(size_t begin, size_t end,
+                           const std::function<void(size_t)> &body) = 0;
+
+  /**
+   * Number of threads loops are spread over
+   */
+  virtual size_t GetConcurrency() const = 0;
+
+  /**
+   * Number of threads the OpenMP loops that do not go through an executor may
+   * start from a thread inside a ParallelScope of this executor. Executors
+   * with threads of their own keep those loops on the calling thread.
+   */
+  virtual size_t GetOpenMPConcurrency() const { return 1; }
+};
+
+/**
+ * @brief Default executor: an OpenMP parallel for, controlled by
+ * ParallelControls. Loops nested in a parallel region run serially.
+ */
+class OpenMPExecutor : public ParallelExecutor {
+ public:
+  /**
+   * @param numThreads the number of threads of each loop; 0 uses the number
+   * set through ParallelControls.
+   */
+  explicit OpenMPExecutor(size_t numThreads = 0) : m_numThreads(numThreads) {}
+
+  void ParallelFor(size_t begin, size_t end,
+                   const std::function<void(size_t)> &body) override;
+
+  size_t GetConcurrency() const override;
+
+  size_t GetOpenMPConcurrency() const override { return GetConcurrency(); }
+
+ private:
+  size_t m_numThreads;
+};
+
+/**
+ * @brief Executor with its own pool of threads and one task deque per thread.
+ * Loop iterations are split into tasks that idle threads steal. A worker
+ * waiting for a nested loop to finish runs queued tasks, and only blocks once
+ * none are left. An application thread that starts a loop hands all of its
+ * iterations to the pool and blocks until they are done, so loops only ever
+ * compute on the worker threads and within their CPU set, however many
+ * application threads submit loops concurrently.
+ */
+class WorkStealingExecutor : public ParallelExecutor {
+ public:
+  /**
+   * @param numThreads the number of worker threads; 0 uses the number of
+   * hardware threads.
+   * @param cpus the CPUs the worker threads are restricted to; empty for no
+   * restriction. Only supported on Linux, ignored elsewhere.
+   */
+  explicit WorkStealingExecutor(size_t numThreads = 0,
+                                const std::vector<int> &cpus = {});
+
+  ~WorkStealingExecutor();
+
+  void ParallelFor(size_t begin, size_t end,
+                   const std::function<void(size_t)> &body) override;
+
+  size_t GetConcurrency() const override { return m_workers.size(); }
+
+ private:
+  struct Group;
+  struct Task {
+    Group *group;
+    size_t begin;
+    size_t end;
+  };
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void WorkerLoop(size_t index);
+  void Shutdown();
+  void Push(const Task &task);
+  bool Pop(size_t self, Task *task);
+  void Run(const Task &task);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  // tasks submitted from threads that do not belong to the pool
+  std::mutex m_injectMutex;
+  std::deque<Task> m_inject;
+
+  std::atomic<size_t> m_numQueued;
+  std::mutex m_sleepMutex;
+  std::condition_variable m_wake;
+  bool m_stop;
+};
+
+/**
+ * @brief Holds the executor used by the library's parallel loops.
+ */
+class ParallelScheduler {
+ public:
+  /**
+   * The current executor; an OpenMPExecutor unless SetExecutor was called
+   */
+  static std::shared_ptr<ParallelExecutor> GetExecutor();
+
+  /**
+   * Installs executor for all subsequent parallel loops; nullptr restores
+   * the OpenMP executor. Loops already running finish on their executor. The
+   * OpenMP loops that do not go through an executor still start a full
+   * OpenMP team; ParallelControls or a ParallelScope limits them.
+   */
+  static void SetExecutor(std::shared_ptr<ParallelExecutor> executor);
+
+  /**
+   * The executor of the innermost ParallelScope of the calling thread, or of
+   * the loop the calling thread is working on; nullptr if there is none
+   */
+  static ParallelExecutor *GetScopedExecutor();
+
+ private:
+  friend class ParallelScope;
+
+  static void SetScopedExecutor(ParallelExecutor *executor);
+};
+
+/**
+ * @brief Runs the parallel loops started by the current thread, until the
+ * scope ends, on a given executor instead of the global one. This is how a
+ * job gets a thread budget and CPU set without affecting other jobs:
+ *
+ *   auto budget = std::make_shared<WorkStealingExecutor>(4, cpus);
+ *   {
+ *     ParallelScope scope(budget);
+ *     auto ct = cc->EvalMult(ct1, ct2);
+ *   }
+ *
+ * Loops nested in the scoped loops stay on the scoped executor, and the OpenMP
+ * loops that do not go through an executor use at most GetOpenMPConcurrency()
+ * threads, i.e. only the current thread for a WorkStealingExecutor. Code
+ * outside parallel loops still runs on the current thread. Scopes nest; a
+ * null executor leaves the current one in place.
+ */
+class ParallelScope {
+ public:
+  explicit ParallelScope(std::shared_ptr<ParallelExecutor> executor);
+  ~ParallelScope();
+
+  ParallelScope(const ParallelScope &) = delete;
+  ParallelScope &operator=(const ParallelScope &) = delete;
+
+ private:
+  std::shared_ptr<ParallelExecutor> m_executor;
+  ParallelExecutor *m_previous;
+  int m_previousThreads;
+};
+
+/**
+ * Calls body(i) for every i in [begin, end) on the scoped executor of the
+ * calling thread, or on the library executor if there is none
+ */
+inline void ParallelFor(size_t begin, size_t end,
+                        const std::function<void(size_t)> &body) {
+  if (end <= begin) return;
+  ParallelExecutor *scoped = ParallelScheduler::GetScopedExecutor();
+  if (scoped != nullptr) {
+    scoped->ParallelFor(begin, end, body);
+    return;
+  }
+  ParallelScheduler::GetExecutor()->ParallelFor(begin, end, body);
+}
+
+/**
+ * Number of threads the parallel loops started by the calling thread are
+ * spread over
+ */
+inline size_t GetParallelConcurrency() {
+  ParallelExecutor *scoped = ParallelScheduler::GetScopedExecutor();
+  if (scoped != nullptr) return scoped->GetConcurrency();
+  return ParallelScheduler::GetExecutor()->GetConcurrency();
+}
+
+/**
+ * Calls body(b, e) for consecutive subranges [b, e) of [begin, end), of grain
+ * iterations each except possibly the last one, through ParallelFor. For
+ * loops whose iterations are too cheap to be dispatched one by one, such as
+ * loops over the coefficients of a polynomial.
+ */
+inline void ParallelForRange(size_t begin, size_t end, size_t grain,
+                             const std::function<void(size_t, size_t)> &body) {
+  if (end <= begin) return;
+  if (grain == 0) grain = 1;
+  size_t numBlocks = (end - begin + grain - 1) / grain;
+  ParallelFor(0, numBlocks, [&](size_t k) {
+    size_t b = begin + k * grain;
+    body(b, std::min(end, b + grain));
+  });
+}
+
+}  // namespace lbcrypto
+
+#endif  // SRC_CORE_INCLUDE_UTILS_SCHEDULER_H_
@@ -117,7 +117,12 @@ bool CKKSPackedEncoding::Encode() {
   uint32_t ringDim = GetElementRingDimension();
   uint32_t Nh = (ringDim >> 1);
 
-  std::vector<std::complex<double>> inverse = this->GetCKKSPackedValue();
+  // per-thread scratch buffers, reused across calls so that encoding many
+  // vectors (see CryptoContextImpl::MakeCKKSPackedPlaintexts) does not
+  // allocate them for every input
+  static thread_local std::vector<std::complex<double>> inverse;
+  const std::vector<std::complex<double>> &input = this->GetCKKSPackedValue();
+  inverse.assign(input.begin(), input.end());
   if (Nh < inverse.size()) {
       std::string errMsg =
           std::string("RingDimention/2 [") + std::to_string(Nh) +
@@ -131,7 +136,7 @@ bool CKKSPackedEncoding::Encode() {
   inverse.resize(Nh);
 
   if (this->typeFlag == IsDCRTPoly) {
-    DiscreteFourierTransform::FFTSpecialInv(inverse);
+    DiscreteFourierTransform::GetPlan(ringDim << 1, Nh)->FFTSpecialInv(inverse);
     uint64_t pBits = encodingParams->GetPlaintextModulus();
     uint32_t precision = 52;
 
@@ -143,7 +148,8 @@ bool CKKSPackedEncoding::Encode() {
     // into (input_mantissa * 2^52) * 2^(p - 52 + input_exponent)
     // to preserve 52-bit precision of doubles
     // when converting to 128-bit numbers
-    std::vector<__int128> temp(2 * Nh);
+    static thread_local std::vector<__int128> temp;
+    temp.resize(2 * Nh);
     for (size_t i = 0; i < Nh; ++i) {
       // Check for possible overflow in llround function
       int32_t n1 = 0;
@@ -194,10 +200,9 @@ bool CKKSPackedEncoding::Encode() {
     for (size_t i = 0; i < nativeParams.size(); i++) {
       NativeVector nativeVec(ringDim, nativeParams[i]->GetModulus());
       FitToNativeVector(temp, Max128BitValue(), &nativeVec);
-      NativePoly element = this->GetElement<DCRTPoly>().GetElementAtIndex(i);
-      element.SetValues(
-          nativeVec, Format::COEFFICIENT);  // output was in coefficient format
-      this->encodedVectorDCRT.SetElementAtIndex(i, element);
+      // output was in coefficient format
+      this->encodedVectorDCRT.ElementAtIndex(i).SetValues(
+          std::move(nativeVec), Format::COEFFICIENT);
     }
 
     usint numTowers = nativeParams.size();
@@ -239,7 +244,12 @@ bool CKKSPackedEncoding::Encode() {
   uint32_t ringDim = GetElementRingDimension();
   uint32_t Nh = (ringDim >> 1);
 
-  std::vector<std::complex<double>> inverse = this->GetCKKSPackedValue();
+  // per-thread scratch buffers, reused across calls so that encoding many
+  // vectors (see CryptoContextImpl::MakeCKKSPackedPlaintexts) does not
+  // allocate them for every input
+  static thread_local std::vector<std::complex<double>> inverse;
+  const std::vector<std::complex<double>> &input = this->GetCKKSPackedValue();
+  inverse.assign(input.begin(), input.end());
   if (Nh < inverse.size()) {
       std::string errMsg =
           std::string("RingDimention/2 [") + std::to_string(Nh) +
@@ -252,10 +262,12 @@ bool CKKSPackedEncoding::Encode() {
 
   inverse.resize(Nh);
   if (this->typeFlag == IsDCRTPoly) {
-    DiscreteFourierTransform::FFTSpecialInv(inverse);
+    auto fftPlan = DiscreteFourierTransform::GetPlan(ringDim << 1, Nh);
+    fftPlan->FFTSpecialInv(inverse);
     double powP = scalingFactor;
 
-    std::vector<int64_t> temp(2 * Nh);
+    static thread_local std::vector<int64_t> temp;
+    temp.resize(2 * Nh);
     for (size_t i = 0; i < Nh; ++i) {
       // Check for possible overflow in llround function
       double dre = inverse[i].real() * powP;
@@ -273,7 +285,7 @@ bool CKKSPackedEncoding::Encode() {
         // this to report it to the user, so they can identify
         // large inputs.
 
-        DiscreteFourierTransform::FFTSpecial(inverse);
+        fftPlan->FFTSpecial(inverse);
 
         double invLen = static_cast<double>(inverse.size());
         double factor = 2 * M_PI * i;
@@ -337,10 +349,9 @@ bool CKKSPackedEncoding::Encode() {
     for (size_t i = 0; i < nativeParams.size(); i++) {
       NativeVector nativeVec(ringDim, nativeParams[i]->GetModulus());
       FitToNativeVector(temp, Max64BitValue(), &nativeVec);
-      NativePoly element = this->GetElement<DCRTPoly>().GetElementAtIndex(i);
-      element.SetValues(
-          nativeVec, Format::COEFFICIENT);  // output was in coefficient format
-      this->encodedVectorDCRT.SetElementAtIndex(i, element);
+      // output was in coefficient format
+      this->encodedVectorDCRT.ElementAtIndex(i).SetValues(
+          std::move(nativeVec), Format::COEFFICIENT);
     }
 
     usint numTowers = nativeParams.size();
@@ -420,27 +431,52 @@ bool CKKSPackedEncoding::Decode(size_t depth, double scalingFactor,
     else
       scalingFactorPre = pow(2, -p * (depth - 1));
 
-    const BigInteger &q = GetElementModulus();
-    BigInteger qHalf = q >> 1;
-
-    for (size_t i = 0, idx = 0; i < Nh; ++i, idx++) {
-      std::complex<double> cur;
+    if (this->typeFlag == IsDCRTPoly && encodedVector.IsEmpty()) {
+      // the plaintext was decrypted to RNS form: reconstruct the centered
+      // coefficients in native arithmetic from the leading towers whose
+      // product covers the scale of the message (CKKS keeps the headroom for
+      // the values in the first modulus); the remaining towers only serve to
+      // check the result
+      const DCRTPoly &element = GetElement<DCRTPoly>();
+      double scaleBits = p - std::log2(scalingFactorPre);
+      double bits = 0.0;
+      usint numTowers = 0;
+      while (numTowers < element.GetNumOfElements() && bits <= scaleBits + 1) {
+        const NativeInteger &qi =
+            element.GetElementAtIndex(numTowers).GetModulus();
+        bits += std::log2(qi.ConvertToDouble());
+        numTowers++;
+      }
 
-      if (GetElement<Poly>()[idx] > qHalf)
-        cur.real(-((q - GetElement<Poly>()[idx])).ConvertToDouble() *
-                 scalingFactorPre);
-      else
-        cur.real((GetElement<Poly>()[idx]).ConvertToDouble() *
-                 scalingFactorPre);
+      std::vector<double> coeffs =
+          element.CRTInterpolateToDouble(scalingFactorPre, numTowers);
 
-      if (GetElement<Poly>()[idx + Nh] > qHalf)
-        cur.imag(-((q - GetElement<Poly>()[idx + Nh])).ConvertToDouble() *
-                 scalingFactorPre);
-      else
-        cur.imag((GetElement<Poly>()[idx + Nh]).ConvertToDouble() *
-                 scalingFactorPre);
-
-      curValues[i] = cur;
+      for (size_t i = 0; i < Nh; ++i) {
+        curValues[i] = std::complex<double>(coeffs[i], coeffs[i + Nh]);
+      }
+    } else {
+      const BigInteger &q = GetElementModulus();
+      BigInteger qHalf = q >> 1;
+
+      for (size_t i = 0, idx = 0; i < Nh; ++i, idx++) {
+        std::complex<double> cur;
+
+        if (GetElement<Poly>()[idx] > qHalf)
+          cur.real(-((q - GetElement<Poly>()[idx])).ConvertToDouble() *
+                   scalingFactorPre);
+        else
+          cur.real((GetElement<Poly>()[idx]).ConvertToDouble() *
+                   scalingFactorPre);
+
+        if (GetElement<Poly>()[idx + Nh] > qHalf)
+          cur.imag(-((q - GetElement<Poly>()[idx + Nh])).ConvertToDouble() *
+                   scalingFactorPre);
+        else
+          cur.imag((GetElement<Poly>()[idx + Nh]).ConvertToDouble() *
+                   scalingFactorPre);
+
+        curValues[i] = cur;
+      }
     }
   }
 
@@ -520,7 +556,7 @@ bool CKKSPackedEncoding::Decode(size_t depth, double scalingFactor,
   // Z[X + 1/X]/(X^n + 1). This would change the complexity from n*logn to
   // roughly (n/2)*log(n/2). This change should be done together with the one
   // above.
-  DiscreteFourierTransform::FFTSpecial(realValues);
+  DiscreteFourierTransform::GetPlan(Nh << 2, Nh)->FFTSpecial(realValues);
 
   // clears all imaginary values for security reasons
   for (size_t i = 0; i < realValues.size(); ++i) realValues[i].imag(0.0);
@@ -24,15 +24,118 @@
 
 #include "encoding/packedencoding.h"
 
-namespace lbcrypto {
+#include <mutex>
 
-std::map<ModulusM, NativeInteger> PackedEncoding::m_initRoot;
-std::map<ModulusM, NativeInteger> PackedEncoding::m_bigModulus;
-std::map<ModulusM, NativeInteger> PackedEncoding::m_bigRoot;
+namespace lbcrypto {
 
+std::map<ModulusM, std::shared_ptr<const PackedEncodingTables>>
+    PackedEncoding::m_tables;
 std::map<usint, usint> PackedEncoding::m_automorphismGenerator;
-std::map<usint, std::vector<usint>> PackedEncoding::m_toCRTPerm;
-std::map<usint, std::vector<usint>> PackedEncoding::m_fromCRTPerm;
+
+// guards m_tables and m_automorphismGenerator; Pack/Unpack only take it when
+// the EncodingParams of the plaintext do not carry matching tables yet
+static std::mutex s_tablesMutex;
+
+PackedEncodingTables::PackedEncodingTables(usint m, EncodingParams params)
+    : m_m(m), m_modulus(params->GetPlaintextModulus()),
+      m_automorphismGenerator(0) {
+  if (IsPowerOfTwo(m)) {
+    if (!MillerRabinPrimalityTest(m_modulus)) {
+      std::string errMsg =
+          "The given modulus: " + m_modulus.ToString() +
+          ", must be prime. The given value does not satisfy this condition.";
+      PALISADE_THROW(math_error, errMsg);
+    }
+
+    // Power of two: m/2-point FTT. So we need the mth root of unity
+    if (params->GetPlaintextRootOfUnity() == 0) {
+      m_initRoot = RootOfUnity<NativeInteger>(m, m_modulus);
+      params->SetPlaintextRootOfUnity(m_initRoot);
+    } else {
+      m_initRoot = params->GetPlaintextRootOfUnity();
+    }
+
+    // Create the permutations that interchange the automorphism and crt
+    // ordering. First we create the cyclic group generated by 5 and then
+    // adjoin the co-factor by multiplying by (-1)
+    usint phim = (m >> 1);
+    usint phim_by_2 = (m >> 2);
+
+    m_toCRTPerm = std::vector<usint>(phim);
+    m_fromCRTPerm = std::vector<usint>(phim);
+
+    usint curr_index = 1;
+    usint logn = std::round(log2(m >> 1));
+    for (usint i = 0; i < phim_by_2; i++) {
+      m_toCRTPerm[ReverseBits((curr_index - 1) / 2, logn)] = i;
+      m_fromCRTPerm[i] = ReverseBits((curr_index - 1) / 2, logn);
+
+      usint cofactor_index = curr_index * (m - 1) % m;
+
+      m_toCRTPerm[ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
+      m_fromCRTPerm[i + phim_by_2] =
+          ReverseBits((cofactor_index - 1) / 2, logn);
+
+      curr_index = curr_index * 5 % m;
+    }
+    return;
+  }
+
+  // Arbitrary: Bluestein based CRT Arb. So we need the 2mth root of unity
+  if (params->GetPlaintextRootOfUnity() == 0) {
+    m_initRoot = RootOfUnity<NativeInteger>(2 * m, m_modulus);
+    params->SetPlaintextRootOfUnity(m_initRoot);
+  } else {
+    m_initRoot = params->GetPlaintextRootOfUnity();
+  }
+
+  // Find a compatible big-modulus and root of unity for CRTArb
+  if (params->GetPlaintextBigModulus() == 0) {
+    usint nttDim = pow(2, ceil(log2(2 * m - 1)));
+    if ((m_modulus.ConvertToInt() - 1) % nttDim == 0) {
+      m_bigModulus = m_modulus;
+    } else {
+      usint bigModulusSize = ceil(log2(2 * m - 1)) + 2 * m_modulus.GetMSB() + 1;
+      m_bigModulus = FirstPrime<NativeInteger>(bigModulusSize, nttDim);
+    }
+    m_bigRoot = RootOfUnity<NativeInteger>(nttDim, m_bigModulus);
+    params->SetPlaintextBigModulus(m_bigModulus);
+    params->SetPlaintextBigRootOfUnity(m_bigRoot);
+  } else {
+    m_bigModulus = params->GetPlaintextBigModulus();
+    m_bigRoot = params->GetPlaintextBigRootOfUnity();
+  }
+
+  // Find a generator for the automorphism group
+  if (params->GetPlaintextGenerator() == 0) {
+    NativeInteger M(m);  // Hackish typecast
+    m_automorphismGenerator =
+        FindGeneratorCyclic<NativeInteger>(M).ConvertToInt();
+    params->SetPlaintextGenerator(m_automorphismGenerator);
+  } else {
+    m_automorphismGenerator = params->GetPlaintextGenerator();
+  }
+
+  // Create the permutations that interchange the automorphism and crt
+  // ordering
+  usint phim = GetTotient(m);
+  auto tList = GetTotientList(m);
+  auto tIdx = std::vector<usint>(m, -1);
+  for (usint i = 0; i < phim; i++) {
+    tIdx[tList[i]] = i;
+  }
+
+  m_toCRTPerm = std::vector<usint>(phim);
+  m_fromCRTPerm = std::vector<usint>(phim);
+
+  usint curr_index = 1;
+  for (usint i = 0; i < phim; i++) {
+    m_toCRTPerm[tIdx[curr_index]] = i;
+    m_fromCRTPerm[i] = tIdx[curr_index];
+
+    curr_index = curr_index * m_automorphismGenerator % m;
+  }
+}
 
 bool PackedEncoding::Encode() {
   if (this->isEncoded) return true;
@@ -215,90 +318,26 @@ bool PackedEncoding::Decode() {
 }
 
 void PackedEncoding::Destroy() {
-  m_initRoot.clear();
-  m_bigModulus.clear();
-  m_bigRoot.clear();
-
+  std::lock_guard<std::mutex> lock(s_tablesMutex);
+  m_tables.clear();
   m_automorphismGenerator.clear();
-  m_toCRTPerm.clear();
-  m_fromCRTPerm.clear();
 }
 
 void PackedEncoding::SetParams(usint m, EncodingParams params) {
-  NativeInteger modulusNI(params->GetPlaintextModulus());  // native int modulus
   std::string exception_message;
   bool hadEx = false;
 
   // initialize the CRT coefficients if not initialized
   try {
-    if (IsPowerOfTwo(m)) {
-#pragma omp critical
-      { SetParams_2n(m, params); }
-    } else {
-#pragma omp critical
-      {
-        const ModulusM modulusM = {modulusNI, m};
-        // Arbitrary: Bluestein based CRT Arb. So we need the 2mth root of unity
-        if (params->GetPlaintextRootOfUnity() == 0) {
-          NativeInteger initRoot = RootOfUnity<NativeInteger>(2 * m, modulusNI);
-          m_initRoot[modulusM] = initRoot;
-          params->SetPlaintextRootOfUnity(m_initRoot[modulusM].ConvertToInt());
-        } else {
-          m_initRoot[modulusM] = params->GetPlaintextRootOfUnity();
-        }
-
-        // Find a compatible big-modulus and root of unity for CRTArb
-        if (params->GetPlaintextBigModulus() == 0) {
-          usint nttDim = pow(2, ceil(log2(2 * m - 1)));
-          if ((modulusNI.ConvertToInt() - 1) % nttDim == 0) {
-            m_bigModulus[modulusM] = modulusNI;
-          } else {
-            usint bigModulusSize =
-                ceil(log2(2 * m - 1)) + 2 * modulusNI.GetMSB() + 1;
-            m_bigModulus[modulusM] =
-                FirstPrime<NativeInteger>(bigModulusSize, nttDim);
-          }
-          m_bigRoot[modulusM] =
-              RootOfUnity<NativeInteger>(nttDim, m_bigModulus[modulusM]);
-          params->SetPlaintextBigModulus(m_bigModulus[modulusM]);
-          params->SetPlaintextBigRootOfUnity(m_bigRoot[modulusM]);
-        } else {
-          m_bigModulus[modulusM] = params->GetPlaintextBigModulus();
-          m_bigRoot[modulusM] = params->GetPlaintextBigRootOfUnity();
-        }
-
-        // Find a generator for the automorphism group
-        if (params->GetPlaintextGenerator() == 0) {
-          NativeInteger M(m);  // Hackish typecast
-          NativeInteger automorphismGenerator =
-              FindGeneratorCyclic<NativeInteger>(M);
-          m_automorphismGenerator[m] = automorphismGenerator.ConvertToInt();
-          params->SetPlaintextGenerator(m_automorphismGenerator[m]);
-        } else {
-          m_automorphismGenerator[m] = params->GetPlaintextGenerator();
-        }
-
-        // Create the permutations that interchange the automorphism and crt
-        // ordering
-        usint phim = GetTotient(m);
-        auto tList = GetTotientList(m);
-        auto tIdx = std::vector<usint>(m, -1);
-        for (usint i = 0; i < phim; i++) {
-          tIdx[tList[i]] = i;
-        }
-
-        m_toCRTPerm[m] = std::vector<usint>(phim);
-        m_fromCRTPerm[m] = std::vector<usint>(phim);
-
-        usint curr_index = 1;
-        for (usint i = 0; i < phim; i++) {
-          m_toCRTPerm[m][tIdx[curr_index]] = i;
-          m_fromCRTPerm[m][i] = tIdx[curr_index];
-
-          curr_index = curr_index * m_automorphismGenerator[m] % m;
-        }
-      }
+    auto tables = std::make_shared<const PackedEncodingTables>(m, params);
+    const ModulusM modulusM = {tables->GetModulus(), m};
+    {
+      std::lock_guard<std::mutex> lock(s_tablesMutex);
+      m_tables[modulusM] = tables;
+      if (!IsPowerOfTwo(m))
+        m_automorphismGenerator[m] = tables->GetAutomorphismGenerator();
     }
+    params->SetPackedEncodingTables(std::move(tables));
   } catch (std::exception &e) {
     exception_message = e.what();
     hadEx = true;
@@ -307,6 +346,39 @@ void PackedEncoding::SetParams(usint m, EncodingParams params) {
   if (hadEx) PALISADE_THROW(palisade_error, exception_message);
 }
 
+usint PackedEncoding::GetAutomorphismGenerator(usint m) {
+  std::lock_guard<std::mutex> lock(s_tablesMutex);
+  auto it = m_automorphismGenerator.find(m);
+  return it == m_automorphismGenerator.end() ? 0 : it->second;
+}
+
+std::shared_ptr<const PackedEncodingTables> PackedEncoding::GetTables(
+    usint m, const NativeInteger &modulusNI) const {
+  // fast path: the tables are already attached to the encoding parameters
+  auto tables = this->encodingParams->GetPackedEncodingTables();
+  if (tables && tables->GetCyclotomicOrder() == m &&
+      tables->GetModulus() == modulusNI)
+    return tables;
+
+  const ModulusM modulusM = {modulusNI, m};
+  {
+    std::lock_guard<std::mutex> lock(s_tablesMutex);
+    auto it = m_tables.find(modulusM);
+    if (it != m_tables.end()) tables = it->second;
+  }
+
+  // Do the precomputation if not initialized
+  if (!tables) {
+    SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(
+                     modulusNI.ConvertToInt())));
+    std::lock_guard<std::mutex> lock(s_tablesMutex);
+    tables = m_tables[modulusM];
+  }
+
+  this->encodingParams->SetPackedEncodingTables(tables);
+  return tables;
+}
+
 template <typename P>
 void PackedEncoding::Pack(P *ring, const PlaintextModulus &modulus) const {
   DEBUG_FLAG(false);
@@ -314,12 +386,11 @@ void PackedEncoding::Pack(P *ring, const PlaintextModulus &modulus) const {
   usint m = ring->GetCyclotomicOrder();  // cyclotomic order
   NativeInteger modulusNI(modulus);      // native int modulus
 
-  const ModulusM modulusM = {modulusNI, m};
-
-  // Do the precomputation if not initialized
-  if (this->m_initRoot[modulusM].GetMSB() == 0) {
-    SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-  }
+  auto tables = GetTables(m, modulusNI);
+  const std::vector<usint> &toCRTPerm = tables->GetToCRTPerm();
+  const NativeInteger &initRoot = tables->GetInitRoot();
+  const NativeInteger &bigModulus = tables->GetBigModulus();
+  const NativeInteger &bigRoot = tables->GetBigRoot();
 
   usint phim = ring->GetRingDimension();
 
@@ -336,38 +407,35 @@ void PackedEncoding::Pack(P *ring, const PlaintextModulus &modulus) const {
 
   // Transform Eval to Coeff
   if (IsPowerOfTwo(m)) {
-    if (m_toCRTPerm[m].size() > 0) {
+    if (toCRTPerm.size() > 0) {
       // Permute to CRT Order
       NativeVector permutedSlots(phim, modulusNI);
 
       for (usint i = 0; i < phim; i++) {
-        permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+        permutedSlots[i] = slotValues[toCRTPerm[i]];
       }
       ChineseRemainderTransformFTT<
-          NativeVector>::InverseTransformFromBitReverse(permutedSlots,
-                                                        m_initRoot[modulusM], m,
-                                                        &slotValues);
+          NativeVector>::InverseTransformFromBitReverse(permutedSlots, initRoot,
+                                                        m, &slotValues);
     } else {
       ChineseRemainderTransformFTT<
-          NativeVector>::InverseTransformFromBitReverse(slotValues,
-                                                        m_initRoot[modulusM], m,
-                                                        &slotValues);
+          NativeVector>::InverseTransformFromBitReverse(slotValues, initRoot,
+                                                        m, &slotValues);
     }
   } else {  // Arbitrary cyclotomic
     // Permute to CRT Order
     NativeVector permutedSlots(phim, modulusNI);
     for (usint i = 0; i < phim; i++) {
-      permutedSlots[i] = slotValues[m_toCRTPerm[m][i]];
+      permutedSlots[i] = slotValues[toCRTPerm[i]];
     }
 
     DEBUG("permutedSlots " << permutedSlots);
-    DEBUG("m_initRoot[modulusM] " << m_initRoot[modulusM]);
-    DEBUG("m_bigModulus[modulusM] " << m_bigModulus[modulusM]);
-    DEBUG("m_bigRoot[modulusM] " << m_bigRoot[modulusM]);
+    DEBUG("initRoot " << initRoot);
+    DEBUG("bigModulus " << bigModulus);
+    DEBUG("bigRoot " << bigRoot);
 
     slotValues = ChineseRemainderTransformArb<NativeVector>::InverseTransform(
-        permutedSlots, m_initRoot[modulusM], m_bigModulus[modulusM],
-        m_bigRoot[modulusM], m);
+        permutedSlots, initRoot, bigModulus, bigRoot, m);
   }
 
   DEBUG("slotvalues now " << slotValues);
@@ -388,12 +456,11 @@ void PackedEncoding::Unpack(P *ring, const PlaintextModulus &modulus) const {
   usint m = ring->GetCyclotomicOrder();  // cyclotomic order
   NativeInteger modulusNI(modulus);      // native int modulus
 
-  const ModulusM modulusM = {modulusNI, m};
-
-  // Do the precomputation if not initialized
-  if (this->m_initRoot[modulusM].GetMSB() == 0) {
-    SetParams(m, EncodingParams(std::make_shared<EncodingParamsImpl>(modulus)));
-  }
+  auto tables = GetTables(m, modulusNI);
+  const std::vector<usint> &fromCRTPerm = tables->GetFromCRTPerm();
+  const NativeInteger &initRoot = tables->GetInitRoot();
+  const NativeInteger &bigModulus = tables->GetBigModulus();
+  const NativeInteger &bigRoot = tables->GetBigRoot();
 
   usint phim = ring->GetRingDimension();  // ring dimension
 
@@ -412,18 +479,17 @@ void PackedEncoding::Unpack(P *ring, const PlaintextModulus &modulus) const {
   NativeVector permutedSlots(phim, modulusNI);
   if (IsPowerOfTwo(m)) {
     ChineseRemainderTransformFTT<NativeVector>::ForwardTransformToBitReverse(
-        packedVector, m_initRoot[modulusM], m, &permutedSlots);
+        packedVector, initRoot, m, &permutedSlots);
   } else {  // Arbitrary cyclotomic
     permutedSlots =
         ChineseRemainderTransformArb<NativeVector>::ForwardTransform(
-            packedVector, m_initRoot[modulusM], m_bigModulus[modulusM],
-            m_bigRoot[modulusM], m);
+            packedVector, initRoot, bigModulus, bigRoot, m);
   }
 
-  if (m_fromCRTPerm[m].size() > 0) {
+  if (fromCRTPerm.size() > 0) {
     // Permute to automorphism Order
     for (usint i = 0; i < phim; i++) {
-      packedVector[i] = permutedSlots[m_fromCRTPerm[m][i]];
+      packedVector[i] = permutedSlots[fromCRTPerm[i]];
     }
   } else {
     packedVector = permutedSlots;
@@ -439,87 +505,4 @@ void PackedEncoding::Unpack(P *ring, const PlaintextModulus &modulus) const {
 
   ring->SetValues(std::move(packedVectorRing), Format::COEFFICIENT);
 }
-
-void PackedEncoding::SetParams_2n(usint m, const NativeInteger &modulusNI) {
-  const ModulusM modulusM = {modulusNI, m};
-
-  // Power of two: m/2-point FTT. So we need the mth root of unity
-  m_initRoot[modulusM] = RootOfUnity<NativeInteger>(m, modulusNI);
-
-  // Create the permutations that interchange the automorphism and crt ordering
-  // First we create the cyclic group generated by 5 and then adjoin the
-  // co-factor by multiplying by (-1)
-
-  usint phim = (m >> 1);
-  usint phim_by_2 = (m >> 2);
-
-  m_toCRTPerm[m] = std::vector<usint>(phim);
-  m_fromCRTPerm[m] = std::vector<usint>(phim);
-
-  if (!MillerRabinPrimalityTest(modulusNI)) {
-    std::string errMsg =
-        "The given modulus: " + modulusNI.ToString() +
-            ", must be prime. The given value does not satisfy this condition.";
-    PALISADE_THROW(math_error, errMsg);
-  }
-
-  usint curr_index = 1;
-  usint logn = std::round(log2(m / 2));
-  for (usint i = 0; i < phim_by_2; i++) {
-    m_toCRTPerm[m][ReverseBits((curr_index - 1) / 2, logn)] = i;
-    m_fromCRTPerm[m][i] = ReverseBits((curr_index - 1) / 2, logn);
-
-    usint cofactor_index = curr_index * (m - 1) % m;
-
-    m_toCRTPerm[m][ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
-    m_fromCRTPerm[m][i + phim_by_2] =
-        ReverseBits((cofactor_index - 1) / 2, logn);
-
-    curr_index = curr_index * 5 % m;
-  }
-}
-
-void PackedEncoding::SetParams_2n(usint m, EncodingParams params) {
-  NativeInteger modulusNI(params->GetPlaintextModulus());  // native int modulus
-  const ModulusM modulusM = {modulusNI, m};
-
-  if (!MillerRabinPrimalityTest(modulusNI)) {
-    std::string errMsg =
-        "The given modulus: " + modulusNI.ToString() +
-        ", must be prime. The given value does not satisfy this condition.";
-    PALISADE_THROW(math_error, errMsg);
-  }
-
-  // Power of two: m/2-point FTT. So we need the mth root of unity
-  if (params->GetPlaintextRootOfUnity() == 0) {
-    m_initRoot[modulusM] = RootOfUnity<NativeInteger>(m, modulusNI);
-    params->SetPlaintextRootOfUnity(m_initRoot[modulusM]);
-  } else {
-    m_initRoot[modulusM] = params->GetPlaintextRootOfUnity();
-  }
-
-  // Create the permutations that interchange the automorphism and crt ordering
-  // First we create the cyclic group generated by 5 and then adjoin the
-  // co-factor by multiplying by (-1)
-  usint phim = (m >> 1);
-  usint phim_by_2 = (m >> 2);
-
-  m_toCRTPerm[m] = std::vector<usint>(phim);
-  m_fromCRTPerm[m] = std::vector<usint>(phim);
-
-  usint curr_index = 1;
-  usint logn = std::round(log2(m >> 1));
-  for (usint i = 0; i < phim_by_2; i++) {
-    m_toCRTPerm[m][ReverseBits((curr_index - 1) / 2, logn)] = i;
-    m_fromCRTPerm[m][i] = ReverseBits((curr_index - 1) / 2, logn);
-
-    usint cofactor_index = curr_index * (m - 1) % m;
-
-    m_toCRTPerm[m][ReverseBits((cofactor_index - 1) / 2, logn)] = i + phim_by_2;
-    m_fromCRTPerm[m][i + phim_by_2] =
-        ReverseBits((cofactor_index - 1) / 2, logn);
-
-    curr_index = curr_index * 5 % m;
-  }
-}
 }  // namespace lbcrypto
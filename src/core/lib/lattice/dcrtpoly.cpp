@@ -22,6 +22,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 
@@ -31,12 +32,17 @@
 
 #include "lattice/dcrtpoly.h"
 #include "utils/debug.h"
+#include "utils/scheduler.h"
 
 using std::shared_ptr;
 using std::string;
 
 namespace lbcrypto {
 
+// number of coefficients each task of a parallel loop over the coefficients
+// of the towers covers
+static const size_t COEF_GRAIN = 512;
+
 /*CONSTRUCTORS*/
 template <typename VecType>
 DCRTPolyImpl<VecType>::DCRTPolyImpl() {
@@ -51,6 +57,11 @@ DCRTPolyImpl<VecType>::DCRTPolyImpl(
   m_format = format;
   m_params = dcrtParams;
 
+  if (initializeElementToZero && IsContiguousStorage()) {
+    m_vectors = MakeContiguousTowers(dcrtParams, format);
+    return;
+  }
+
   size_t vecSize = dcrtParams->GetParams().size();
   m_vectors.reserve(vecSize);
 
@@ -63,8 +74,57 @@ DCRTPolyImpl<VecType>::DCRTPolyImpl(
 template <typename VecType>
 DCRTPolyImpl<VecType>::DCRTPolyImpl(const DCRTPolyImpl &element) {
   m_format = element.m_format;
-  m_vectors = element.m_vectors;
   m_params = element.m_params;
+  if (IsContiguousStorage() && element.m_vectors.size() > 0 &&
+      element.AllTowersSet(0, element.m_vectors.size() - 1)) {
+    m_vectors = MakeContiguousTowers(m_params, m_format, &element.m_vectors);
+  } else {
+    m_vectors = element.m_vectors;
+  }
+}
+
+template <typename VecType>
+std::vector<typename DCRTPolyImpl<VecType>::PolyType>
+DCRTPolyImpl<VecType>::MakeContiguousTowers(
+    const shared_ptr<DCRTPolyImpl::Params> params, Format format,
+    const std::vector<PolyType> *src, usint first) {
+  const auto &towerParams = params->GetParams();
+  size_t vecSize = towerParams.size();
+
+  size_t bytes = 0;
+  for (usint i = 0; i < vecSize; i++) {
+    bytes += LimbBuffer::Stride(towerParams[i]->GetRingDimension() *
+                                sizeof(NativeInteger));
+  }
+  auto buffer = std::make_shared<LimbBuffer>(bytes);
+
+  std::vector<PolyType> towers;
+  towers.reserve(vecSize);
+  for (usint i = 0; i < vecSize; i++) {
+    NativeVector values(towerParams[i]->GetRingDimension(),
+                        towerParams[i]->GetModulus(), buffer);
+    Format towerFormat = format;
+    if (src != nullptr) {
+      const PolyType &tower = (*src)[first + i];
+      values = tower.GetValues();
+      towerFormat = tower.GetFormat();
+    }
+    towers.emplace_back(towerParams[i], towerFormat, std::move(values));
+  }
+  return towers;
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::IsContiguous() const {
+  if (m_vectors.empty() || m_vectors[0].IsEmpty()) return false;
+  const auto &buffer = m_vectors[0].GetValues().GetLimbBuffer();
+  if (buffer == nullptr) return false;
+  for (usint i = 0; i < m_vectors.size(); i++) {
+    if (m_vectors[i].IsEmpty()) return false;
+    const auto &values = m_vectors[i].GetValues();
+    if (!buffer->Owns(&values[0])) return false;
+  }
+  return true;
 }
 
 template <typename VecType>
@@ -488,8 +548,7 @@ std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::CRTDecompose(
   DCRTPolyType input = this->Clone();
   input.SetFormat(Format::COEFFICIENT);
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     if (baseBits == 0) {
       DCRTPolyType currentDCRTPoly = input.Clone();
 
@@ -529,7 +588,7 @@ std::vector<DCRTPolyImpl<VecType>> DCRTPolyImpl<VecType>::CRTDecompose(
         result[j + arrWindows[i]] = std::move(currentDCRTPoly);
       }
     }
-  }
+  });
 
   return result;
 }
@@ -616,10 +675,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(
   }
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < tmp.m_vectors.size(); i++) {
+  ParallelFor(0, tmp.m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] += element.GetElementAtIndex(i);
-  }
+  });
   return tmp;
 }
 
@@ -643,40 +701,36 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(
   }
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < tmp.m_vectors.size(); i++) {
+  ParallelFor(0, tmp.m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] -= element.GetElementAtIndex(i);
-  }
+  });
   return tmp;
 }
 
 template <typename VecType>
 const DCRTPolyImpl<VecType> &DCRTPolyImpl<VecType>::operator+=(
     const DCRTPolyImpl &rhs) {
-#pragma omp parallel for
-  for (usint i = 0; i < this->GetNumOfElements(); i++) {
+  ParallelFor(0, this->GetNumOfElements(), [&](size_t i) {
     this->m_vectors[i] += rhs.m_vectors[i];
-  }
+  });
   return *this;
 }
 
 template <typename VecType>
 const DCRTPolyImpl<VecType> &DCRTPolyImpl<VecType>::operator-=(
     const DCRTPolyImpl &rhs) {
-#pragma omp parallel for
-  for (usint i = 0; i < this->GetNumOfElements(); i++) {
+  ParallelFor(0, this->GetNumOfElements(), [&](size_t i) {
     this->m_vectors.at(i) -= rhs.m_vectors[i];
-  }
+  });
   return *this;
 }
 
 template <typename VecType>
 const DCRTPolyImpl<VecType> &DCRTPolyImpl<VecType>::operator*=(
     const DCRTPolyImpl &element) {
-#pragma omp parallel for
-  for (usint i = 0; i < this->m_vectors.size(); i++) {
+  ParallelFor(0, this->m_vectors.size(), [&](size_t i) {
     this->m_vectors.at(i) *= element.m_vectors.at(i);
-  }
+  });
 
   return *this;
 }
@@ -702,9 +756,14 @@ template <typename VecType>
 const DCRTPolyImpl<VecType> &DCRTPolyImpl<VecType>::operator=(
     const DCRTPolyImpl &rhs) {
   if (this != &rhs) {
-    m_vectors = rhs.m_vectors;
     m_format = rhs.m_format;
     m_params = rhs.m_params;
+    if (IsContiguousStorage() && rhs.m_vectors.size() > 0 &&
+        rhs.AllTowersSet(0, rhs.m_vectors.size() - 1)) {
+      m_vectors = MakeContiguousTowers(m_params, m_format, &rhs.m_vectors);
+    } else {
+      m_vectors = rhs.m_vectors;
+    }
   }
   return *this;
 }
@@ -861,10 +920,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(
     const Integer &element) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < tmp.m_vectors.size(); i++) {
+  ParallelFor(0, tmp.m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] += element.ConvertToInt();
-  }
+  });
   return tmp;
 }
 
@@ -873,10 +931,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Plus(
     const vector<Integer> &crtElement) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < tmp.m_vectors.size(); i++) {
+  ParallelFor(0, tmp.m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] += crtElement[i].ConvertToInt();
-  }
+  });
   return tmp;
 }
 
@@ -885,10 +942,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(
     const Integer &element) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < tmp.m_vectors.size(); i++) {
+  ParallelFor(0, tmp.m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] -= element.ConvertToInt();
-  }
+  });
   return tmp;
 }
 
@@ -897,10 +953,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Minus(
     const vector<Integer> &crtElement) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < tmp.m_vectors.size(); i++) {
+  ParallelFor(0, tmp.m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] -= crtElement[i].ConvertToInt();
-  }
+  });
   return tmp;
 }
 
@@ -912,12 +967,11 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(
   }
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     // ModMul multiplies and performs a mod operation on the results. The mod is
     // the modulus of each tower.
     tmp.m_vectors[i] *= element.m_vectors[i];
-  }
+  });
   return tmp;
 }
 
@@ -926,14 +980,13 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(
     const Integer &element) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] =
         tmp.m_vectors[i] *
         element
             .ConvertToInt();  // (element %
                               // Integer((*m_params)[i]->GetModulus().ConvertToInt())).ConvertToInt();
-  }
+  });
   return tmp;
 }
 
@@ -942,10 +995,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(
     bigintnat::NativeInteger::SignedNativeInt element) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] = tmp.m_vectors[i].Times(element);
-  }
+  });
   return tmp;
 }
 
@@ -954,11 +1006,10 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(
     const std::vector<Integer> &crtElement) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] =
         this->m_vectors[i].Times(NativeInteger(crtElement[i].ConvertToInt()));
-  }
+  });
   return tmp;
 }
 
@@ -967,10 +1018,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::Times(
     const std::vector<NativeInteger> &element) const {
   DCRTPolyImpl<VecType> tmp(*this);
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     tmp.m_vectors[i] *= element[i];
-  }
+  });
   return tmp;
 }
 
@@ -1040,11 +1090,14 @@ void DCRTPolyImpl<VecType>::DropLastElement() {
   if (m_vectors.size() == 0) {
     PALISADE_THROW(math_error, "Last element being removed from empty list");
   }
+  bool repack = RepackAfterDrop(1);
   m_vectors.resize(m_vectors.size() - 1);
 
   DCRTPolyImpl::Params *newP = new DCRTPolyImpl::Params(*m_params);
   newP->PopLastParam();
   m_params.reset(newP);
+
+  if (repack) m_vectors = MakeContiguousTowers(m_params, m_format, &m_vectors);
 }
 
 template <typename VecType>
@@ -1055,10 +1108,22 @@ void DCRTPolyImpl<VecType>::DropLastElements(size_t i) {
                    "perform the modulus reduction");
   }
 
+  bool repack = RepackAfterDrop(i);
   m_vectors.resize(m_vectors.size() - i);
   DCRTPolyImpl::Params *newP = new DCRTPolyImpl::Params(*m_params);
   for (size_t j = 0; j < i; j++) newP->PopLastParam();
   m_params.reset(newP);
+
+  if (repack) m_vectors = MakeContiguousTowers(m_params, m_format, &m_vectors);
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::RepackAfterDrop(size_t dropped) const {
+  // the towers that are dropped stay in the shared buffer until every tower
+  // placed in it is gone, so once they make up half of it or more the
+  // remaining towers are moved to a buffer of their own
+  return IsContiguousStorage() && dropped < m_vectors.size() &&
+         2 * dropped >= m_vectors.size() && IsContiguous();
 }
 
 // used for CKKS rescaling
@@ -1079,13 +1144,12 @@ void DCRTPolyImpl<VecType>::DropLastElementAndScale(
   lastPoly.SetFormat(Format::COEFFICIENT);
   DCRTPolyType extra(m_params, COEFFICIENT, true);
 
-#pragma omp parallel for
-  for (usint i = 0; i < extra.m_vectors.size(); i++) {
+  ParallelFor(0, extra.m_vectors.size(), [&](size_t i) {
     auto temp = lastPoly;
     temp.SwitchModulus(m_vectors[i].GetModulus(),
                        m_vectors[i].GetRootOfUnity());
     extra.m_vectors[i] = (temp *= QlQlInvModqlDivqlModq[i]);
-  }
+  });
 
   if (this->GetFormat() == Format::EVALUATION)
     extra.SetFormat(Format::EVALUATION);
@@ -1104,11 +1168,10 @@ void DCRTPolyImpl<VecType>::DropLastElementAndScale(
                                1);
   }
 #else
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
+  ParallelFor(0, m_vectors.size(), [&](size_t i) {
     m_vectors[i] *= qlInvModq[i];
     m_vectors[i] += extra.m_vectors[i];
-  }
+  });
 #endif
 
   this->SetFormat(Format::EVALUATION);
@@ -1156,33 +1219,30 @@ void DCRTPolyImpl<VecType>::ModReduce(
 
     delta *= negtInvModq;
 
-#pragma omp parallel for
-    for (usint i = 0; i < m_vectors.size(); i++) {
+    ParallelFor(0, m_vectors.size(), [&](size_t i) {
       auto temp = delta;
       temp.SwitchModulus(m_vectors[i].GetModulus(),
                          m_vectors[i].GetRootOfUnity());
       extra.m_vectors[i] = temp;
-    }
+    });
 
     extra.SetFormat(Format::EVALUATION);
 
-#pragma omp parallel for
-    for (usint i = 0; i < m_vectors.size(); i++) {
+    ParallelFor(0, m_vectors.size(), [&](size_t i) {
       extra.m_vectors[i] *= t;
       m_vectors[i] += extra.m_vectors[i];
       m_vectors[i] *= qlInvModq[i];
-    }
+    });
 
   } else {
     delta *= negtInvModq;
-#pragma omp parallel for
-    for (usint i = 0; i < m_vectors.size(); i++) {
+    ParallelFor(0, m_vectors.size(), [&](size_t i) {
       auto temp = delta;
       temp.SwitchModulus(m_vectors[i].GetModulus(),
                          m_vectors[i].GetRootOfUnity());
       m_vectors[i] += (temp *= t);
       m_vectors[i] *= qlInvModq[i];
-    }
+    });
   }
 }
 
@@ -1294,17 +1354,19 @@ DCRTPolyImpl<VecType>::CRTInterpolate() const {
   Integer mu = bigModulus.ComputeMu();
 
   // now, compute the values for the vector
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDimension; ri++) {
-    coefficients[ri] = 0;
-    for (usint vi = 0; vi < nTowers; vi++) {
-      coefficients[ri] += (Integer((*vecs)[vi].GetValues()[ri].ConvertToInt()) *
-                           multiplier[vi]);
+  ParallelForRange(0, ringDimension, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      coefficients[ri] = 0;
+      for (usint vi = 0; vi < nTowers; vi++) {
+        coefficients[ri] +=
+            (Integer((*vecs)[vi].GetValues()[ri].ConvertToInt()) *
+             multiplier[vi]);
+      }
+      DEBUG((*vecs)[0].GetValues()[ri] << " * " << multiplier[0]
+                                       << " == " << coefficients[ri]);
+      coefficients[ri].ModEq(bigModulus, mu);
     }
-    DEBUG((*vecs)[0].GetValues()[ri] << " * " << multiplier[0]
-                                     << " == " << coefficients[ri]);
-    coefficients[ri].ModEq(bigModulus, mu);
-  }
+  });
 
   DEBUG("passed loops");
   DEBUG(coefficients);
@@ -1327,6 +1389,133 @@ DCRTPolyImpl<VecType>::CRTInterpolate() const {
   return polynomialReconstructed;
 }
 
+// a value given by its mixed-radix digits is in the upper half (Q/2, Q), i.e.
+// negative when centered, iff its digits exceed those of (Q-1)/2, which are
+// (q_i-1)/2 for odd moduli
+static bool IsNegativeMixedRadix(const std::vector<NativeInteger> &digits,
+                                 const std::vector<NativeInteger> &q, usint n) {
+  for (usint i = n; i-- > 0;) {
+    NativeInteger half = q[i] >> 1;
+    if (digits[i] != half) return digits[i] > half;
+  }
+  return false;
+}
+
+template <typename VecType>
+std::vector<double> DCRTPolyImpl<VecType>::CRTInterpolateToDouble(
+    double scale, usint numTowers) const {
+  usint ringDimension = GetRingDimension();
+  usint nTowers = m_vectors.size();
+  usint k = (numTowers == 0 || numTowers > nTowers) ? nTowers : numTowers;
+
+  const std::vector<PolyType> *vecs = &m_vectors;
+  std::vector<PolyType> coeffVecs;
+  if (m_format == Format::EVALUATION) {
+    for (usint i = 0; i < nTowers; i++) {
+      PolyType vecCopy(m_vectors[i]);
+      vecCopy.SetFormat(Format::COEFFICIENT);
+      coeffVecs.push_back(std::move(vecCopy));
+    }
+    vecs = &coeffVecs;
+  }
+
+  std::vector<NativeInteger> q(nTowers);
+  std::vector<NativeInteger> mu(nTowers);
+  for (usint j = 0; j < nTowers; j++) {
+    q[j] = m_vectors[j].GetModulus();
+    mu[j] = q[j].ComputeMu();
+  }
+
+  // Garner's algorithm: qInvModq[j][i] = q_i^{-1} mod q_j for i < j
+  std::vector<std::vector<NativeInteger>> qInvModq(nTowers);
+  std::vector<std::vector<NativeInteger>> qInvModqPrecon(nTowers);
+  for (usint j = 1; j < nTowers; j++) {
+    qInvModq[j].resize(j);
+    qInvModqPrecon[j].resize(j);
+    for (usint i = 0; i < j; i++) {
+      qInvModq[j][i] = q[i].Mod(q[j]).ModInverse(q[j]);
+      qInvModqPrecon[j][i] = qInvModq[j][i].PrepModMulConst(q[j]);
+    }
+  }
+
+  // for the check against tower j >= k: qModq[j][i] = q_i mod q_j for i < k
+  // and QkModq[j] = q_0 * ... * q_{k-1} mod q_j
+  std::vector<std::vector<NativeInteger>> qModq(nTowers);
+  std::vector<std::vector<NativeInteger>> qModqPrecon(nTowers);
+  std::vector<NativeInteger> QkModq(nTowers);
+  for (usint j = k; j < nTowers; j++) {
+    qModq[j].resize(k);
+    qModqPrecon[j].resize(k);
+    QkModq[j] = 1;
+    for (usint i = 0; i < k; i++) {
+      qModq[j][i] = q[i].Mod(q[j]);
+      qModqPrecon[j][i] = qModq[j][i].PrepModMulConst(q[j]);
+      QkModq[j].ModMulFastConstEq(qModq[j][i], q[j], qModqPrecon[j][i]);
+    }
+  }
+
+  std::vector<double> result(ringDimension);
+
+  ParallelForRange(0, ringDimension, COEF_GRAIN, [&](size_t begin, size_t end) {
+    std::vector<NativeInteger> digits(nTowers);
+
+    for (usint ri = begin; ri < end; ri++) {
+      // mixed-radix digits of x_ri mod q_0 * ... * q_{n-1}
+      usint n = k;
+      for (usint j = 0; j < n; j++) {
+        NativeInteger t = (*vecs)[j][ri];
+        for (usint i = 0; i < j; i++) {
+          t = t.ModSub(digits[i], q[j], mu[j])
+                  .ModMulFastConst(qInvModq[j][i], q[j], qInvModqPrecon[j][i]);
+        }
+        digits[j] = t;
+
+        // check the value reconstructed from the leading towers against the
+        // remaining ones
+        if (j + 1 == n && n < nTowers) {
+          bool negative = IsNegativeMixedRadix(digits, q, n);
+          for (usint l = n; l < nTowers; l++) {
+            NativeInteger r = digits[n - 1].Mod(q[l], mu[l]);
+            for (usint i = n - 1; i-- > 0;) {
+              r = r.ModMulFastConst(qModq[l][i], q[l], qModqPrecon[l][i])
+                      .ModAdd(digits[i], q[l], mu[l]);
+            }
+            if (negative) r.ModSubEq(QkModq[l], q[l], mu[l]);
+            if (r != (*vecs)[l][ri]) {
+              n = nTowers;
+              break;
+            }
+          }
+        }
+      }
+
+      bool negative = IsNegativeMixedRadix(digits, q, n);
+      // -x has the digits q_i - 1 - x_i, plus one
+      if (negative) {
+        bool carry = true;
+        for (usint i = 0; i < n; i++) {
+          digits[i] = q[i] - NativeInteger(1) - digits[i];
+          if (carry) {
+            digits[i] += NativeInteger(1);
+            carry = (digits[i] == q[i]);
+            if (carry) digits[i] = 0;
+          }
+        }
+      }
+
+      long double value = digits[n - 1].ConvertToInt();
+      for (usint i = n - 1; i-- > 0;) {
+        value = value * static_cast<long double>(q[i].ConvertToInt()) +
+                static_cast<long double>(digits[i].ConvertToInt());
+      }
+      value *= scale;
+      result[ri] = static_cast<double>(negative ? -value : value);
+    }
+  });
+
+  return result;
+}
+
 /*
  * This method applies the Chinese Remainder Interpolation on a
  * single element across all towers of a DCRTPolyImpl and produces an Poly
@@ -1479,6 +1668,98 @@ DCRTPolyImpl<VecType>::GetExtendedCRTBasis(
                                                 moduliQP, rootsQP);
 }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+// number of coefficients FastBaseConv converts at a time; one tile of every
+// input tower plus the 128-bit sums for one output tower fit in L1
+static const uint32_t BASE_CONV_TILE = 64;
+
+/**
+ * Fast (approximate) base conversion shared by ApproxSwitchCRTBasis,
+ * FastBaseConvqToBskMontgomery and FastBaseConvSK: for every coefficient k
+ * computes
+ *   y[j][k] = sum_i [x[i][k] * twist[i]]_{moduliIn[i]} * matrix[i][j]
+ * reduced mod moduliOut[j]. The input is processed in tiles of coefficients,
+ * so the (numIn x numOut) matrix is read once per tile rather than once per
+ * coefficient, and the products are accumulated lazily in 128 bits with a
+ * single Barrett reduction per output.
+ *
+ * @param x the input towers.
+ * @param moduliIn the moduli of the input towers.
+ * @param twist factors the inputs are multiplied by first, or nullptr if the
+ * inputs are already twisted.
+ * @param twistPrecon precomputations for twist.
+ * @param matrix the numIn x numOut conversion matrix.
+ * @param y the output towers.
+ * @param moduliOut the moduli of the output towers.
+ * @param modOutBarrettMu Barrett constants for moduliOut.
+ * @param n the number of coefficients.
+ */
+static void FastBaseConv(const std::vector<const NativeInteger *> &x,
+                         const std::vector<NativeInteger> &moduliIn,
+                         const std::vector<NativeInteger> *twist,
+                         const std::vector<NativeInteger> *twistPrecon,
+                         const std::vector<std::vector<NativeInteger>> &matrix,
+                         const std::vector<NativeInteger *> &y,
+                         const std::vector<NativeInteger> &moduliOut,
+                         const std::vector<DoubleNativeInt> &modOutBarrettMu,
+                         uint32_t n) {
+  const uint32_t numIn = x.size();
+  const uint32_t numOut = y.size();
+
+  // transposed, so that the factors for one output tower are contiguous
+  std::vector<uint64_t> matrixT(numOut * numIn);
+  for (uint32_t i = 0; i < numIn; i++) {
+    for (uint32_t j = 0; j < numOut; j++) {
+      matrixT[j * numIn + i] = matrix[i][j].ConvertToInt();
+    }
+  }
+
+  const uint32_t numTiles = (n + BASE_CONV_TILE - 1) / BASE_CONV_TILE;
+
+  const uint32_t tilesPerTask = COEF_GRAIN / BASE_CONV_TILE;
+  ParallelForRange(0, numTiles, tilesPerTask, [&](size_t first, size_t last) {
+    std::vector<uint64_t> xTile(numIn * BASE_CONV_TILE);
+    DoubleNativeInt sum[BASE_CONV_TILE];
+
+    for (uint32_t t = first; t < last; t++) {
+      const uint32_t begin = t * BASE_CONV_TILE;
+      const uint32_t len = std::min(BASE_CONV_TILE, n - begin);
+
+      for (uint32_t i = 0; i < numIn; i++) {
+        const NativeInteger *xi = x[i] + begin;
+        uint64_t *xt = &xTile[i * BASE_CONV_TILE];
+        if (twist != nullptr) {
+          for (uint32_t k = 0; k < len; k++) {
+            xt[k] = xi[k]
+                        .ModMulFastConst((*twist)[i], moduliIn[i],
+                                         (*twistPrecon)[i])
+                        .ConvertToInt();
+          }
+        } else {
+          for (uint32_t k = 0; k < len; k++) xt[k] = xi[k].ConvertToInt();
+        }
+      }
+
+      for (uint32_t j = 0; j < numOut; j++) {
+        const uint64_t *mj = &matrixT[j * numIn];
+        for (uint32_t k = 0; k < len; k++) sum[k] = 0;
+        for (uint32_t i = 0; i < numIn; i++) {
+          const uint64_t *xt = &xTile[i * BASE_CONV_TILE];
+          const uint64_t mij = mj[i];
+          for (uint32_t k = 0; k < len; k++) sum[k] += Mul128(xt[k], mij);
+        }
+
+        const uint64_t pj = moduliOut[j].ConvertToInt();
+        NativeInteger *yj = y[j] + begin;
+        for (uint32_t k = 0; k < len; k++) {
+          yj[k] = BarrettUint128ModUint64(sum[k], pj, modOutBarrettMu[j]);
+        }
+      }
+    }
+  });
+}
+#endif
+
 #if defined(HAVE_INT128) && NATIVEINT == 64 && !defined(__EMSCRIPTEN__)
 template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
@@ -1496,27 +1777,22 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
                     : m_vectors.size();
   usint sizeP = ans.m_vectors.size();
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    vector<DoubleNativeInt> sum(sizeP);
-    for (usint i = 0; i < sizeQ; i++) {
-      const NativeInteger &xi = m_vectors[i][ri];
-      const NativeInteger &qi = m_vectors[i].GetModulus();
-      NativeInteger xQHatInvModqi =
-          xi.ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]);
-      for (usint j = 0; j < sizeP; j++) {
-        sum[j] +=
-            Mul128(xQHatInvModqi.ConvertToInt(), QHatModp[i][j].ConvertToInt());
-      }
-    }
-
-    for (usint j = 0; j < sizeP; j++) {
-      const NativeInteger &pj = ans.m_vectors[j].GetModulus();
-      ans.m_vectors[j][ri] =
-          BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), modpBarrettMu[j]);
-    }
+  std::vector<const NativeInteger *> x(sizeQ);
+  std::vector<NativeInteger> moduliQ(sizeQ);
+  for (usint i = 0; i < sizeQ; i++) {
+    x[i] = &m_vectors[i][0];
+    moduliQ[i] = m_vectors[i].GetModulus();
+  }
+  std::vector<NativeInteger *> y(sizeP);
+  std::vector<NativeInteger> moduliP(sizeP);
+  for (usint j = 0; j < sizeP; j++) {
+    y[j] = &ans.m_vectors[j][0];
+    moduliP[j] = ans.m_vectors[j].GetModulus();
   }
 
+  FastBaseConv(x, moduliQ, &QHatInvModq, &QHatInvModqPrecon, QHatModp, y,
+               moduliP, modpBarrettMu, ringDim);
+
   return ans;
 }
 #else
@@ -1537,13 +1813,12 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
 
   for (usint i = 0; i < sizeQ; i++) {
     auto xQHatInvModqi = m_vectors[i] * QHatInvModq[i];
-#pragma omp parallel for
-    for (usint j = 0; j < sizeP; j++) {
+    ParallelFor(0, sizeP, [&](size_t j) {
       auto temp = xQHatInvModqi;
       temp.SwitchModulus(ans.m_vectors[j].GetModulus(),
                          ans.m_vectors[j].GetRootOfUnity());
       ans.m_vectors[j] += (temp *= QHatModp[i][j]);
-    }
+    });
   }
 
   return ans;
@@ -1575,13 +1850,12 @@ void DCRTPolyImpl<VecType>::ApproxModUp(
 
   m_vectors.resize(sizeQP);
 
-#pragma omp parallel for
   // populate the towers corresponding to CRT basis P and convert them to
   // evaluation representation
-  for (size_t j = 0; j < sizeP; j++) {
+  ParallelFor(0, sizeP, [&](size_t j) {
     m_vectors[sizeQ + j] = partP.m_vectors[j];
     m_vectors[sizeQ + j].SetFormat(Format::EVALUATION);
-  }
+  });
   // if the input polynomial was in evaluation representation, use the towers
   // for Q from it
   if (polyInNTT.size() > 0) {
@@ -1590,10 +1864,7 @@ void DCRTPolyImpl<VecType>::ApproxModUp(
     }
   } else {
 // else call NTT for the towers for Q
-#pragma omp parallel for
-    for (size_t i = 0; i < sizeQ; i++) {
-      m_vectors[i].SwitchFormat();
-    }
+    PolyType::SwitchFormat(&m_vectors, 0, sizeQ);
   }
 
   m_format = Format::EVALUATION;
@@ -1626,10 +1897,9 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
 
   // Multiply everything by -t^(-1) mod P (BGVrns only)
   if (t > 0) {
-#pragma omp parallel for
-    for (usint j = 0; j < sizeP; j++) {
+    ParallelFor(0, sizeP, [&](size_t j) {
       partP.m_vectors[j] *= tInvModp[j];
-    }
+    });
   }
 
   DCRTPolyType partPSwitchedToQ =
@@ -1643,23 +1913,93 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
 
   // Multiply everything by t mod Q (BGVrns only)
   if (t > 0) {
-#pragma omp parallel for
-    for (usint i = 0; i < sizeQ; i++) {
+    ParallelFor(0, sizeQ, [&](size_t i) {
       partPSwitchedToQ.m_vectors[i] *= t;
-    }
+    });
   }
 
   partPSwitchedToQ.SetFormat(EVALUATION);
 
-#pragma omp parallel for
-  for (usint i = 0; i < sizeQ; i++) {
+  ParallelFor(0, sizeQ, [&](size_t i) {
     auto diff = m_vectors[i] - partPSwitchedToQ.m_vectors[i];
     ans.m_vectors[i] = diff * PInvModq[i];
-  }
+  });
 
   return ans;
 }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64 && !defined(__EMSCRIPTEN__)
+template <typename VecType>
+void DCRTPolyImpl<VecType>::KeySwitchInnerProduct(
+    const vector<DCRTPolyType> &digits, const vector<DCRTPolyType> &bv,
+    const vector<DCRTPolyType> &av, usint sizeQ,
+    const vector<DoubleNativeInt> &modqBarrettMu,
+    const vector<DoubleNativeInt> &modpBarrettMu, DCRTPolyType *sum0,
+    DCRTPolyType *sum1) {
+  usint numDigits = digits.size();
+  usint sizeQlP = sum0->m_vectors.size();
+  usint sizeQl = sizeQlP - modpBarrettMu.size();
+  usint ringDim = sum0->GetRingDimension();
+
+  ParallelFor(0, sizeQlP, [&](size_t i) {
+    // towers of P come after all towers of Q in the key components
+    usint idx = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+    uint64_t qi = sum0->m_vectors[i].GetModulus().ConvertToInt();
+    const DoubleNativeInt &mu =
+        (i < sizeQl) ? modqBarrettMu[i] : modpBarrettMu[i - sizeQl];
+
+    vector<const NativeInteger *> c(numDigits), b(numDigits), a(numDigits);
+    for (usint j = 0; j < numDigits; j++) {
+      c[j] = &digits[j].m_vectors[i].GetValues()[0];
+      b[j] = &bv[j].m_vectors[idx].GetValues()[0];
+      a[j] = &av[j].m_vectors[idx].GetValues()[0];
+    }
+    NativeInteger *out0 = &sum0->m_vectors[i][0];
+    NativeInteger *out1 = &sum1->m_vectors[i][0];
+
+    for (usint ri = 0; ri < ringDim; ri++) {
+      // each product is below 2^120, so up to 2^8 of them fit in 128 bits
+      DoubleNativeInt acc0 = 0;
+      DoubleNativeInt acc1 = 0;
+      for (usint j = 0; j < numDigits; j++) {
+        uint64_t cj = c[j][ri].ConvertToInt();
+        acc0 += Mul128(cj, b[j][ri].ConvertToInt());
+        acc1 += Mul128(cj, a[j][ri].ConvertToInt());
+        if ((j & 0xFF) == 0xFF) {
+          acc0 = BarrettUint128ModUint64(acc0, qi, mu);
+          acc1 = BarrettUint128ModUint64(acc1, qi, mu);
+        }
+      }
+      out0[ri] = BarrettUint128ModUint64(acc0, qi, mu);
+      out1[ri] = BarrettUint128ModUint64(acc1, qi, mu);
+    }
+  });
+}
+#else
+template <typename VecType>
+void DCRTPolyImpl<VecType>::KeySwitchInnerProduct(
+    const vector<DCRTPolyType> &digits, const vector<DCRTPolyType> &bv,
+    const vector<DCRTPolyType> &av, usint sizeQ,
+    const vector<DoubleNativeInt> &modqBarrettMu,
+    const vector<DoubleNativeInt> &modpBarrettMu, DCRTPolyType *sum0,
+    DCRTPolyType *sum1) {
+  usint numDigits = digits.size();
+  usint sizeQlP = sum0->m_vectors.size();
+  usint sizeQl = sizeQlP - modpBarrettMu.size();
+
+  ParallelFor(0, sizeQlP, [&](size_t i) {
+    usint idx = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+    sum0->m_vectors[i].SetValuesToZero();
+    sum1->m_vectors[i].SetValuesToZero();
+    for (usint j = 0; j < numDigits; j++) {
+      const auto &cji = digits[j].m_vectors[i];
+      sum0->m_vectors[i] += cji * bv[j].m_vectors[idx];
+      sum1->m_vectors[i] += cji * av[j].m_vectors[idx];
+    }
+  });
+}
+#endif
+
 #if defined(HAVE_INT128) && NATIVEINT == 64
 template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::SwitchCRTBasis(
@@ -1676,49 +2016,50 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::SwitchCRTBasis(
   usint sizeQ = m_vectors.size();
   usint sizeP = ans.m_vectors.size();
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    std::vector<NativeInteger> xQHatInvModq(sizeQ);
-    double nu = 0.5;
+  ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      std::vector<NativeInteger> xQHatInvModq(sizeQ);
+      double nu = 0.5;
 
-    // Compute alpha and vector of x_i terms
-    for (usint i = 0; i < sizeQ; i++) {
-      //      const NativeInteger &xi = m_vectors[i][ri];
-      const NativeInteger &qi = m_vectors[i].GetModulus();
+      // Compute alpha and vector of x_i terms
+      for (usint i = 0; i < sizeQ; i++) {
+        //      const NativeInteger &xi = m_vectors[i][ri];
+        const NativeInteger &qi = m_vectors[i].GetModulus();
 
-      // computes [x_i (Q/q_i)^{-1}]_{q_i}
-      xQHatInvModq[i] = m_vectors[i][ri].ModMulFastConst(QHatInvModq[i], qi,
-                                                         QHatInvModqPrecon[i]);
+        // computes [x_i (Q/q_i)^{-1}]_{q_i}
+        xQHatInvModq[i] = m_vectors[i][ri].ModMulFastConst(
+            QHatInvModq[i], qi, QHatInvModqPrecon[i]);
 
-      // computes [x_i (Q/q_i)^{-1}]_{q_i} / q_i
-      // to keep track of the number of q-overflows
-      nu += static_cast<double>(xQHatInvModq[i].ConvertToInt()) * qInv[i];
-    }
+        // computes [x_i (Q/q_i)^{-1}]_{q_i} / q_i
+        // to keep track of the number of q-overflows
+        nu += static_cast<double>(xQHatInvModq[i].ConvertToInt()) * qInv[i];
+      }
 
-    // alpha corresponds to the number of overflows, 0 <= alpha <= sizeQ
-    usint alpha = static_cast<usint>(nu);
+      // alpha corresponds to the number of overflows, 0 <= alpha <= sizeQ
+      usint alpha = static_cast<usint>(nu);
 
-    const std::vector<NativeInteger> &alphaQModpri = alphaQModp[alpha];
+      const std::vector<NativeInteger> &alphaQModpri = alphaQModp[alpha];
 
-    for (usint j = 0; j < sizeP; j++) {
-      DoubleNativeInt curValue = 0;
+      for (usint j = 0; j < sizeP; j++) {
+        DoubleNativeInt curValue = 0;
 
-      const NativeInteger &pj = ans.m_vectors[j].GetModulus();
-      const std::vector<NativeInteger> &QHatModpj = QHatModp[j];
-      // first round - compute "fast conversion"
-      for (usint i = 0; i < sizeQ; i++) {
-        curValue +=
-            Mul128(xQHatInvModq[i].ConvertToInt(), QHatModpj[i].ConvertToInt());
-      }
+        const NativeInteger &pj = ans.m_vectors[j].GetModulus();
+        const std::vector<NativeInteger> &QHatModpj = QHatModp[j];
+        // first round - compute "fast conversion"
+        for (usint i = 0; i < sizeQ; i++) {
+          curValue += Mul128(xQHatInvModq[i].ConvertToInt(),
+                             QHatModpj[i].ConvertToInt());
+        }
 
-      const NativeInteger &curNativeValue =
-          NativeInteger(BarrettUint128ModUint64(curValue, pj.ConvertToInt(),
-                                                modpBarrettMu[j]));
+        const NativeInteger &curNativeValue =
+            NativeInteger(BarrettUint128ModUint64(curValue, pj.ConvertToInt(),
+                                                  modpBarrettMu[j]));
 
-      // second round - remove q-overflows
-      ans.m_vectors[j][ri] = curNativeValue.ModSubFast(alphaQModpri[j], pj);
+        // second round - remove q-overflows
+        ans.m_vectors[j][ri] = curNativeValue.ModSubFast(alphaQModpri[j], pj);
+      }
     }
-  }
+  });
 
   return ans;
 }
@@ -1738,48 +2079,49 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::SwitchCRTBasis(
   usint sizeQ = m_vectors.size();
   usint sizeP = ans.m_vectors.size();
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    std::vector<NativeInteger> xQHatInvModq(sizeQ);
-    double nu = 0.5;
-
-    // Compute alpha and vector of x_i terms
-    for (usint i = 0; i < sizeQ; i++) {
-      //      const NativeInteger &xi = m_vectors[i][ri];
-      const NativeInteger &qi = m_vectors[i].GetModulus();
+  ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      std::vector<NativeInteger> xQHatInvModq(sizeQ);
+      double nu = 0.5;
 
-      // computes [x_i (Q/q_i)^{-1}]_{q_i}
-      xQHatInvModq[i] = m_vectors[i][ri].ModMulFastConst(QHatInvModq[i], qi,
-                                                         QHatInvModqPrecon[i]);
+      // Compute alpha and vector of x_i terms
+      for (usint i = 0; i < sizeQ; i++) {
+        //      const NativeInteger &xi = m_vectors[i][ri];
+        const NativeInteger &qi = m_vectors[i].GetModulus();
 
-      // computes [x_i (Q/q_i)^{-1}]_{q_i} / q_i
-      // to keep track of the number of q-overflows
-      nu += static_cast<double>(xQHatInvModq[i].ConvertToInt()) * qInv[i];
-    }
+        // computes [x_i (Q/q_i)^{-1}]_{q_i}
+        xQHatInvModq[i] = m_vectors[i][ri].ModMulFastConst(
+            QHatInvModq[i], qi, QHatInvModqPrecon[i]);
 
-    // alpha corresponds to the number of overflows, 0 <= alpha <= sizeQ
-    usint alpha = static_cast<usint>(nu);
+        // computes [x_i (Q/q_i)^{-1}]_{q_i} / q_i
+        // to keep track of the number of q-overflows
+        nu += static_cast<double>(xQHatInvModq[i].ConvertToInt()) * qInv[i];
+      }
 
-    const std::vector<NativeInteger> &alphaQModpri = alphaQModp[alpha];
+      // alpha corresponds to the number of overflows, 0 <= alpha <= sizeQ
+      usint alpha = static_cast<usint>(nu);
 
-    vector<NativeInteger> mu(sizeP);
-    for (usint j = 0; j < sizeP; j++) {
-      mu[j] = ans.m_vectors[j].GetModulus().ComputeMu();
-    }
+      const std::vector<NativeInteger> &alphaQModpri = alphaQModp[alpha];
 
-    for (usint j = 0; j < sizeP; j++) {
-      const NativeInteger &pj = ans.m_vectors[j].GetModulus();
-      const std::vector<NativeInteger> &QHatModpj = QHatModp[j];
-      // first round - compute "fast conversion"
-      for (usint i = 0; i < sizeQ; i++) {
-        ans.m_vectors[j][ri].ModAddFastEq(
-            xQHatInvModq[i].ModMulFast(QHatModpj[i], pj, mu[j]), pj);
+      vector<NativeInteger> mu(sizeP);
+      for (usint j = 0; j < sizeP; j++) {
+        mu[j] = ans.m_vectors[j].GetModulus().ComputeMu();
       }
 
-      // second round - remove q-overflows
-      ans.m_vectors[j][ri].ModSubFastEq(alphaQModpri[j], pj);
+      for (usint j = 0; j < sizeP; j++) {
+        const NativeInteger &pj = ans.m_vectors[j].GetModulus();
+        const std::vector<NativeInteger> &QHatModpj = QHatModp[j];
+        // first round - compute "fast conversion"
+        for (usint i = 0; i < sizeQ; i++) {
+          ans.m_vectors[j][ri].ModAddFastEq(
+              xQHatInvModq[i].ModMulFast(QHatModpj[i], pj, mu[j]), pj);
+        }
+
+        // second round - remove q-overflows
+        ans.m_vectors[j][ri].ModSubFastEq(alphaQModpri[j], pj);
+      }
     }
-  }
+  });
 
   return ans;
 }
@@ -1814,13 +2156,12 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasis(
 
   m_vectors.resize(sizeQP);
 
-#pragma omp parallel for
   // populate the towers corresponding to CRT basis P and convert them to
   // evaluation representation
-  for (size_t j = 0; j < sizeP; j++) {
+  ParallelFor(0, sizeP, [&](size_t j) {
     m_vectors[sizeQ + j] = partP.m_vectors[j];
     m_vectors[sizeQ + j].SetFormat(resultFormat);
-  }
+  });
 
   if (resultFormat == Format::EVALUATION) {
     // if the input polynomial was in evaluation representation, use the towers
@@ -1829,8 +2170,9 @@ void DCRTPolyImpl<VecType>::ExpandCRTBasis(
       for (size_t i = 0; i < sizeQ; i++) m_vectors[i] = polyInNTT[i];
     } else {
       // else call NTT for the towers for Q
-#pragma omp parallel for
-      for (size_t i = 0; i < sizeQ; i++) m_vectors[i].SetFormat(resultFormat);
+      ParallelFor(0, sizeQ, [&](size_t i) {
+        m_vectors[i].SetFormat(resultFormat);
+      });
     }
   }
   m_format = resultFormat;
@@ -1872,24 +2214,25 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
         // we fit in 63 bits, so we can do multiplications and
         // additions without modulo reduction, and do modulo reduction
         // only once
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.5;
-          NativeInteger intSum = 0, tmp;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmp = m_vectors[i][ri];
-
-            floatSum += static_cast<double>(tmp.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-
-            // No intermediate modulo reductions are needed in this case
-            tmp.MulEqFast(tQHatInvModqDivqModt[i]);
-            intSum.AddEqFast(tmp);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.5;
+            NativeInteger intSum = 0, tmp;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmp = m_vectors[i][ri];
+
+              floatSum += static_cast<double>(tmp.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+
+              // No intermediate modulo reductions are needed in this case
+              tmp.MulEqFast(tQHatInvModqDivqModt[i]);
+              intSum.AddEqFast(tmp);
+            }
+            intSum += static_cast<uint64_t>(floatSum);
+            // mod a power of two
+            coefficients[ri] = intSum.ConvertToInt() & tMinus1;
           }
-          intSum += static_cast<uint64_t>(floatSum);
-          // mod a power of two
-          coefficients[ri] = intSum.ConvertToInt() & tMinus1;
-        }
+        });
       } else {
         // In case of qMSB + sizeQMSB >= 52 we decompose x_i in the basis
         // B=2^{qMSB/2} And split the sum \sum x_i*tQHatInvModqDivqFrac[i] to
@@ -1900,24 +2243,25 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
         // is bounded by 2^{-53}. Thus the floating point error is bounded by
         // sizeQ * 2^30 * 2^{-53}. We always have sizeQ < 2^11, which means the
         // error is bounded by 1/4, and the rounding will be correct.
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.5;
-          NativeInteger intSum = 0, tmp;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmp = m_vectors[i][ri];
-
-            floatSum += static_cast<double>(tmp.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-
-            tmp.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
-                                  tQHatInvModqDivqModtPrecon[i]);
-            intSum.AddEqFast(tmp);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.5;
+            NativeInteger intSum = 0, tmp;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmp = m_vectors[i][ri];
+
+              floatSum += static_cast<double>(tmp.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+
+              tmp.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
+                                    tQHatInvModqDivqModtPrecon[i]);
+              intSum.AddEqFast(tmp);
+            }
+            intSum += static_cast<uint64_t>(floatSum);
+            // mod a power of two
+            coefficients[ri] = intSum.ConvertToInt() & tMinus1;
           }
-          intSum += static_cast<uint64_t>(floatSum);
-          // mod a power of two
-          coefficients[ri] = intSum.ConvertToInt() & tMinus1;
-        }
+        });
       }
     } else {
       usint qMSBHf = qMSB >> 1;
@@ -1926,58 +2270,60 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
         // we fit in 62 bits, so we can do multiplications and
         // additions without modulo reduction, and do modulo reduction
         // only once
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.5;
-          NativeInteger intSum = 0;
-          NativeInteger tmpHi, tmpLo;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmpLo = m_vectors[i][ri];
-            tmpHi = tmpLo.RShift(qMSBHf);
-            tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
-
-            floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-            floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
-                        tQHatInvModqDivqBFrac[i];
-
-            // No intermediate modulo reductions are needed in this case
-            tmpLo.MulEqFast(tQHatInvModqDivqModt[i]);
-            tmpHi.MulEqFast(tQHatInvModqBDivqModt[i]);
-            intSum.AddEqFast(tmpLo);
-            intSum.AddEqFast(tmpHi);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.5;
+            NativeInteger intSum = 0;
+            NativeInteger tmpHi, tmpLo;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmpLo = m_vectors[i][ri];
+              tmpHi = tmpLo.RShift(qMSBHf);
+              tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
+
+              floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+              floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
+                          tQHatInvModqDivqBFrac[i];
+
+              // No intermediate modulo reductions are needed in this case
+              tmpLo.MulEqFast(tQHatInvModqDivqModt[i]);
+              tmpHi.MulEqFast(tQHatInvModqBDivqModt[i]);
+              intSum.AddEqFast(tmpLo);
+              intSum.AddEqFast(tmpHi);
+            }
+            intSum += static_cast<uint64_t>(floatSum);
+            // mod a power of two
+            coefficients[ri] = intSum.ConvertToInt() & tMinus1;
           }
-          intSum += static_cast<uint64_t>(floatSum);
-          // mod a power of two
-          coefficients[ri] = intSum.ConvertToInt() & tMinus1;
-        }
+        });
       } else {
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.5;
-          NativeInteger intSum = 0;
-          NativeInteger tmpHi, tmpLo;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmpLo = m_vectors[i][ri];
-            tmpHi = tmpLo.RShift(qMSBHf);
-            tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
-
-            floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-            floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
-                        tQHatInvModqDivqBFrac[i];
-
-            tmpLo.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
-                                    tQHatInvModqDivqModtPrecon[i]);
-            tmpHi.ModMulFastConstEq(tQHatInvModqBDivqModt[i], t,
-                                    tQHatInvModqBDivqModtPrecon[i]);
-            intSum.AddEqFast(tmpLo);
-            intSum.AddEqFast(tmpHi);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.5;
+            NativeInteger intSum = 0;
+            NativeInteger tmpHi, tmpLo;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmpLo = m_vectors[i][ri];
+              tmpHi = tmpLo.RShift(qMSBHf);
+              tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
+
+              floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+              floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
+                          tQHatInvModqDivqBFrac[i];
+
+              tmpLo.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
+                                      tQHatInvModqDivqModtPrecon[i]);
+              tmpHi.ModMulFastConstEq(tQHatInvModqBDivqModt[i], t,
+                                      tQHatInvModqBDivqModtPrecon[i]);
+              intSum.AddEqFast(tmpLo);
+              intSum.AddEqFast(tmpHi);
+            }
+            intSum += static_cast<uint64_t>(floatSum);
+            // mod a power of two
+            coefficients[ri] = intSum.ConvertToInt() & tMinus1;
           }
-          intSum += static_cast<uint64_t>(floatSum);
-          // mod a power of two
-          coefficients[ri] = intSum.ConvertToInt() & tMinus1;
-        }
+        });
       }
     }
   } else {
@@ -1996,28 +2342,29 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
         // we fit in 52 bits, so we can do multiplications and
         // additions without modulo reduction, and do modulo reduction
         // only once using floating point techniques
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.0;
-          NativeInteger intSum = 0, tmp;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmp = m_vectors[i][ri];
-
-            floatSum += static_cast<double>(tmp.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-
-            // No intermediate modulo reductions are needed in this case
-            tmp.MulEqFast(tQHatInvModqDivqModt[i]);
-            intSum.AddEqFast(tmp);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.0;
+            NativeInteger intSum = 0, tmp;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmp = m_vectors[i][ri];
+
+              floatSum += static_cast<double>(tmp.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+
+              // No intermediate modulo reductions are needed in this case
+              tmp.MulEqFast(tQHatInvModqDivqModt[i]);
+              intSum.AddEqFast(tmp);
+            }
+            // compute modulo reduction by finding the quotient using doubles
+            // and then substracting quotient * t
+            floatSum += intSum.ConvertToInt();
+            uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
+            floatSum -= td * quot;
+            // rounding
+            coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
           }
-          // compute modulo reduction by finding the quotient using doubles
-          // and then substracting quotient * t
-          floatSum += intSum.ConvertToInt();
-          uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
-          floatSum -= td * quot;
-          // rounding
-          coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
-        }
+        });
       } else {
         // In case of qMSB + sizeQMSB >= 52 we decompose x_i in the basis
         // B=2^{qMSB/2} And split the sum \sum x_i*tQHatInvModqDivqFrac[i] to
@@ -2028,28 +2375,29 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
         // is bounded by 2^{-53}. Thus the floating point error is bounded by
         // sizeQ * 2^30 * 2^{-53}. We always have sizeQ < 2^11, which means the
         // error is bounded by 1/4, and the rounding will be correct.
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.0;
-          NativeInteger intSum = 0, tmp;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmp = m_vectors[i][ri];
-
-            floatSum += static_cast<double>(tmp.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-
-            tmp.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
-                                  tQHatInvModqDivqModtPrecon[i]);
-            intSum.AddEqFast(tmp);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.0;
+            NativeInteger intSum = 0, tmp;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmp = m_vectors[i][ri];
+
+              floatSum += static_cast<double>(tmp.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+
+              tmp.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
+                                    tQHatInvModqDivqModtPrecon[i]);
+              intSum.AddEqFast(tmp);
+            }
+            // compute modulo reduction by finding the quotient using doubles
+            // and then substracting quotient * t
+            floatSum += intSum.ConvertToInt();
+            uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
+            floatSum -= td * quot;
+            // rounding
+            coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
           }
-          // compute modulo reduction by finding the quotient using doubles
-          // and then substracting quotient * t
-          floatSum += intSum.ConvertToInt();
-          uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
-          floatSum -= td * quot;
-          // rounding
-          coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
-        }
+        });
       }
     } else {
       usint qMSBHf = qMSB >> 1;
@@ -2058,66 +2406,68 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
         // we fit in 52 bits, so we can do multiplications and
         // additions without modulo reduction, and do modulo reduction
         // only once using floating point techniques
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.0;
-          NativeInteger intSum = 0;
-          NativeInteger tmpHi, tmpLo;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmpLo = m_vectors[i][ri];
-            tmpHi = tmpLo.RShift(qMSBHf);
-            tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
-
-            floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-            floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
-                        tQHatInvModqDivqBFrac[i];
-
-            // No intermediate modulo reductions are needed in this case
-            tmpLo.MulEqFast(tQHatInvModqDivqModt[i]);
-            tmpHi.MulEqFast(tQHatInvModqBDivqModt[i]);
-            intSum.AddEqFast(tmpLo);
-            intSum.AddEqFast(tmpHi);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.0;
+            NativeInteger intSum = 0;
+            NativeInteger tmpHi, tmpLo;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmpLo = m_vectors[i][ri];
+              tmpHi = tmpLo.RShift(qMSBHf);
+              tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
+
+              floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+              floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
+                          tQHatInvModqDivqBFrac[i];
+
+              // No intermediate modulo reductions are needed in this case
+              tmpLo.MulEqFast(tQHatInvModqDivqModt[i]);
+              tmpHi.MulEqFast(tQHatInvModqBDivqModt[i]);
+              intSum.AddEqFast(tmpLo);
+              intSum.AddEqFast(tmpHi);
+            }
+            // compute modulo reduction by finding the quotient using doubles
+            // and then substracting quotient * t
+            floatSum += intSum.ConvertToInt();
+            uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
+            floatSum -= td * quot;
+            // rounding
+            coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
           }
-          // compute modulo reduction by finding the quotient using doubles
-          // and then substracting quotient * t
-          floatSum += intSum.ConvertToInt();
-          uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
-          floatSum -= td * quot;
-          // rounding
-          coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
-        }
+        });
       } else {
-#pragma omp parallel for
-        for (usint ri = 0; ri < ringDim; ri++) {
-          double floatSum = 0.0;
-          NativeInteger intSum = 0;
-          NativeInteger tmpHi, tmpLo;
-          for (usint i = 0; i < sizeQ; i++) {
-            tmpLo = m_vectors[i][ri];
-            tmpHi = tmpLo.RShift(qMSBHf);
-            tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
-
-            floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
-                        tQHatInvModqDivqFrac[i];
-            floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
-                        tQHatInvModqDivqBFrac[i];
-
-            tmpLo.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
-                                    tQHatInvModqDivqModtPrecon[i]);
-            tmpHi.ModMulFastConstEq(tQHatInvModqBDivqModt[i], t,
-                                    tQHatInvModqBDivqModtPrecon[i]);
-            intSum.AddEqFast(tmpLo);
-            intSum.AddEqFast(tmpHi);
+        ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+          for (usint ri = begin; ri < end; ri++) {
+            double floatSum = 0.0;
+            NativeInteger intSum = 0;
+            NativeInteger tmpHi, tmpLo;
+            for (usint i = 0; i < sizeQ; i++) {
+              tmpLo = m_vectors[i][ri];
+              tmpHi = tmpLo.RShift(qMSBHf);
+              tmpLo.SubEqFast(tmpHi.LShift(qMSBHf));
+
+              floatSum += static_cast<double>(tmpLo.ConvertToInt()) *
+                          tQHatInvModqDivqFrac[i];
+              floatSum += static_cast<double>(tmpHi.ConvertToInt()) *
+                          tQHatInvModqDivqBFrac[i];
+
+              tmpLo.ModMulFastConstEq(tQHatInvModqDivqModt[i], t,
+                                      tQHatInvModqDivqModtPrecon[i]);
+              tmpHi.ModMulFastConstEq(tQHatInvModqBDivqModt[i], t,
+                                      tQHatInvModqBDivqModtPrecon[i]);
+              intSum.AddEqFast(tmpLo);
+              intSum.AddEqFast(tmpHi);
+            }
+            // compute modulo reduction by finding the quotient using doubles
+            // and then substracting quotient * t
+            floatSum += intSum.ConvertToInt();
+            uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
+            floatSum -= td * quot;
+            // rounding
+            coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
           }
-          // compute modulo reduction by finding the quotient using doubles
-          // and then substracting quotient * t
-          floatSum += intSum.ConvertToInt();
-          uint64_t quot = static_cast<uint64_t>(floatSum * tInv);
-          floatSum -= td * quot;
-          // rounding
-          coefficients[ri] = static_cast<uint64_t>(floatSum + 0.5);
-        }
+        });
       }
     }
   }
@@ -2145,29 +2495,30 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxScaleAndRound(
   size_t sizeP = ans.m_vectors.size();
   size_t sizeQ = sizeQP - sizeP;
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    for (usint j = 0; j < sizeP; j++) {
-      DoubleNativeInt curValue = 0;
+  ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      for (usint j = 0; j < sizeP; j++) {
+        DoubleNativeInt curValue = 0;
 
-      const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
-      const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
-          tPSHatInvModsDivsModp[j];
+        const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
+        const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
+            tPSHatInvModsDivsModp[j];
 
-      for (usint i = 0; i < sizeQ; i++) {
-        const NativeInteger &xi = m_vectors[i][ri];
-        curValue +=
-            Mul128(xi.ConvertToInt(), tPSHatInvModsDivsModpj[i].ConvertToInt());
-      }
+        for (usint i = 0; i < sizeQ; i++) {
+          const NativeInteger &xi = m_vectors[i][ri];
+          curValue += Mul128(xi.ConvertToInt(),
+                             tPSHatInvModsDivsModpj[i].ConvertToInt());
+        }
 
-      const NativeInteger &xi = m_vectors[sizeQ + j][ri];
-      curValue += Mul128(xi.ConvertToInt(),
-                         tPSHatInvModsDivsModpj[sizeQ].ConvertToInt());
+        const NativeInteger &xi = m_vectors[sizeQ + j][ri];
+        curValue += Mul128(xi.ConvertToInt(),
+                           tPSHatInvModsDivsModpj[sizeQ].ConvertToInt());
 
-      ans.m_vectors[j][ri] =
-          BarrettUint128ModUint64(curValue, pj.ConvertToInt(), modpBarretMu[j]);
+        ans.m_vectors[j][ri] = BarrettUint128ModUint64(
+            curValue, pj.ConvertToInt(), modpBarretMu[j]);
+      }
     }
-  }
+  });
 
   return ans;
 }
@@ -2189,25 +2540,26 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxScaleAndRound(
     mu[j] = (paramsP->GetParams()[j]->GetModulus()).ComputeMu();
   }
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    for (usint j = 0; j < sizeP; j++) {
-      const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
-      const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
-          tPSHatInvModsDivsModp[j];
+  ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      for (usint j = 0; j < sizeP; j++) {
+        const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
+        const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
+            tPSHatInvModsDivsModp[j];
+
+        for (usint i = 0; i < sizeQ; i++) {
+          const NativeInteger &xi = m_vectors[i][ri];
+          const NativeInteger &pj = ans.m_vectors[j].GetModulus();
+          ans.m_vectors[j][ri].ModAddFastEq(
+              xi.ModMulFast(tPSHatInvModsDivsModpj[i], pj, mu[j]), pj);
+        }
 
-      for (usint i = 0; i < sizeQ; i++) {
-        const NativeInteger &xi = m_vectors[i][ri];
-        const NativeInteger &pj = ans.m_vectors[j].GetModulus();
+        const NativeInteger &xi = m_vectors[sizeQ + j][ri];
         ans.m_vectors[j][ri].ModAddFastEq(
-            xi.ModMulFast(tPSHatInvModsDivsModpj[i], pj, mu[j]), pj);
+            xi.ModMulFast(tPSHatInvModsDivsModpj[sizeQ], pj, mu[j]), pj);
       }
-
-      const NativeInteger &xi = m_vectors[sizeQ + j][ri];
-      ans.m_vectors[j][ri].ModAddFastEq(
-          xi.ModMulFast(tPSHatInvModsDivsModpj[sizeQ], pj, mu[j]), pj);
     }
-  }
+  });
 
   return ans;
 }
@@ -2227,41 +2579,42 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ScaleAndRound(
   size_t sizeP = ans.m_vectors.size();
   size_t sizeQ = sizeQP - sizeP;
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    double nu = 0.5;
+  ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      double nu = 0.5;
 
-    for (usint i = 0; i < sizeQ; i++) {
-      const NativeInteger &xi = m_vectors[i][ri];
-      nu += tPSHatInvModsDivsFrac[i] * xi.ConvertToInt();
-    }
+      for (usint i = 0; i < sizeQ; i++) {
+        const NativeInteger &xi = m_vectors[i][ri];
+        nu += tPSHatInvModsDivsFrac[i] * xi.ConvertToInt();
+      }
 
-    NativeInteger alpha = static_cast<uint64_t>(nu);
+      NativeInteger alpha = static_cast<uint64_t>(nu);
 
-    for (usint j = 0; j < sizeP; j++) {
-      DoubleNativeInt curValue = 0;
+      for (usint j = 0; j < sizeP; j++) {
+        DoubleNativeInt curValue = 0;
 
-      const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
-      const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
-          tPSHatInvModsDivsModp[j];
+        const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
+        const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
+            tPSHatInvModsDivsModp[j];
 
-      for (usint i = 0; i < sizeQ; i++) {
-        const NativeInteger &xi = m_vectors[i][ri];
-        curValue +=
-            Mul128(xi.ConvertToInt(), tPSHatInvModsDivsModpj[i].ConvertToInt());
-      }
+        for (usint i = 0; i < sizeQ; i++) {
+          const NativeInteger &xi = m_vectors[i][ri];
+          curValue += Mul128(xi.ConvertToInt(),
+                             tPSHatInvModsDivsModpj[i].ConvertToInt());
+        }
 
-      const NativeInteger &xi = m_vectors[sizeQ + j][ri];
-      curValue += Mul128(xi.ConvertToInt(),
-                         tPSHatInvModsDivsModpj[sizeQ].ConvertToInt());
+        const NativeInteger &xi = m_vectors[sizeQ + j][ri];
+        curValue += Mul128(xi.ConvertToInt(),
+                           tPSHatInvModsDivsModpj[sizeQ].ConvertToInt());
 
-      const NativeInteger &curNativeValue =
-          NativeInteger(BarrettUint128ModUint64(curValue, pj.ConvertToInt(),
-                                                modpBarretMu[j]));
+        const NativeInteger &curNativeValue =
+            NativeInteger(BarrettUint128ModUint64(curValue, pj.ConvertToInt(),
+                                                  modpBarretMu[j]));
 
-      ans.m_vectors[j][ri] = curNativeValue.ModAddFast(alpha, pj);
+        ans.m_vectors[j][ri] = curNativeValue.ModAddFast(alpha, pj);
+      }
     }
-  }
+  });
 
   return ans;
 }
@@ -2284,35 +2637,36 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ScaleAndRound(
     mu[j] = (paramsP->GetParams()[j]->GetModulus()).ComputeMu();
   }
 
-#pragma omp parallel for
-  for (usint ri = 0; ri < ringDim; ri++) {
-    double nu = 0.5;
+  ParallelForRange(0, ringDim, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint ri = begin; ri < end; ri++) {
+      double nu = 0.5;
 
-    for (usint i = 0; i < sizeQ; i++) {
-      const NativeInteger &xi = m_vectors[i][ri];
-      nu += tPSHatInvModsDivsFrac[i] * xi.ConvertToInt();
-    }
+      for (usint i = 0; i < sizeQ; i++) {
+        const NativeInteger &xi = m_vectors[i][ri];
+        nu += tPSHatInvModsDivsFrac[i] * xi.ConvertToInt();
+      }
 
-    NativeInteger alpha = static_cast<uint64_t>(nu);
+      NativeInteger alpha = static_cast<uint64_t>(nu);
 
-    for (usint j = 0; j < sizeP; j++) {
-      const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
-      const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
-          tPSHatInvModsDivsModp[j];
+      for (usint j = 0; j < sizeP; j++) {
+        const NativeInteger &pj = paramsP->GetParams()[j]->GetModulus();
+        const std::vector<NativeInteger> &tPSHatInvModsDivsModpj =
+            tPSHatInvModsDivsModp[j];
+
+        for (usint i = 0; i < sizeQ; i++) {
+          const NativeInteger &xi = m_vectors[i][ri];
+          const NativeInteger &pj = ans.m_vectors[j].GetModulus();
+          ans.m_vectors[j][ri].ModAddFastEq(
+              xi.ModMulFast(tPSHatInvModsDivsModpj[i], pj, mu[j]), pj);
+        }
 
-      for (usint i = 0; i < sizeQ; i++) {
-        const NativeInteger &xi = m_vectors[i][ri];
-        const NativeInteger &pj = ans.m_vectors[j].GetModulus();
+        const NativeInteger &xi = m_vectors[sizeQ + j][ri];
         ans.m_vectors[j][ri].ModAddFastEq(
-            xi.ModMulFast(tPSHatInvModsDivsModpj[i], pj, mu[j]), pj);
+            xi.ModMulFast(tPSHatInvModsDivsModpj[sizeQ], pj, mu[j]), pj);
+        ans.m_vectors[j][ri].ModAddFastEq(alpha, pj);
       }
-
-      const NativeInteger &xi = m_vectors[sizeQ + j][ri];
-      ans.m_vectors[j][ri].ModAddFastEq(
-          xi.ModMulFast(tPSHatInvModsDivsModpj[sizeQ], pj, mu[j]), pj);
-      ans.m_vectors[j][ri].ModAddFastEq(alpha, pj);
     }
-  }
+  });
 
   return ans;
 }
@@ -2333,30 +2687,31 @@ PolyImpl<NativeVector> DCRTPolyImpl<VecType>::ScaleAndRound(
 
   typename PolyType::Vector coefficients(n, t.ConvertToInt());
 
-#pragma omp parallel for
-  for (usint k = 0; k < n; k++) {
-    // TODO: use 64 bit words in case NativeInteger uses smaller word size
-    NativeInteger s = 0, tmp;
-    for (usint i = 0; i < sizeQ; i++) {
-      const NativeInteger &qi = moduliQ[i];
-      tmp = m_vectors[i][k];
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (usint k = begin; k < end; k++) {
+      // TODO: use 64 bit words in case NativeInteger uses smaller word size
+      NativeInteger s = 0, tmp;
+      for (usint i = 0; i < sizeQ; i++) {
+        const NativeInteger &qi = moduliQ[i];
+        tmp = m_vectors[i][k];
 
-      // xi*t*gamma*(q/qi)^-1 mod qi
-      tmp.ModMulFastConstEq(tgammaQHatModq[i], qi, tgammaQHatModqPrecon[i]);
+        // xi*t*gamma*(q/qi)^-1 mod qi
+        tmp.ModMulFastConstEq(tgammaQHatModq[i], qi, tgammaQHatModqPrecon[i]);
 
-      // -tmp/qi mod gamma*t < 2^58
-      tmp = tmp.ModMulFastConst(negInvqModtgamma[i], tgamma,
-                                negInvqModtgammaPrecon[i]);
+        // -tmp/qi mod gamma*t < 2^58
+        tmp = tmp.ModMulFastConst(negInvqModtgamma[i], tgamma,
+                                  negInvqModtgammaPrecon[i]);
 
-      s.ModAddFastEq(tmp, tgamma);
-    }
+        s.ModAddFastEq(tmp, tgamma);
+      }
 
-    // Compute s + s & (gamma-1)
-    s += NativeInteger(s.ConvertToInt() & gammaMinus1);
+      // Compute s + s & (gamma-1)
+      s += NativeInteger(s.ConvertToInt() & gammaMinus1);
 
-    // shift by log(gamma) to get the result
-    coefficients[k] = s >> 26;
-  }
+      // shift by log(gamma) to get the result
+      coefficients[k] = s >> 26;
+    }
+  });
 
   // Setting the root of unity to ONE as the calculation is expensive
   // It is assumed that no polynomial multiplications in evaluation
@@ -2417,40 +2772,38 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
     const NativeInteger &currentmtildeQHatInvModqPrecon =
         mtildeQHatInvModqPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      ximtildeQHatModqi[i * n + k] = m_vectors[i][k].ModMulFastConst(
-          currentmtildeQHatInvModq, moduliQ[i], currentmtildeQHatInvModqPrecon);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        ximtildeQHatModqi[i * n + k] =
+            m_vectors[i][k].ModMulFastConst(currentmtildeQHatInvModq,
+                                            moduliQ[i],
+                                            currentmtildeQHatInvModqPrecon);
+      }
+    });
   }
 
   // mod Bsk
+  std::vector<const NativeInteger *> x(numQ);
+  for (uint32_t i = 0; i < numQ; i++) x[i] = &ximtildeQHatModqi[i * n];
+  std::vector<NativeInteger *> y(numBsk);
   for (uint32_t j = 0; j < numBsk; j++) {
     PolyType newvec(m_params->GetParams()[j], m_format, true);
     m_vectors[numQ + j] = std::move(newvec);
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      DoubleNativeInt result = 0;
-      for (uint32_t i = 0; i < numQ; i++) {
-        const NativeInteger &QHatModbskij = QHatModbsk[i][j];
-        result += Mul128(ximtildeQHatModqi[i * n + k].ConvertToInt(),
-                         QHatModbskij.ConvertToInt());
-      }
-
-      m_vectors[numQ + j][k] = BarrettUint128ModUint64(
-          result, moduliBsk[j].ConvertToInt(), modbskBarrettMu[j]);
-    }
+    y[j] = &m_vectors[numQ + j][0];
   }
+  FastBaseConv(x, moduliQ, nullptr, nullptr, QHatModbsk, y, moduliBsk,
+               modbskBarrettMu, n);
 
   // mod mtilde = 2^16
   std::vector<uint16_t> result_mtilde(n);
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    result_mtilde[k] = 0;
-    for (uint32_t i = 0; i < numQ; i++)
-      result_mtilde[k] +=
-          ximtildeQHatModqi[i * n + k].ConvertToInt() * QHatModmtilde[i];
-  }
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      result_mtilde[k] = 0;
+      for (uint32_t i = 0; i < numQ; i++)
+        result_mtilde[k] +=
+            ximtildeQHatModqi[i * n + k].ConvertToInt() * QHatModmtilde[i];
+    }
+  });
 
   // now we have input in Basis (q U Bsk U mtilde)
   // next we perform Small Motgomery Reduction mod q
@@ -2460,30 +2813,32 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
   uint64_t mtilde = (uint64_t)1 << 16;
   uint64_t mtilde_half = mtilde >> 1;
 
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    result_mtilde[k] *= negQInvModmtilde;
-  }
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      result_mtilde[k] *= negQInvModmtilde;
+    }
+  });
 
   for (uint32_t i = 0; i < numBsk; i++) {
     const NativeInteger &currentqModBski = QModbsk[i];
     const NativeInteger &currentqModBskiPrecon = QModbskPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      NativeInteger r_m_tilde =
-          NativeInteger(result_mtilde[k]);  // mtilde = 2^16 < all moduli of Bsk
-      if (result_mtilde[k] >= mtilde_half)
-        r_m_tilde += moduliBsk[i] - mtilde;  // centred remainder
-
-      r_m_tilde.ModMulFastConstEq(
-          currentqModBski, moduliBsk[i],
-          currentqModBskiPrecon);  // (r_mtilde) * q mod Bski
-      r_m_tilde.ModAddFastEq(m_vectors[numQ + i][k],
-                             moduliBsk[i]);  // (c``_m + (r_mtilde* q)) mod Bski
-      m_vectors[numQ + i][k] = r_m_tilde.ModMulFastConst(
-          mtildeInvModbsk[i], moduliBsk[i], mtildeInvModbskPrecon[i]);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        // mtilde = 2^16 < all moduli of Bsk
+        NativeInteger r_m_tilde = NativeInteger(result_mtilde[k]);
+        if (result_mtilde[k] >= mtilde_half)
+          r_m_tilde += moduliBsk[i] - mtilde;  // centred remainder
+
+        r_m_tilde.ModMulFastConstEq(
+            currentqModBski, moduliBsk[i],
+            currentqModBskiPrecon);  // (r_mtilde) * q mod Bski
+        // (c``_m + (r_mtilde* q)) mod Bski
+        r_m_tilde.ModAddFastEq(m_vectors[numQ + i][k], moduliBsk[i]);
+        m_vectors[numQ + i][k] = r_m_tilde.ModMulFastConst(
+            mtildeInvModbsk[i], moduliBsk[i], mtildeInvModbskPrecon[i]);
+      }
+    });
   }
 
   // if the input polynomial was in evaluation representation, use the towers
@@ -2491,12 +2846,10 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
   if (polyInNTT.size() > 0) {
     for (size_t i = 0; i < numQ; i++) m_vectors[i] = polyInNTT[i];
   } else {  // else call NTT for the towers for q
-#pragma omp parallel for
-    for (size_t i = 0; i < numQ; i++) m_vectors[i].SwitchFormat();
+    PolyType::SwitchFormat(&m_vectors, 0, numQ);
   }
 
-#pragma omp parallel for
-  for (uint32_t i = 0; i < numBsk; i++) m_vectors[numQ + i].SwitchFormat();
+  PolyType::SwitchFormat(&m_vectors, numQ, numQ + numBsk);
 
   m_format = Format::EVALUATION;
 
@@ -2552,11 +2905,14 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
     const NativeInteger &currentmtildeQHatInvModqPrecon =
         mtildeQHatInvModqPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      ximtildeQHatModqi[i * n + k] = m_vectors[i][k].ModMulFastConst(
-          currentmtildeQHatInvModq, moduliQ[i], currentmtildeQHatInvModqPrecon);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        ximtildeQHatModqi[i * n + k] =
+            m_vectors[i][k].ModMulFastConst(currentmtildeQHatInvModq,
+                                            moduliQ[i],
+                                            currentmtildeQHatInvModqPrecon);
+      }
+    });
   }
 
   vector<NativeInteger> mu(numBsk);
@@ -2568,27 +2924,29 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
   for (uint32_t j = 0; j < numBsk; j++) {
     PolyType newvec(m_params->GetParams()[j], m_format, true);
     m_vectors[numQ + j] = std::move(newvec);
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      for (uint32_t i = 0; i < numQ; i++) {
-        const NativeInteger &QHatModbskij = QHatModbsk[i][j];
-        m_vectors[numQ + j][k].ModAddFastEq(
-            ximtildeQHatModqi[i * n + k].ModMulFast(QHatModbskij, moduliBsk[j],
-                                                    mu[j]),
-            moduliBsk[j]);
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        for (uint32_t i = 0; i < numQ; i++) {
+          const NativeInteger &QHatModbskij = QHatModbsk[i][j];
+          m_vectors[numQ + j][k].ModAddFastEq(
+              ximtildeQHatModqi[i * n + k].ModMulFast(QHatModbskij,
+                                                      moduliBsk[j], mu[j]),
+              moduliBsk[j]);
+        }
       }
-    }
+    });
   }
 
   // mod mtilde = 2^16
   std::vector<uint16_t> result_mtilde(n);
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    result_mtilde[k] = 0;
-    for (uint32_t i = 0; i < numQ; i++)
-      result_mtilde[k] +=
-          ximtildeQHatModqi[i * n + k].ConvertToInt() * QHatModmtilde[i];
-  }
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      result_mtilde[k] = 0;
+      for (uint32_t i = 0; i < numQ; i++)
+        result_mtilde[k] +=
+            ximtildeQHatModqi[i * n + k].ConvertToInt() * QHatModmtilde[i];
+    }
+  });
 
   // now we have input in Basis (q U Bsk U mtilde)
   // next we perform Small Motgomery Reduction mod q
@@ -2598,30 +2956,32 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
   uint64_t mtilde = (uint64_t)1 << 16;
   uint64_t mtilde_half = mtilde >> 1;
 
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    result_mtilde[k] *= negQInvModmtilde;
-  }
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      result_mtilde[k] *= negQInvModmtilde;
+    }
+  });
 
   for (uint32_t i = 0; i < numBsk; i++) {
     const NativeInteger &currentqModBski = QModbsk[i];
     const NativeInteger &currentqModBskiPrecon = QModbskPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      NativeInteger r_m_tilde =
-          NativeInteger(result_mtilde[k]);  // mtilde = 2^16 < all moduli of Bsk
-      if (result_mtilde[k] >= mtilde_half)
-        r_m_tilde += moduliBsk[i] - mtilde;  // centred remainder
-
-      r_m_tilde.ModMulFastConstEq(
-          currentqModBski, moduliBsk[i],
-          currentqModBskiPrecon);  // (r_mtilde) * q mod Bski
-      r_m_tilde.ModAddFastEq(m_vectors[numQ + i][k],
-                             moduliBsk[i]);  // (c``_m + (r_mtilde* q)) mod Bski
-      m_vectors[numQ + i][k] = r_m_tilde.ModMulFastConst(
-          mtildeInvModbsk[i], moduliBsk[i], mtildeInvModbskPrecon[i]);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        // mtilde = 2^16 < all moduli of Bsk
+        NativeInteger r_m_tilde = NativeInteger(result_mtilde[k]);
+        if (result_mtilde[k] >= mtilde_half)
+          r_m_tilde += moduliBsk[i] - mtilde;  // centred remainder
+
+        r_m_tilde.ModMulFastConstEq(
+            currentqModBski, moduliBsk[i],
+            currentqModBskiPrecon);  // (r_mtilde) * q mod Bski
+        // (c``_m + (r_mtilde* q)) mod Bski
+        r_m_tilde.ModAddFastEq(m_vectors[numQ + i][k], moduliBsk[i]);
+        m_vectors[numQ + i][k] = r_m_tilde.ModMulFastConst(
+            mtildeInvModbsk[i], moduliBsk[i], mtildeInvModbskPrecon[i]);
+      }
+    });
   }
 
   // if the input polynomial was in evaluation representation, use the towers
@@ -2629,12 +2989,10 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
   if (polyInNTT.size() > 0) {
     for (size_t i = 0; i < numQ; i++) m_vectors[i] = polyInNTT[i];
   } else {  // else call NTT for the towers for q
-#pragma omp parallel for
-    for (size_t i = 0; i < numQ; i++) m_vectors[i].SwitchFormat();
+    PolyType::SwitchFormat(&m_vectors, 0, numQ);
   }
 
-#pragma omp parallel for
-  for (uint32_t i = 0; i < numBsk; i++) m_vectors[numQ + i].SwitchFormat();
+  PolyType::SwitchFormat(&m_vectors, numQ, numQ + numBsk);
 
   m_format = EVALUATION;
 
@@ -2672,26 +3030,28 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
     const NativeInteger &currenttqDivqiModqi = tQHatInvModq[i];
     const NativeInteger &currenttqDivqiModqiPrecon = tQHatInvModqPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      // multiply by t*(q/qi)^-1 mod qi
-      m_vectors[i][k].ModMulFastConstEq(currenttqDivqiModqi, moduliQ[i],
-                                        currenttqDivqiModqiPrecon);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        // multiply by t*(q/qi)^-1 mod qi
+        m_vectors[i][k].ModMulFastConstEq(currenttqDivqiModqi, moduliQ[i],
+                                          currenttqDivqiModqiPrecon);
+      }
+    });
   }
 
   for (uint32_t j = 0; j < numBsk; j++) {
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      DoubleNativeInt aq = 0;
-      for (uint32_t i = 0; i < numQ; i++) {
-        const NativeInteger &InvqiModBjValue = qInvModbsk[i][j];
-        NativeInteger &xi = m_vectors[i][k];
-        aq += Mul128(xi.ConvertToInt(), InvqiModBjValue.ConvertToInt());
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        DoubleNativeInt aq = 0;
+        for (uint32_t i = 0; i < numQ; i++) {
+          const NativeInteger &InvqiModBjValue = qInvModbsk[i][j];
+          NativeInteger &xi = m_vectors[i][k];
+          aq += Mul128(xi.ConvertToInt(), InvqiModBjValue.ConvertToInt());
+        }
+        txiqiDivqModqi[j * n + k] = BarrettUint128ModUint64(
+            aq, moduliBsk[j].ConvertToInt(), modbskBarrettMu[j]);
       }
-      txiqiDivqModqi[j * n + k] = BarrettUint128ModUint64(
-          aq, moduliBsk[j].ConvertToInt(), modbskBarrettMu[j]);
-    }
+    });
   }
 
   // now we have FastBaseConv( |t*ct|q, q, Bsk ) in txiqiDivqModqi
@@ -2699,14 +3059,15 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
   for (uint32_t i = 0; i < numBsk; i++) {
     const NativeInteger &currenttDivqModBski = tQInvModbsk[i];
     const NativeInteger &currenttDivqModBskiPrecon = tQInvModbskPrecon[i];
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      // Not worthy to use lazy reduction here
-      m_vectors[i + numQ][k].ModMulFastConstEq(
-          currenttDivqModBski, moduliBsk[i], currenttDivqModBskiPrecon);
-      m_vectors[i + numQ][k].ModSubFastEq(txiqiDivqModqi[i * n + k],
-                                          moduliBsk[i]);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        // Not worthy to use lazy reduction here
+        m_vectors[i + numQ][k].ModMulFastConstEq(
+            currenttDivqModBski, moduliBsk[i], currenttDivqModBskiPrecon);
+        m_vectors[i + numQ][k].ModSubFastEq(txiqiDivqModqi[i * n + k],
+                                            moduliBsk[i]);
+      }
+    });
   }
   delete[] txiqiDivqModqi;
   txiqiDivqModqi = nullptr;
@@ -2741,12 +3102,13 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
     const NativeInteger &currenttqDivqiModqi = tQHatInvModq[i];
     const NativeInteger &currenttqDivqiModqiPrecon = tQHatInvModqPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      // multiply by t*(q/qi)^-1 mod qi
-      m_vectors[i][k].ModMulFastConstEq(currenttqDivqiModqi, moduliQ[i],
-                                        currenttqDivqiModqiPrecon);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        // multiply by t*(q/qi)^-1 mod qi
+        m_vectors[i][k].ModMulFastConstEq(currenttqDivqiModqi, moduliQ[i],
+                                          currenttqDivqiModqiPrecon);
+      }
+    });
   }
 
   vector<NativeInteger> mu(numBsk);
@@ -2755,15 +3117,17 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
   }
 
   for (uint32_t j = 0; j < numBsk; j++) {
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      for (uint32_t i = 0; i < numQ; i++) {
-        const NativeInteger &InvqiModBjValue = qInvModbsk[i][j];
-        NativeInteger &xi = m_vectors[i][k];
-        txiqiDivqModqi[j * n + k].ModAddFastEq(
-            xi.ModMulFast(InvqiModBjValue, moduliBsk[j], mu[j]), moduliBsk[j]);
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        for (uint32_t i = 0; i < numQ; i++) {
+          const NativeInteger &InvqiModBjValue = qInvModbsk[i][j];
+          NativeInteger &xi = m_vectors[i][k];
+          txiqiDivqModqi[j * n + k].ModAddFastEq(
+              xi.ModMulFast(InvqiModBjValue, moduliBsk[j], mu[j]),
+              moduliBsk[j]);
+        }
       }
-    }
+    });
   }
 
   // now we have FastBaseConv( |t*ct|q, q, Bsk ) in txiqiDivqModqi
@@ -2771,14 +3135,15 @@ void DCRTPolyImpl<VecType>::FastRNSFloorq(
   for (uint32_t i = 0; i < numBsk; i++) {
     const NativeInteger &currenttDivqModBski = tQInvModbsk[i];
     const NativeInteger &currenttDivqModBskiPrecon = tQInvModbskPrecon[i];
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      // Not worthy to use lazy reduction here
-      m_vectors[i + numQ][k].ModMulFastConstEq(
-          currenttDivqModBski, moduliBsk[i], currenttDivqModBskiPrecon);
-      m_vectors[i + numQ][k].ModSubFastEq(txiqiDivqModqi[i * n + k],
-                                          moduliBsk[i]);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        // Not worthy to use lazy reduction here
+        m_vectors[i + numQ][k].ModMulFastConstEq(
+            currenttDivqModBski, moduliBsk[i], currenttDivqModBskiPrecon);
+        m_vectors[i + numQ][k].ModSubFastEq(txiqiDivqModqi[i * n + k],
+                                            moduliBsk[i]);
+      }
+    });
   }
   delete[] txiqiDivqModqi;
   txiqiDivqModqi = nullptr;
@@ -2811,51 +3176,42 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
   for (uint32_t i = 0; i < sizeBsk - 1; i++) {  // exclude msk residue
     const NativeInteger &currentBDivBiModBi = BHatInvModb[i];
     const NativeInteger &currentBDivBiModBiPrecon = BHatInvModbPrecon[i];
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      m_vectors[sizeQ + i][k].ModMulFastConstEq(
-          currentBDivBiModBi, moduliBsk[i], currentBDivBiModBiPrecon);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        m_vectors[sizeQ + i][k].ModMulFastConstEq(
+            currentBDivBiModBi, moduliBsk[i], currentBDivBiModBiPrecon);
+      }
+    });
   }
 
-  for (uint32_t j = 0; j < sizeQ; j++) {
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      DoubleNativeInt result = 0;
-      for (uint32_t i = 0; i < sizeBsk - 1; i++) {  // exclude msk residue
-        const NativeInteger &currentBDivBiModqj = BHatModq[i][j];
-        const NativeInteger &xi = m_vectors[sizeQ + i][k];
-        result += Mul128(xi.ConvertToInt(), currentBDivBiModqj.ConvertToInt());
-      }
-      m_vectors[j][k] = BarrettUint128ModUint64(
-          result, moduliQ[j].ConvertToInt(), modqBarrettMu[j]);
-    }
+  std::vector<const NativeInteger *> x(sizeBsk - 1);  // exclude msk residue
+  std::vector<NativeInteger> moduliB(sizeBsk - 1);
+  for (uint32_t i = 0; i < sizeBsk - 1; i++) {
+    x[i] = &m_vectors[sizeQ + i][0];
+    moduliB[i] = moduliBsk[i];
   }
+  std::vector<NativeInteger *> y(sizeQ);
+  for (uint32_t j = 0; j < sizeQ; j++) y[j] = &m_vectors[j][0];
+  FastBaseConv(x, moduliB, nullptr, nullptr, BHatModq, y, moduliQ,
+               modqBarrettMu, n);
 
   // calculate alphaskx
   // FastBaseConv(x, B, msk)
   NativeInteger *alphaskxVector = new NativeInteger[n];
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    DoubleNativeInt result = 0;
-    for (uint32_t i = 0; i < sizeBsk - 1; i++) {
-      const NativeInteger &currentBDivBiModmsk = BHatModmsk[i];
-      result += Mul128(m_vectors[sizeQ + i][k].ConvertToInt(),
-                       currentBDivBiModmsk.ConvertToInt());
-    }
-    alphaskxVector[k] =
-        BarrettUint128ModUint64(result, moduliBsk[sizeBsk - 1].ConvertToInt(),
-                                modbskBarrettMu[sizeBsk - 1]);
-  }
+  std::vector<std::vector<NativeInteger>> BHatModmskCol(sizeBsk - 1);
+  for (uint32_t i = 0; i < sizeBsk - 1; i++) BHatModmskCol[i] = {BHatModmsk[i]};
+  FastBaseConv(x, moduliB, nullptr, nullptr, BHatModmskCol, {alphaskxVector},
+               {moduliBsk[sizeBsk - 1]}, {modbskBarrettMu[sizeBsk - 1]}, n);
 
   // subtract xsk
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    alphaskxVector[k] = alphaskxVector[k].ModSubFast(
-        m_vectors[sizeQ + sizeBsk - 1][k], moduliBsk[sizeBsk - 1]);
-    alphaskxVector[k].ModMulFastConstEq(BInvModmsk, moduliBsk[sizeBsk - 1],
-                                        BInvModmskPrecon);
-  }
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      alphaskxVector[k] = alphaskxVector[k].ModSubFast(
+          m_vectors[sizeQ + sizeBsk - 1][k], moduliBsk[sizeBsk - 1]);
+      alphaskxVector[k].ModMulFastConstEq(BInvModmsk, moduliBsk[sizeBsk - 1],
+                                          BInvModmskPrecon);
+    }
+  });
 
   // do (m_vector - alphaskx*M) mod q
   NativeInteger mskDivTwo = moduliBsk[sizeBsk - 1] / 2;
@@ -2863,17 +3219,18 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
     const NativeInteger &currentBModqi = BModq[i];
     const NativeInteger &currentBModqiPrecon = BModqPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      NativeInteger alphaskBModqi = alphaskxVector[k];
-      if (alphaskBModqi > mskDivTwo)
-        alphaskBModqi =
-            alphaskBModqi.ModSubFast(moduliBsk[sizeBsk - 1], moduliQ[i]);
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        NativeInteger alphaskBModqi = alphaskxVector[k];
+        if (alphaskBModqi > mskDivTwo)
+          alphaskBModqi =
+              alphaskBModqi.ModSubFast(moduliBsk[sizeBsk - 1], moduliQ[i]);
 
-      alphaskBModqi.ModMulFastConstEq(currentBModqi, moduliQ[i],
-                                      currentBModqiPrecon);
-      m_vectors[i][k] = m_vectors[i][k].ModSubFast(alphaskBModqi, moduliQ[i]);
-    }
+        alphaskBModqi.ModMulFastConstEq(currentBModqi, moduliQ[i],
+                                        currentBModqiPrecon);
+        m_vectors[i][k] = m_vectors[i][k].ModSubFast(alphaskBModqi, moduliQ[i]);
+      }
+    });
   }
 
   // drop extra vectors
@@ -2922,11 +3279,12 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
   for (uint32_t i = 0; i < sizeBsk - 1; i++) {  // exclude msk residue
     const NativeInteger &currentBDivBiModBi = BHatInvModb[i];
     const NativeInteger &currentBDivBiModBiPrecon = BHatInvModbPrecon[i];
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      m_vectors[sizeQ + i][k].ModMulFastConstEq(
-          currentBDivBiModBi, moduliBsk[i], currentBDivBiModBiPrecon);
-    }
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        m_vectors[sizeQ + i][k].ModMulFastConstEq(
+            currentBDivBiModBi, moduliBsk[i], currentBDivBiModBiPrecon);
+      }
+    });
   }
 
   vector<NativeInteger> mu(sizeQ);
@@ -2935,16 +3293,17 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
   }
 
   for (uint32_t j = 0; j < sizeQ; j++) {
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      m_vectors[j][k] = NativeInteger(0);
-      for (uint32_t i = 0; i < sizeBsk - 1; i++) {  // exclude msk residue
-        const NativeInteger &currentBDivBiModqj = BHatModq[i][j];
-        const NativeInteger &xi = m_vectors[sizeQ + i][k];
-        m_vectors[j][k].ModAddFastEq(
-            xi.ModMulFast(currentBDivBiModqj, moduliQ[j], mu[j]), moduliQ[j]);
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        m_vectors[j][k] = NativeInteger(0);
+        for (uint32_t i = 0; i < sizeBsk - 1; i++) {  // exclude msk residue
+          const NativeInteger &currentBDivBiModqj = BHatModq[i][j];
+          const NativeInteger &xi = m_vectors[sizeQ + i][k];
+          m_vectors[j][k].ModAddFastEq(
+              xi.ModMulFast(currentBDivBiModqj, moduliQ[j], mu[j]), moduliQ[j]);
+        }
       }
-    }
+    });
   }
 
   NativeInteger muBsk = moduliBsk[sizeBsk - 1].ComputeMu();
@@ -2952,26 +3311,28 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
   // calculate alphaskx
   // FastBaseConv(x, B, msk)
   NativeInteger *alphaskxVector = new NativeInteger[n];
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    for (uint32_t i = 0; i < sizeBsk - 1; i++) {
-      const NativeInteger &currentBDivBiModmsk = BHatModmsk[i];
-      // changed from ModAddFastEq to ModAddEq
-      alphaskxVector[k].ModAddEq(
-          m_vectors[sizeQ + i][k].ModMul(currentBDivBiModmsk,
-                                         moduliBsk[sizeBsk - 1], muBsk),
-          moduliBsk[sizeBsk - 1]);
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      for (uint32_t i = 0; i < sizeBsk - 1; i++) {
+        const NativeInteger &currentBDivBiModmsk = BHatModmsk[i];
+        // changed from ModAddFastEq to ModAddEq
+        alphaskxVector[k].ModAddEq(
+            m_vectors[sizeQ + i][k].ModMul(currentBDivBiModmsk,
+                                           moduliBsk[sizeBsk - 1], muBsk),
+            moduliBsk[sizeBsk - 1]);
+      }
     }
-  }
+  });
 
   // subtract xsk
-#pragma omp parallel for
-  for (uint32_t k = 0; k < n; k++) {
-    alphaskxVector[k] = alphaskxVector[k].ModSubFast(
-        m_vectors[sizeQ + sizeBsk - 1][k], moduliBsk[sizeBsk - 1]);
-    alphaskxVector[k].ModMulFastConstEq(BInvModmsk, moduliBsk[sizeBsk - 1],
-                                        BInvModmskPrecon);
-  }
+  ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+    for (uint32_t k = begin; k < end; k++) {
+      alphaskxVector[k] = alphaskxVector[k].ModSubFast(
+          m_vectors[sizeQ + sizeBsk - 1][k], moduliBsk[sizeBsk - 1]);
+      alphaskxVector[k].ModMulFastConstEq(BInvModmsk, moduliBsk[sizeBsk - 1],
+                                          BInvModmskPrecon);
+    }
+  });
 
   // do (m_vector - alphaskx*M) mod q
   NativeInteger mskDivTwo = moduliBsk[sizeBsk - 1] / 2;
@@ -2979,17 +3340,18 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
     const NativeInteger &currentBModqi = BModq[i];
     const NativeInteger &currentBModqiPrecon = BModqPrecon[i];
 
-#pragma omp parallel for
-    for (uint32_t k = 0; k < n; k++) {
-      NativeInteger alphaskBModqi = alphaskxVector[k];
-      if (alphaskBModqi > mskDivTwo)
-        alphaskBModqi =
-            alphaskBModqi.ModSubFast(moduliBsk[sizeBsk - 1], moduliQ[i]);
+    ParallelForRange(0, n, COEF_GRAIN, [&](size_t begin, size_t end) {
+      for (uint32_t k = begin; k < end; k++) {
+        NativeInteger alphaskBModqi = alphaskxVector[k];
+        if (alphaskBModqi > mskDivTwo)
+          alphaskBModqi =
+              alphaskBModqi.ModSubFast(moduliBsk[sizeBsk - 1], moduliQ[i]);
 
-      alphaskBModqi.ModMulFastConstEq(currentBModqi, moduliQ[i],
-                                      currentBModqiPrecon);
-      m_vectors[i][k] = m_vectors[i][k].ModSubFast(alphaskBModqi, moduliQ[i]);
-    }
+        alphaskBModqi.ModMulFastConstEq(currentBModqi, moduliQ[i],
+                                        currentBModqiPrecon);
+        m_vectors[i][k] = m_vectors[i][k].ModSubFast(alphaskBModqi, moduliQ[i]);
+      }
+    });
   }
 
   // drop extra vectors
@@ -3014,7 +3376,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
 }
 #endif
 
-/*Switch format calls IlVector2n's switchformat*/
+/*Switch format transforms all towers in one batched pass*/
 template <typename VecType>
 void DCRTPolyImpl<VecType>::SwitchFormat() {
   if (m_format == Format::COEFFICIENT) {
@@ -3023,10 +3385,7 @@ void DCRTPolyImpl<VecType>::SwitchFormat() {
     m_format = Format::COEFFICIENT;
   }
 
-#pragma omp parallel for
-  for (usint i = 0; i < m_vectors.size(); i++) {
-    m_vectors[i].SwitchFormat();
-  }
+  PolyType::SwitchFormat(&m_vectors, 0, m_vectors.size());
 }
 
 #ifdef OUT
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <fstream>
 #include "lattice/backend.h"
+#include "utils/scheduler.h"
 
 #define DEMANGLER  // used for the demangling type namefunction.
 
@@ -65,6 +66,17 @@ PolyImpl<VecType>::PolyImpl(const shared_ptr<PolyImpl::Params> params,
   }
 }
 
+template <typename VecType>
+PolyImpl<VecType>::PolyImpl(const shared_ptr<PolyImpl::Params> params,
+                            Format format, VecType &&values)
+    : m_format(format), m_params(params) {
+  if (m_params->GetRingDimension() != values.GetLength() ||
+      m_params->GetModulus() != values.GetModulus()) {
+    PALISADE_THROW(type_error, "Parameter mismatch on PolyImpl constructor");
+  }
+  m_values = make_unique<VecType>(std::move(values));
+}
+
 template <typename VecType>
 PolyImpl<VecType>::PolyImpl(bool initializeElementToMax,
                             const shared_ptr<PolyImpl::Params> params,
@@ -853,6 +865,94 @@ void PolyImpl<VecType>::SwitchFormat() {
   }
 }
 
+template <typename VecType>
+void PolyImpl<VecType>::SwitchFormat(std::vector<PolyImpl> *elements,
+                                     usint first, usint last) {
+  if (first >= last) {
+    return;
+  }
+
+  std::vector<PolyImpl> &polys = *elements;
+  Format format = polys[first].m_format;
+  usint cycloOrder = polys[first].GetCyclotomicOrder();
+  bool batch = true;
+  for (usint i = first; i < last; i++) {
+    if (polys[i].m_values == nullptr) {
+      std::string errMsg = "Poly switch format to empty values";
+      PALISADE_THROW(not_available_error, errMsg);
+    }
+    if (polys[i].m_format != format ||
+        polys[i].GetCyclotomicOrder() != cycloOrder ||
+        !polys[i].m_params->OrderIsPowerOfTwo()) {
+      batch = false;
+    }
+  }
+
+  if (!batch) {
+    ParallelFor(first, last, [&](size_t i) {
+      polys[i].SwitchFormat();
+    });
+    return;
+  }
+
+  // the tables of each tower are cached on its parameters, so the map lookups
+  // of ChineseRemainderTransformFTT are only done once per set of parameters
+  using CRT = ChineseRemainderTransformFTT<VecType>;
+  std::vector<std::shared_ptr<const bigintnat::NativeNTTTables>> resolved;
+  std::vector<const bigintnat::NativeNTTTables *> tables;
+  std::vector<VecType *> values;
+  resolved.reserve(last - first);
+  tables.reserve(last - first);
+  values.reserve(last - first);
+  for (usint i = first; i < last; i++) {
+    const Params &params = *polys[i].m_params;
+    auto cached = params.GetNativeNTTTables();
+    if (cached == nullptr ||
+        !CRT::IsCurrent(*cached, params.GetRootOfUnity(), cycloOrder,
+                        params.GetModulus())) {
+      cached = CRT::GetNativeTables(params.GetRootOfUnity(), cycloOrder,
+                                    params.GetModulus());
+      if (cached == nullptr) {
+        batch = false;
+        break;
+      }
+      params.SetNativeNTTTables(cached);
+    }
+    resolved.push_back(cached);
+    tables.push_back(cached.get());
+    values.push_back(polys[i].m_values.get());
+  }
+
+  if (batch) {
+    if (format == Format::COEFFICIENT) {
+      CRT::ForwardTransformToBitReverseInPlace(tables, values);
+    } else {
+      CRT::InverseTransformFromBitReverseInPlace(tables, values);
+    }
+  } else {
+    std::vector<Integer> rootOfUnity;
+    values.clear();
+    rootOfUnity.reserve(last - first);
+    for (usint i = first; i < last; i++) {
+      rootOfUnity.push_back(polys[i].GetRootOfUnity());
+      values.push_back(polys[i].m_values.get());
+    }
+    if (format == Format::COEFFICIENT) {
+      CRT::ForwardTransformToBitReverseInPlace(rootOfUnity, cycloOrder,
+                                               values);
+    } else {
+      CRT::InverseTransformFromBitReverseInPlace(rootOfUnity, cycloOrder,
+                                                 values);
+    }
+  }
+  format = (format == Format::COEFFICIENT) ? Format::EVALUATION
+                                           : Format::COEFFICIENT;
+
+  for (usint i = first; i < last; i++) {
+    polys[i].m_format = format;
+  }
+}
+
 template <typename VecType>
 void PolyImpl<VecType>::ArbitrarySwitchFormat() {
   DEBUG_FLAG(false);
@@ -24,6 +24,7 @@
 
 #include "math/backend.h"
 #include "math/bigintnat/mubintvecnat.h"
+#include "math/bigintnat/vecopsnat.h"
 #include "math/nbtheory.h"
 #include "utils/debug.h"
 #include "utils/serializable.h"
@@ -56,6 +57,23 @@ NativeVector<IntegerType>::NativeVector(usint length,
   this->m_data.resize(length);
 }
 
+template <class IntegerType>
+NativeVector<IntegerType>::NativeVector(
+    usint length, const IntegerType &modulus,
+    std::shared_ptr<lbcrypto::LimbBuffer> buffer)
+#if BLOCK_VECTOR_ALLOCATION != 1
+    : m_data(lbcrypto::LimbAllocator<IntegerType>(std::move(buffer)))
+#endif
+{
+  if (modulus.GetMSB() > MAX_MODULUS_SIZE) {
+    PALISADE_THROW(lbcrypto::not_available_error,
+                   "NativeVector supports only modulus size <=  " +
+                       std::to_string(MAX_MODULUS_SIZE) + " bits");
+  }
+  this->SetModulus(modulus);
+  this->m_data.resize(length);
+}
+
 template <class IntegerType>
 NativeVector<IntegerType>::NativeVector(const NativeVector &bigVector) {
   m_modulus = bigVector.m_modulus;
@@ -235,6 +253,86 @@ const IntegerType &NativeVector<IntegerType>::GetModulus() const {
 
 // MODULAR ARITHMETIC OPERATIONS
 
+// 64-bit native vectors are routed to the SIMD kernels of
+// bigintnat::NativeVectorOps; all other integer types use the loops below.
+template <class IntegerType>
+inline bool SIMDModAddEq(NativeVector<IntegerType> *a,
+                         const NativeVector<IntegerType> &b) {
+  return false;
+}
+
+template <class IntegerType>
+inline bool SIMDModSubEq(NativeVector<IntegerType> *a,
+                         const NativeVector<IntegerType> &b) {
+  return false;
+}
+
+template <class IntegerType>
+inline bool SIMDModMulEq(NativeVector<IntegerType> *a,
+                         const NativeVector<IntegerType> &b) {
+  return false;
+}
+
+template <class IntegerType>
+inline bool SIMDModMulConstEq(NativeVector<IntegerType> *a,
+                              const IntegerType &b, const IntegerType &bPrec) {
+  return false;
+}
+
+#if NATIVEINT == 64
+typedef NativeVector<NativeIntegerT<uint64_t>> NativeVectorU64;
+
+inline bool SIMDModAddEq(NativeVectorU64 *a, const NativeVectorU64 &b) {
+  usint n = a->GetLength();
+  uint64_t modulus = a->GetModulus().ConvertToInt();
+  if (n == 0 || !NativeVectorOps::IsSupportedModulus(modulus)) {
+    return false;
+  }
+  NativeVectorOps::ModAddEq(reinterpret_cast<uint64_t *>(&a->at(0)),
+                            reinterpret_cast<const uint64_t *>(&b.at(0)), n,
+                            modulus);
+  return true;
+}
+
+inline bool SIMDModSubEq(NativeVectorU64 *a, const NativeVectorU64 &b) {
+  usint n = a->GetLength();
+  uint64_t modulus = a->GetModulus().ConvertToInt();
+  if (n == 0 || !NativeVectorOps::IsSupportedModulus(modulus)) {
+    return false;
+  }
+  NativeVectorOps::ModSubEq(reinterpret_cast<uint64_t *>(&a->at(0)),
+                            reinterpret_cast<const uint64_t *>(&b.at(0)), n,
+                            modulus);
+  return true;
+}
+
+inline bool SIMDModMulEq(NativeVectorU64 *a, const NativeVectorU64 &b) {
+  usint n = a->GetLength();
+  uint64_t modulus = a->GetModulus().ConvertToInt();
+  if (n == 0 || !NativeVectorOps::IsSupportedModulus(modulus)) {
+    return false;
+  }
+  NativeVectorOps::ModMulEq(reinterpret_cast<uint64_t *>(&a->at(0)),
+                            reinterpret_cast<const uint64_t *>(&b.at(0)), n,
+                            modulus);
+  return true;
+}
+
+inline bool SIMDModMulConstEq(NativeVectorU64 *a,
+                              const NativeIntegerT<uint64_t> &b,
+                              const NativeIntegerT<uint64_t> &bPrec) {
+  usint n = a->GetLength();
+  uint64_t modulus = a->GetModulus().ConvertToInt();
+  if (n == 0 || !NativeVectorOps::IsSupportedModulus(modulus)) {
+    return false;
+  }
+  NativeVectorOps::ModMulConstEq(reinterpret_cast<uint64_t *>(&a->at(0)), n,
+                                 modulus, b.ConvertToInt(),
+                                 bPrec.ConvertToInt());
+  return true;
+}
+#endif
+
 template <class IntegerType>
 NativeVector<IntegerType> NativeVector<IntegerType>::Mod(
     const IntegerType &modulus) const {
@@ -338,6 +436,9 @@ NativeVector<IntegerType> NativeVector<IntegerType>::ModAdd(
         "ModAdd called on NativeVector's with different parameters.");
   }
   NativeVector ans(*this);
+  if (SIMDModAddEq(&ans, b)) {
+    return ans;
+  }
   IntegerType modulus = this->m_modulus;
   for (usint i = 0; i < ans.m_data.size(); i++) {
     ans.m_data[i].ModAddFastEq(b[i], modulus);
@@ -354,6 +455,9 @@ const NativeVector<IntegerType> &NativeVector<IntegerType>::ModAddEq(
         lbcrypto::math_error,
         "ModAddEq called on NativeVector's with different parameters.");
   }
+  if (SIMDModAddEq(this, b)) {
+    return *this;
+  }
   IntegerType modulus = this->m_modulus;
   for (usint i = 0; i < this->m_data.size(); i++) {
     this->m_data[i].ModAddFastEq(b[i], modulus);
@@ -390,6 +494,9 @@ NativeVector<IntegerType> NativeVector<IntegerType>::ModSub(
         "ModSub called on NativeVector's with different parameters.");
   }
   NativeVector ans(*this);
+  if (SIMDModSubEq(&ans, b)) {
+    return ans;
+  }
   for (usint i = 0; i < ans.m_data.size(); i++) {
     ans.m_data[i].ModSubFastEq(b.m_data[i], this->m_modulus);
   }
@@ -405,6 +512,9 @@ const NativeVector<IntegerType> &NativeVector<IntegerType>::ModSubEq(
         lbcrypto::math_error,
         "ModSubEq called on NativeVector's with different parameters.");
   }
+  if (SIMDModSubEq(this, b)) {
+    return *this;
+  }
   for (usint i = 0; i < this->m_data.size(); i++) {
     this->m_data[i].ModSubFastEq(b.m_data[i], this->m_modulus);
   }
@@ -421,6 +531,9 @@ NativeVector<IntegerType> NativeVector<IntegerType>::ModMul(
     bLocal.ModEq(modulus);
   }
   IntegerType bPrec = bLocal.PrepModMulConst(modulus);
+  if (SIMDModMulConstEq(&ans, bLocal, bPrec)) {
+    return ans;
+  }
   for (usint i = 0; i < this->m_data.size(); i++) {
     ans.m_data[i].ModMulFastConstEq(bLocal, modulus, bPrec);
   }
@@ -436,6 +549,9 @@ const NativeVector<IntegerType> &NativeVector<IntegerType>::ModMulEq(
     bLocal.ModEq(modulus);
   }
   IntegerType bPrec = bLocal.PrepModMulConst(modulus);
+  if (SIMDModMulConstEq(this, bLocal, bPrec)) {
+    return *this;
+  }
   for (usint i = 0; i < this->m_data.size(); i++) {
     this->m_data[i].ModMulFastConstEq(bLocal, modulus, bPrec);
   }
@@ -461,6 +577,9 @@ NativeVector<IntegerType> NativeVector<IntegerType>::ModMul(
   return ans;
 #endif
 
+  if (SIMDModMulEq(&ans, b)) {
+    return ans;
+  }
   IntegerType modulus = this->m_modulus;
   IntegerType mu = modulus.ComputeMu();
   for (usint i = 0; i < this->m_data.size(); i++) {
@@ -487,6 +606,9 @@ const NativeVector<IntegerType> &NativeVector<IntegerType>::ModMulEq(
   return *this;
 #endif
 
+  if (SIMDModMulEq(this, b)) {
+    return *this;
+  }
   IntegerType modulus = this->m_modulus;
   IntegerType mu = modulus.ComputeMu();
   for (usint i = 0; i < this->m_data.size(); i++) {
@@ -0,0 +1,483 @@
+// @file nttnat.cpp This file contains the lazy-reduction number theoretic
+// transform kernels for 64-bit native vectors.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "math/bigintnat/nttnat.h"
+
+#include "math/bigintnat/simdnat.h"
+#include "utils/parallel.h"
+#include "utils/scheduler.h"
+
+#ifdef PALISADE_X86_SIMD
+// GCC flags the placeholder operand of the AVX-512 broadcast intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#endif
+
+namespace bigintnat {
+
+// Every kernel below works on "rows": in a stage with m twiddles and
+// butterfly distance t, row i pairs a[2it + j] with a[2it + t + j] for
+// j in [0, t) using the twiddle w[m + i]. Restricting the rows and the range
+// of j lets the same kernels run a whole transform, the stages of one
+// independent block, or a slice of a single stage.
+
+/// SCALAR KERNELS
+
+// forward butterflies, [0, 4q) -> [0, 4q)
+static void ForwardRowsScalar(uint64_t* a, usint m, usint t, usint iBegin,
+                              usint iEnd, usint jBegin, usint jEnd, uint64_t q,
+                              const uint64_t* w, const uint64_t* wPrecon) {
+  const uint64_t twoq = q << 1;
+  for (usint i = iBegin; i < iEnd; ++i) {
+    const uint64_t omega = w[m + i];
+    const uint64_t preconOmega = wPrecon[m + i];
+    uint64_t* loPtr = a + ((2 * i) * t);
+    uint64_t* hiPtr = loPtr + t;
+    for (usint j = jBegin; j < jEnd; ++j) {
+      uint64_t loVal = loPtr[j];
+      loVal -= (loVal >= twoq) ? twoq : 0;
+      uint64_t omegaFactor = MulShoupLazy(hiPtr[j], omega, preconOmega, q);
+      loPtr[j] = loVal + omegaFactor;
+      hiPtr[j] = loVal - omegaFactor + twoq;
+    }
+  }
+}
+
+// inverse butterflies, [0, 2q) -> [0, 2q)
+static void InverseRowsScalar(uint64_t* a, usint m, usint t, usint iBegin,
+                              usint iEnd, usint jBegin, usint jEnd, uint64_t q,
+                              const uint64_t* w, const uint64_t* wPrecon) {
+  const uint64_t twoq = q << 1;
+  for (usint i = iBegin; i < iEnd; ++i) {
+    const uint64_t omega = w[m + i];
+    const uint64_t preconOmega = wPrecon[m + i];
+    uint64_t* loPtr = a + ((2 * i) * t);
+    uint64_t* hiPtr = loPtr + t;
+    for (usint j = jBegin; j < jEnd; ++j) {
+      uint64_t loVal = loPtr[j] + hiPtr[j];
+      loVal -= (loVal >= twoq) ? twoq : 0;
+      uint64_t omegaFactor = loPtr[j] + twoq - hiPtr[j];
+      loPtr[j] = loVal;
+      hiPtr[j] = MulShoupLazy(omegaFactor, omega, preconOmega, q);
+    }
+  }
+}
+
+// [0, 4q) -> [0, q)
+static void ReduceFromFourQScalar(uint64_t* a, usint from, usint to,
+                                  uint64_t q) {
+  const uint64_t twoq = q << 1;
+  for (usint i = from; i < to; ++i) {
+    uint64_t val = a[i];
+    val -= (val >= twoq) ? twoq : 0;
+    val -= (val >= q) ? q : 0;
+    a[i] = val;
+  }
+}
+
+// multiplication by n^{-1}, [0, 2q) -> [0, q)
+static void ScaleScalar(uint64_t* a, usint from, usint to, uint64_t q,
+                        uint64_t scale, uint64_t preconScale) {
+  for (usint i = from; i < to; ++i) {
+    uint64_t val = MulShoupLazy(a[i], scale, preconScale, q);
+    a[i] = val - ((val >= q) ? q : 0);
+  }
+}
+
+#ifdef PALISADE_X86_SIMD
+
+/// AVX2 KERNELS
+
+PALISADE_TARGET_AVX2 static void ForwardRowsAVX2(
+    uint64_t* a, usint m, usint t, usint iBegin, usint iEnd, usint jBegin,
+    usint jEnd, uint64_t q, const uint64_t* w, const uint64_t* wPrecon) {
+  if (t < 4) {
+    ForwardRowsScalar(a, m, t, iBegin, iEnd, jBegin, jEnd, q, w, wPrecon);
+    return;
+  }
+  const __m256i vq = _mm256_set1_epi64x(q);
+  const __m256i vtwoq = _mm256_set1_epi64x(q << 1);
+  for (usint i = iBegin; i < iEnd; ++i) {
+    const __m256i omega = _mm256_set1_epi64x(w[m + i]);
+    const __m256i preconOmega = _mm256_set1_epi64x(wPrecon[m + i]);
+    uint64_t* loPtr = a + ((2 * i) * t);
+    uint64_t* hiPtr = loPtr + t;
+    usint j = jBegin;
+    for (; j + 4 <= jEnd; j += 4) {
+      __m256i loVal =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(loPtr + j));
+      __m256i hiVal =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hiPtr + j));
+      loVal = CondSubAVX2(loVal, vtwoq);
+      __m256i omegaFactor = MulShoupLazyAVX2(hiVal, omega, preconOmega, vq);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(loPtr + j),
+                          _mm256_add_epi64(loVal, omegaFactor));
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(hiPtr + j),
+          _mm256_add_epi64(_mm256_sub_epi64(loVal, omegaFactor), vtwoq));
+    }
+    ForwardRowsScalar(a, m, t, i, i + 1, j, jEnd, q, w, wPrecon);
+  }
+}
+
+PALISADE_TARGET_AVX2 static void InverseRowsAVX2(
+    uint64_t* a, usint m, usint t, usint iBegin, usint iEnd, usint jBegin,
+    usint jEnd, uint64_t q, const uint64_t* w, const uint64_t* wPrecon) {
+  if (t < 4) {
+    InverseRowsScalar(a, m, t, iBegin, iEnd, jBegin, jEnd, q, w, wPrecon);
+    return;
+  }
+  const __m256i vq = _mm256_set1_epi64x(q);
+  const __m256i vtwoq = _mm256_set1_epi64x(q << 1);
+  for (usint i = iBegin; i < iEnd; ++i) {
+    const __m256i omega = _mm256_set1_epi64x(w[m + i]);
+    const __m256i preconOmega = _mm256_set1_epi64x(wPrecon[m + i]);
+    uint64_t* loPtr = a + ((2 * i) * t);
+    uint64_t* hiPtr = loPtr + t;
+    usint j = jBegin;
+    for (; j + 4 <= jEnd; j += 4) {
+      __m256i loVal =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(loPtr + j));
+      __m256i hiVal =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hiPtr + j));
+      __m256i sum = CondSubAVX2(_mm256_add_epi64(loVal, hiVal), vtwoq);
+      __m256i diff = _mm256_sub_epi64(_mm256_add_epi64(loVal, vtwoq), hiVal);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(loPtr + j), sum);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(hiPtr + j),
+                          MulShoupLazyAVX2(diff, omega, preconOmega, vq));
+    }
+    InverseRowsScalar(a, m, t, i, i + 1, j, jEnd, q, w, wPrecon);
+  }
+}
+
+PALISADE_TARGET_AVX2 static void ReduceFromFourQAVX2(uint64_t* a, usint from,
+                                                     usint to, uint64_t q) {
+  const __m256i vq = _mm256_set1_epi64x(q);
+  const __m256i vtwoq = _mm256_set1_epi64x(q << 1);
+  usint i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i val = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    val = CondSubAVX2(CondSubAVX2(val, vtwoq), vq);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), val);
+  }
+  ReduceFromFourQScalar(a, i, to, q);
+}
+
+PALISADE_TARGET_AVX2 static void ScaleAVX2(uint64_t* a, usint from, usint to,
+                                           uint64_t q, uint64_t scale,
+                                           uint64_t preconScale) {
+  const __m256i vq = _mm256_set1_epi64x(q);
+  const __m256i vscale = _mm256_set1_epi64x(scale);
+  const __m256i vpreconScale = _mm256_set1_epi64x(preconScale);
+  usint i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i val = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    val = CondSubAVX2(MulShoupLazyAVX2(val, vscale, vpreconScale, vq), vq);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), val);
+  }
+  ScaleScalar(a, i, to, q, scale, preconScale);
+}
+
+/// AVX-512 KERNELS
+
+PALISADE_TARGET_AVX512 static void ForwardRowsAVX512(
+    uint64_t* a, usint m, usint t, usint iBegin, usint iEnd, usint jBegin,
+    usint jEnd, uint64_t q, const uint64_t* w, const uint64_t* wPrecon) {
+  if (t < 8) {
+    ForwardRowsScalar(a, m, t, iBegin, iEnd, jBegin, jEnd, q, w, wPrecon);
+    return;
+  }
+  const __m512i vq = _mm512_set1_epi64(q);
+  const __m512i vtwoq = _mm512_set1_epi64(q << 1);
+  for (usint i = iBegin; i < iEnd; ++i) {
+    const __m512i omega = _mm512_set1_epi64(w[m + i]);
+    const __m512i preconOmega = _mm512_set1_epi64(wPrecon[m + i]);
+    uint64_t* loPtr = a + ((2 * i) * t);
+    uint64_t* hiPtr = loPtr + t;
+    usint j = jBegin;
+    for (; j + 8 <= jEnd; j += 8) {
+      __m512i loVal = _mm512_loadu_si512(loPtr + j);
+      __m512i hiVal = _mm512_loadu_si512(hiPtr + j);
+      loVal = CondSubAVX512(loVal, vtwoq);
+      __m512i omegaFactor = MulShoupLazyAVX512(hiVal, omega, preconOmega, vq);
+      _mm512_storeu_si512(loPtr + j, _mm512_add_epi64(loVal, omegaFactor));
+      _mm512_storeu_si512(
+          hiPtr + j,
+          _mm512_add_epi64(_mm512_sub_epi64(loVal, omegaFactor), vtwoq));
+    }
+    ForwardRowsScalar(a, m, t, i, i + 1, j, jEnd, q, w, wPrecon);
+  }
+}
+
+PALISADE_TARGET_AVX512 static void InverseRowsAVX512(
+    uint64_t* a, usint m, usint t, usint iBegin, usint iEnd, usint jBegin,
+    usint jEnd, uint64_t q, const uint64_t* w, const uint64_t* wPrecon) {
+  if (t < 8) {
+    InverseRowsScalar(a, m, t, iBegin, iEnd, jBegin, jEnd, q, w, wPrecon);
+    return;
+  }
+  const __m512i vq = _mm512_set1_epi64(q);
+  const __m512i vtwoq = _mm512_set1_epi64(q << 1);
+  for (usint i = iBegin; i < iEnd; ++i) {
+    const __m512i omega = _mm512_set1_epi64(w[m + i]);
+    const __m512i preconOmega = _mm512_set1_epi64(wPrecon[m + i]);
+    uint64_t* loPtr = a + ((2 * i) * t);
+    uint64_t* hiPtr = loPtr + t;
+    usint j = jBegin;
+    for (; j + 8 <= jEnd; j += 8) {
+      __m512i loVal = _mm512_loadu_si512(loPtr + j);
+      __m512i hiVal = _mm512_loadu_si512(hiPtr + j);
+      __m512i sum = CondSubAVX512(_mm512_add_epi64(loVal, hiVal), vtwoq);
+      __m512i diff = _mm512_sub_epi64(_mm512_add_epi64(loVal, vtwoq), hiVal);
+      _mm512_storeu_si512(loPtr + j, sum);
+      _mm512_storeu_si512(hiPtr + j,
+                          MulShoupLazyAVX512(diff, omega, preconOmega, vq));
+    }
+    InverseRowsScalar(a, m, t, i, i + 1, j, jEnd, q, w, wPrecon);
+  }
+}
+
+PALISADE_TARGET_AVX512 static void ReduceFromFourQAVX512(uint64_t* a,
+                                                         usint from, usint to,
+                                                         uint64_t q) {
+  const __m512i vq = _mm512_set1_epi64(q);
+  const __m512i vtwoq = _mm512_set1_epi64(q << 1);
+  usint i = from;
+  for (; i + 8 <= to; i += 8) {
+    __m512i val = _mm512_loadu_si512(a + i);
+    _mm512_storeu_si512(a + i, CondSubAVX512(CondSubAVX512(val, vtwoq), vq));
+  }
+  ReduceFromFourQScalar(a, i, to, q);
+}
+
+PALISADE_TARGET_AVX512 static void ScaleAVX512(uint64_t* a, usint from,
+                                               usint to, uint64_t q,
+                                               uint64_t scale,
+                                               uint64_t preconScale) {
+  const __m512i vq = _mm512_set1_epi64(q);
+  const __m512i vscale = _mm512_set1_epi64(scale);
+  const __m512i vpreconScale = _mm512_set1_epi64(preconScale);
+  usint i = from;
+  for (; i + 8 <= to; i += 8) {
+    __m512i val = _mm512_loadu_si512(a + i);
+    val = CondSubAVX512(MulShoupLazyAVX512(val, vscale, vpreconScale, vq), vq);
+    _mm512_storeu_si512(a + i, val);
+  }
+  ScaleScalar(a, i, to, q, scale, preconScale);
+}
+
+#endif  // PALISADE_X86_SIMD
+
+/// DISPATCH
+
+typedef void (*RowsKernel)(uint64_t*, usint, usint, usint, usint, usint, usint,
+                           uint64_t, const uint64_t*, const uint64_t*);
+typedef void (*ReduceKernel)(uint64_t*, usint, usint, uint64_t);
+typedef void (*ScaleKernel)(uint64_t*, usint, usint, uint64_t, uint64_t,
+                            uint64_t);
+
+struct NTTKernels {
+  RowsKernel forwardRows;
+  RowsKernel inverseRows;
+  ReduceKernel reduce;
+  ScaleKernel scale;
+};
+
+static const NTTKernels& GetKernels() {
+  static const NTTKernels scalarKernels = {
+      ForwardRowsScalar, InverseRowsScalar, ReduceFromFourQScalar, ScaleScalar};
+#ifdef PALISADE_X86_SIMD
+  static const NTTKernels avx2Kernels = {ForwardRowsAVX2, InverseRowsAVX2,
+                                         ReduceFromFourQAVX2, ScaleAVX2};
+  static const NTTKernels avx512Kernels = {
+      ForwardRowsAVX512, InverseRowsAVX512, ReduceFromFourQAVX512, ScaleAVX512};
+  switch (lbcrypto::CPUFeatures::GetSIMDLevel()) {
+    case lbcrypto::SIMD_AVX512:
+      return avx512Kernels;
+    case lbcrypto::SIMD_AVX2:
+      return avx2Kernels;
+    default:
+      break;
+  }
+#endif
+  return scalarKernels;
+}
+
+/// DRIVERS
+
+// Forward stages from m = 2^logBlocks on are confined to blocks of
+// n / 2^logBlocks coefficients; runs them on one block and reduces it.
+static void ForwardTransformBlock(const NTTKernels& k, uint64_t* a, usint n,
+                                  uint64_t q, const uint64_t* w,
+                                  const uint64_t* wPrecon, usint logBlocks,
+                                  usint block) {
+  for (usint m = (1 << logBlocks), t = ((n >> 1) >> logBlocks); m < n;
+       m <<= 1, t >>= 1) {
+    usint rows = (m >> logBlocks);
+    k.forwardRows(a, m, t, block * rows, (block + 1) * rows, 0, t, q, w,
+                  wPrecon);
+  }
+  usint blockSize = (n >> logBlocks);
+  k.reduce(a, block * blockSize, (block + 1) * blockSize, q);
+}
+
+// Inverse stages down to m = 2^logBlocks are confined to blocks of
+// n / 2^logBlocks coefficients; runs them on one block without scaling.
+static void InverseTransformBlock(const NTTKernels& k, uint64_t* a, usint n,
+                                  uint64_t q, const uint64_t* w,
+                                  const uint64_t* wPrecon, usint logBlocks,
+                                  usint block) {
+  const usint minM = (1 << logBlocks);
+  for (usint m = (n >> 1), t = 1; m >= minM; m >>= 1, t <<= 1) {
+    usint rows = (m >> logBlocks);
+    k.inverseRows(a, m, t, block * rows, (block + 1) * rows, 0, t, q, w,
+                  wPrecon);
+  }
+}
+
+// Minimum number of coefficients handed to one thread by the batched
+// transforms; smaller blocks cost more in synchronization than they gain
+static const usint NTT_MIN_BLOCK_SIZE = 2048;
+
+// Each element of a batch is split into 2^logBlocks blocks, with logBlocks
+// the smallest value that gives every thread at least one work unit
+static usint BatchLogBlocks(usint numElements, usint n) {
+  usint numThreads = lbcrypto::GetParallelConcurrency();
+#ifdef PARALLEL
+  // loops nested in an OpenMP region run serially
+  if (omp_in_parallel()) {
+    numThreads = 1;
+  }
+#endif
+  usint logBlocks = 0;
+  while ((numElements << logBlocks) < numThreads &&
+         (n >> (logBlocks + 1)) >= NTT_MIN_BLOCK_SIZE) {
+    ++logBlocks;
+  }
+  return logBlocks;
+}
+
+void NativeNTT::ForwardTransformToBitReverseInPlace(
+    uint64_t* element, usint n, uint64_t modulus,
+    const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable) {
+  ForwardTransformBlock(GetKernels(), element, n, modulus, rootOfUnityTable,
+                        preconRootOfUnityTable, 0, 0);
+}
+
+void NativeNTT::InverseTransformFromBitReverseInPlace(
+    uint64_t* element, usint n, uint64_t modulus,
+    const uint64_t* rootOfUnityInverseTable,
+    const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+    uint64_t preconCycloOrderInv) {
+  const NTTKernels& k = GetKernels();
+  InverseTransformBlock(k, element, n, modulus, rootOfUnityInverseTable,
+                        preconRootOfUnityInverseTable, 0, 0);
+  k.scale(element, 0, n, modulus, cycloOrderInv, preconCycloOrderInv);
+}
+
+// The first logBlocks forward stages span several blocks and are cut into
+// slices of equal size, one stage at a time; the remaining stages run on
+// independent (element, block) units.
+void NativeNTT::ForwardTransformToBitReverseInPlace(
+    uint64_t* const* elements, usint numElements, usint n,
+    const uint64_t* moduli, const uint64_t* const* rootOfUnityTables,
+    const uint64_t* const* preconRootOfUnityTables) {
+  const NTTKernels& k = GetKernels();
+  const usint logBlocks = BatchLogBlocks(numElements, n);
+  const usint numBlocks = (1 << logBlocks);
+  const usint numUnits = (numElements << logBlocks);
+  const usint sliceSize = ((n >> 1) >> logBlocks);
+
+  // every stage is a parallel loop of its own, so that a stage only starts
+  // once the previous one has completed
+  for (usint m = 1; m < numBlocks; m <<= 1) {
+    const usint t = ((n >> 1) / m);
+    const usint slicesPerRow = (numBlocks / m);
+    lbcrypto::ParallelFor(0, numUnits, [&](size_t u) {
+      const usint e = (u >> logBlocks);
+      const usint slice = (u & (numBlocks - 1));
+      const usint i = slice / slicesPerRow;
+      const usint jBegin = (slice % slicesPerRow) * sliceSize;
+      k.forwardRows(elements[e], m, t, i, i + 1, jBegin, jBegin + sliceSize,
+                    moduli[e], rootOfUnityTables[e],
+                    preconRootOfUnityTables[e]);
+    });
+  }
+  lbcrypto::ParallelFor(0, numUnits, [&](size_t u) {
+    const usint e = (u >> logBlocks);
+    ForwardTransformBlock(k, elements[e], n, moduli[e], rootOfUnityTables[e],
+                          preconRootOfUnityTables[e], logBlocks,
+                          (u & (numBlocks - 1)));
+  });
+}
+
+// Mirror image of the forward batch: the block-local stages run first, then
+// the last logBlocks stages are sliced, and the slices of the final stage
+// also apply the scaling by n^{-1}.
+void NativeNTT::InverseTransformFromBitReverseInPlace(
+    uint64_t* const* elements, usint numElements, usint n,
+    const uint64_t* moduli, const uint64_t* const* rootOfUnityInverseTables,
+    const uint64_t* const* preconRootOfUnityInverseTables,
+    const uint64_t* cycloOrderInv, const uint64_t* preconCycloOrderInv) {
+  const NTTKernels& k = GetKernels();
+  const usint logBlocks = BatchLogBlocks(numElements, n);
+  const usint numBlocks = (1 << logBlocks);
+  const usint numUnits = (numElements << logBlocks);
+  const usint sliceSize = ((n >> 1) >> logBlocks);
+
+  lbcrypto::ParallelFor(0, numUnits, [&](size_t u) {
+    const usint e = (u >> logBlocks);
+    uint64_t* a = elements[e];
+    InverseTransformBlock(k, a, n, moduli[e], rootOfUnityInverseTables[e],
+                          preconRootOfUnityInverseTables[e], logBlocks,
+                          (u & (numBlocks - 1)));
+    if (logBlocks == 0) {
+      k.scale(a, 0, n, moduli[e], cycloOrderInv[e], preconCycloOrderInv[e]);
+    }
+  });
+  for (usint m = (numBlocks >> 1); m >= 1; m >>= 1) {
+    const usint t = ((n >> 1) / m);
+    const usint slicesPerRow = (numBlocks / m);
+    lbcrypto::ParallelFor(0, numUnits, [&](size_t u) {
+      const usint e = (u >> logBlocks);
+      uint64_t* a = elements[e];
+      const usint slice = (u & (numBlocks - 1));
+      const usint i = slice / slicesPerRow;
+      const usint jBegin = (slice % slicesPerRow) * sliceSize;
+      const usint jEnd = jBegin + sliceSize;
+      k.inverseRows(a, m, t, i, i + 1, jBegin, jEnd, moduli[e],
+                    rootOfUnityInverseTables[e],
+                    preconRootOfUnityInverseTables[e]);
+      if (m == 1) {
+        k.scale(a, jBegin, jEnd, moduli[e], cycloOrderInv[e],
+                preconCycloOrderInv[e]);
+        k.scale(a, t + jBegin, t + jEnd, moduli[e], cycloOrderInv[e],
+                preconCycloOrderInv[e]);
+      }
+    });
+  }
+}
+
+}  // namespace bigintnat
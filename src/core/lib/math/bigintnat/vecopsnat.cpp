@@ -0,0 +1,325 @@
+// @file vecopsnat.cpp This file contains the element-wise modular arithmetic
+// kernels for 64-bit native vectors.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+#include "math/bigintnat/vecopsnat.h"
+
+#include "math/bigintnat/simdnat.h"
+
+#ifdef PALISADE_X86_SIMD
+// GCC flags the placeholder operand of the AVX-512 broadcast intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#endif
+
+namespace bigintnat {
+
+// Barrett precomputation for a modulus q of l bits: mu = floor(2^{2l} / q).
+// For z = a*b < 2^{2l}, the quotient estimate ((z >> (l-1)) * mu) >> (l+1)
+// is at most 2 below floor(z / q), so the remainder lies in [0, 3q).
+struct BarrettPrecon {
+  uint64_t mu;
+  usint bits;
+};
+
+static BarrettPrecon PrepBarrett(uint64_t q) {
+  BarrettPrecon p;
+  p.bits = 0;
+  while ((q >> p.bits) != 0) ++p.bits;
+  // long division of 2^{2l} by q, one quotient bit at a time
+  uint64_t quot = 0, rem = 1;
+  for (usint i = 0; i < 2 * p.bits; ++i) {
+    rem <<= 1;
+    quot <<= 1;
+    if (rem >= q) {
+      rem -= q;
+      quot |= 1;
+    }
+  }
+  p.mu = quot;
+  return p;
+}
+
+/// SCALAR KERNELS
+
+static void ModAddEqScalar(uint64_t* a, const uint64_t* b, usint from,
+                           usint to, uint64_t q) {
+  for (usint i = from; i < to; ++i) {
+    uint64_t sum = a[i] + b[i];
+    a[i] = sum - ((sum >= q) ? q : 0);
+  }
+}
+
+static void ModSubEqScalar(uint64_t* a, const uint64_t* b, usint from,
+                           usint to, uint64_t q) {
+  for (usint i = from; i < to; ++i) {
+    uint64_t diff = a[i] - b[i];
+    a[i] = diff + ((a[i] < b[i]) ? q : 0);
+  }
+}
+
+static void ModMulEqScalar(uint64_t* a, const uint64_t* b, usint from,
+                           usint to, uint64_t q, const BarrettPrecon& p) {
+  const uint64_t twoq = q << 1;
+  const usint zShift = p.bits - 1, qShift = p.bits + 1;
+  for (usint i = from; i < to; ++i) {
+    uint64_t zHi = MulHi64(a[i], b[i]);
+    uint64_t zLo = a[i] * b[i];
+    uint64_t t = (zHi << (64 - zShift)) | (zLo >> zShift);
+    uint64_t tHi = MulHi64(t, p.mu);
+    uint64_t tLo = t * p.mu;
+    uint64_t quot = (tHi << (64 - qShift)) | (tLo >> qShift);
+    uint64_t r = zLo - quot * q;
+    r -= (r >= twoq) ? twoq : 0;
+    a[i] = r - ((r >= q) ? q : 0);
+  }
+}
+
+static void ModMulConstEqScalar(uint64_t* a, usint from, usint to, uint64_t q,
+                                uint64_t b, uint64_t bPrecon) {
+  for (usint i = from; i < to; ++i) {
+    uint64_t r = MulShoupLazy(a[i], b, bPrecon, q);
+    a[i] = r - ((r >= q) ? q : 0);
+  }
+}
+
+#ifdef PALISADE_X86_SIMD
+
+/// AVX2 KERNELS
+
+PALISADE_TARGET_AVX2 static void ModAddEqAVX2(uint64_t* a, const uint64_t* b,
+                                              usint from, usint to,
+                                              uint64_t q) {
+  const __m256i vq = _mm256_set1_epi64x(q);
+  usint i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i),
+                        CondSubAVX2(_mm256_add_epi64(x, y), vq));
+  }
+  ModAddEqScalar(a, b, i, to, q);
+}
+
+PALISADE_TARGET_AVX2 static void ModSubEqAVX2(uint64_t* a, const uint64_t* b,
+                                              usint from, usint to,
+                                              uint64_t q) {
+  const __m256i vq = _mm256_set1_epi64x(q);
+  usint i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i borrow = _mm256_cmpgt_epi64(y, x);
+    __m256i diff = _mm256_sub_epi64(x, y);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i),
+                        _mm256_add_epi64(diff, _mm256_and_si256(borrow, vq)));
+  }
+  ModSubEqScalar(a, b, i, to, q);
+}
+
+PALISADE_TARGET_AVX2 static void ModMulEqAVX2(uint64_t* a, const uint64_t* b,
+                                              usint from, usint to, uint64_t q,
+                                              const BarrettPrecon& p) {
+  const __m256i vq = _mm256_set1_epi64x(q);
+  const __m256i vtwoq = _mm256_set1_epi64x(q << 1);
+  const __m256i vmu = _mm256_set1_epi64x(p.mu);
+  const __m128i zShiftR = _mm_cvtsi64_si128(p.bits - 1);
+  const __m128i zShiftL = _mm_cvtsi64_si128(65 - p.bits);
+  const __m128i qShiftR = _mm_cvtsi64_si128(p.bits + 1);
+  const __m128i qShiftL = _mm_cvtsi64_si128(63 - p.bits);
+  usint i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i zHi, zLo, tHi, tLo;
+    MulWide64AVX2(x, y, &zHi, &zLo);
+    __m256i t = _mm256_or_si256(_mm256_sll_epi64(zHi, zShiftL),
+                                _mm256_srl_epi64(zLo, zShiftR));
+    MulWide64AVX2(t, vmu, &tHi, &tLo);
+    __m256i quot = _mm256_or_si256(_mm256_sll_epi64(tHi, qShiftL),
+                                   _mm256_srl_epi64(tLo, qShiftR));
+    __m256i r = _mm256_sub_epi64(zLo, MulLo64AVX2(quot, vq));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i),
+                        CondSubAVX2(CondSubAVX2(r, vtwoq), vq));
+  }
+  ModMulEqScalar(a, b, i, to, q, p);
+}
+
+PALISADE_TARGET_AVX2 static void ModMulConstEqAVX2(uint64_t* a, usint from,
+                                                   usint to, uint64_t q,
+                                                   uint64_t b,
+                                                   uint64_t bPrecon) {
+  const __m256i vq = _mm256_set1_epi64x(q);
+  const __m256i vb = _mm256_set1_epi64x(b);
+  const __m256i vbPrecon = _mm256_set1_epi64x(bPrecon);
+  usint i = from;
+  for (; i + 4 <= to; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    x = CondSubAVX2(MulShoupLazyAVX2(x, vb, vbPrecon, vq), vq);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), x);
+  }
+  ModMulConstEqScalar(a, i, to, q, b, bPrecon);
+}
+
+/// AVX-512 KERNELS
+
+PALISADE_TARGET_AVX512 static void ModAddEqAVX512(uint64_t* a,
+                                                  const uint64_t* b,
+                                                  usint from, usint to,
+                                                  uint64_t q) {
+  const __m512i vq = _mm512_set1_epi64(q);
+  usint i = from;
+  for (; i + 8 <= to; i += 8) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    __m512i y = _mm512_loadu_si512(b + i);
+    _mm512_storeu_si512(a + i, CondSubAVX512(_mm512_add_epi64(x, y), vq));
+  }
+  ModAddEqScalar(a, b, i, to, q);
+}
+
+// x - y wraps around for x < y, in which case x - y + q is the smaller value
+PALISADE_TARGET_AVX512 static void ModSubEqAVX512(uint64_t* a,
+                                                  const uint64_t* b,
+                                                  usint from, usint to,
+                                                  uint64_t q) {
+  const __m512i vq = _mm512_set1_epi64(q);
+  usint i = from;
+  for (; i + 8 <= to; i += 8) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    __m512i y = _mm512_loadu_si512(b + i);
+    __m512i diff = _mm512_sub_epi64(x, y);
+    _mm512_storeu_si512(a + i,
+                        _mm512_min_epu64(diff, _mm512_add_epi64(diff, vq)));
+  }
+  ModSubEqScalar(a, b, i, to, q);
+}
+
+PALISADE_TARGET_AVX512 static void ModMulEqAVX512(uint64_t* a,
+                                                  const uint64_t* b,
+                                                  usint from, usint to,
+                                                  uint64_t q,
+                                                  const BarrettPrecon& p) {
+  const __m512i vq = _mm512_set1_epi64(q);
+  const __m512i vtwoq = _mm512_set1_epi64(q << 1);
+  const __m512i vmu = _mm512_set1_epi64(p.mu);
+  const __m128i zShiftR = _mm_cvtsi64_si128(p.bits - 1);
+  const __m128i zShiftL = _mm_cvtsi64_si128(65 - p.bits);
+  const __m128i qShiftR = _mm_cvtsi64_si128(p.bits + 1);
+  const __m128i qShiftL = _mm_cvtsi64_si128(63 - p.bits);
+  usint i = from;
+  for (; i + 8 <= to; i += 8) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    __m512i y = _mm512_loadu_si512(b + i);
+    __m512i zHi, zLo, tHi, tLo;
+    MulWide64AVX512(x, y, &zHi, &zLo);
+    __m512i t = _mm512_or_si512(_mm512_sll_epi64(zHi, zShiftL),
+                                _mm512_srl_epi64(zLo, zShiftR));
+    MulWide64AVX512(t, vmu, &tHi, &tLo);
+    __m512i quot = _mm512_or_si512(_mm512_sll_epi64(tHi, qShiftL),
+                                   _mm512_srl_epi64(tLo, qShiftR));
+    __m512i r = _mm512_sub_epi64(zLo, _mm512_mullo_epi64(quot, vq));
+    _mm512_storeu_si512(a + i, CondSubAVX512(CondSubAVX512(r, vtwoq), vq));
+  }
+  ModMulEqScalar(a, b, i, to, q, p);
+}
+
+PALISADE_TARGET_AVX512 static void ModMulConstEqAVX512(uint64_t* a,
+                                                       usint from, usint to,
+                                                       uint64_t q, uint64_t b,
+                                                       uint64_t bPrecon) {
+  const __m512i vq = _mm512_set1_epi64(q);
+  const __m512i vb = _mm512_set1_epi64(b);
+  const __m512i vbPrecon = _mm512_set1_epi64(bPrecon);
+  usint i = from;
+  for (; i + 8 <= to; i += 8) {
+    __m512i x = _mm512_loadu_si512(a + i);
+    x = CondSubAVX512(MulShoupLazyAVX512(x, vb, vbPrecon, vq), vq);
+    _mm512_storeu_si512(a + i, x);
+  }
+  ModMulConstEqScalar(a, i, to, q, b, bPrecon);
+}
+
+#endif  // PALISADE_X86_SIMD
+
+/// DISPATCH
+
+typedef void (*AddSubKernel)(uint64_t*, const uint64_t*, usint, usint,
+                             uint64_t);
+typedef void (*MulKernel)(uint64_t*, const uint64_t*, usint, usint, uint64_t,
+                          const BarrettPrecon&);
+typedef void (*MulConstKernel)(uint64_t*, usint, usint, uint64_t, uint64_t,
+                               uint64_t);
+
+struct VectorKernels {
+  AddSubKernel modAdd;
+  AddSubKernel modSub;
+  MulKernel modMul;
+  MulConstKernel modMulConst;
+};
+
+static const VectorKernels& GetKernels() {
+  static const VectorKernels scalarKernels = {ModAddEqScalar, ModSubEqScalar,
+                                              ModMulEqScalar,
+                                              ModMulConstEqScalar};
+#ifdef PALISADE_X86_SIMD
+  static const VectorKernels avx2Kernels = {ModAddEqAVX2, ModSubEqAVX2,
+                                            ModMulEqAVX2, ModMulConstEqAVX2};
+  static const VectorKernels avx512Kernels = {
+      ModAddEqAVX512, ModSubEqAVX512, ModMulEqAVX512, ModMulConstEqAVX512};
+  switch (lbcrypto::CPUFeatures::GetSIMDLevel()) {
+    case lbcrypto::SIMD_AVX512:
+      return avx512Kernels;
+    case lbcrypto::SIMD_AVX2:
+      return avx2Kernels;
+    default:
+      break;
+  }
+#endif
+  return scalarKernels;
+}
+
+/// DRIVERS
+
+void NativeVectorOps::ModAddEq(uint64_t* a, const uint64_t* b, usint n,
+                               uint64_t modulus) {
+  GetKernels().modAdd(a, b, 0, n, modulus);
+}
+
+void NativeVectorOps::ModSubEq(uint64_t* a, const uint64_t* b, usint n,
+                               uint64_t modulus) {
+  GetKernels().modSub(a, b, 0, n, modulus);
+}
+
+void NativeVectorOps::ModMulEq(uint64_t* a, const uint64_t* b, usint n,
+                               uint64_t modulus) {
+  GetKernels().modMul(a, b, 0, n, modulus, PrepBarrett(modulus));
+}
+
+void NativeVectorOps::ModMulConstEq(uint64_t* a, usint n, uint64_t modulus,
+                                    uint64_t b, uint64_t bPrecon) {
+  GetKernels().modMulConst(a, 0, n, modulus, b, bPrecon);
+}
+
+}  // namespace bigintnat
@@ -24,17 +24,136 @@
 
 #include "math/dftransfrm.h"
 
+#include <algorithm>
+#include <mutex>
+#include <utility>
+
 namespace lbcrypto {
 
 std::complex<double> *DiscreteFourierTransform::rootOfUnityTable = nullptr;
-size_t DiscreteFourierTransform::m_M = 0;
-size_t DiscreteFourierTransform::m_Nh = 0;
-bool DiscreteFourierTransform::m_isInitialized = false;
 
-/// precomputed rotation group indices
-std::vector<uint32_t> DiscreteFourierTransform::m_rotGroup;
-/// precomputed ksi powers
-std::vector<std::complex<double>> DiscreteFourierTransform::m_ksiPows;
+// all special FFT plans built so far, keyed by (m, nh)
+static std::map<std::pair<size_t, size_t>,
+                std::shared_ptr<const FFTSpecialPlan>>
+    s_fftPlans;
+static std::mutex s_fftPlansMutex;
+// most recently requested plan for each log2(nh); read without locking
+static std::shared_ptr<const FFTSpecialPlan> s_fftPlanSlots[64];
+
+FFTSpecialPlan::FFTSpecialPlan(size_t m, size_t nh) : m_M(m), m_Nh(nh) {
+  if (nh == 0 || (nh & (nh - 1)) != 0 || m % (4 * nh) != 0)
+    PALISADE_THROW(math_error,
+                   "FFTSpecialPlan: the number of slots " + std::to_string(nh) +
+                       " must be a power of two dividing m/4 for m = " +
+                       std::to_string(m));
+
+  // precomputed rotation group indices
+  std::vector<uint64_t> rotGroup(std::max<size_t>(nh >> 1, 1));
+  uint64_t fivePows = 1;
+  for (size_t i = 0; i < rotGroup.size(); ++i) {
+    rotGroup[i] = fivePows;
+    fivePows = fivePows * 5 % m_M;
+  }
+
+  m_twiddleRe.resize(nh);
+  m_twiddleIm.resize(nh);
+  m_twiddleInvRe.resize(nh);
+  m_twiddleInvIm.resize(nh);
+  for (size_t lenh = 1; lenh < nh; lenh <<= 1) {
+    size_t lenq = lenh << 3;
+    for (size_t j = 0; j < lenh; ++j) {
+      size_t idx = (rotGroup[j] % lenq) * m_M / lenq;
+      double angle = 2.0 * M_PI * idx / m_M;
+      m_twiddleRe[lenh + j] = cos(angle);
+      m_twiddleIm[lenh + j] = sin(angle);
+
+      size_t idxInv = (lenq - (rotGroup[j] % lenq)) * m_M / lenq;
+      double angleInv = 2.0 * M_PI * idxInv / m_M;
+      m_twiddleInvRe[lenh + j] = cos(angleInv);
+      m_twiddleInvIm[lenh + j] = sin(angleInv);
+    }
+  }
+
+  m_bitReverse.resize(nh);
+  for (size_t i = 1, j = 0; i < nh; ++i) {
+    size_t bit = nh >> 1;
+    for (; j >= bit; bit >>= 1) {
+      j -= bit;
+    }
+    j += bit;
+    m_bitReverse[i] = j;
+  }
+}
+
+void FFTSpecialPlan::BitReverse(std::vector<std::complex<double>> &vals) const {
+  for (size_t i = 1; i < m_Nh; ++i) {
+    size_t j = m_bitReverse[i];
+    if (i < j) {
+      std::swap(vals[i], vals[j]);
+    }
+  }
+}
+
+void FFTSpecialPlan::FFTSpecial(std::vector<std::complex<double>> &vals) const {
+  if (vals.size() != m_Nh)
+    PALISADE_THROW(math_error, "FFTSpecial: expected " + std::to_string(m_Nh) +
+                                   " values, got " +
+                                   std::to_string(vals.size()));
+
+  BitReverse(vals);
+  // std::complex<double> is laid out as {real, imag}
+  double *data = reinterpret_cast<double *>(vals.data());
+  for (size_t lenh = 1; lenh < m_Nh; lenh <<= 1) {
+    const double *wRe = &m_twiddleRe[lenh];
+    const double *wIm = &m_twiddleIm[lenh];
+    for (size_t i = 0; i < m_Nh; i += 2 * lenh) {
+      double *x = data + 2 * i;
+      double *y = x + 2 * lenh;
+      for (size_t j = 0; j < lenh; ++j) {
+        double vRe = y[2 * j] * wRe[j] - y[2 * j + 1] * wIm[j];
+        double vIm = y[2 * j] * wIm[j] + y[2 * j + 1] * wRe[j];
+        double uRe = x[2 * j];
+        double uIm = x[2 * j + 1];
+        x[2 * j] = uRe + vRe;
+        x[2 * j + 1] = uIm + vIm;
+        y[2 * j] = uRe - vRe;
+        y[2 * j + 1] = uIm - vIm;
+      }
+    }
+  }
+}
+
+void FFTSpecialPlan::FFTSpecialInv(
+    std::vector<std::complex<double>> &vals) const {
+  if (vals.size() != m_Nh)
+    PALISADE_THROW(math_error, "FFTSpecialInv: expected " +
+                                   std::to_string(m_Nh) + " values, got " +
+                                   std::to_string(vals.size()));
+
+  double *data = reinterpret_cast<double *>(vals.data());
+  for (size_t lenh = m_Nh >> 1; lenh > 0; lenh >>= 1) {
+    const double *wRe = &m_twiddleInvRe[lenh];
+    const double *wIm = &m_twiddleInvIm[lenh];
+    for (size_t i = 0; i < m_Nh; i += 2 * lenh) {
+      double *x = data + 2 * i;
+      double *y = x + 2 * lenh;
+      for (size_t j = 0; j < lenh; ++j) {
+        double dRe = x[2 * j] - y[2 * j];
+        double dIm = x[2 * j + 1] - y[2 * j + 1];
+        x[2 * j] += y[2 * j];
+        x[2 * j + 1] += y[2 * j + 1];
+        y[2 * j] = dRe * wRe[j] - dIm * wIm[j];
+        y[2 * j + 1] = dRe * wIm[j] + dIm * wRe[j];
+      }
+    }
+  }
+  BitReverse(vals);
+
+  double size = m_Nh;
+  for (size_t i = 0; i < 2 * m_Nh; ++i) {
+    data[i] /= size;
+  }
+}
 
 void DiscreteFourierTransform::Reset() {
   if (rootOfUnityTable) {
@@ -44,30 +163,23 @@ void DiscreteFourierTransform::Reset() {
 }
 
 void DiscreteFourierTransform::Initialize(size_t m, size_t nh) {
-#pragma omp critical
-  {
-    m_isInitialized = false;
-    m_M = m;
-    m_Nh = nh;
-
-    m_rotGroup.resize(m_Nh);
-    uint32_t fivePows = 1;
-    for (size_t i = 0; i < m_Nh; ++i) {
-      m_rotGroup[i] = fivePows;
-      fivePows *= 5;
-      fivePows %= m_M;
-    }
+  GetPlan(m, nh);
+}
 
-    m_ksiPows.resize(m_M + 1);
-    for (size_t j = 0; j < m_M; ++j) {
-      double angle = 2.0 * M_PI * j / m_M;
-      m_ksiPows[j].real(cos(angle));
-      m_ksiPows[j].imag(sin(angle));
-    }
+std::shared_ptr<const FFTSpecialPlan> DiscreteFourierTransform::GetPlan(
+    size_t m, size_t nh) {
+  size_t slot = 0;
+  for (size_t v = nh; v > 1; v >>= 1) ++slot;
 
-    m_ksiPows[m_M] = m_ksiPows[0];
-    m_isInitialized = true;
-  }
+  auto plan = std::atomic_load(&s_fftPlanSlots[slot]);
+  if (plan && plan->GetCyclotomicOrder() == m && plan->GetSlots() == nh)
+    return plan;
+
+  std::lock_guard<std::mutex> lock(s_fftPlansMutex);
+  auto &cached = s_fftPlans[std::make_pair(m, nh)];
+  if (!cached) cached = std::make_shared<const FFTSpecialPlan>(m, nh);
+  std::atomic_store(&s_fftPlanSlots[slot], cached);
+  return cached;
 }
 
 void DiscreteFourierTransform::PreComputeTable(uint32_t s) {
@@ -201,74 +313,14 @@ std::vector<std::complex<double>> DiscreteFourierTransform::InverseTransform(
   return invDftRemainder;
 }
 
-void DiscreteFourierTransform::FFTSpecialInvLazy(
-    std::vector<std::complex<double>> &vals) {
-  uint32_t size = vals.size();
-  for (size_t len = size; len >= 1; len >>= 1) {
-    for (size_t i = 0; i < size; i += len) {
-      size_t lenh = len >> 1;
-      size_t lenq = len << 2;
-      for (size_t j = 0; j < lenh; ++j) {
-        size_t idx = (lenq - (m_rotGroup[j] % lenq)) * m_M / lenq;
-        std::complex<double> u = vals[i + j] + vals[i + j + lenh];
-        std::complex<double> v = vals[i + j] - vals[i + j + lenh];
-        v *= m_ksiPows[idx];
-        vals[i + j] = u;
-        vals[i + j + lenh] = v;
-      }
-    }
-  }
-  BitReverse(vals);
-}
-
 void DiscreteFourierTransform::FFTSpecialInv(
     std::vector<std::complex<double>> &vals) {
-  // if the precomputed tables do not exist
-  if ((vals.size() != m_Nh) || (!m_isInitialized))
-    Initialize(vals.size() * 4, vals.size());
-  FFTSpecialInvLazy(vals);
-  uint32_t size = vals.size();
-  for (size_t i = 0; i < size; ++i) {
-    vals[i] /= size;
-  }
+  GetPlan(vals.size() * 4, vals.size())->FFTSpecialInv(vals);
 }
 
 void DiscreteFourierTransform::FFTSpecial(
     std::vector<std::complex<double>> &vals) {
-  // if the precomputed tables do not exist
-  if ((vals.size() != m_Nh) || (!m_isInitialized))
-    Initialize(vals.size() * 4, vals.size());
-  BitReverse(vals);
-  uint32_t size = vals.size();
-  for (size_t len = 2; len <= size; len <<= 1) {
-    for (size_t i = 0; i < size; i += len) {
-      size_t lenh = len >> 1;
-      size_t lenq = len << 2;
-      for (size_t j = 0; j < lenh; ++j) {
-        long idx = ((m_rotGroup[j] % lenq)) * m_M / lenq;
-        std::complex<double> u = vals[i + j];
-        std::complex<double> v = vals[i + j + lenh];
-        v *= m_ksiPows[idx];
-        vals[i + j] = u + v;
-        vals[i + j + lenh] = u - v;
-      }
-    }
-  }
-}
-
-void DiscreteFourierTransform::BitReverse(
-    std::vector<std::complex<double>> &vals) {
-  uint32_t size = vals.size();
-  for (size_t i = 1, j = 0; i < size; ++i) {
-    size_t bit = size >> 1;
-    for (; j >= bit; bit >>= 1) {
-      j -= bit;
-    }
-    j += bit;
-    if (i < j) {
-      swap(vals[i], vals[j]);
-    }
-  }
+  GetPlan(vals.size() * 4, vals.size())->FFTSpecial(vals);
 }
 
 }  // namespace lbcrypto
@@ -23,8 +23,10 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <bitset>
 #include <sstream>
+#include <vector>
 
 #include "math/backend.h"
 #include "math/discreteuniformgenerator.h"
@@ -32,11 +34,6 @@
 
 namespace lbcrypto {
 
-template <typename VecType>
-std::uniform_int_distribution<uint32_t>
-    DiscreteUniformGeneratorImpl<VecType>::m_distribution =
-        std::uniform_int_distribution<uint32_t>(CHUNK_MIN, CHUNK_MAX);
-
 template <typename VecType>
 DiscreteUniformGeneratorImpl<VecType>::DiscreteUniformGeneratorImpl()
     : DistributionGenerator<VecType>() {
@@ -49,10 +46,46 @@ void DiscreteUniformGeneratorImpl<VecType>::SetModulus(
   m_modulus = modulus;
 
   // Update values that depend on modulus.
-  auto modulusWidth = m_modulus.GetMSB();
-  // Get the number of chunks in the modulus
-  // 1 is subtracted to make sure the last chunk is fully used by the modulus
-  m_chunksPerValue = (modulusWidth - 1) / CHUNK_WIDTH;
+  usint modulusWidth = m_modulus.GetMSB();
+  // Get the number of full chunks in the modulus and the mask of the bits
+  // left for the most significant chunk
+  m_chunksPerValue = modulusWidth / CHUNK_WIDTH;
+  usint remainingBits = modulusWidth % CHUNK_WIDTH;
+  m_topChunkMask = (remainingBits == 0) ? 0 : (1u << remainingBits) - 1;
+}
+
+template <typename VecType>
+void DiscreteUniformGeneratorImpl<VecType>::SetSeed(
+    const std::array<uint32_t, 16>& seed) {
+  m_prng = std::make_shared<PRNG>(seed);
+}
+
+template <typename VecType>
+void DiscreteUniformGeneratorImpl<VecType>::SetSeed(
+    const std::vector<uint32_t>& seed, uint32_t stream, uint32_t domain) {
+  std::array<uint32_t, 16> prngSeed{};
+  if (seed.size() + 2 > prngSeed.size()) {
+    PALISADE_THROW(math_error, "DiscreteUniformGenerator: seed is too long");
+  }
+  std::copy(seed.begin(), seed.end(), prngSeed.begin());
+  prngSeed[seed.size()] = stream;
+  prngSeed[seed.size() + 1] = domain;
+  SetSeed(prngSeed);
+}
+
+template <typename VecType>
+std::vector<uint32_t> DiscreteUniformGeneratorImpl<VecType>::GenerateSeed() {
+  // 256 bits
+  std::vector<uint32_t> seed(8);
+  for (auto& word : seed) {
+    word = PseudoRandomNumberGenerator::GetPRNG()();
+  }
+  return seed;
+}
+
+template <typename VecType>
+PRNG& DiscreteUniformGeneratorImpl<VecType>::GetPRNG() const {
+  return m_prng ? *m_prng : PseudoRandomNumberGenerator::GetPRNG();
 }
 
 template <typename VecType>
@@ -64,53 +97,35 @@ DiscreteUniformGeneratorImpl<VecType>::GenerateInteger() const {
   // temp is used for intermediate multiprecision computations
   typename VecType::Integer temp;
 
-  // stores current random number generated by built-in C++ 11 uniform generator
-  // (used for 32-bit unsigned integers)
-  uint32_t value;
-
   if (m_modulus == typename VecType::Integer(0)) {
     PALISADE_THROW(math_error, "0 modulus?");
   }
 
+  // The samples are built from the raw 32-bit words of the PRNG rather than
+  // through std::uniform_int_distribution, whose algorithm is left to the
+  // standard library: a seeded generator must produce the same values on
+  // every platform, as seeds are sent in place of the elements they expand
+  // to. A value with as many bits as the modulus is drawn and rejected if it
+  // is not below the modulus, which happens less than half of the time.
   do {
     result = 0;
 
     // Generate random uint32_t "limbs" of the BigInteger
     for (usint i = 0; i < m_chunksPerValue; i++) {
-      // Generate an unsigned long integer
-      value = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
-      // converts value to IntType
-      temp = value;
+      temp = GetPRNG()();
       // Move it to the appropriate chunk of the big integer
       temp <<= i * CHUNK_WIDTH;
       // Add it to the current big integer storing the result
       result += temp;
     }
 
-    // work with the remainder - after all 32-bit chunks were processed
-    temp = m_modulus >> m_chunksPerValue * CHUNK_WIDTH;
-
-    // Generate a uniform number for the remainder
-    // If not 1, i.e., the modulus is either 1 or a power of 2*CHUNK_WIDTH
-    if (temp.GetMSB() != 1) {
-      uint32_t bound = temp.ConvertToInt();
-
-      // built-in generator for the most significant chunk of the multiprecision
-      // number
-      std::uniform_int_distribution<uint32_t> distribution(CHUNK_MIN, bound);
-
-      value = distribution(PseudoRandomNumberGenerator::GetPRNG());
-      // converts value to IntType
-      temp = value;
-      // Move it to the appropriate chunk of the big integer
+    // the most significant chunk only holds the remaining bits
+    if (m_topChunkMask != 0) {
+      temp = GetPRNG()() & m_topChunkMask;
       temp <<= m_chunksPerValue * CHUNK_WIDTH;
-      // Add it to the current big integer storing the result
       result += temp;
     }
-  } while (result >= m_modulus);  // deals with the rare scenario when the bits
-                                  // in the most significant chunk are the same
-                                  // and the bits in the following chunk of the
-                                  // result are larger than in the modulus
+  } while (result >= m_modulus);
 
   return result;
 }
@@ -235,17 +235,15 @@ template <>
 void Matrix<Field2n>::SetFormat(Format f) {
   if (rows == 1) {
     for (size_t row = 0; row < rows; ++row) {
-#pragma omp parallel for
-      for (size_t col = 0; col < cols; ++col) {
+      ParallelFor(0, cols, [&](size_t col) {
         data[row][col].SetFormat(f);
-      }
+      });
     }
   } else {
     for (size_t col = 0; col < cols; ++col) {
-#pragma omp parallel for
-      for (size_t row = 0; row < rows; ++row) {
+      ParallelFor(0, rows, [&](size_t row) {
         data[row][col].SetFormat(f);
-      }
+      });
     }
   }
 }
@@ -254,17 +252,15 @@ template <>
 void Matrix<Field2n>::SwitchFormat() {
   if (rows == 1) {
     for (size_t row = 0; row < rows; ++row) {
-#pragma omp parallel for
-      for (size_t col = 0; col < cols; ++col) {
+      ParallelFor(0, cols, [&](size_t col) {
         data[row][col].SwitchFormat();
-      }
+      });
     }
   } else {
     for (size_t col = 0; col < cols; ++col) {
-#pragma omp parallel for
-      for (size_t row = 0; row < rows; ++row) {
+      ParallelFor(0, rows, [&](size_t row) {
         data[row][col].SwitchFormat();
-      }
+      });
     }
   }
 }
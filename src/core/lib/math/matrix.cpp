@@ -69,21 +69,19 @@ Matrix<Element> Matrix<Element>::Mult(Matrix<Element> const& other) const {
   }
   Matrix<Element> result(allocZero, rows, other.cols);
   if (rows == 1) {
-#pragma omp parallel for
-    for (size_t col = 0; col < result.cols; ++col) {
+    ParallelFor(0, result.cols, [&](size_t col) {
       for (size_t i = 0; i < cols; ++i) {
         result.data[0][col] += data[0][i] * other.data[i][col];
       }
-    }
+    });
   } else {
-#pragma omp parallel for
-    for (size_t row = 0; row < result.rows; ++row) {
+    ParallelFor(0, result.rows, [&](size_t row) {
       for (size_t i = 0; i < cols; ++i) {
         for (size_t col = 0; col < result.cols; ++col) {
           result.data[row][col] += data[row][i] * other.data[i][col];
         }
       }
-    }
+    });
   }
   return result;
 }
@@ -94,12 +92,11 @@ Matrix<Element>& Matrix<Element>::operator+=(Matrix<Element> const& other) {
     PALISADE_THROW(math_error,
                    "Addition operands have incompatible dimensions");
   }
-#pragma omp parallel for
-  for (size_t j = 0; j < cols; ++j) {
+  ParallelFor(0, cols, [&](size_t j) {
     for (size_t i = 0; i < rows; ++i) {
       data[i][j] += other.data[i][j];
     }
-  }
+  });
 
   return *this;
 }
@@ -110,12 +107,11 @@ Matrix<Element>& Matrix<Element>::operator-=(Matrix<Element> const& other) {
     PALISADE_THROW(math_error,
                    "Subtraction operands have incompatible dimensions");
   }
-#pragma omp parallel for
-  for (size_t j = 0; j < cols; ++j) {
+  ParallelFor(0, cols, [&](size_t j) {
     for (size_t i = 0; i < rows; ++i) {
       data[i][j] -= other.data[i][j];
     }
-  }
+  });
 
   return *this;
 }
@@ -290,12 +286,11 @@ template <class Element>
 Matrix<Element> Matrix<Element>::MultByUnityVector() const {
   Matrix<Element> result(allocZero, rows, 1);
 
-#pragma omp parallel for
-  for (size_t row = 0; row < result.rows; ++row) {
+  ParallelFor(0, result.rows, [&](size_t row) {
     for (size_t col = 0; col < cols; ++col) {
       result.data[row][0] += data[row][col];
     }
-  }
+  });
 
   return result;
 }
@@ -310,12 +305,11 @@ Matrix<Element> Matrix<Element>::MultByRandomVector(
     std::vector<int> ranvec) const {
   Matrix<Element> result(allocZero, rows, 1);
 
-#pragma omp parallel for
-  for (size_t row = 0; row < result.rows; ++row) {
+  ParallelFor(0, result.rows, [&](size_t row) {
     for (size_t col = 0; col < cols; ++col) {
       if (ranvec[col] == 1) result.data[row][0] += data[row][col];
     }
-  }
+  });
   return result;
 }
 
@@ -23,7 +23,9 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "math/transfrm.h"
+#include "math/bigintnat/nttnat.h"
 #include "utils/defines.h"
+#include "utils/scheduler.h"
 
 #ifdef WITH_INTEL_HEXL
 #include "hexl/hexl.hpp"
@@ -55,6 +57,10 @@ template <typename VecType>
 std::map<typename VecType::Integer, NativeVector> ChineseRemainderTransformFTT<
     VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
 
+template <typename VecType>
+std::atomic<uint64_t>
+    ChineseRemainderTransformFTT<VecType>::m_tablesGeneration(0);
+
 #ifdef WITH_INTEL_HEXL
 template <typename VecType>
 // N, modulus
@@ -115,6 +121,74 @@ std::map<typename VecType::Integer, typename VecType::Integer>
 template <typename VecType>
 std::map<usint, usint> ChineseRemainderTransformArb<VecType>::m_nttDivisionDim;
 
+// 64-bit native vectors are routed to the lazy-reduction kernels of
+// bigintnat::NativeNTT; all other vector types use the loops below.
+template <typename VecType>
+inline bool NativeForwardTransformToBitReverseInPlace(
+    const VecType &rootOfUnityTable, const NativeVector &preconRootOfUnityTable,
+    VecType *element) {
+  return false;
+}
+
+template <typename VecType>
+inline bool NativeInverseTransformFromBitReverseInPlace(
+    const VecType &rootOfUnityInverseTable,
+    const NativeVector &preconRootOfUnityInverseTable,
+    const typename VecType::Integer &cycloOrderInv,
+    const NativeInteger &preconCycloOrderInv, VecType *element) {
+  return false;
+}
+
+#if NATIVEINT == 64
+inline bool NativeForwardTransformToBitReverseInPlace(
+    const NativeVector64 &rootOfUnityTable,
+    const NativeVector &preconRootOfUnityTable, NativeVector64 *element) {
+  usint n = element->GetLength();
+  uint64_t modulus = element->GetModulus().ConvertToInt();
+  if (n == 0 || !bigintnat::NativeNTT::IsSupportedModulus(modulus)) {
+    return false;
+  }
+  bigintnat::NativeNTT::ForwardTransformToBitReverseInPlace(
+      reinterpret_cast<uint64_t *>(&element->at(0)), n, modulus,
+      reinterpret_cast<const uint64_t *>(&rootOfUnityTable.at(0)),
+      reinterpret_cast<const uint64_t *>(&preconRootOfUnityTable.at(0)));
+  return true;
+}
+
+inline bool NativeInverseTransformFromBitReverseInPlace(
+    const NativeVector64 &rootOfUnityInverseTable,
+    const NativeVector &preconRootOfUnityInverseTable,
+    const NativeInteger64 &cycloOrderInv,
+    const NativeInteger &preconCycloOrderInv, NativeVector64 *element) {
+  usint n = element->GetLength();
+  uint64_t modulus = element->GetModulus().ConvertToInt();
+  if (n == 0 || !bigintnat::NativeNTT::IsSupportedModulus(modulus)) {
+    return false;
+  }
+  bigintnat::NativeNTT::InverseTransformFromBitReverseInPlace(
+      reinterpret_cast<uint64_t *>(&element->at(0)), n, modulus,
+      reinterpret_cast<const uint64_t *>(&rootOfUnityInverseTable.at(0)),
+      reinterpret_cast<const uint64_t *>(&preconRootOfUnityInverseTable.at(0)),
+      cycloOrderInv.ConvertToInt(), preconCycloOrderInv.ConvertToInt());
+  return true;
+}
+#endif
+
+// Whether ChineseRemainderTransformFTT::GetNativeTables() can hand out tables
+// for this vector type and modulus.
+template <typename VecType>
+inline bool NativeTablesSupported(const VecType *,
+                                  const typename VecType::Integer &modulus) {
+  return false;
+}
+
+#if NATIVEINT == 64
+inline bool NativeTablesSupported(const NativeVector64 *,
+                                  const NativeInteger64 &modulus) {
+  return bigintnat::NativeNTT::IsSupportedModulus(modulus.ConvertToInt());
+}
+#endif
+
 template <typename VecType>
 void NumberTheoreticTransform<VecType>::ForwardTransformIterative(
     const VecType &element, const VecType &rootOfUnityTable, VecType *result) {
@@ -298,6 +372,11 @@ template <typename VecType>
 void NumberTheoreticTransform<VecType>::ForwardTransformToBitReverseInPlace(
     const VecType &rootOfUnityTable, const NativeVector &preconRootOfUnityTable,
     VecType *element) {
+  if (NativeForwardTransformToBitReverseInPlace(
+          rootOfUnityTable, preconRootOfUnityTable, element)) {
+    return;
+  }
+
   usint n = element->GetLength();
   IntType modulus = element->GetModulus();
 
@@ -359,6 +438,11 @@ void NumberTheoreticTransform<VecType>::ForwardTransformToBitReverse(
     (*result)[i] = element[i];
   }
 
+  if (NativeForwardTransformToBitReverseInPlace(
+          rootOfUnityTable, preconRootOfUnityTable, result)) {
+    return;
+  }
+
   uint32_t indexOmega, indexHi;
   NativeInteger preconOmega;
   IntType omega, omegaFactor, loVal, hiVal, zero(0);
@@ -482,6 +566,12 @@ void NumberTheoreticTransform<VecType>::InverseTransformFromBitReverseInPlace(
     const NativeVector &preconRootOfUnityInverseTable,
     const IntType &cycloOrderInv, const NativeInteger &preconCycloOrderInv,
     VecType *element) {
+  if (NativeInverseTransformFromBitReverseInPlace(
+          rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+          cycloOrderInv, preconCycloOrderInv, element)) {
+    return;
+  }
+
   usint n = element->GetLength();
 
   IntType modulus = element->GetModulus();
@@ -845,6 +935,221 @@ void ChineseRemainderTransformFTT<VecType>::InverseTransformFromBitReverse(
   return;
 }
 
+template <typename VecType>
+void ChineseRemainderTransformFTT<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<IntType> &rootOfUnity, const usint CycloOrder,
+    const std::vector<VecType *> &elements) {
+  if (rootOfUnity.size() != elements.size()) {
+    PALISADE_THROW(math_error,
+                   "size of root of unity and number of elements not of same "
+                   "size");
+  }
+
+  if (!IsPowerOfTwo(CycloOrder)) {
+    PALISADE_THROW(math_error, "CyclotomicOrder is not a power of two");
+  }
+
+  usint CycloOrderHf = (CycloOrder >> 1);
+  usint size = elements.size();
+  bool batch = true;
+  std::vector<std::shared_ptr<const bigintnat::NativeNTTTables>> resolved(size);
+  std::vector<const bigintnat::NativeNTTTables *> tables(size, nullptr);
+  for (usint i = 0; i < size; i++) {
+    if (elements[i]->GetLength() != CycloOrderHf) {
+      PALISADE_THROW(math_error,
+                     "element size must be equal to CyclotomicOrder / 2");
+    }
+    if (batch) {
+      resolved[i] = GetNativeTables(rootOfUnity[i], CycloOrder,
+                                    elements[i]->GetModulus());
+      tables[i] = resolved[i].get();
+      batch = (tables[i] != nullptr);
+    }
+  }
+
+  if (batch) {
+    ForwardTransformToBitReverseInPlace(tables, elements);
+    return;
+  }
+
+  ParallelFor(0, size, [&](size_t i) {
+    ForwardTransformToBitReverseInPlace(rootOfUnity[i], CycloOrder,
+                                        elements[i]);
+  });
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTT<VecType>::
+    InverseTransformFromBitReverseInPlace(
+        const std::vector<IntType> &rootOfUnity, const usint CycloOrder,
+        const std::vector<VecType *> &elements) {
+  if (rootOfUnity.size() != elements.size()) {
+    PALISADE_THROW(math_error,
+                   "size of root of unity and number of elements not of same "
+                   "size");
+  }
+
+  if (!IsPowerOfTwo(CycloOrder)) {
+    PALISADE_THROW(math_error, "CyclotomicOrder is not a power of two");
+  }
+
+  usint CycloOrderHf = (CycloOrder >> 1);
+  usint size = elements.size();
+  bool batch = true;
+  std::vector<std::shared_ptr<const bigintnat::NativeNTTTables>> resolved(size);
+  std::vector<const bigintnat::NativeNTTTables *> tables(size, nullptr);
+  for (usint i = 0; i < size; i++) {
+    if (elements[i]->GetLength() != CycloOrderHf) {
+      PALISADE_THROW(math_error,
+                     "element size must be equal to CyclotomicOrder / 2");
+    }
+    if (batch) {
+      resolved[i] = GetNativeTables(rootOfUnity[i], CycloOrder,
+                                    elements[i]->GetModulus());
+      tables[i] = resolved[i].get();
+      batch = (tables[i] != nullptr);
+    }
+  }
+
+  if (batch) {
+    InverseTransformFromBitReverseInPlace(tables, elements);
+    return;
+  }
+
+  ParallelFor(0, size, [&](size_t i) {
+    InverseTransformFromBitReverseInPlace(rootOfUnity[i], CycloOrder,
+                                          elements[i]);
+  });
+}
+
+template <typename VecType>
+std::shared_ptr<const bigintnat::NativeNTTTables>
+ChineseRemainderTransformFTT<VecType>::GetNativeTables(
+    const IntType &rootOfUnity, const usint CycloOrder,
+    const IntType &modulus) {
+#ifdef WITH_INTEL_HEXL
+  // the HEXL transforms are used instead
+  return nullptr;
+#else
+  if (rootOfUnity == IntType(1) || rootOfUnity == IntType(0) ||
+      !IsPowerOfTwo(CycloOrder) ||
+      !NativeTablesSupported(static_cast<const VecType *>(nullptr), modulus)) {
+    return nullptr;
+  }
+
+  usint CycloOrderHf = (CycloOrder >> 1);
+  usint msb = GetMSB64(CycloOrderHf - 1);
+  auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
+  if (mapSearch == m_rootOfUnityReverseTableByModulus.end() ||
+      mapSearch->second.GetLength() != CycloOrderHf) {
+    PreCompute(rootOfUnity, CycloOrder, modulus);
+    mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
+  }
+
+  auto tables = std::make_shared<bigintnat::NativeNTTTables>();
+  tables->cycloOrder = CycloOrder;
+  tables->modulus = modulus.ConvertToInt();
+  tables->rootOfUnity = rootOfUnity.ConvertToInt();
+  tables->generation = m_tablesGeneration.load();
+  tables->rootOfUnityTable =
+      reinterpret_cast<const uint64_t *>(&mapSearch->second.at(0));
+  tables->preconRootOfUnityTable = reinterpret_cast<const uint64_t *>(
+      &m_rootOfUnityPreconReverseTableByModulus.find(modulus)->second.at(0));
+  tables->rootOfUnityInverseTable = reinterpret_cast<const uint64_t *>(
+      &m_rootOfUnityInverseReverseTableByModulus.find(modulus)->second.at(0));
+  tables->preconRootOfUnityInverseTable = reinterpret_cast<const uint64_t *>(
+      &m_rootOfUnityInversePreconReverseTableByModulus.find(modulus)
+           ->second.at(0));
+  tables->cycloOrderInv =
+      m_cycloOrderInverseTableByModulus.find(modulus)->second[msb]
+          .ConvertToInt();
+  tables->preconCycloOrderInv =
+      m_cycloOrderInversePreconTableByModulus.find(modulus)->second[msb]
+          .ConvertToInt();
+  return tables;
+#endif
+}
+
+template <typename VecType>
+bool ChineseRemainderTransformFTT<VecType>::IsCurrent(
+    const bigintnat::NativeNTTTables &tables, const IntType &rootOfUnity,
+    const usint CycloOrder, const IntType &modulus) {
+  return tables.generation == m_tablesGeneration.load() &&
+         tables.cycloOrder == CycloOrder &&
+         tables.modulus == modulus.ConvertToInt() &&
+         tables.rootOfUnity == rootOfUnity.ConvertToInt();
+}
+
+// collects the raw words of a batch with resolved tables
+template <typename VecType>
+static usint NativeBatchPointers(
+    const std::vector<const bigintnat::NativeNTTTables *> &tables,
+    const std::vector<VecType *> &elements, std::vector<uint64_t *> *data,
+    std::vector<uint64_t> *moduli) {
+  if (tables.size() != elements.size()) {
+    PALISADE_THROW(math_error,
+                   "number of tables and number of elements not of same size");
+  }
+  usint size = elements.size();
+  usint n = (size > 0) ? elements[0]->GetLength() : 0;
+  data->resize(size);
+  moduli->resize(size);
+  for (usint i = 0; i < size; i++) {
+    if (elements[i]->GetLength() != n || (tables[i]->cycloOrder >> 1) != n) {
+      PALISADE_THROW(math_error,
+                     "element size must be equal to CyclotomicOrder / 2");
+    }
+    (*data)[i] = reinterpret_cast<uint64_t *>(&elements[i]->at(0));
+    (*moduli)[i] = tables[i]->modulus;
+  }
+  return n;
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTT<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<const bigintnat::NativeNTTTables *> &tables,
+    const std::vector<VecType *> &elements) {
+  std::vector<uint64_t *> data;
+  std::vector<uint64_t> moduli;
+  usint n = NativeBatchPointers(tables, elements, &data, &moduli);
+  if (n == 0) {
+    return;
+  }
+  usint size = elements.size();
+  std::vector<const uint64_t *> w(size), wPrecon(size);
+  for (usint i = 0; i < size; i++) {
+    w[i] = tables[i]->rootOfUnityTable;
+    wPrecon[i] = tables[i]->preconRootOfUnityTable;
+  }
+  bigintnat::NativeNTT::ForwardTransformToBitReverseInPlace(
+      data.data(), size, n, moduli.data(), w.data(), wPrecon.data());
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTT<VecType>::
+    InverseTransformFromBitReverseInPlace(
+        const std::vector<const bigintnat::NativeNTTTables *> &tables,
+        const std::vector<VecType *> &elements) {
+  std::vector<uint64_t *> data;
+  std::vector<uint64_t> moduli;
+  usint n = NativeBatchPointers(tables, elements, &data, &moduli);
+  if (n == 0) {
+    return;
+  }
+  usint size = elements.size();
+  std::vector<const uint64_t *> w(size), wPrecon(size);
+  std::vector<uint64_t> scale(size), preconScale(size);
+  for (usint i = 0; i < size; i++) {
+    w[i] = tables[i]->rootOfUnityInverseTable;
+    wPrecon[i] = tables[i]->preconRootOfUnityInverseTable;
+    scale[i] = tables[i]->cycloOrderInv;
+    preconScale[i] = tables[i]->preconCycloOrderInv;
+  }
+  bigintnat::NativeNTT::InverseTransformFromBitReverseInPlace(
+      data.data(), size, n, moduli.data(), w.data(), wPrecon.data(),
+      scale.data(), preconScale.data());
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTT<VecType>::PreCompute(
     const IntType &rootOfUnity, const usint CycloOrder,
@@ -910,6 +1215,8 @@ void ChineseRemainderTransformFTT<VecType>::PreCompute(
         m_rootOfUnityInversePreconReverseTableByModulus[modulus] = preconTableI;
         m_cycloOrderInversePreconTableByModulus[modulus] = preconTableCOI;
       }
+      // the assignments above may have replaced tables handed out earlier
+      m_tablesGeneration++;
     }
   }
 }
@@ -942,6 +1249,7 @@ void ChineseRemainderTransformFTT<VecType>::Reset() {
   m_rootOfUnityInverseReverseTableByModulus.clear();
   m_rootOfUnityPreconReverseTableByModulus.clear();
   m_rootOfUnityInversePreconReverseTableByModulus.clear();
+  m_tablesGeneration++;
 }
 
 template <typename VecType>
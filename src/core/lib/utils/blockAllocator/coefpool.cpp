@@ -0,0 +1,276 @@
+// @file coefpool.cpp This file contains the thread-caching size-class pool
+// used for the coefficient buffers of native vectors
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#include "utils/blockAllocator/coefpool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+namespace lbcrypto {
+
+static std::atomic<bool> coefPoolEnabled(false);
+
+// bytes in the free lists of all threads, and their limit
+static std::atomic<size_t> cachedBytes(0);
+static std::atomic<size_t> maxCachedBytes(
+    CoefficientPool::DEFAULT_MAX_CACHED_BYTES);
+
+// returns the size class of a request, or -1 if it is not pooled
+static inline int SizeClass(size_t bytes) {
+  if (bytes < CoefficientPool::MIN_BLOCK_SIZE ||
+      bytes > CoefficientPool::MAX_BLOCK_SIZE || (bytes & (bytes - 1)) != 0) {
+    return -1;
+  }
+  int index = 0;
+  for (size_t size = CoefficientPool::MIN_BLOCK_SIZE; size < bytes; size <<= 1)
+    index++;
+  return index;
+}
+
+// counters are only written by the owning thread, so relaxed load/store
+// pairs are enough and no cache line is shared between writers
+static inline void Bump(std::atomic<uint64_t> &counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+namespace {
+
+struct ThreadCache {
+  std::vector<void *> freeLists[CoefficientPool::NUM_SIZE_CLASSES];
+  std::atomic<uint64_t> allocations[CoefficientPool::NUM_SIZE_CLASSES];
+  std::atomic<uint64_t> hits[CoefficientPool::NUM_SIZE_CLASSES];
+  std::atomic<uint64_t> deallocations[CoefficientPool::NUM_SIZE_CLASSES];
+  std::atomic<uint64_t> releases[CoefficientPool::NUM_SIZE_CLASSES];
+  // set by Trim() on other threads
+  std::atomic<bool> trimRequested;
+
+  ThreadCache();
+  ~ThreadCache();
+
+  // returns all free blocks to the heap; only called by the owning thread
+  void Release();
+};
+
+// all live thread caches plus the counters of the threads that have exited;
+// the lock is only taken when a thread starts or stops using the pool and
+// when the statistics are read
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadCache *> caches;
+  uint64_t allocations[CoefficientPool::NUM_SIZE_CLASSES] = {};
+  uint64_t hits[CoefficientPool::NUM_SIZE_CLASSES] = {};
+  uint64_t deallocations[CoefficientPool::NUM_SIZE_CLASSES] = {};
+  uint64_t releases[CoefficientPool::NUM_SIZE_CLASSES] = {};
+};
+
+// never destroyed, as worker threads may still release blocks during exit
+Registry &GetRegistry() {
+  static Registry *registry = new Registry();
+  return *registry;
+}
+
+ThreadCache::ThreadCache() {
+  for (size_t i = 0; i < CoefficientPool::NUM_SIZE_CLASSES; i++) {
+    freeLists[i].reserve(CoefficientPool::MAX_CACHED_BLOCKS);
+    allocations[i] = 0;
+    hits[i] = 0;
+    deallocations[i] = 0;
+    releases[i] = 0;
+  }
+  trimRequested = false;
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.caches.push_back(this);
+}
+
+ThreadCache::~ThreadCache() {
+  Release();
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (size_t i = 0; i < CoefficientPool::NUM_SIZE_CLASSES; i++) {
+    registry.allocations[i] += allocations[i];
+    registry.hits[i] += hits[i];
+    registry.deallocations[i] += deallocations[i];
+    registry.releases[i] += releases[i];
+  }
+  for (size_t i = 0; i < registry.caches.size(); i++) {
+    if (registry.caches[i] == this) {
+      registry.caches.erase(registry.caches.begin() + i);
+      break;
+    }
+  }
+}
+
+void ThreadCache::Release() {
+  trimRequested.store(false, std::memory_order_relaxed);
+  for (size_t i = 0; i < CoefficientPool::NUM_SIZE_CLASSES; i++) {
+    size_t count = freeLists[i].size();
+    if (count == 0) continue;
+    for (void *p : freeLists[i]) ::operator delete(p);
+    freeLists[i].clear();
+    releases[i].store(releases[i].load(std::memory_order_relaxed) + count,
+                      std::memory_order_relaxed);
+    cachedBytes.fetch_sub(count * (CoefficientPool::MIN_BLOCK_SIZE << i),
+                          std::memory_order_relaxed);
+  }
+}
+
+// plain pointers stay usable while the thread is torn down, after the holder
+// below has been destroyed
+thread_local ThreadCache *tlsCache = nullptr;
+thread_local bool tlsCacheDestroyed = false;
+
+struct ThreadCacheHolder {
+  ThreadCacheHolder() { tlsCache = new ThreadCache(); }
+  ~ThreadCacheHolder() {
+    delete tlsCache;
+    tlsCache = nullptr;
+    tlsCacheDestroyed = true;
+  }
+};
+
+ThreadCache *GetThreadCache() {
+  if (tlsCache != nullptr || tlsCacheDestroyed) return tlsCache;
+  static thread_local ThreadCacheHolder holder;
+  return tlsCache;
+}
+
+// takes room for a free block in the limit shared by all threads
+bool ReserveCachedBytes(size_t bytes) {
+  size_t cached = cachedBytes.fetch_add(bytes, std::memory_order_relaxed);
+  if (cached + bytes <= maxCachedBytes.load(std::memory_order_relaxed))
+    return true;
+  cachedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  return false;
+}
+
+}  // namespace
+
+void *CoefficientPool::Allocate(size_t bytes) {
+  int sc = IsEnabled() ? SizeClass(bytes) : -1;
+  ThreadCache *cache = (sc < 0) ? nullptr : GetThreadCache();
+  if (cache == nullptr) {
+    return ::operator new(bytes);
+  }
+  if (cache->trimRequested.load(std::memory_order_relaxed)) cache->Release();
+  Bump(cache->allocations[sc]);
+  if (!cache->freeLists[sc].empty()) {
+    void *p = cache->freeLists[sc].back();
+    cache->freeLists[sc].pop_back();
+    cachedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    Bump(cache->hits[sc]);
+    return p;
+  }
+  return ::operator new(bytes);
+}
+
+void CoefficientPool::Deallocate(void *p, size_t bytes) noexcept {
+  if (p == nullptr) return;
+  int sc = IsEnabled() ? SizeClass(bytes) : -1;
+  // creating the cache of the thread allocates and locks the registry, so
+  // only an existing cache is used; the free lists never grow past their
+  // reserved capacity
+  ThreadCache *cache = (sc < 0) ? nullptr : tlsCache;
+  if (cache == nullptr) {
+    ::operator delete(p);
+    return;
+  }
+  if (cache->trimRequested.load(std::memory_order_relaxed)) cache->Release();
+  Bump(cache->deallocations[sc]);
+  if (cache->freeLists[sc].size() < MAX_CACHED_BLOCKS &&
+      ReserveCachedBytes(bytes)) {
+    cache->freeLists[sc].push_back(p);
+  } else {
+    Bump(cache->releases[sc]);
+    ::operator delete(p);
+  }
+}
+
+bool CoefficientPool::IsEnabled() {
+  return coefPoolEnabled.load(std::memory_order_relaxed);
+}
+
+void CoefficientPool::SetEnabled(bool enabled) {
+  coefPoolEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void CoefficientPool::Trim() {
+  {
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (ThreadCache *cache : registry.caches)
+      cache->trimRequested.store(true, std::memory_order_relaxed);
+  }
+  if (tlsCache != nullptr) tlsCache->Release();
+}
+
+size_t CoefficientPool::GetCachedBytes() {
+  return cachedBytes.load(std::memory_order_relaxed);
+}
+
+size_t CoefficientPool::GetMaxCachedBytes() {
+  return maxCachedBytes.load(std::memory_order_relaxed);
+}
+
+void CoefficientPool::SetMaxCachedBytes(size_t bytes) {
+  maxCachedBytes.store(bytes, std::memory_order_relaxed);
+}
+
+std::vector<CoefficientPool::Stats> CoefficientPool::GetStats() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  std::vector<Stats> result;
+  for (size_t i = 0; i < NUM_SIZE_CLASSES; i++) {
+    Stats s;
+    s.blockSize = MIN_BLOCK_SIZE << i;
+    s.allocations = registry.allocations[i];
+    s.hits = registry.hits[i];
+    s.deallocations = registry.deallocations[i];
+    s.releases = registry.releases[i];
+    for (ThreadCache *cache : registry.caches) {
+      s.allocations += cache->allocations[i].load(std::memory_order_relaxed);
+      s.hits += cache->hits[i].load(std::memory_order_relaxed);
+      s.deallocations +=
+          cache->deallocations[i].load(std::memory_order_relaxed);
+      s.releases += cache->releases[i].load(std::memory_order_relaxed);
+    }
+    if (s.allocations != 0 || s.deallocations != 0) result.push_back(s);
+  }
+  return result;
+}
+
+void CoefficientPool::PrintStats(std::ostream &os) {
+  for (const Stats &s : GetStats()) {
+    os << "CoefficientPool Block Size: " << s.blockSize;
+    os << " Allocations: " << s.allocations;
+    os << " Hits: " << s.hits;
+    os << " Hit Rate: " << s.HitRate();
+    os << " Deallocations: " << s.deallocations;
+    os << " Released: " << s.releases;
+    os << std::endl;
+  }
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,73 @@
+// @file cpufeatures.cpp This file contains the runtime detection and
+// selection of the SIMD instruction sets used by the native math kernels
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "utils/cpufeatures.h"
+
+#include <atomic>
+
+namespace lbcrypto {
+
+static SIMDLevel DetectSIMDLevel() {
+#ifdef PALISADE_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+    return SIMD_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_AVX2;
+  }
+#endif
+  return SIMD_SCALAR;
+}
+
+static const SIMDLevel supportedSIMDLevel = DetectSIMDLevel();
+static std::atomic<int> currentSIMDLevel(supportedSIMDLevel);
+
+SIMDLevel CPUFeatures::GetSupportedSIMDLevel() { return supportedSIMDLevel; }
+
+SIMDLevel CPUFeatures::GetSIMDLevel() {
+  return static_cast<SIMDLevel>(
+      currentSIMDLevel.load(std::memory_order_relaxed));
+}
+
+SIMDLevel CPUFeatures::SetSIMDLevel(SIMDLevel level) {
+  if (level > supportedSIMDLevel) {
+    level = supportedSIMDLevel;
+  }
+  currentSIMDLevel.store(level, std::memory_order_relaxed);
+  return level;
+}
+
+std::string CPUFeatures::SIMDLevelToString(SIMDLevel level) {
+  switch (level) {
+    case SIMD_AVX512:
+      return "AVX512";
+    case SIMD_AVX2:
+      return "AVX2";
+    default:
+      return "SCALAR";
+  }
+}
+
+}  // namespace lbcrypto
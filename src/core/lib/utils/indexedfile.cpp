@@ -0,0 +1,190 @@
+// @file indexedfile.cpp This file contains the implementation of the indexed
+// container of binary records
+// @author TPOC: contact@palisade-crypto.org
+//
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#include "utils/indexedfile.h"
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PALISADE_HAVE_MMAP
+#endif
+
+#include "utils/exception.h"
+
+namespace lbcrypto {
+
+static const char INDEXED_FILE_MAGIC[8] = {'P', 'A', 'L', 'I',
+                                           'D', 'X', '0', '1'};
+
+// each index entry holds the id, offset and length of a record
+static const size_t INDEX_ENTRY_WORDS = 3;
+
+static void WriteWord(std::ostream& out, uint64_t value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+IndexedFileWriter::IndexedFileWriter(const std::string& filename,
+                                     const std::string& header,
+                                     size_t numRecords)
+    : m_file(filename, std::ios::out | std::ios::binary | std::ios::trunc),
+      m_numRecords(numRecords) {
+  if (!m_file.is_open())
+    PALISADE_THROW(config_error, "Could not open " + filename);
+
+  m_file.write(INDEXED_FILE_MAGIC, sizeof(INDEXED_FILE_MAGIC));
+  WriteWord(m_file, header.size());
+  m_file.write(header.data(), header.size());
+  WriteWord(m_file, numRecords);
+
+  // the index is filled in by Close()
+  m_indexOffset = m_file.tellp();
+  std::vector<char> placeholder(numRecords * INDEX_ENTRY_WORDS *
+                                sizeof(uint64_t));
+  m_file.write(placeholder.data(), placeholder.size());
+  m_index.reserve(numRecords * INDEX_ENTRY_WORDS);
+}
+
+IndexedFileWriter::~IndexedFileWriter() {
+  if (m_file.is_open()) m_file.close();
+}
+
+void IndexedFileWriter::Append(uint64_t id, const std::string& record) {
+  if (m_index.size() == m_numRecords * INDEX_ENTRY_WORDS)
+    PALISADE_THROW(config_error, "IndexedFileWriter: too many records");
+
+  m_index.push_back(id);
+  m_index.push_back(m_file.tellp());
+  m_index.push_back(record.size());
+  m_file.write(record.data(), record.size());
+}
+
+void IndexedFileWriter::Close() {
+  if (m_index.size() != m_numRecords * INDEX_ENTRY_WORDS)
+    PALISADE_THROW(config_error, "IndexedFileWriter: missing records");
+
+  m_file.seekp(m_indexOffset);
+  for (auto word : m_index) WriteWord(m_file, word);
+  m_file.close();
+  if (m_file.fail())
+    PALISADE_THROW(config_error, "IndexedFileWriter: write failed");
+}
+
+IndexedFileReader::IndexedFileReader(const std::string& filename)
+    : m_data(nullptr), m_size(0), m_mapped(false) {
+#ifdef PALISADE_HAVE_MMAP
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) PALISADE_THROW(config_error, "Could not open " + filename);
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    PALISADE_THROW(config_error, "Could not stat " + filename);
+  }
+  m_size = st.st_size;
+  if (m_size > 0) {
+    void* addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      PALISADE_THROW(config_error, "Could not map " + filename);
+    }
+    m_data = static_cast<const char*>(addr);
+    m_mapped = true;
+  }
+  close(fd);
+#else
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    PALISADE_THROW(config_error, "Could not open " + filename);
+  file.seekg(0, std::ios::end);
+  m_size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  char* buffer = new char[m_size];
+  file.read(buffer, m_size);
+  m_data = buffer;
+#endif
+
+  // parses the header and the index
+  size_t pos = 0;
+  auto readWord = [&]() {
+    if (pos + sizeof(uint64_t) > m_size)
+      PALISADE_THROW(config_error, filename + " is truncated");
+    uint64_t value;
+    std::memcpy(&value, m_data + pos, sizeof(value));
+    pos += sizeof(value);
+    return value;
+  };
+
+  try {
+    if (m_size < sizeof(INDEXED_FILE_MAGIC) ||
+        std::memcmp(m_data, INDEXED_FILE_MAGIC, sizeof(INDEXED_FILE_MAGIC)))
+      PALISADE_THROW(config_error, filename + " is not an indexed file");
+    pos = sizeof(INDEXED_FILE_MAGIC);
+
+    uint64_t headerSize = readWord();
+    if (headerSize > m_size - pos)
+      PALISADE_THROW(config_error, filename + " is truncated");
+    m_header.assign(m_data + pos, headerSize);
+    pos += headerSize;
+
+    uint64_t numRecords = readWord();
+    m_ids.reserve(numRecords);
+    for (uint64_t i = 0; i < numRecords; i++) {
+      uint64_t id = readWord();
+      uint64_t offset = readWord();
+      uint64_t length = readWord();
+      if (offset > m_size || length > m_size - offset)
+        PALISADE_THROW(config_error, filename + " has an invalid index");
+      m_ids.push_back(id);
+      m_records[id] = std::make_pair(offset, length);
+    }
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+IndexedFileReader::~IndexedFileReader() { Release(); }
+
+void IndexedFileReader::Release() {
+  if (m_data == nullptr) return;
+#ifdef PALISADE_HAVE_MMAP
+  if (m_mapped) munmap(const_cast<char*>(m_data), m_size);
+#else
+  delete[] m_data;
+#endif
+  m_data = nullptr;
+}
+
+std::pair<const char*, size_t> IndexedFileReader::GetRecord(uint64_t id) const {
+  auto it = m_records.find(id);
+  if (it == m_records.end())
+    PALISADE_THROW(not_available_error,
+                   "IndexedFileReader: no record with id " + std::to_string(id));
+  return std::make_pair(m_data + it->second.first, it->second.second);
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,64 @@
+// @file limbbuffer.cpp This file contains the aligned single-buffer storage
+// used for the towers of a DCRTPoly
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+
+#include "utils/limbbuffer.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace lbcrypto {
+
+static std::atomic<bool> limbBufferEnabled(false);
+
+LimbBuffer::LimbBuffer(size_t capacity)
+    : m_raw(nullptr), m_begin(nullptr), m_capacity(capacity), m_used(0) {
+  m_raw = std::malloc(capacity + ALIGNMENT);
+  if (m_raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  uintptr_t addr = reinterpret_cast<uintptr_t>(m_raw);
+  m_begin = reinterpret_cast<char *>((addr + ALIGNMENT - 1) &
+                                     ~uintptr_t(ALIGNMENT - 1));
+}
+
+LimbBuffer::~LimbBuffer() { std::free(m_raw); }
+
+void *LimbBuffer::Allocate(size_t bytes) {
+  size_t stride = Stride(bytes);
+  size_t offset = m_used.fetch_add(stride, std::memory_order_relaxed);
+  if (offset + stride > m_capacity) {
+    return nullptr;
+  }
+  return m_begin + offset;
+}
+
+bool LimbBuffer::IsEnabled() {
+  return limbBufferEnabled.load(std::memory_order_relaxed);
+}
+
+void LimbBuffer::SetEnabled(bool enabled) {
+  limbBufferEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,320 @@
+// @file scheduler.cpp This file contains the OpenMP and work-stealing
+// executors of the library parallel loops
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "utils/scheduler.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+namespace lbcrypto {
+
+// the executor loops started by the current thread run on, if not the global
+// one
+static thread_local ParallelExecutor *t_scoped = nullptr;
+
+void OpenMPExecutor::ParallelFor(size_t begin, size_t end,
+                                 const std::function<void(size_t)> &body) {
+  if (end <= begin) return;
+  if (end - begin == 1) {
+    body(begin);
+    return;
+  }
+  ThreadException e;
+#ifdef PARALLEL
+  int numThreads = static_cast<int>(GetConcurrency());
+#endif
+#pragma omp parallel for num_threads(numThreads)
+  for (size_t i = begin; i < end; ++i) {
+    // loops nested in body stay on this executor
+    ParallelExecutor *previous = t_scoped;
+    t_scoped = this;
+    try {
+      body(i);
+    } catch (...) {
+      e.CaptureException();
+    }
+    t_scoped = previous;
+  }
+  e.Rethrow();
+}
+
+size_t OpenMPExecutor::GetConcurrency() const {
+  if (m_numThreads != 0) return m_numThreads;
+#ifdef PARALLEL
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// the loop a group of tasks belongs to; lives on the stack of the thread that
+// called ParallelFor, which does not return before pending drops to zero
+struct WorkStealingExecutor::Group {
+  const std::function<void(size_t)> *body;
+  // pending and error are guarded by mutex
+  size_t pending;
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr error;
+};
+
+// the pool the current thread belongs to, if any, and its index in the pool
+static thread_local const void *t_pool = nullptr;
+static thread_local size_t t_workerIndex = 0;
+
+WorkStealingExecutor::WorkStealingExecutor(size_t numThreads,
+                                           const std::vector<int> &cpus)
+    : m_numQueued(0), m_stop(false) {
+  if (numThreads == 0) {
+    numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+#if defined(__linux__)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      PALISADE_THROW(config_error,
+                     "CPU index " + std::to_string(cpu) + " is out of range");
+    }
+    CPU_SET(cpu, &cpuSet);
+  }
+#endif
+  for (size_t i = 0; i < numThreads; ++i) {
+    m_workers.emplace_back(new Worker());
+  }
+  for (size_t i = 0; i < numThreads; ++i) {
+    m_workers[i]->thread =
+        std::thread(&WorkStealingExecutor::WorkerLoop, this, i);
+  }
+#if defined(__linux__)
+  if (!cpus.empty()) {
+    for (auto &w : m_workers) {
+      if (pthread_setaffinity_np(w->thread.native_handle(), sizeof(cpuSet),
+                                 &cpuSet) != 0) {
+        Shutdown();
+        PALISADE_THROW(config_error,
+                       "Worker threads cannot be restricted to the given "
+                       "CPUs");
+      }
+    }
+  }
+#endif
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() { Shutdown(); }
+
+void WorkStealingExecutor::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (auto &w : m_workers) {
+    if (w->thread.joinable()) w->thread.join();
+  }
+}
+
+void WorkStealingExecutor::ParallelFor(
+    size_t begin, size_t end, const std::function<void(size_t)> &body) {
+  if (end <= begin) return;
+  bool worker = (t_pool == this);
+  size_t n = end - begin;
+  if (worker && n == 1) {
+    body(begin);
+    return;
+  }
+  // a few tasks per thread so that uneven iterations still balance
+  size_t numTasks = std::min(n, 4 * m_workers.size());
+  size_t chunk = (n + numTasks - 1) / numTasks;
+  numTasks = (n + chunk - 1) / chunk;
+
+  Group group;
+  group.body = &body;
+  group.pending = numTasks;
+  // threads outside the pool do not compute: they may run on any CPU and
+  // would exceed the number of threads of the pool
+  for (size_t t = worker ? 1 : 0; t < numTasks; ++t) {
+    size_t b = begin + t * chunk;
+    Push(Task{&group, b, std::min(end, b + chunk)});
+  }
+  if (worker) {
+    Run(Task{&group, begin, std::min(end, begin + chunk)});
+    // help with whatever is queued, including tasks of other loops; once
+    // nothing is queued, the remaining tasks of this loop are running on
+    // other workers and there is nothing left to do but wait for them
+    Task task;
+    while (Pop(t_workerIndex, &task)) {
+      Run(task);
+    }
+  }
+  std::unique_lock<std::mutex> lock(group.mutex);
+  group.done.wait(lock, [&group] { return group.pending == 0; });
+  if (group.error) std::rethrow_exception(group.error);
+}
+
+void WorkStealingExecutor::Push(const Task &task) {
+  m_numQueued.fetch_add(1);
+  if (t_pool == this) {
+    Worker &w = *m_workers[t_workerIndex];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    w.tasks.push_back(task);
+  } else {
+    std::lock_guard<std::mutex> lock(m_injectMutex);
+    m_inject.push_back(task);
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+  }
+  m_wake.notify_one();
+}
+
+// own deque first (newest task, hottest in cache), then tasks submitted from
+// outside the pool, then the oldest task of another worker
+bool WorkStealingExecutor::Pop(size_t self, Task *task) {
+  size_t numWorkers = m_workers.size();
+  if (self < numWorkers) {
+    Worker &w = *m_workers[self];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (!w.tasks.empty()) {
+      *task = w.tasks.back();
+      w.tasks.pop_back();
+      m_numQueued.fetch_sub(1);
+      return true;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_injectMutex);
+    if (!m_inject.empty()) {
+      *task = m_inject.front();
+      m_inject.pop_front();
+      m_numQueued.fetch_sub(1);
+      return true;
+    }
+  }
+  for (size_t k = 1; k <= numWorkers; ++k) {
+    size_t victim = (self + k) % numWorkers;
+    if (victim == self) continue;
+    Worker &w = *m_workers[victim];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (!w.tasks.empty()) {
+      *task = w.tasks.front();
+      w.tasks.pop_front();
+      m_numQueued.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::Run(const Task &task) {
+  Group *group = task.group;
+  std::exception_ptr error;
+  try {
+    for (size_t i = task.begin; i < task.end; ++i) {
+      (*group->body)(i);
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+  // the group may be destroyed as soon as pending reaches zero and the mutex
+  // is released, so the owner is notified under the lock
+  std::lock_guard<std::mutex> lock(group->mutex);
+  if (error && !group->error) group->error = error;
+  if (--group->pending == 0) group->done.notify_all();
+}
+
+void WorkStealingExecutor::WorkerLoop(size_t index) {
+  t_pool = this;
+  t_workerIndex = index;
+  t_scoped = this;
+#ifdef PARALLEL
+  // OpenMP loops inside tasks run on the worker itself; parallelism comes
+  // from the pool
+  omp_set_num_threads(1);
+#endif
+  while (true) {
+    Task task;
+    if (Pop(index, &task)) {
+      Run(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_wake.wait(lock, [this] { return m_stop || m_numQueued.load() != 0; });
+    if (m_stop && m_numQueued.load() == 0) return;
+  }
+}
+
+static std::shared_ptr<ParallelExecutor> s_executor;
+
+std::shared_ptr<ParallelExecutor> ParallelScheduler::GetExecutor() {
+  static std::shared_ptr<ParallelExecutor> defaultExecutor =
+      std::make_shared<OpenMPExecutor>();
+  std::shared_ptr<ParallelExecutor> executor = std::atomic_load(&s_executor);
+  return executor ? executor : defaultExecutor;
+}
+
+void ParallelScheduler::SetExecutor(
+    std::shared_ptr<ParallelExecutor> executor) {
+  std::atomic_store(&s_executor, std::move(executor));
+}
+
+ParallelExecutor *ParallelScheduler::GetScopedExecutor() { return t_scoped; }
+
+void ParallelScheduler::SetScopedExecutor(ParallelExecutor *executor) {
+  t_scoped = executor;
+}
+
+ParallelScope::ParallelScope(std::shared_ptr<ParallelExecutor> executor)
+    : m_executor(std::move(executor)),
+      m_previous(nullptr),
+      m_previousThreads(0) {
+  if (!m_executor) return;
+  m_previous = ParallelScheduler::GetScopedExecutor();
+  ParallelScheduler::SetScopedExecutor(m_executor.get());
+#ifdef PARALLEL
+  // keep the OpenMP loops of the current thread within the budget too
+  int budget = static_cast<int>(m_executor->GetOpenMPConcurrency());
+  if (budget < omp_get_max_threads()) {
+    m_previousThreads = omp_get_max_threads();
+    omp_set_num_threads(budget);
+  }
+#endif
+}
+
+ParallelScope::~ParallelScope() {
+  if (!m_executor) return;
+  ParallelScheduler::SetScopedExecutor(m_previous);
+#ifdef PARALLEL
+  if (m_previousThreads != 0) omp_set_num_threads(m_previousThreads);
+#endif
+}
+
+}  // namespace lbcrypto
@@ -33,7 +33,10 @@
 #include "lattice/ilelement.h"
 #include "lattice/ilparams.h"
 #include "lattice/poly.h"
+#include "math/distrgen.h"
+#include "math/nbtheory.h"
 #include "testdefs.h"
+#include "utils/cpufeatures.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
 #include "utils/utilities.h"
@@ -548,3 +551,51 @@ void modmul_vector(const string& msg) {
 TEST(UTBinVect, modmul_vector) {
   RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+// the element-wise kernels used for NativeVector must agree with the integer
+// arithmetic for every instruction set supported by the processor; the
+// lengths cover full SIMD blocks as well as scalar tails
+TEST(UTBinVect, native_simd_kernels_match_scalar) {
+  SIMDLevel supported = CPUFeatures::GetSupportedSIMDLevel();
+
+  for (usint bits : {20, 40, MAX_MODULUS_SIZE - 1}) {
+    NativeInteger modulus = FirstPrime<NativeInteger>(bits, 2048);
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    dug.SetModulus(modulus);
+
+    for (usint n : {1, 7, 16, 1031}) {
+      NativeVector a = dug.GenerateVector(n);
+      NativeVector b = dug.GenerateVector(n);
+      NativeInteger c = dug.GenerateInteger();
+      // the largest residues exercise the final corrections
+      a[0] = modulus - 1;
+      b[0] = modulus - 1;
+
+      for (int level = SIMD_SCALAR; level <= supported; level++) {
+        std::string msg = "bits = " + std::to_string(bits) +
+                          ", n = " + std::to_string(n) + ", " +
+                          CPUFeatures::SIMDLevelToString(SIMDLevel(level));
+        CPUFeatures::SetSIMDLevel(SIMDLevel(level));
+
+        NativeVector sum = a.ModAdd(b);
+        NativeVector diff = a.ModSub(b);
+        NativeVector prod = a.ModMul(b);
+        NativeVector scaled = a.ModMul(c);
+        for (usint i = 0; i < n; i++) {
+          EXPECT_EQ(a[i].ModAdd(b[i], modulus), sum[i]) << msg;
+          EXPECT_EQ(a[i].ModSub(b[i], modulus), diff[i]) << msg;
+          EXPECT_EQ(a[i].ModMul(b[i], modulus), prod[i]) << msg;
+          EXPECT_EQ(a[i].ModMul(c, modulus), scaled[i]) << msg;
+        }
+
+        NativeVector x(a);
+        x.ModMulEq(b);
+        x.ModSubEq(a);
+        x.ModAddEq(a);
+        x.ModMulEq(c);
+        EXPECT_EQ(prod.ModMul(c), x) << msg;
+      }
+    }
+  }
+  CPUFeatures::SetSIMDLevel(supported);
+}
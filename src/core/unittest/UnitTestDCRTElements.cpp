@@ -25,6 +25,9 @@ This code tests the transform feature of the PALISADE lattice encryption
 library.
 */
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include "gtest/gtest.h"
@@ -35,6 +38,7 @@ library.
 #include "math/distrgen.h"
 #include "testdefs.h"
 #include "utils/exception.h"
+#include "utils/scheduler.h"
 
 using namespace std;
 using namespace lbcrypto;
@@ -648,6 +652,289 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
                     "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+TEST(UTDCRTPoly, DCRT_key_switch_inner_product) {
+  usint m = 16;
+  usint sizeQ = 3;
+  usint sizeQl = 2;
+  usint sizeP = 2;
+  usint numDigits = 3;
+
+  std::vector<NativeInteger> moduli(sizeQ + sizeP);
+  std::vector<NativeInteger> roots(sizeQ + sizeP);
+  moduli[0] = FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  roots[0] = RootOfUnity(m, moduli[0]);
+  for (usint i = 1; i < sizeQ + sizeP; i++) {
+    moduli[i] = PreviousPrime<NativeInteger>(moduli[i - 1], m);
+    roots[i] = RootOfUnity(m, moduli[i]);
+  }
+
+  std::vector<NativeInteger> moduliQlP, rootsQlP;
+  for (usint i = 0; i < sizeQl; i++) {
+    moduliQlP.push_back(moduli[i]);
+    rootsQlP.push_back(roots[i]);
+  }
+  for (usint i = sizeQ; i < sizeQ + sizeP; i++) {
+    moduliQlP.push_back(moduli[i]);
+    rootsQlP.push_back(roots[i]);
+  }
+  auto paramsQP = std::make_shared<ILDCRTParams<BigInteger>>(m, moduli, roots);
+  auto paramsQlP =
+      std::make_shared<ILDCRTParams<BigInteger>>(m, moduliQlP, rootsQlP);
+
+  // 2^128 / q
+  const BigInteger barrettBase("340282366920938463463374607431768211456");
+  const BigInteger twoPower64("18446744073709551616");
+  std::vector<DoubleNativeInt> modqBarrettMu(sizeQ), modpBarrettMu(sizeP);
+  for (usint i = 0; i < sizeQ + sizeP; i++) {
+    BigInteger mu = barrettBase / BigInteger(moduli[i]);
+    uint64_t val[2];
+    val[0] = (mu % twoPower64).ConvertToInt();
+    val[1] = mu.RShift(64).ConvertToInt();
+    memcpy((i < sizeQ) ? &modqBarrettMu[i] : &modpBarrettMu[i - sizeQ], val,
+           sizeof(DoubleNativeInt));
+  }
+
+  DCRTPoly::DugType dug;
+  std::vector<DCRTPoly> digits, bv, av;
+  for (usint j = 0; j < numDigits; j++) {
+    digits.push_back(DCRTPoly(dug, paramsQlP, Format::EVALUATION));
+    bv.push_back(DCRTPoly(dug, paramsQP, Format::EVALUATION));
+    av.push_back(DCRTPoly(dug, paramsQP, Format::EVALUATION));
+  }
+
+  DCRTPoly sum0(paramsQlP, Format::EVALUATION, true);
+  DCRTPoly sum1(paramsQlP, Format::EVALUATION, true);
+  DCRTPoly::KeySwitchInnerProduct(digits, bv, av, sizeQ, modqBarrettMu,
+                                  modpBarrettMu, &sum0, &sum1);
+
+  for (usint i = 0; i < sizeQl + sizeP; i++) {
+    usint idx = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+    NativePoly expected0 = digits[0].GetElementAtIndex(i) *
+                           bv[0].GetElementAtIndex(idx);
+    NativePoly expected1 = digits[0].GetElementAtIndex(i) *
+                           av[0].GetElementAtIndex(idx);
+    for (usint j = 1; j < numDigits; j++) {
+      expected0 += digits[j].GetElementAtIndex(i) * bv[j].GetElementAtIndex(idx);
+      expected1 += digits[j].GetElementAtIndex(i) * av[j].GetElementAtIndex(idx);
+    }
+    EXPECT_EQ(expected0, sum0.GetElementAtIndex(i)) << "tower " << i;
+    EXPECT_EQ(expected1, sum1.GetElementAtIndex(i)) << "tower " << i;
+  }
+}
+
+TEST(UTDCRTPoly, DCRT_contiguous_storage) {
+  usint order = 16;
+  usint nBits = 24;
+  usint towersize = 4;
+
+  auto params = GenerateDCRTParams<BigInteger>(order, towersize, nBits);
+
+  DCRTPoly::DugType dug;
+  DCRTPoly op1(dug, params);
+  DCRTPoly op2(dug, params);
+  DCRTPoly expectedSum = op1 + op2;
+  DCRTPoly expectedProd = op1 * op2;
+
+  DCRTPoly::SetContiguousStorage(true);
+
+  DCRTPoly zero(params, Format::EVALUATION, true);
+  EXPECT_TRUE(zero.IsContiguous());
+  EXPECT_EQ(NativeInteger(0), zero.GetElementAtIndex(towersize - 1).at(0));
+
+  DCRTPoly copy(op1);
+  EXPECT_TRUE(copy.IsContiguous());
+  EXPECT_EQ(op1, copy);
+  for (usint i = 0; i < towersize; i++) {
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(
+                      &copy.GetElementAtIndex(i).GetValues()[0]) %
+                      LimbBuffer::ALIGNMENT)
+        << "tower " << i;
+  }
+
+  DCRTPoly sum = op1 + op2;
+  DCRTPoly prod = op1 * op2;
+  EXPECT_TRUE(sum.IsContiguous());
+  EXPECT_EQ(expectedSum, sum);
+  EXPECT_EQ(expectedProd, prod);
+
+  DCRTPoly clone = prod.CloneTowers(1, towersize - 2);
+  EXPECT_TRUE(clone.IsContiguous());
+  for (usint i = 1; i < towersize - 1; i++) {
+    EXPECT_EQ(prod.GetElementAtIndex(i), clone.GetElementAtIndex(i - 1))
+        << "tower " << i;
+  }
+
+  prod.DropLastElement();
+  EXPECT_TRUE(prod.IsContiguous());
+  EXPECT_EQ(expectedProd.GetElementAtIndex(0), prod.GetElementAtIndex(0));
+
+  DCRTPoly assigned;
+  assigned = op2;
+  EXPECT_TRUE(assigned.IsContiguous());
+  EXPECT_EQ(op2, assigned);
+
+  // dropping half of the towers moves the others out of the shared buffer
+  uintptr_t first = reinterpret_cast<uintptr_t>(
+      &assigned.GetElementAtIndex(0).GetValues()[0]);
+  assigned.DropLastElements(towersize / 2);
+  EXPECT_TRUE(assigned.IsContiguous());
+  EXPECT_NE(first, reinterpret_cast<uintptr_t>(
+                       &assigned.GetElementAtIndex(0).GetValues()[0]));
+  EXPECT_EQ(op2.GetElementAtIndex(0), assigned.GetElementAtIndex(0));
+
+  DCRTPoly::SetContiguousStorage(false);
+
+  DCRTPoly heapCopy(sum);
+  EXPECT_FALSE(heapCopy.IsContiguous());
+  EXPECT_EQ(expectedSum, heapCopy);
+}
+
+TEST(UTDCRTPoly, DCRT_crt_interpolate_to_double) {
+  usint m = 32;
+  usint towersize = 5;
+
+  std::vector<NativeInteger> moduli(towersize);
+  std::vector<NativeInteger> roots(towersize);
+  moduli[0] = FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  roots[0] = RootOfUnity(m, moduli[0]);
+  for (usint i = 1; i < towersize; i++) {
+    moduli[i] = PreviousPrime<NativeInteger>(moduli[i - 1], m);
+    roots[i] = RootOfUnity(m, moduli[i]);
+  }
+  auto params = std::make_shared<ILDCRTParams<BigInteger>>(m, moduli, roots);
+  BigInteger Q = params->GetModulus();
+  BigInteger halfQ = Q >> 1;
+
+  // centered values of growing size, both signs, up to the edge of (-Q/2, Q/2]
+  usint n = params->GetRingDimension();
+  Poly big(std::make_shared<ILParams>(m, Q, BigInteger(1)), COEFFICIENT, true);
+  for (usint i = 0; i < n; i++) {
+    BigInteger v = BigInteger(1) << (i * 19);
+    if (v > halfQ) v = halfQ;
+    big[i] = (i % 2 == 0) ? v : Q - v;
+  }
+  DCRTPoly element(big, params);
+
+  const double scale = 0.25;
+  for (usint numTowers = 0; numTowers <= towersize; numTowers++) {
+    std::vector<double> result =
+        element.CRTInterpolateToDouble(scale, numTowers);
+    for (usint i = 0; i < n; i++) {
+      double expected = (big[i] > halfQ)
+                            ? -(Q - big[i]).ConvertToDouble() * scale
+                            : big[i].ConvertToDouble() * scale;
+      EXPECT_NEAR(expected, result[i], std::abs(expected) * 1e-14)
+          << "towers " << numTowers << " index " << i;
+    }
+  }
+}
+
+TEST(UTDCRTPoly, DCRT_approx_switch_crt_basis) {
+  usint m = 256;
+  usint sizeQ = 4;
+  usint sizeP = 3;
+
+  std::vector<NativeInteger> moduli(sizeQ + sizeP);
+  std::vector<NativeInteger> roots(sizeQ + sizeP);
+  moduli[0] = FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  roots[0] = RootOfUnity(m, moduli[0]);
+  for (usint i = 1; i < sizeQ + sizeP; i++) {
+    moduli[i] = PreviousPrime<NativeInteger>(moduli[i - 1], m);
+    roots[i] = RootOfUnity(m, moduli[i]);
+  }
+  std::vector<NativeInteger> moduliQ(moduli.begin(), moduli.begin() + sizeQ);
+  std::vector<NativeInteger> rootsQ(roots.begin(), roots.begin() + sizeQ);
+  std::vector<NativeInteger> moduliP(moduli.begin() + sizeQ, moduli.end());
+  std::vector<NativeInteger> rootsP(roots.begin() + sizeQ, roots.end());
+  auto paramsQ = std::make_shared<ILDCRTParams<BigInteger>>(m, moduliQ, rootsQ);
+  auto paramsP = std::make_shared<ILDCRTParams<BigInteger>>(m, moduliP, rootsP);
+  BigInteger Q = paramsQ->GetModulus();
+
+  std::vector<NativeInteger> QHatInvModq(sizeQ);
+  std::vector<NativeInteger> QHatInvModqPrecon(sizeQ);
+  std::vector<std::vector<NativeInteger>> QHatModp(sizeQ);
+  for (usint i = 0; i < sizeQ; i++) {
+    BigInteger QHati = Q / BigInteger(moduliQ[i]);
+    QHatInvModq[i] = QHati.ModInverse(moduliQ[i]).ConvertToInt();
+    QHatInvModqPrecon[i] = QHatInvModq[i].PrepModMulConst(moduliQ[i]);
+    QHatModp[i].resize(sizeP);
+    for (usint j = 0; j < sizeP; j++)
+      QHatModp[i][j] = QHati.Mod(moduliP[j]).ConvertToInt();
+  }
+
+  const BigInteger BarrettBase128Bit(
+      "340282366920938463463374607431768211456");       // 2^128
+  const BigInteger TwoPower64("18446744073709551616");  // 2^64
+  std::vector<DoubleNativeInt> modpBarrettMu(sizeP);
+  for (usint j = 0; j < sizeP; j++) {
+    BigInteger mu = BarrettBase128Bit / BigInteger(moduliP[j]);
+    uint64_t val[2];
+    val[0] = (mu % TwoPower64).ConvertToInt();
+    val[1] = mu.RShift(64).ConvertToInt();
+    memcpy(&modpBarrettMu[j], val, sizeof(DoubleNativeInt));
+  }
+
+  DiscreteUniformGeneratorImpl<BigVector> dug;
+  dug.SetModulus(Q);
+  Poly big(std::make_shared<ILParams>(m, Q, BigInteger(1)), COEFFICIENT, true);
+  big.SetValues(dug.GenerateVector(paramsQ->GetRingDimension()), COEFFICIENT);
+  DCRTPoly x(big, paramsQ);
+
+  DCRTPoly y = x.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq,
+                                      QHatInvModqPrecon, QHatModp,
+                                      modpBarrettMu);
+
+  // the result is X + alpha * Q for some 0 <= alpha < sizeQ
+  for (usint k = 0; k < paramsQ->GetRingDimension(); k++) {
+    bool found = false;
+    for (usint alpha = 0; alpha < sizeQ && !found; alpha++) {
+      BigInteger expected = big[k] + BigInteger(alpha) * Q;
+      bool match = true;
+      for (usint j = 0; j < sizeP; j++) {
+        match = match && (y.GetElementAtIndex(j)[k] ==
+                          expected.Mod(moduliP[j]).ConvertToInt());
+      }
+      found = match;
+    }
+    EXPECT_TRUE(found) << "coefficient " << k;
+  }
+}
+
+TEST(UTDCRTPoly, DCRT_ops_work_stealing_executor) {
+  usint order = 64;
+  usint nBits = 40;
+  usint towersize = 6;
+  usint numPolys = 8;
+
+  auto params = GenerateDCRTParams<BigInteger>(order, towersize, nBits);
+  DCRTPoly::DugType dug;
+  std::vector<DCRTPoly> a, b;
+  for (usint i = 0; i < numPolys; i++) {
+    a.push_back(DCRTPoly(dug, params, Format::EVALUATION));
+    b.push_back(DCRTPoly(dug, params, Format::EVALUATION));
+  }
+
+  auto compute = [&](usint i) {
+    DCRTPoly r = a[i] * b[i] + a[i] - b[i];
+    r += a[i];
+    r.SwitchFormat();
+    return r;
+  };
+
+  std::vector<DCRTPoly> expected;
+  for (usint i = 0; i < numPolys; i++) expected.push_back(compute(i));
+
+  // the tower loops inside compute nest in the outer loop
+  ParallelScheduler::SetExecutor(std::make_shared<WorkStealingExecutor>(4));
+  std::vector<DCRTPoly> results(numPolys);
+  ParallelFor(0, numPolys, [&](size_t i) { results[i] = compute(i); });
+  ParallelScheduler::SetExecutor(nullptr);
+
+  for (usint i = 0; i < numPolys; i++) {
+    EXPECT_EQ(expected[i], results[i]) << "polynomial " << i;
+  }
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
   DCRTPoly expectException(towers);
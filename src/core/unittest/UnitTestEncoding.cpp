@@ -32,6 +32,7 @@
 #include "encoding/encodings.h"
 #include "lattice/dcrtpoly.h"
 #include "math/backend.h"
+#include "math/dftransfrm.h"
 
 #include "lattice/elemparamfactory.h"
 #include "utils/inttypes.h"
@@ -250,6 +251,62 @@ TEST_F(UTEncoding,
       << "packed int - prime cyclotomics";
 }
 
+TEST_F(UTEncoding, packed_int_ptxt_encoding_shared_tables) {
+  usint m = 16;
+  PlaintextModulus p = 17;
+
+  shared_ptr<ILParams> lp =
+      ElemParamFactory::GenElemParams<ILParamsImpl<BigInteger>>(m);
+  EncodingParams ep(std::make_shared<EncodingParamsImpl>(p));
+
+  PackedEncoding::SetParams(m, ep);
+  auto tables = ep->GetPackedEncodingTables();
+  ASSERT_NE(tables, nullptr) << "tables not attached to encoding params";
+  EXPECT_EQ(tables->GetCyclotomicOrder(), m);
+  EXPECT_EQ(tables->GetInitRoot(),
+            NativeInteger(ep->GetPlaintextRootOfUnity()));
+
+  // all threads share the tables built by SetParams
+  const int numPlaintexts = 32;
+  vector<vector<int64_t>> values(numPlaintexts);
+  vector<vector<int64_t>> decoded(numPlaintexts);
+#pragma omp parallel for
+  for (int i = 0; i < numPlaintexts; i++) {
+    values[i] = {i % 8, 1, -2, 3, -4, 5, -6, 7};
+    PackedEncoding se(lp, ep, values[i]);
+    se.Encode();
+    se.Decode();
+    decoded[i] = se.GetPackedValue();
+  }
+
+  for (int i = 0; i < numPlaintexts; i++)
+    EXPECT_EQ(decoded[i], values[i]) << "packed int, plaintext " << i;
+  EXPECT_EQ(ep->GetPackedEncodingTables(), tables) << "tables were rebuilt";
+}
+
+TEST_F(UTEncoding, fft_special_plans_multiple_ring_dimensions) {
+  auto plan8 = DiscreteFourierTransform::GetPlan(32, 8);
+  auto plan16 = DiscreteFourierTransform::GetPlan(64, 16);
+  EXPECT_NE(plan8, plan16);
+  EXPECT_EQ(DiscreteFourierTransform::GetPlan(32, 8), plan8)
+      << "plan for 8 slots was rebuilt";
+
+  for (auto plan : {plan8, plan16}) {
+    vector<std::complex<double>> values(plan->GetSlots());
+    for (size_t i = 0; i < values.size(); i++)
+      values[i] = std::complex<double>(i, -0.5 * i);
+    auto result = values;
+    plan->FFTSpecialInv(result);
+    plan->FFTSpecial(result);
+    for (size_t i = 0; i < values.size(); i++)
+      EXPECT_NEAR(std::abs(result[i] - values[i]), 0, 1e-9)
+          << "slots " << plan->GetSlots() << ", index " << i;
+  }
+
+  vector<std::complex<double>> wrongSize(4);
+  EXPECT_THROW(plan8->FFTSpecial(wrongSize), math_error);
+}
+
 TEST_F(UTEncoding, string_encoding) {
   string value = "Hello, world!";
   usint m = 64;
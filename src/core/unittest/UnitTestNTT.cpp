@@ -36,10 +36,13 @@ IntPlainTextEncoding) work.
 
 #include "lattice/backend.h"
 #include "math/backend.h"
+#include "math/bigintnat/nttnat.h"
 #include "math/distrgen.h"
 #include "math/nbtheory.h"
 #include "testdefs.h"
+#include "utils/cpufeatures.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
 using namespace std;
@@ -132,3 +135,198 @@ TEST(UTNTT, switch_format_simple_double_crt) {
   RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt,
                     "switch_format_simple_double_crt")
 }
+
+// the lazy-reduction kernels used for NativeVector must agree with the generic
+// transform for every instruction set supported by the processor
+TEST(UTNTT, native_lazy_kernels_match_generic) {
+  SIMDLevel supported = CPUFeatures::GetSupportedSIMDLevel();
+
+  for (usint m : {4, 16, 64, 8192}) {
+    usint n = m / 2;
+    NativeInteger modulus =
+        FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+    NativeInteger rootOfUnity = RootOfUnity(m, modulus);
+    BigInteger bigModulus(modulus.ConvertToInt());
+    BigInteger bigRootOfUnity(rootOfUnity.ConvertToInt());
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    dug.SetModulus(modulus);
+    NativeVector x = dug.GenerateVector(n);
+
+    BigVector expected(n, bigModulus);
+    for (usint i = 0; i < n; i++) {
+      expected[i] = BigInteger(x[i].ConvertToInt());
+    }
+    ChineseRemainderTransformFTT<BigVector>::ForwardTransformToBitReverseInPlace(
+        bigRootOfUnity, m, &expected);
+
+    for (int level = SIMD_SCALAR; level <= supported; level++) {
+      std::string msg = "m = " + std::to_string(m) + ", " +
+                        CPUFeatures::SIMDLevelToString(SIMDLevel(level));
+      CPUFeatures::SetSIMDLevel(SIMDLevel(level));
+
+      NativeVector X(x);
+      ChineseRemainderTransformFTT<
+          NativeVector>::ForwardTransformToBitReverseInPlace(rootOfUnity, m,
+                                                             &X);
+      for (usint i = 0; i < n; i++) {
+        EXPECT_EQ(expected[i].ConvertToInt(), X[i].ConvertToInt()) << msg;
+      }
+
+      ChineseRemainderTransformFTT<
+          NativeVector>::InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                               &X);
+      EXPECT_EQ(x, X) << msg;
+    }
+  }
+
+  CPUFeatures::SetSIMDLevel(supported);
+}
+
+// moduli just below 2^62 leave lazy values at or above 2^63, which the SIMD
+// kernels must still compare as unsigned words
+TEST(UTNTT, native_lazy_kernels_large_modulus) {
+  SIMDLevel supported = CPUFeatures::GetSupportedSIMDLevel();
+
+  usint m = 64;
+  usint n = m / 2;
+  BigInteger modulus =
+      PreviousPrime<BigInteger>((BigInteger(1) << 62) + BigInteger(1), m);
+  BigInteger rootOfUnity = RootOfUnity(m, modulus);
+  ASSERT_TRUE(bigintnat::NativeNTT::IsSupportedModulus(modulus.ConvertToInt()));
+
+  // twiddle tables in the layout of ChineseRemainderTransformFTT::PreCompute
+  std::vector<uint64_t> table(n), tableI(n), precon(n), preconI(n);
+  BigInteger x(1), xinv(1);
+  BigInteger rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
+  usint msb = GetMSB64(n - 1);
+  for (usint i = 0; i < n; i++) {
+    usint iinv = ReverseBits(i, msb);
+    table[iinv] = x.ConvertToInt();
+    tableI[iinv] = xinv.ConvertToInt();
+    precon[iinv] = ((x << 64) / modulus).ConvertToInt();
+    preconI[iinv] = ((xinv << 64) / modulus).ConvertToInt();
+    x = x.ModMul(rootOfUnity, modulus);
+    xinv = xinv.ModMul(rootOfUnityInverse, modulus);
+  }
+  BigInteger nInv = BigInteger(n).ModInverse(modulus);
+  uint64_t preconNInv = ((nInv << 64) / modulus).ConvertToInt();
+
+  DiscreteUniformGeneratorImpl<BigVector> dug;
+  dug.SetModulus(modulus);
+  BigVector expected = dug.GenerateVector(n);
+  std::vector<uint64_t> input(n);
+  for (usint i = 0; i < n; i++) {
+    input[i] = expected[i].ConvertToInt();
+  }
+  ChineseRemainderTransformFTT<BigVector>::ForwardTransformToBitReverseInPlace(
+      rootOfUnity, m, &expected);
+
+  for (int level = SIMD_SCALAR; level <= supported; level++) {
+    std::string msg = CPUFeatures::SIMDLevelToString(SIMDLevel(level));
+    CPUFeatures::SetSIMDLevel(SIMDLevel(level));
+
+    std::vector<uint64_t> X(input);
+    bigintnat::NativeNTT::ForwardTransformToBitReverseInPlace(
+        X.data(), n, modulus.ConvertToInt(), table.data(), precon.data());
+    for (usint i = 0; i < n; i++) {
+      EXPECT_EQ(expected[i].ConvertToInt(), X[i]) << msg;
+    }
+
+    bigintnat::NativeNTT::InverseTransformFromBitReverseInPlace(
+        X.data(), n, modulus.ConvertToInt(), tableI.data(), preconI.data(),
+        nInv.ConvertToInt(), preconNInv);
+    EXPECT_EQ(input, X) << msg;
+  }
+
+  CPUFeatures::SetSIMDLevel(supported);
+}
+
+TEST(UTNTT, batched_transform_matches_single) {
+  usint m = 16384;
+  usint n = m / 2;
+  usint numTowers = 3;
+
+#ifdef PARALLEL
+  // enough threads to split every tower into blocks
+  omp_set_num_threads(8);
+#endif
+
+  std::vector<NativeInteger> rootOfUnity;
+  std::vector<NativeVector> x;
+  NativeInteger modulus = FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  for (usint k = 0; k < numTowers; k++) {
+    rootOfUnity.push_back(RootOfUnity(m, modulus));
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    dug.SetModulus(modulus);
+    x.push_back(dug.GenerateVector(n));
+    modulus = PreviousPrime<NativeInteger>(modulus, m);
+  }
+
+  SIMDLevel supported = CPUFeatures::GetSupportedSIMDLevel();
+  for (int level = SIMD_SCALAR; level <= supported; level++) {
+    std::string msg = CPUFeatures::SIMDLevelToString(SIMDLevel(level));
+    CPUFeatures::SetSIMDLevel(SIMDLevel(level));
+
+    std::vector<NativeVector> X(x);
+    std::vector<NativeVector *> batch;
+    for (usint k = 0; k < numTowers; k++) {
+      batch.push_back(&X[k]);
+    }
+    ChineseRemainderTransformFTT<
+        NativeVector>::ForwardTransformToBitReverseInPlace(rootOfUnity, m,
+                                                           batch);
+    for (usint k = 0; k < numTowers; k++) {
+      NativeVector expected(x[k]);
+      ChineseRemainderTransformFTT<
+          NativeVector>::ForwardTransformToBitReverseInPlace(rootOfUnity[k],
+                                                             m, &expected);
+      EXPECT_EQ(expected, X[k]) << msg << ", tower " << k;
+    }
+
+    ChineseRemainderTransformFTT<
+        NativeVector>::InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                             batch);
+    for (usint k = 0; k < numTowers; k++) {
+      EXPECT_EQ(x[k], X[k]) << msg << ", tower " << k;
+    }
+  }
+
+  CPUFeatures::SetSIMDLevel(supported);
+  PalisadeParallelControls.Enable();
+}
+
+TEST(UTNTT, batched_transform_caches_tables_on_params) {
+  usint m = 2048;
+  usint numTowers = 3;
+
+  std::vector<NativeInteger> moduli;
+  std::vector<NativeInteger> roots;
+  NativeInteger modulus = FirstPrime<NativeInteger>(MAX_MODULUS_SIZE - 1, m);
+  for (usint k = 0; k < numTowers; k++) {
+    moduli.push_back(modulus);
+    roots.push_back(RootOfUnity(m, modulus));
+    modulus = PreviousPrime<NativeInteger>(modulus, m);
+  }
+  auto params = std::make_shared<ILDCRTParams<BigInteger>>(m, moduli, roots);
+
+  DCRTPoly::DugType dug;
+  DCRTPoly x(dug, params, Format::COEFFICIENT);
+  DCRTPoly y(x);
+  y.SwitchFormat();
+#if NATIVEINT == 64 && !defined(WITH_INTEL_HEXL)
+  for (usint k = 0; k < numTowers; k++) {
+    EXPECT_NE(nullptr, params->GetParams()[k]->GetNativeNTTTables())
+        << "tower " << k;
+  }
+#endif
+
+  // the cached tables are invalidated with the tables they point to
+  ChineseRemainderTransformFTT<NativeVector>::Reset();
+  y.SwitchFormat();
+  EXPECT_EQ(x, y);
+
+  y.SwitchFormat();
+  y.SwitchFormat();
+  EXPECT_EQ(x, y);
+}
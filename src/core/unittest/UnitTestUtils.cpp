@@ -28,10 +28,17 @@
  *
  */
 
+#include <atomic>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include "include/gtest/gtest.h"
 
+#include "utils/exception.h"
+#include "utils/indexedfile.h"
+#include "utils/lrucache.h"
+#include "utils/parallel.h"
+#include "utils/scheduler.h"
 #include "utils/utilities.h"
 
 using namespace std;
@@ -50,3 +57,154 @@ TEST(Utilities, IsPowerOfTwo) {
     EXPECT_FALSE(IsPowerOfTwo(not_power_of_two));
   }
 }
+
+TEST(Utilities, IndexedFile) {
+  const std::string filename = "UnitTestIndexedFile.bin";
+  std::vector<std::pair<uint64_t, std::string>> records{
+      {5, "five"}, {1, std::string("o\0ne", 4)}, {1000, ""}, {3, "three"}};
+
+  IndexedFileWriter writer(filename, "header", records.size());
+  for (const auto& r : records) writer.Append(r.first, r.second);
+  writer.Close();
+
+  {
+    IndexedFileReader reader(filename);
+    EXPECT_EQ(reader.GetHeader(), "header");
+    ASSERT_EQ(reader.GetIds().size(), records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+      EXPECT_EQ(reader.GetIds()[i], records[i].first);
+      EXPECT_TRUE(reader.Contains(records[i].first));
+      auto record = reader.GetRecord(records[i].first);
+      EXPECT_EQ(std::string(record.first, record.second), records[i].second);
+    }
+    EXPECT_FALSE(reader.Contains(2));
+    EXPECT_THROW(reader.GetRecord(2), not_available_error);
+
+    // records can be read in place through a stream
+    auto record = reader.GetRecord(3);
+    MemoryStreamBuf buffer(record.first, record.second);
+    std::istream stream(&buffer);
+    std::string word;
+    stream >> word;
+    EXPECT_EQ(word, "three");
+  }
+
+  // a truncated file is rejected
+  {
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out << "PALIDX01";
+  }
+  EXPECT_THROW(IndexedFileReader reader(filename), config_error);
+  EXPECT_THROW(IndexedFileReader reader("no-such-file.bin"), config_error);
+  std::remove(filename.c_str());
+}
+
+TEST(Utilities, LRUCache) {
+  LRUCache<int, int> cache(2);
+  int value = 0;
+
+  cache.Put(1, 10);
+  cache.Put(2, 20);
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_EQ(value, 10);
+
+  // 2 is now the least recently used entry
+  cache.Put(3, 30);
+  EXPECT_EQ(cache.Size(), 2U);
+  EXPECT_FALSE(cache.Get(2, &value));
+  EXPECT_TRUE(cache.Get(1, &value));
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_EQ(value, 30);
+
+  cache.Put(3, 31);
+  EXPECT_TRUE(cache.Get(3, &value));
+  EXPECT_EQ(value, 31);
+  EXPECT_EQ(cache.Size(), 2U);
+
+  cache.Clear();
+  EXPECT_EQ(cache.Size(), 0U);
+
+  LRUCache<int, int> unbounded;
+  for (int i = 0; i < 100; i++) unbounded.Put(i, i);
+  EXPECT_EQ(unbounded.Size(), 100U);
+}
+
+TEST(Utilities, WorkStealingExecutor) {
+  WorkStealingExecutor executor(4);
+  EXPECT_EQ(executor.GetConcurrency(), 4U);
+
+  // nested loops share the pool and every iteration runs exactly once
+  const size_t outer = 16;
+  const size_t inner = 100;
+  std::vector<std::atomic<int>> hits(outer * inner);
+  for (auto &h : hits) h = 0;
+  executor.ParallelFor(0, outer, [&](size_t i) {
+    executor.ParallelFor(0, inner, [&](size_t j) { hits[i * inner + j]++; });
+  });
+  for (size_t k = 0; k < hits.size(); k++) {
+    EXPECT_EQ(hits[k].load(), 1) << "iteration " << k;
+  }
+
+  // exceptions reach the caller and leave the pool usable
+  EXPECT_THROW(executor.ParallelFor(0, 64,
+                                    [](size_t i) {
+                                      if (i == 33)
+                                        PALISADE_THROW(math_error, "thrown");
+                                    }),
+               math_error);
+  std::atomic<size_t> sum(0);
+  executor.ParallelFor(0, 1000, [&](size_t i) { sum += i; });
+  EXPECT_EQ(sum.load(), 499500U);
+
+  // the default executor is OpenMP
+  EXPECT_NE(std::dynamic_pointer_cast<OpenMPExecutor>(
+                ParallelScheduler::GetExecutor()),
+            nullptr);
+}
+
+TEST(Utilities, ParallelScope) {
+  auto budget = std::make_shared<WorkStealingExecutor>(2);
+  auto single = std::make_shared<OpenMPExecutor>(1);
+  EXPECT_EQ(ParallelScheduler::GetScopedExecutor(), nullptr);
+  {
+    ParallelScope outer(budget);
+    EXPECT_EQ(ParallelScheduler::GetScopedExecutor(), budget.get());
+
+    // loops nested in the scoped loop stay on its executor
+    std::atomic<int> onBudget(0);
+    ParallelFor(0, 8, [&](size_t i) {
+      ParallelFor(0, 2, [&](size_t j) {
+        if (ParallelScheduler::GetScopedExecutor() == budget.get())
+          onBudget++;
+      });
+    });
+    EXPECT_EQ(onBudget.load(), 16);
+
+    // the current thread only waits, even for a single iteration, and its
+    // own OpenMP loops stay on it
+    std::atomic<int> onCaller(0);
+    std::thread::id caller = std::this_thread::get_id();
+    for (size_t n : {1, 2, 100}) {
+      ParallelFor(0, n, [&](size_t i) {
+        if (std::this_thread::get_id() == caller) onCaller++;
+      });
+    }
+    EXPECT_EQ(onCaller.load(), 0);
+#ifdef PARALLEL
+    EXPECT_EQ(omp_get_max_threads(), 1);
+#endif
+
+    {
+      ParallelScope inner(single);
+      EXPECT_EQ(ParallelScheduler::GetScopedExecutor(), single.get());
+      ParallelScope none(nullptr);
+      EXPECT_EQ(ParallelScheduler::GetScopedExecutor(), single.get());
+    }
+    EXPECT_EQ(ParallelScheduler::GetScopedExecutor(), budget.get());
+  }
+  EXPECT_EQ(ParallelScheduler::GetScopedExecutor(), nullptr);
+
+#if defined(__linux__)
+  EXPECT_THROW(WorkStealingExecutor(1, {-1}), config_error);
+#endif
+}
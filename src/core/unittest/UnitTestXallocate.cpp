@@ -31,10 +31,12 @@
 
 #include <iostream>
 #include <new>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "math/backend.h"
+#include "utils/blockAllocator/coefpool.h"
 #include "utils/blockAllocator/xallocator.h"
 #include "utils/debug.h"
 #include "utils/defines.h"
@@ -186,3 +188,51 @@ TEST(UTBlockAllocate, xalloc_test) {
   // if using xallocator in a C-only application.
   // xalloc_destroy();
 }
+
+TEST(UTBlockAllocate, coefficient_pool_test) {
+  const usint n = 1 << 10;
+  const NativeInteger q(65537);
+
+  auto hitsFor = [](size_t blockSize) -> uint64_t {
+    for (const auto& s : CoefficientPool::GetStats())
+      if (s.blockSize == blockSize) return s.hits;
+    return 0;
+  };
+  size_t blockSize = n * sizeof(NativeInteger);
+  uint64_t hitsBefore = hitsFor(blockSize);
+
+  CoefficientPool::SetEnabled(true);
+  NativeVector expected(n, q);
+  for (usint i = 0; i < n; i++) expected[i] = i;
+  for (usint r = 0; r < 8; r++) {
+    NativeVector a(n, q);
+    for (usint i = 0; i < n; i++) a[i] = i;
+    NativeVector b(a);
+    EXPECT_EQ(expected, b) << "round " << r;
+  }
+  // a vector created while the pool is enabled may be released after it has
+  // been disabled
+  NativeVector* survivor = new NativeVector(expected);
+  CoefficientPool::SetEnabled(false);
+  delete survivor;
+
+  // every round after the first reuses the blocks released by the previous one
+  EXPECT_GE(hitsFor(blockSize) - hitsBefore, 14u);
+
+  // the free lists hold at most GetMaxCachedBytes() and Trim() empties them
+  size_t maxCachedBytes = CoefficientPool::GetMaxCachedBytes();
+  CoefficientPool::SetEnabled(true);
+  CoefficientPool::Trim();
+  size_t cachedBytes = CoefficientPool::GetCachedBytes();
+  CoefficientPool::SetMaxCachedBytes(cachedBytes + blockSize);
+  { std::vector<NativeVector> vectors(4, expected); }
+  EXPECT_EQ(cachedBytes + blockSize, CoefficientPool::GetCachedBytes());
+  CoefficientPool::Trim();
+  EXPECT_EQ(cachedBytes, CoefficientPool::GetCachedBytes());
+  CoefficientPool::SetMaxCachedBytes(maxCachedBytes);
+  CoefficientPool::SetEnabled(false);
+
+#ifdef PROFILE
+  CoefficientPool::PrintStats();
+#endif
+}
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "palisade.h"
+#include "seededuniform.h"
 
 namespace lbcrypto {
 
@@ -95,6 +96,7 @@ class CiphertextImpl : public CryptoObject<Element> {
   CiphertextImpl(const CiphertextImpl<Element>& ciphertext)
       : CryptoObject<Element>(ciphertext) {
     m_elements = ciphertext.m_elements;
+    m_seed = ciphertext.m_seed;
     m_depth = ciphertext.m_depth;
     m_level = ciphertext.m_level;
     m_scalingFactor = ciphertext.m_scalingFactor;
@@ -105,6 +107,7 @@ class CiphertextImpl : public CryptoObject<Element> {
   explicit CiphertextImpl(Ciphertext<Element> ciphertext)
       : CryptoObject<Element>(*ciphertext) {
     m_elements = ciphertext->m_elements;
+    m_seed = ciphertext->m_seed;
     m_depth = ciphertext->m_depth;
     m_level = ciphertext->m_level;
     m_scalingFactor = ciphertext->m_scalingFactor;
@@ -118,6 +121,7 @@ class CiphertextImpl : public CryptoObject<Element> {
   CiphertextImpl(CiphertextImpl<Element>&& ciphertext)
       : CryptoObject<Element>(ciphertext) {
     m_elements = std::move(ciphertext.m_elements);
+    m_seed = std::move(ciphertext.m_seed);
     m_depth = std::move(ciphertext.m_depth);
     m_level = std::move(ciphertext.m_level);
     m_scalingFactor = std::move(ciphertext.m_scalingFactor);
@@ -128,6 +132,7 @@ class CiphertextImpl : public CryptoObject<Element> {
   explicit CiphertextImpl(Ciphertext<Element>&& ciphertext)
       : CryptoObject<Element>(*ciphertext) {
     m_elements = std::move(ciphertext->m_elements);
+    m_seed = std::move(ciphertext->m_seed);
     m_depth = std::move(ciphertext->m_depth);
     m_level = std::move(ciphertext->m_level);
     m_scalingFactor = std::move(ciphertext->m_scalingFactor);
@@ -180,6 +185,7 @@ class CiphertextImpl : public CryptoObject<Element> {
     if (this != &rhs) {
       CryptoObject<Element>::operator=(rhs);
       this->m_elements = rhs.m_elements;
+      this->m_seed = rhs.m_seed;
       this->m_depth = rhs.m_depth;
       this->m_level = rhs.m_level;
       this->m_scalingFactor = rhs.m_scalingFactor;
@@ -200,6 +206,7 @@ class CiphertextImpl : public CryptoObject<Element> {
     if (this != &rhs) {
       CryptoObject<Element>::operator=(rhs);
       this->m_elements = std::move(rhs.m_elements);
+      this->m_seed = std::move(rhs.m_seed);
       this->m_depth = std::move(rhs.m_depth);
       this->m_level = std::move(rhs.m_level);
       this->m_scalingFactor = std::move(rhs.m_scalingFactor);
@@ -257,6 +264,7 @@ class CiphertextImpl : public CryptoObject<Element> {
    * @param &element is a polynomial ring element.
    */
   void SetElement(const Element& element) {
+    m_seed.clear();
     if (m_elements.size() == 0)
       m_elements.push_back(element);
     else if (m_elements.size() == 1)
@@ -274,6 +282,7 @@ class CiphertextImpl : public CryptoObject<Element> {
    */
   void SetElements(const std::vector<Element>& elements) {
     m_elements = elements;
+    m_seed.clear();
   }
 
   /**
@@ -283,6 +292,46 @@ class CiphertextImpl : public CryptoObject<Element> {
    */
   void SetElements(std::vector<Element>&& elements) {
     m_elements = std::move(elements);
+    m_seed.clear();
+  }
+
+  /**
+   * Marks a fresh two-element ciphertext as seeded: its second element is
+   * the negation of SeededUniform::Expand(seed, CIPHERTEXT, 0, params of the
+   * first element). A seeded ciphertext serializes only the seed and the
+   * first element, and the second element is regenerated on
+   * deserialization. Setting the elements drops the seed; elements modified
+   * through the non-const accessors are checked by IsSeeded.
+   *
+   * @param &seed is the seed the second element was derived from.
+   */
+  void SetSeed(const std::vector<uint32_t>& seed) {
+    if (!seed.empty() && m_elements.size() != 2) {
+      PALISADE_THROW(config_error,
+                     "Only ciphertexts with two elements can be seeded");
+    }
+    m_seed = seed;
+  }
+
+  /**
+   * Get the seed of a seeded ciphertext.
+   * @return the seed; empty if the ciphertext was not seeded or its elements
+   * were set since
+   */
+  const std::vector<uint32_t>& GetSeed() const { return m_seed; }
+
+  /**
+   * The seed survives access through the non-const element accessors, so the
+   * second element is regenerated from the seed and compared; only call this
+   * where that cost is acceptable, e.g., when serializing.
+   *
+   * @return true if the second element is derived from the seed.
+   */
+  bool IsSeeded() const {
+    if (m_seed.empty() || m_elements.size() != 2) return false;
+    return m_elements[1] == -SeededUniform<Element>::Expand(
+                                m_seed, SeededUniform<Element>::CIPHERTEXT, 0,
+                                m_elements[0].GetParams());
   }
 
   /**
@@ -385,6 +434,7 @@ class CiphertextImpl : public CryptoObject<Element> {
   virtual Ciphertext<Element> Clone() const {
     Ciphertext<Element> cRes = this->CloneEmpty();
     cRes->SetElements(this->GetElements());
+    cRes->m_seed = this->m_seed;
     cRes->SetDepth(this->GetDepth());
     cRes->SetLevel(this->GetLevel());
     cRes->SetScalingFactor(this->GetScalingFactor());
@@ -454,7 +504,16 @@ class CiphertextImpl : public CryptoObject<Element> {
   template <class Archive>
   void save(Archive& ar, std::uint32_t const version) const {
     ar(cereal::base_class<CryptoObject<Element>>(this));
-    ar(cereal::make_nvp("v", m_elements));
+    // a seed that no longer matches the elements is not written
+    bool seeded = IsSeeded();
+    const std::vector<uint32_t> noSeed;
+    ar(cereal::make_nvp("c", seeded ? m_seed : noSeed));
+    if (!seeded) {
+      ar(cereal::make_nvp("v", m_elements));
+    } else {
+      // the second element of a seeded ciphertext is regenerated on load
+      ar(cereal::make_nvp("v0", m_elements[0]));
+    }
     ar(cereal::make_nvp("d", m_depth));
     ar(cereal::make_nvp("l", m_level));
     ar(cereal::make_nvp("s", m_scalingFactor));
@@ -470,7 +529,17 @@ class CiphertextImpl : public CryptoObject<Element> {
                          " is from a later version of the library");
     }
     ar(cereal::base_class<CryptoObject<Element>>(this));
-    ar(cereal::make_nvp("v", m_elements));
+    m_seed.clear();
+    if (version > 1) ar(cereal::make_nvp("c", m_seed));
+    if (m_seed.empty()) {
+      ar(cereal::make_nvp("v", m_elements));
+    } else {
+      Element c0;
+      ar(cereal::make_nvp("v0", c0));
+      Element c1 = -SeededUniform<Element>::Expand(
+          m_seed, SeededUniform<Element>::CIPHERTEXT, 0, c0.GetParams());
+      m_elements = {std::move(c0), std::move(c1)};
+    }
     ar(cereal::make_nvp("d", m_depth));
     ar(cereal::make_nvp("l", m_level));
     ar(cereal::make_nvp("s", m_scalingFactor));
@@ -479,7 +548,7 @@ class CiphertextImpl : public CryptoObject<Element> {
   }
 
   std::string SerializedObjectName() const { return "Ciphertext"; }
-  static uint32_t SerializedVersion() { return 1; }
+  static uint32_t SerializedVersion() { return 2; }
 
  private:
   // FUTURE ENHANCEMENT: current value of error norm
@@ -487,6 +556,8 @@ class CiphertextImpl : public CryptoObject<Element> {
 
   std::vector<Element>
       m_elements;  /*!< vector of ring elements for this Ciphertext */
+  // seed of the second element of a fresh seeded encryption; empty otherwise
+  std::vector<uint32_t> m_seed;
   uint32_t m_depth;  // holds the multiplicative depth of the ciphertext.
   PlaintextEncodings encodingType; /*!< how was this Ciphertext encoded? */
 
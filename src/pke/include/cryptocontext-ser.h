@@ -55,21 +55,19 @@ template <typename ST>
 bool CryptoContextImpl<Element>::SerializeEvalMultKey(std::ostream& ser,
                                                       const ST& sertype,
                                                       string id) {
-  std::map<string, std::vector<LPEvalKey<Element>>>* smap;
   std::map<string, std::vector<LPEvalKey<Element>>> omap;
 
   if (id.length() == 0) {
-    smap = &GetAllEvalMultKeys();
+    omap = GetAllEvalMultKeys();
   } else {
-    const auto k = GetAllEvalMultKeys().find(id);
+    const auto k = evalMultKeyMap().Find(id);
 
-    if (k == GetAllEvalMultKeys().end()) return false;  // no such id
+    if (k == nullptr) return false;  // no such id
 
-    smap = &omap;
-    omap[k->first] = k->second;
+    omap[id] = *k;
   }
 
-  Serial::Serialize(*smap, ser, sertype);
+  Serial::Serialize(omap, ser, sertype);
   return true;
 }
 
@@ -24,8 +24,12 @@
 #ifndef SRC_PKE_CRYPTOCONTEXT_H_
 #define SRC_PKE_CRYPTOCONTEXT_H_
 
+#include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <sstream>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,8 +38,13 @@
 #include "scheme/allscheme.h"
 
 #include "cryptocontexthelper.h"
+#include "evalkeyfile.h"
+#include "evalkeystore.h"
+#include "lineartransform.h"
+#include "rotationkeyplan.h"
 
 #include "utils/caller_info.h"
+#include "utils/scheduler.h"
 #include "utils/serial.h"
 
 namespace lbcrypto {
@@ -87,32 +96,63 @@ class CryptoContextImpl : public Serializable {
   // algorithm used; accesses all crypto methods
   shared_ptr<LPPublicKeyEncryptionScheme<Element>> scheme;
 
-  static std::map<string, std::vector<LPEvalKey<Element>>>& evalMultKeyMap() {
+  static EvalKeyStore<std::vector<LPEvalKey<Element>>>& evalMultKeyMap() {
     // cached evalmult keys, by secret key UID
-    static std::map<string, std::vector<LPEvalKey<Element>>> s_evalMultKeyMap;
+    static EvalKeyStore<std::vector<LPEvalKey<Element>>> s_evalMultKeyMap;
     return s_evalMultKeyMap;
   }
 
-  static std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>&
-  evalSumKeyMap() {
+  static EvalKeyStore<std::map<usint, LPEvalKey<Element>>>& evalSumKeyMap() {
     // cached evalsum keys, by secret key UID
-    static std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>
-        s_evalSumKeyMap;
+    static EvalKeyStore<std::map<usint, LPEvalKey<Element>>> s_evalSumKeyMap;
     return s_evalSumKeyMap;
   }
 
-  static std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>&
+  static EvalKeyStore<std::map<usint, LPEvalKey<Element>>>&
   evalAutomorphismKeyMap() {
     // cached evalautomorphism keys, by secret key UID
-    static std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>
+    static EvalKeyStore<std::map<usint, LPEvalKey<Element>>>
         s_evalAutomorphismKeyMap;
     return s_evalAutomorphismKeyMap;
   }
 
+  static EvalKeyStore<EvalKeyFile<Element>>& evalAutomorphismKeyFiles() {
+    // lazily loaded evalautomorphism keys, by secret key UID; only used for
+    // the IDs without keys in evalAutomorphismKeyMap
+    static EvalKeyStore<EvalKeyFile<Element>> s_evalAutomorphismKeyFiles;
+    return s_evalAutomorphismKeyFiles;
+  }
+
+  // evalautomorphism keys for an ID, deserializing all the keys of its file if
+  // they are lazily loaded; nullptr if there are no keys for the ID
+  static shared_ptr<std::map<usint, LPEvalKey<Element>>>
+  FindEvalAutomorphismKeys(const string& id) {
+    auto keys = evalAutomorphismKeyMap().Find(id);
+    if (keys != nullptr) return keys;
+
+    auto file = evalAutomorphismKeyFiles().Find(id);
+    if (file != nullptr) return file->GetKeys(file->GetIndices());
+
+    return nullptr;
+  }
+
   string m_schemeId;
 
   uint32_t m_keyGenLevel;
 
+  // generate the A vectors of evaluation keys from seeds
+  bool m_evalKeyCompression;
+
+  // generate the masks of secret-key encryptions from seeds
+  bool m_ciphertextCompression;
+
+  // executor the parallel loops of this context's operations run on; null to
+  // use the executor of the calling thread
+  std::shared_ptr<ParallelExecutor> m_executor;
+
+  // compose rotations without a key from the rotation keys that exist
+  bool m_rotationComposition;
+
   /**
    * TypeCheck makes sure that an operation between two ciphertexts is permitted
    * @param a
@@ -326,6 +366,9 @@ class CryptoContextImpl : public Serializable {
     this->params.reset(params);
     this->scheme.reset(scheme);
     this->m_keyGenLevel = 0;
+    this->m_evalKeyCompression = false;
+    this->m_rotationComposition = false;
+    this->m_ciphertextCompression = false;
     this->m_schemeId = schemeId;
   }
 
@@ -340,6 +383,9 @@ class CryptoContextImpl : public Serializable {
     this->params = params;
     this->scheme = scheme;
     this->m_keyGenLevel = 0;
+    this->m_evalKeyCompression = false;
+    this->m_rotationComposition = false;
+    this->m_ciphertextCompression = false;
     this->m_schemeId = schemeId;
   }
 
@@ -351,7 +397,11 @@ class CryptoContextImpl : public Serializable {
     params = c.params;
     scheme = c.scheme;
     this->m_keyGenLevel = 0;
+    this->m_evalKeyCompression = c.m_evalKeyCompression;
+    this->m_ciphertextCompression = c.m_ciphertextCompression;
     this->m_schemeId = c.m_schemeId;
+    this->m_executor = c.m_executor;
+    this->m_rotationComposition = c.m_rotationComposition;
   }
 
   /**
@@ -363,7 +413,11 @@ class CryptoContextImpl : public Serializable {
     params = rhs.params;
     scheme = rhs.scheme;
     m_keyGenLevel = rhs.m_keyGenLevel;
+    m_evalKeyCompression = rhs.m_evalKeyCompression;
+    m_ciphertextCompression = rhs.m_ciphertextCompression;
     m_schemeId = rhs.m_schemeId;
+    m_executor = rhs.m_executor;
+    m_rotationComposition = rhs.m_rotationComposition;
     return *this;
   }
 
@@ -457,13 +511,14 @@ class CryptoContextImpl : public Serializable {
   static bool DeserializeEvalMultKey(std::istream& ser, const ST& sertype) {
     std::map<string, std::vector<LPEvalKey<Element>>> evalMultKeys;
 
-    Serial::Deserialize(GetAllEvalMultKeys(), ser, sertype);
+    Serial::Deserialize(evalMultKeys, ser, sertype);
 
     // The deserialize call created any contexts that needed to be created....
     // so all we need to do is put the keys into the maps for their context
 
-    for (auto k : GetAllEvalMultKeys()) {
-      GetAllEvalMultKeys()[k.first] = k.second;
+    for (auto k : evalMultKeys) {
+      evalMultKeyMap().Insert(
+          k.first, std::make_shared<std::vector<LPEvalKey<Element>>>(k.second));
     }
 
     return true;
@@ -505,20 +560,18 @@ class CryptoContextImpl : public Serializable {
   template <typename ST>
   static bool SerializeEvalSumKey(std::ostream& ser, const ST& sertype,
                                   string id = "") {
-    std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>* smap;
     std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>> omap;
 
     if (id.length() == 0) {
-      smap = &GetAllEvalSumKeys();
+      omap = GetAllEvalSumKeys();
     } else {
-      auto k = GetAllEvalSumKeys().find(id);
+      auto k = evalSumKeyMap().Find(id);
 
-      if (k == GetAllEvalSumKeys().end()) return false;  // no such id
+      if (k == nullptr) return false;  // no such id
 
-      smap = &omap;
-      omap[k->first] = k->second;
+      omap[id] = k;
     }
-    Serial::Serialize(*smap, ser, sertype);
+    Serial::Serialize(omap, ser, sertype);
     return true;
   }
 
@@ -567,7 +620,7 @@ class CryptoContextImpl : public Serializable {
     // so all we need to do is put the keys into the maps for their context
 
     for (auto k : evalSumKeys) {
-      GetAllEvalSumKeys()[k.first] = k.second;
+      evalSumKeyMap().Insert(k.first, k.second);
     }
 
     return true;
@@ -610,19 +663,18 @@ class CryptoContextImpl : public Serializable {
   template <typename ST>
   static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype,
                                            string id = "") {
-    std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>* smap;
     std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>> omap;
+
     if (id.length() == 0) {
-      smap = &GetAllEvalAutomorphismKeys();
+      omap = GetAllEvalAutomorphismKeys();
     } else {
-      auto k = GetAllEvalAutomorphismKeys().find(id);
+      auto k = FindEvalAutomorphismKeys(id);
 
-      if (k == GetAllEvalAutomorphismKeys().end()) return false;  // no such id
+      if (k == nullptr) return false;  // no such id
 
-      smap = &omap;
-      omap[k->first] = k->second;
+      omap[id] = k;
     }
-    Serial::Serialize(*smap, ser, sertype);
+    Serial::Serialize(omap, ser, sertype);
     return true;
   }
 
@@ -671,7 +723,7 @@ class CryptoContextImpl : public Serializable {
     // so all we need to do is put the keys into the maps for their context
 
     for (auto k : evalSumKeys) {
-      GetAllEvalAutomorphismKeys()[k.first] = k.second;
+      evalAutomorphismKeyMap().Insert(k.first, k.second);
     }
 
     return true;
@@ -703,6 +755,71 @@ class CryptoContextImpl : public Serializable {
   static void InsertEvalAutomorphismKey(
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> mapToInsert);
 
+  /**
+   * SerializeEvalAutomorphismKeyIndexed writes the EvalAuto keys for a key ID
+   * to an indexed key file, which can be loaded lazily with
+   * DeserializeEvalAutomorphismKeyLazy
+   *
+   * @param filename - path of the file
+   * @param sertype - type of serialization of the individual keys
+   * @param id - key to serialize
+   * @return true on success (false if there are no keys for the id)
+   */
+  template <typename ST>
+  static bool SerializeEvalAutomorphismKeyIndexed(const std::string& filename,
+                                                  const ST& sertype,
+                                                  const string& id) {
+    auto keys = FindEvalAutomorphismKeys(id);
+    if (keys == nullptr) return false;  // no such id
+
+    IndexedFileWriter writer(filename, id, keys->size());
+    for (const auto& k : *keys) {
+      std::stringstream s;
+      Serial::Serialize(k.second, s, sertype);
+      writer.Append(k.first, s.str());
+    }
+    writer.Close();
+    return true;
+  }
+
+  /**
+   * DeserializeEvalAutomorphismKeyLazy opens an indexed key file written by
+   * SerializeEvalAutomorphismKeyIndexed. Only the index is read; EvalAtIndex
+   * and the fast rotations deserialize each key from the memory-mapped file
+   * the first time it is needed. The keys replace any existing EvalAuto keys
+   * for the same key ID until keys are inserted again for that ID.
+   *
+   * @param filename - path of the file
+   * @param sertype - type of serialization of the individual keys
+   * @param maxResidentKeys - maximum number of deserialized keys kept in
+   * memory, least recently used keys are dropped first; 0 means unbounded
+   * @return true on success
+   */
+  template <typename ST>
+  static bool DeserializeEvalAutomorphismKeyLazy(const std::string& filename,
+                                                 const ST& sertype,
+                                                 size_t maxResidentKeys = 0) {
+    auto loader = [sertype](std::istream& stream) {
+      LPEvalKey<Element> key;
+      Serial::Deserialize(key, stream, sertype);
+      return key;
+    };
+
+    shared_ptr<EvalKeyFile<Element>> file;
+    try {
+      file = std::make_shared<EvalKeyFile<Element>>(filename, maxResidentKeys,
+                                                    loader);
+    } catch (const palisade_error&) {
+      return false;
+    }
+
+    // the file is stored before the keys it replaces are dropped, so that
+    // concurrent readers always find keys for the ID
+    evalAutomorphismKeyFiles().Insert(file->GetKeyTag(), file);
+    evalAutomorphismKeyMap().Erase(file->GetKeyTag());
+    return true;
+  }
+
   // TURN FEATURES ON
   /**
    * Enable a particular feature for use with this CryptoContextImpl
@@ -734,10 +851,67 @@ class CryptoContextImpl : public Serializable {
     return params;
   }
 
+  /**
+   * Sets the executor that the parallel loops of this context's operations
+   * run on, e.g. a WorkStealingExecutor with a thread budget and a CPU set.
+   * Other contexts are not affected. With a WorkStealingExecutor, the
+   * parallel loops of an operation compute on the pool only, while the
+   * calling thread runs the serial code between them; see ParallelScope for
+   * the OpenMP loops that do not go through an executor. The factory hands
+   * out the same context for identical parameters, so use a ParallelScope
+   * instead to budget individual jobs that share parameters.
+   * @param executor - the executor; nullptr (the default) uses the executor
+   * of the calling thread, see ParallelScheduler
+   */
+  void SetExecutor(std::shared_ptr<ParallelExecutor> executor) {
+    m_executor = executor;
+  }
+
+  std::shared_ptr<ParallelExecutor> GetExecutor() const { return m_executor; }
+
   size_t GetKeyGenLevel() const { return m_keyGenLevel; }
 
   void SetKeyGenLevel(size_t level) { m_keyGenLevel = level; }
 
+  /**
+   * Turns seed compression of evaluation keys on or off. When it is on, the
+   * uniformly random A vectors of newly generated relinearization and
+   * rotation keys (BV and hybrid key switching) are derived from a 256-bit
+   * seed; the keys store and serialize only the seed and the B vectors, and
+   * A is regenerated and cached on first use.
+   * @param compress - true to generate seeded keys
+   */
+  void SetEvalKeyCompression(bool compress) { m_evalKeyCompression = compress; }
+
+  bool GetEvalKeyCompression() const { return m_evalKeyCompression; }
+
+  /**
+   * Turns seed compression of fresh secret-key encryptions on or off. When it
+   * is on, Encrypt(privateKey, plaintext) for CKKS, BGVrns and BFVrns derives
+   * the uniformly random mask of the ciphertext from a 256-bit seed, so the
+   * serialized ciphertext holds only the seed and the first element; the
+   * second element is regenerated on deserialization.
+   * @param compress - true to produce seeded ciphertexts
+   */
+  void SetCiphertextCompression(bool compress) {
+    m_ciphertextCompression = compress;
+  }
+
+  bool GetCiphertextCompression() const { return m_ciphertextCompression; }
+
+  /**
+   * Turns the composition of rotations on or off. When it is on, EvalAtIndex
+   * and EvalAtIndexBatch do a rotation that has no key as the shortest chain
+   * of rotations that have keys, one key switch each, instead of throwing.
+   * Use PlanRotationKeys to choose the keys. Power-of-two cyclotomics only.
+   * @param compose - true to compose missing rotations
+   */
+  void SetRotationComposition(bool compose) {
+    m_rotationComposition = compose;
+  }
+
+  bool GetRotationComposition() const { return m_rotationComposition; }
+
   /**
    * Getter for element params
    * @return
@@ -795,6 +969,7 @@ class CryptoContextImpl : public Serializable {
    * @return a public/secret key pair
    */
   LPKeyPair<Element> KeyGen() {
+    ParallelScope scope(m_executor);
     auto r = GetEncryptionAlgorithm()->KeyGen(
         CryptoContextFactory<Element>::GetContextForPointer(this), false);
     return r;
@@ -816,6 +991,7 @@ class CryptoContextImpl : public Serializable {
   LPKeyPair<Element> MultipartyKeyGen(const LPPublicKey<Element> pk,
                                       bool makeSparse = false,
                                       bool fresh = false) {
+    ParallelScope scope(m_executor);
     if (!pk) PALISADE_THROW(config_error, "Input public key is empty");
     auto r = GetEncryptionAlgorithm()->MultipartyKeyGen(
         CryptoContextFactory<Element>::GetContextForPointer(this), pk,
@@ -833,6 +1009,7 @@ class CryptoContextImpl : public Serializable {
    */
   LPKeyPair<Element> MultipartyKeyGen(
       const vector<LPPrivateKey<Element>>& secretKeys) {
+    ParallelScope scope(m_executor);
     if (!secretKeys.size())
       PALISADE_THROW(config_error, "Input private key vector is empty");
     auto r = GetEncryptionAlgorithm()->MultipartyKeyGen(
@@ -851,6 +1028,7 @@ class CryptoContextImpl : public Serializable {
   vector<Ciphertext<Element>> MultipartyDecryptLead(
       const LPPrivateKey<Element> privateKey,
       const vector<Ciphertext<Element>>& ciphertext) const {
+    ParallelScope scope(m_executor);
     if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext()))
       PALISADE_THROW(config_error,
                      "Information passed to MultipartyDecryptLead was not "
@@ -882,6 +1060,7 @@ class CryptoContextImpl : public Serializable {
   vector<Ciphertext<Element>> MultipartyDecryptMain(
       const LPPrivateKey<Element> privateKey,
       const vector<Ciphertext<Element>>& ciphertext) const {
+    ParallelScope scope(m_executor);
     if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext()))
       PALISADE_THROW(config_error,
                      "Information passed to MultipartyDecryptMain was not "
@@ -929,6 +1108,7 @@ class CryptoContextImpl : public Serializable {
       const LPPrivateKey<Element> originalPrivateKey,
       const LPPrivateKey<Element> newPrivateKey,
       const LPEvalKey<Element> ek) const {
+    ParallelScope scope(m_executor);
     if (!originalPrivateKey)
       PALISADE_THROW(config_error, "Input first private key is nullptr");
     if (!newPrivateKey)
@@ -954,6 +1134,7 @@ class CryptoContextImpl : public Serializable {
       const LPPrivateKey<Element> privateKey,
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> eAuto,
       const std::vector<usint>& indexList, const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!privateKey)
       PALISADE_THROW(config_error, "Input private key is nullptr");
     if (!eAuto)
@@ -980,6 +1161,7 @@ class CryptoContextImpl : public Serializable {
       const LPPrivateKey<Element> privateKey,
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> eAuto,
       const std::vector<int32_t>& indexList, const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!privateKey)
       PALISADE_THROW(config_error, "Input private key is nullptr");
     if (!eAuto)
@@ -1005,6 +1187,7 @@ class CryptoContextImpl : public Serializable {
       const LPPrivateKey<Element> privateKey,
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> eSum,
       const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!privateKey)
       PALISADE_THROW(config_error, "Input private key is nullptr");
     if (!eSum)
@@ -1025,6 +1208,7 @@ class CryptoContextImpl : public Serializable {
   LPEvalKey<Element> MultiAddEvalKeys(LPEvalKey<Element> a,
                                       LPEvalKey<Element> b,
                                       const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!a)
       PALISADE_THROW(config_error, "Input first evaluation key is nullptr");
     if (!b)
@@ -1046,6 +1230,7 @@ class CryptoContextImpl : public Serializable {
   LPEvalKey<Element> MultiMultEvalKey(LPEvalKey<Element> evalKey,
                                       LPPrivateKey<Element> sk,
                                       const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!evalKey)
       PALISADE_THROW(config_error, "Input evaluation key is nullptr");
     if (!sk) PALISADE_THROW(config_error, "Input private key is nullptr");
@@ -1065,6 +1250,7 @@ class CryptoContextImpl : public Serializable {
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> es1,
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> es2,
       const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!es1)
       PALISADE_THROW(config_error, "Input first evaluation key map is nullptr");
     if (!es2)
@@ -1086,6 +1272,7 @@ class CryptoContextImpl : public Serializable {
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> es1,
       const shared_ptr<std::map<usint, LPEvalKey<Element>>> es2,
       const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!es1)
       PALISADE_THROW(config_error, "Input first evaluation key map is nullptr");
     if (!es2)
@@ -1107,6 +1294,7 @@ class CryptoContextImpl : public Serializable {
   LPPublicKey<Element> MultiAddPubKeys(LPPublicKey<Element> pubKey1,
                                        LPPublicKey<Element> pubKey2,
                                        const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!pubKey1)
       PALISADE_THROW(config_error, "Input first public key is nullptr");
     if (!pubKey2)
@@ -1127,6 +1315,7 @@ class CryptoContextImpl : public Serializable {
   LPEvalKey<Element> MultiAddEvalMultKeys(LPEvalKey<Element> evalKey1,
                                           LPEvalKey<Element> evalKey2,
                                           const std::string& keyId = "") {
+    ParallelScope scope(m_executor);
     if (!evalKey1)
       PALISADE_THROW(config_error, "Input first evaluation key is nullptr");
     if (!evalKey2)
@@ -1142,6 +1331,7 @@ class CryptoContextImpl : public Serializable {
    * @return a public/secret key pair
    */
   LPKeyPair<Element> SparseKeyGen() {
+    ParallelScope scope(m_executor);
     auto r = GetEncryptionAlgorithm()->KeyGen(
         CryptoContextFactory<Element>::GetContextForPointer(this), true);
     return r;
@@ -1155,6 +1345,7 @@ class CryptoContextImpl : public Serializable {
    */
   LPEvalKey<Element> ReKeyGen(const LPPublicKey<Element> newKey,
                               const LPPrivateKey<Element> oldKey) const {
+    ParallelScope scope(m_executor);
     if (newKey == nullptr || oldKey == nullptr ||
         Mismatched(newKey->GetCryptoContext()) ||
         Mismatched(oldKey->GetCryptoContext()))
@@ -1197,18 +1388,30 @@ class CryptoContextImpl : public Serializable {
   void EvalMultKeysGen(const LPPrivateKey<Element> key);
 
   /**
-   * GetEvalMultKeyVector fetches the eval mult keys for a given KeyID
+   * GetEvalMultKeyVector fetches a copy of the eval mult keys for a given
+   * KeyID
    * @param keyID
    * @return key vector from ID
    */
-  static const vector<LPEvalKey<Element>>& GetEvalMultKeyVector(
+  static const vector<LPEvalKey<Element>> GetEvalMultKeyVector(
       const string& keyID);
 
   /**
-   * GetEvalMultKeys
-   * @return map of all the keys
+   * GetEvalMultKeyVectorPtr returns a shared pointer to the eval mult keys
+   * for a given KeyID, which keeps the keys alive while they are in use even
+   * if they are concurrently replaced
+   * @param keyID
+   * @return key vector from ID
    */
-  static std::map<string, std::vector<LPEvalKey<Element>>>&
+  static shared_ptr<vector<LPEvalKey<Element>>> GetEvalMultKeyVectorPtr(
+      const string& keyID);
+
+  /**
+   * GetAllEvalMultKeys
+   * @return a snapshot of all the keys; use InsertEvalMultKey and
+   * ClearEvalMultKeys to modify the stored keys
+   */
+  static const std::map<string, std::vector<LPEvalKey<Element>>>
   GetAllEvalMultKeys();
 
   /**
@@ -1220,6 +1423,7 @@ class CryptoContextImpl : public Serializable {
    */
   LPEvalKey<Element> KeySwitchGen(const LPPrivateKey<Element> key1,
                                   const LPPrivateKey<Element> key2) const {
+    ParallelScope scope(m_executor);
     if (key1 == nullptr || key2 == nullptr ||
         Mismatched(key1->GetCryptoContext()) ||
         Mismatched(key2->GetCryptoContext()))
@@ -1239,6 +1443,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> Encrypt(const LPPublicKey<Element> publicKey,
                               Plaintext plaintext) {
+    ParallelScope scope(m_executor);
     if (publicKey == nullptr)
       PALISADE_THROW(type_error, "null key passed to Encrypt");
 
@@ -1271,6 +1476,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> Encrypt(const LPPrivateKey<Element> privateKey,
                               Plaintext plaintext) const {
+    ParallelScope scope(m_executor);
     if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext()))
       PALISADE_THROW(
           config_error,
@@ -1416,6 +1622,176 @@ class CryptoContextImpl : public Serializable {
     return MakeCKKSPackedPlaintext(complexValue, depth, level, params);
   }
 
+  /**
+   * MakeCKKSPackedPlaintexts constructs one CKKSPackedEncoding per input
+   * vector. The element parameters and the scaling factor are looked up once
+   * for the whole batch, and the inputs are encoded in parallel.
+   * @param values - input vectors
+   * @paran depth - depth used to encode the vectors
+   * @param level - level at each the vectors will get encrypted
+   * @param params - parameters to be usef for the ciphertexts
+   * @return plaintexts, in the order of the inputs
+   */
+  std::vector<Plaintext> MakeCKKSPackedPlaintexts(
+      const std::vector<std::vector<std::complex<double>>>& values,
+      size_t depth = 1, uint32_t level = 0,
+      const shared_ptr<ParmType> params = nullptr) const {
+    const auto cryptoParamsCKKS =
+        std::dynamic_pointer_cast<LPCryptoParametersCKKS<DCRTPoly>>(
+            this->GetCryptoParameters());
+
+    double scFact = cryptoParamsCKKS->GetScalingFactorOfLevel(level);
+
+    shared_ptr<ILDCRTParams<DCRTPoly::Integer>> elemParamsPtr;
+    if (params == nullptr) {
+      elemParamsPtr = cryptoParamsCKKS->GetElementParams();
+      if (level != 0) {
+        auto elemParams =
+            std::make_shared<ILDCRTParams<DCRTPoly::Integer>>(*elemParamsPtr);
+        for (uint32_t i = 0; i < level; i++) {
+          elemParams->PopLastParam();
+        }
+        elemParamsPtr = elemParams;
+      }
+    }
+
+    std::vector<Plaintext> plaintexts(values.size());
+    ParallelScope scope(m_executor);
+    ParallelFor(0, values.size(), [&](size_t i) {
+      if (params == nullptr) {
+        plaintexts[i] = Plaintext(std::make_shared<CKKSPackedEncoding>(
+            elemParamsPtr, this->GetEncodingParams(), values[i], depth, level,
+            scFact));
+      } else {
+        plaintexts[i] = Plaintext(std::make_shared<CKKSPackedEncoding>(
+            params, this->GetEncodingParams(), values[i], depth, level,
+            scFact));
+      }
+      plaintexts[i]->Encode();
+    });
+
+    return plaintexts;
+  }
+
+  /**
+   * MakeCKKSPackedPlaintexts constructs one CKKSPackedEncoding per vector of
+   * real numbers; see the complex-valued version
+   * @param values - input vectors
+   * @paran depth - depth used to encode the vectors
+   * @param level - level at each the vectors will get encrypted
+   * @param params - parameters to be usef for the ciphertexts
+   * @return plaintexts, in the order of the inputs
+   */
+  std::vector<Plaintext> MakeCKKSPackedPlaintexts(
+      const std::vector<std::vector<double>>& values, size_t depth = 1,
+      uint32_t level = 0, const shared_ptr<ParmType> params = nullptr) const {
+    std::vector<std::vector<std::complex<double>>> complexValues(
+        values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      complexValues[i].assign(values[i].begin(), values[i].end());
+    }
+
+    return MakeCKKSPackedPlaintexts(complexValues, depth, level, params);
+  }
+
+  /**
+   * MakeCKKSLinearTransform encodes an n x n real matrix for
+   * EvalLinearTransform, where n is the number of CKKS slots (the batch size,
+   * or half the ring dimension if no batch size is set). A batch smaller than
+   * half the ring dimension must be at most a quarter of it, and the slots
+   * of the input past the batch must be zero.
+   * @param diagonals - the n generalized diagonals of the matrix,
+   * diagonals[k][t] = M[t][(t + k) % n]; an empty vector is a zero diagonal
+   * @param depth - depth used to encode the diagonals
+   * @param level - level of the ciphertexts the matrix will be applied to
+   * @return the encoded matrix
+   */
+  LinearTransform<Element> MakeCKKSLinearTransform(
+      const std::vector<std::vector<double>>& diagonals, size_t depth = 1,
+      uint32_t level = 0) const {
+    usint slots = GetEncodingParams()->GetBatchSize();
+    if (slots == 0) slots = GetRingDimension() / 2;
+    return MakeLinearTransform<double>(
+        diagonals, slots, GetRingDimension() / 2,
+        [&](const std::vector<double>& diagonal) {
+          return MakeCKKSPackedPlaintext(diagonal, depth, level);
+        });
+  }
+
+  /**
+   * MakePackedLinearTransform encodes an n x n integer matrix for
+   * EvalLinearTransform on packed BGVrns ciphertexts, where n is half the
+   * ring dimension, the length of the rows EvalAtIndex rotates
+   * @param diagonals - the n generalized diagonals of the matrix,
+   * diagonals[k][t] = M[t][(t + k) % n]; an empty vector is a zero diagonal
+   * @return the encoded matrix
+   */
+  LinearTransform<Element> MakePackedLinearTransform(
+      const std::vector<std::vector<int64_t>>& diagonals) const {
+    return MakeLinearTransform<int64_t>(
+        diagonals, GetRingDimension() / 2, GetRingDimension() / 2,
+        [&](const std::vector<int64_t>& diagonal) {
+          return MakePackedPlaintext(diagonal);
+        });
+  }
+
+ private:
+  // splits the diagonals into baby and giant steps, rotates each diagonal
+  // back by its giant step and encodes it; rowSize is the number of slots
+  // rotations cycle through
+  template <typename T>
+  LinearTransform<Element> MakeLinearTransform(
+      const std::vector<std::vector<T>>& diagonals, usint slots,
+      usint rowSize,
+      const std::function<Plaintext(const std::vector<T>&)>& encode) const {
+    usint n = diagonals.size();
+    if (n != slots) {
+      PALISADE_THROW(config_error,
+                     "A linear transform needs " + std::to_string(slots) +
+                         " diagonals, one per slot; got " + std::to_string(n));
+    }
+    bool replicated = (n < rowSize);
+    if (replicated && 2 * n > rowSize) {
+      PALISADE_THROW(config_error,
+                     "A linear transform on " + std::to_string(n) +
+                         " slots needs at least " + std::to_string(2 * n) +
+                         " slots per ciphertext; got " +
+                         std::to_string(rowSize));
+    }
+    usint babySteps = 1;
+    while (babySteps * babySteps < n) babySteps++;
+
+    std::vector<Plaintext> encoded(n);
+    ParallelScope scope(m_executor);
+    ParallelFor(0, n, [&](size_t k) {
+      const std::vector<T>& diagonal = diagonals[k];
+      if (std::all_of(diagonal.begin(), diagonal.end(),
+                      [](const T& v) { return v == T(0); }))
+        return;
+      if (diagonal.size() != n) {
+        PALISADE_THROW(config_error, "Diagonal " + std::to_string(k) +
+                                         " does not have " +
+                                         std::to_string(n) + " entries");
+      }
+      usint shift = k - k % babySteps;
+      std::vector<T> rotated(replicated ? 2 * n : n);
+      for (usint t = 0; t < n; t++) rotated[(t + shift) % n] = diagonal[t];
+      if (replicated) {
+        std::copy(rotated.begin(), rotated.begin() + n, rotated.begin() + n);
+      }
+      encoded[k] = encode(rotated);
+    });
+
+    auto transform = std::make_shared<LinearTransformImpl<Element>>(
+        n, babySteps, replicated);
+    for (usint k = 0; k < n; k++) {
+      if (encoded[k]) transform->SetDiagonal(k, encoded[k]);
+    }
+    return transform;
+  }
+
+ public:
+
   /**
    * GetPlaintextForDecrypt returns a new Plaintext to be used in decryption.
    *
@@ -1441,6 +1817,32 @@ class CryptoContextImpl : public Serializable {
                         ConstCiphertext<Element> ciphertext,
                         Plaintext* plaintext);
 
+  /**
+   * Decrypt a batch of ciphertexts; the ciphertexts are decrypted and decoded
+   * in parallel
+   *
+   * @param privateKey - decryption key
+   * @param ciphertexts - ciphertexts to decrypt
+   * @param plaintexts - resulting plaintexts, in the order of the ciphertexts
+   * @return the result of decrypting each ciphertext
+   */
+  std::vector<DecryptResult> Decrypt(
+      const LPPrivateKey<Element> privateKey,
+      const std::vector<Ciphertext<Element>>& ciphertexts,
+      std::vector<Plaintext>* plaintexts) {
+    if (plaintexts == nullptr)
+      PALISADE_THROW(config_error, "plaintexts passed to Decrypt is empty");
+
+    plaintexts->resize(ciphertexts.size());
+    std::vector<DecryptResult> results(ciphertexts.size());
+    ParallelScope scope(m_executor);
+    ParallelFor(0, ciphertexts.size(), [&](size_t i) {
+      results[i] = Decrypt(privateKey, ciphertexts[i], &(*plaintexts)[i]);
+    });
+
+    return results;
+  }
+
   /**
    * ReEncrypt - Proxy Re Encryption mechanism for PALISADE
    * @param evalKey - evaluation key from the PRE keygen method
@@ -1452,6 +1854,7 @@ class CryptoContextImpl : public Serializable {
   Ciphertext<Element> ReEncrypt(
       LPEvalKey<Element> evalKey, ConstCiphertext<Element> ciphertext,
       const LPPublicKey<Element> publicKey = nullptr) const {
+    ParallelScope scope(m_executor);
     if (evalKey == nullptr || Mismatched(evalKey->GetCryptoContext()))
       PALISADE_THROW(config_error,
                      "Information passed to ReEncrypt was not generated with "
@@ -1476,6 +1879,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAdd(ConstCiphertext<Element> ct1,
                               ConstCiphertext<Element> ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
     auto rv = GetEncryptionAlgorithm()->EvalAdd(ct1, ct2);
@@ -1490,6 +1894,7 @@ class CryptoContextImpl : public Serializable {
    */
   void EvalAddInPlace(Ciphertext<Element>& ct1,
                       ConstCiphertext<Element> ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
     GetEncryptionAlgorithm()->EvalAddInPlace(ct1, ct2);
@@ -1506,6 +1911,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAddMutable(Ciphertext<Element>& ct1,
                                      Ciphertext<Element>& ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
     auto rv = GetEncryptionAlgorithm()->EvalAddMutable(ct1, ct2);
@@ -1520,6 +1926,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalSub(ConstCiphertext<Element> ct1,
                               ConstCiphertext<Element> ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
     auto rv = GetEncryptionAlgorithm()->EvalSub(ct1, ct2);
@@ -1537,6 +1944,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalSubMutable(Ciphertext<Element>& ct1,
                                      Ciphertext<Element>& ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
     auto rv = GetEncryptionAlgorithm()->EvalSubMutable(ct1, ct2);
@@ -1551,6 +1959,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAdd(ConstCiphertext<Element> ciphertext,
                               ConstPlaintext plaintext) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ciphertext, plaintext);
 
     plaintext->SetFormat(EVALUATION);
@@ -1570,6 +1979,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAddMutable(Ciphertext<Element>& ciphertext,
                                      Plaintext plaintext) const {
+    ParallelScope scope(m_executor);
     TypeCheck((ConstCiphertext<Element>)ciphertext, (ConstPlaintext)plaintext);
 
     plaintext->SetFormat(EVALUATION);
@@ -1586,6 +1996,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAdd(ConstCiphertext<Element> ciphertext,
                               double constant) const {
+    ParallelScope scope(m_executor);
     Ciphertext<Element> rv;
 
     if (constant >= 0) {
@@ -1607,6 +2018,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalLinearWSum(vector<Ciphertext<Element>> ciphertexts,
                                      vector<double> constants) const {
+    ParallelScope scope(m_executor);
     auto rv = GetEncryptionAlgorithm()->EvalLinearWSum(ciphertexts, constants);
     return rv;
   }
@@ -1622,6 +2034,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalLinearWSumMutable(
       vector<Ciphertext<Element>> ciphertexts, vector<double> constants) const {
+    ParallelScope scope(m_executor);
     auto rv =
         GetEncryptionAlgorithm()->EvalLinearWSumMutable(ciphertexts, constants);
     return rv;
@@ -1660,6 +2073,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalSub(ConstCiphertext<Element> ciphertext,
                               ConstPlaintext plaintext) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ciphertext, plaintext);
 
     auto rv = GetEncryptionAlgorithm()->EvalSub(ciphertext, plaintext);
@@ -1677,6 +2091,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalSubMutable(Ciphertext<Element>& ciphertext,
                                      Plaintext plaintext) const {
+    ParallelScope scope(m_executor);
     TypeCheck((ConstCiphertext<Element>)ciphertext, (ConstPlaintext)plaintext);
 
     auto rv = GetEncryptionAlgorithm()->EvalSubMutable(ciphertext, plaintext);
@@ -1691,6 +2106,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalSub(ConstCiphertext<Element> ciphertext,
                               double constant) const {
+    ParallelScope scope(m_executor);
     Ciphertext<Element> rv;
 
     if (constant >= 0) {
@@ -1729,15 +2145,16 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMult(ConstCiphertext<Element> ct1,
                                ConstCiphertext<Element> ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
-    auto ek = GetEvalMultKeyVector(ct1->GetKeyTag());
-    if (!ek.size()) {
+    auto ek = GetEvalMultKeyVectorPtr(ct1->GetKeyTag());
+    if (!ek->size()) {
       PALISADE_THROW(type_error,
                      "Evaluation key has not been generated for EvalMult");
     }
 
-    auto rv = GetEncryptionAlgorithm()->EvalMult(ct1, ct2, ek[0]);
+    auto rv = GetEncryptionAlgorithm()->EvalMult(ct1, ct2, (*ek)[0]);
     return rv;
   }
 
@@ -1752,15 +2169,16 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMultMutable(Ciphertext<Element>& ct1,
                                       Ciphertext<Element>& ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
-    auto ek = GetEvalMultKeyVector(ct1->GetKeyTag());
-    if (!ek.size()) {
+    auto ek = GetEvalMultKeyVectorPtr(ct1->GetKeyTag());
+    if (!ek->size()) {
       PALISADE_THROW(type_error,
                      "Evaluation key has not been generated for EvalMult");
     }
 
-    auto rv = GetEncryptionAlgorithm()->EvalMultMutable(ct1, ct2, ek[0]);
+    auto rv = GetEncryptionAlgorithm()->EvalMultMutable(ct1, ct2, (*ek)[0]);
     return rv;
   }
 
@@ -1773,6 +2191,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMultNoRelin(ConstCiphertext<Element> ct1,
                                       ConstCiphertext<Element> ct2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, ct2);
 
     auto rv = GetEncryptionAlgorithm()->EvalMult(ct1, ct2);
@@ -1794,6 +2213,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMultMany(
       const vector<Ciphertext<Element>>& ct) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ct.size()) PALISADE_THROW(type_error, "Empty input ciphertext vector");
 
@@ -1801,14 +2221,14 @@ class CryptoContextImpl : public Serializable {
         return ct[0];
     }
 
-    const auto ek = GetEvalMultKeyVector(ct[0]->GetKeyTag());
-    if (ek.size() < (ct[0]->GetElements().size() - 2)) {
+    const auto ek = GetEvalMultKeyVectorPtr(ct[0]->GetKeyTag());
+    if (ek->size() < (ct[0]->GetElements().size() - 2)) {
       PALISADE_THROW(type_error,
                      "Insufficient value was used for maxDepth to generate "
                      "keys for EvalMult");
     }
 
-    auto rv = GetEncryptionAlgorithm()->EvalMultMany(ct, ek);
+    auto rv = GetEncryptionAlgorithm()->EvalMultMany(ct, *ek);
     return rv;
   }
 
@@ -1822,6 +2242,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAddMany(
       const vector<Ciphertext<Element>>& ctList) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ctList.size())
       PALISADE_THROW(type_error, "Empty input ciphertext vector");
@@ -1846,6 +2267,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalAddManyInPlace(
       vector<Ciphertext<Element>>& ctList) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ctList.size())
       PALISADE_THROW(type_error, "Empty input ciphertext vector");
@@ -1867,18 +2289,19 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMultAndRelinearize(
       ConstCiphertext<Element> ct1, ConstCiphertext<Element> ct2) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ct1 || !ct2) PALISADE_THROW(type_error, "Input ciphertext is nullptr");
 
-    const auto ek = GetEvalMultKeyVector(ct1->GetKeyTag());
-    if (ek.size() <
+    const auto ek = GetEvalMultKeyVectorPtr(ct1->GetKeyTag());
+    if (ek->size() <
         (ct1->GetElements().size() + ct2->GetElements().size() - 3)) {
       PALISADE_THROW(type_error,
                      "Insufficient value was used for maxDepth to generate "
                      "keys for EvalMult");
     }
 
-    auto rv = GetEncryptionAlgorithm()->EvalMultAndRelinearize(ct1, ct2, ek);
+    auto rv = GetEncryptionAlgorithm()->EvalMultAndRelinearize(ct1, ct2, *ek);
     return rv;
   }
 
@@ -1890,18 +2313,19 @@ class CryptoContextImpl : public Serializable {
    * @return relinearized ciphertext
    */
   Ciphertext<Element> Relinearize(ConstCiphertext<Element> ct) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ct) PALISADE_THROW(type_error, "Input ciphertext is nullptr");
 
-    const auto ek = GetEvalMultKeyVector(ct->GetKeyTag());
+    const auto ek = GetEvalMultKeyVectorPtr(ct->GetKeyTag());
 
-    if (ek.size() < (ct->GetElements().size() - 2)) {
+    if (ek->size() < (ct->GetElements().size() - 2)) {
       PALISADE_THROW(type_error,
                      "Insufficient value was used for maxDepth to generate "
                      "keys for EvalMult");
     }
 
-    auto rv = GetEncryptionAlgorithm()->Relinearize(ct, ek);
+    auto rv = GetEncryptionAlgorithm()->Relinearize(ct, *ek);
     return rv;
   }
 
@@ -1917,14 +2341,14 @@ class CryptoContextImpl : public Serializable {
     if (!ct)
       PALISADE_THROW(type_error, "Input ciphertext is nullptr");
 
-    const auto ek = GetEvalMultKeyVector(ct->GetKeyTag());
-    if (ek.size() < (ct->GetElements().size() - 2)) {
+    const auto ek = GetEvalMultKeyVectorPtr(ct->GetKeyTag());
+    if (ek->size() < (ct->GetElements().size() - 2)) {
       PALISADE_THROW(type_error,
                      "Insufficient value was used for maxDepth to generate "
                      "keys for EvalMult");
     }
 
-    GetEncryptionAlgorithm()->RelinearizeInPlace(ct, ek);
+    GetEncryptionAlgorithm()->RelinearizeInPlace(ct, *ek);
    }
 
   /**
@@ -1973,6 +2397,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMult(ConstCiphertext<Element> ct1,
                                ConstPlaintext pt2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, pt2);
 
     auto rv = GetEncryptionAlgorithm()->EvalMult(ct1, pt2);
@@ -1990,6 +2415,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMultMutable(Ciphertext<Element>& ct1,
                                       Plaintext pt2) const {
+    ParallelScope scope(m_executor);
     TypeCheck(ct1, pt2);
 
     auto rv = GetEncryptionAlgorithm()->EvalMultMutable(ct1, pt2);
@@ -2004,6 +2430,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMult(ConstCiphertext<Element> ciphertext,
                                double constant) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ciphertext) {
       PALISADE_THROW(type_error, "Input ciphertext is nullptr");
@@ -2024,6 +2451,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> EvalMultMutable(Ciphertext<Element>& ciphertext,
                                       double constant) const {
+    ParallelScope scope(m_executor);
     // input parameter check
     if (!ciphertext) {
       PALISADE_THROW(type_error, "Input ciphertext is nullptr");
@@ -2039,6 +2467,7 @@ class CryptoContextImpl : public Serializable {
    * @return new ciphertext -ct
    */
   Ciphertext<Element> EvalNegate(ConstCiphertext<Element> ct) const {
+    ParallelScope scope(m_executor);
     if (ct == nullptr || Mismatched(ct->GetCryptoContext()))
       PALISADE_THROW(config_error,
                      "Information passed to EvalNegate was not generated with "
@@ -2061,6 +2490,7 @@ class CryptoContextImpl : public Serializable {
       const LPPublicKey<Element> publicKey,
       const LPPrivateKey<Element> origPrivateKey,
       const std::vector<usint>& indexList) const {
+    ParallelScope scope(m_executor);
     if (publicKey == nullptr || origPrivateKey == nullptr)
       PALISADE_THROW(type_error, "Null Keys");
     if (!indexList.size())
@@ -2090,6 +2520,7 @@ class CryptoContextImpl : public Serializable {
       ConstCiphertext<Element> ciphertext, usint i,
       const std::map<usint, LPEvalKey<Element>>& evalKeys,
       CALLER_INFO_ARGS_HDR) const {
+    ParallelScope scope(m_executor);
     if (nullptr == ciphertext) {
       std::string errorMsg(std::string("Input ciphertext is nullptr") +
                            CALLER_INFO);
@@ -2142,6 +2573,7 @@ class CryptoContextImpl : public Serializable {
   shared_ptr<std::map<usint, LPEvalKey<Element>>> EvalAutomorphismKeyGen(
       const LPPrivateKey<Element> privateKey,
       const std::vector<usint>& indexList) const {
+    ParallelScope scope(m_executor);
     if (privateKey == nullptr) PALISADE_THROW(type_error, "Null input");
     if (!indexList.size())
       PALISADE_THROW(config_error, "Input index vector is empty");
@@ -2173,14 +2605,28 @@ class CryptoContextImpl : public Serializable {
       const LPPublicKey<Element> publicKey = nullptr);
 
   /**
-   * GetEvalSumKey  returns the map
+   * GetEvalSumKey  returns a copy of the map
    *
    * @return the EvalSum key map
    */
-  static const std::map<usint, LPEvalKey<Element>>& GetEvalSumKeyMap(
+  static const std::map<usint, LPEvalKey<Element>> GetEvalSumKeyMap(
       const string& id);
 
-  static std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>&
+  /**
+   * GetEvalSumKeyMapPtr returns a shared pointer to the map, which keeps the
+   * keys alive while they are in use even if they are concurrently replaced
+   *
+   * @return the EvalSum key map
+   */
+  static shared_ptr<std::map<usint, LPEvalKey<Element>>> GetEvalSumKeyMapPtr(
+      const string& id);
+
+  /**
+   * GetAllEvalSumKeys
+   * @return a snapshot of all the keys; use InsertEvalSumKey and
+   * ClearEvalSumKeys to modify the stored keys
+   */
+  static const std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>
   GetAllEvalSumKeys();
 
   /**
@@ -2202,6 +2648,80 @@ class CryptoContextImpl : public Serializable {
       ConstCiphertext<Element> ciphertext, usint rowSize,
       const std::map<usint, LPEvalKey<Element>>& evalKeys) const;
 
+  /**
+   * EvalSumHoisted computes the same sum as EvalSum with fewer dependent key
+   * switches. Each round adds radix - 1 rotations of the partial sum, which
+   * share one digit decomposition and run in parallel (EvalAtIndexBatch), so
+   * the sum takes log_radix(batchSize) rounds instead of log2(batchSize)
+   * sequential automorphisms. It uses the rotation keys for
+   * GetEvalSumHoistedIndices, generated with EvalAtIndexKeyGen, instead of
+   * the EvalSum keys.
+   *
+   * @param ciphertext the input ciphertext.
+   * @param batchSize size of the batch
+   * @param radix number of terms added per round; a power of two
+   * @return resulting ciphertext
+   */
+  Ciphertext<Element> EvalSumHoisted(ConstCiphertext<Element> ciphertext,
+                                     usint batchSize, usint radix = 4) const;
+
+  /**
+   * EvalSumRowsHoisted computes the same sum as EvalSumRows for the full
+   * cyclotomic order, in rounds of hoisted rotations like EvalSumHoisted
+   *
+   * @param ciphertext the input ciphertext.
+   * @param rowSize size of rows in the matrix
+   * @param radix number of terms added per round; a power of two
+   * @return resulting ciphertext
+   */
+  Ciphertext<Element> EvalSumRowsHoisted(ConstCiphertext<Element> ciphertext,
+                                         usint rowSize, usint radix = 4) const;
+
+  /**
+   * EvalSumColsHoisted computes the same sum as EvalSumCols, in rounds of
+   * hoisted rotations like EvalSumHoisted; CKKS only
+   *
+   * @param ciphertext the input ciphertext.
+   * @param batchSize size of the rows in the matrix
+   * @param radix number of terms added per round; a power of two
+   * @return resulting ciphertext
+   */
+  Ciphertext<Element> EvalSumColsHoisted(ConstCiphertext<Element> ciphertext,
+                                         usint batchSize,
+                                         usint radix = 4) const;
+
+  /**
+   * Rotation indices EvalSumHoisted needs keys for
+   */
+  std::vector<int32_t> GetEvalSumHoistedIndices(usint batchSize,
+                                                usint radix = 4) const;
+
+  /**
+   * Rotation indices EvalSumRowsHoisted needs keys for
+   */
+  std::vector<int32_t> GetEvalSumRowsHoistedIndices(usint rowSize,
+                                                    usint radix = 4) const;
+
+  /**
+   * Rotation indices EvalSumColsHoisted needs keys for
+   */
+  std::vector<int32_t> GetEvalSumColsHoistedIndices(usint batchSize,
+                                                    usint radix = 4) const;
+
+ private:
+  // the rotation indices of each round of a sum of count rotations of a
+  // ciphertext by 0, step, 2 * step, ... (count rounded up to a power of two)
+  static std::vector<std::vector<int32_t>> RotateAndSumRounds(int32_t step,
+                                                              usint count,
+                                                              usint radix);
+
+  // sums the rotations of RotateAndSumRounds, one EvalAtIndexBatch per round
+  Ciphertext<Element> EvalRotateAndSum(ConstCiphertext<Element> ciphertext,
+                                       int32_t step, usint count,
+                                       usint radix) const;
+
+ public:
+
   /**
    * EvalAtIndexKeyGen generates evaluation keys for a list of indices
    *
@@ -2242,6 +2762,7 @@ class CryptoContextImpl : public Serializable {
    */
   shared_ptr<vector<Element>> EvalFastRotationPrecompute(
       ConstCiphertext<Element> ct) const {
+    ParallelScope scope(m_executor);
     auto rv = GetEncryptionAlgorithm()->EvalFastRotationPrecompute(ct);
     return rv;
   }
@@ -2285,6 +2806,7 @@ class CryptoContextImpl : public Serializable {
   Ciphertext<Element> EvalFastRotation(
       ConstCiphertext<Element> ct, const usint index, const usint m,
       const shared_ptr<vector<Element>> digits) const {
+    ParallelScope scope(m_executor);
     auto rv = GetEncryptionAlgorithm()->EvalFastRotation(ct, index, m, digits);
     return rv;
   }
@@ -2303,14 +2825,72 @@ class CryptoContextImpl : public Serializable {
       const vector<Ciphertext<Element>>& ciphertextVector) const;
 
   /**
-   * GetEvalAutomorphismKey  returns the map
+   * EvalLinearTransform multiplies an encrypted vector by a plaintext matrix
+   * encoded with MakeCKKSLinearTransform or MakePackedLinearTransform. The
+   * baby-step rotations are hoisted (EvalFastRotation), so the product costs
+   * about 2 * sqrt(n) key switches instead of one per diagonal. The rotation
+   * keys for transform->GetRotationIndices() must have been generated with
+   * EvalAtIndexKeyGen.
+   *
+   * @param ciphertext - the encrypted vector
+   * @param transform - the encoded matrix
+   * @return the encrypted product in the first n slots, one plaintext
+   * multiplication deeper than the input
+   */
+  Ciphertext<Element> EvalLinearTransform(
+      ConstCiphertext<Element> ciphertext,
+      const LinearTransform<Element>& transform) const;
+
+  /**
+   * GetEvalAutomorphismKey  returns a copy of the map
    *
    * @return the EvalAutomorphism key map
    */
-  static const std::map<usint, LPEvalKey<Element>>& GetEvalAutomorphismKeyMap(
+  static const std::map<usint, LPEvalKey<Element>> GetEvalAutomorphismKeyMap(
       const string& id);
 
-  static std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>&
+  /**
+   * GetEvalAutomorphismKeyMapPtr returns a shared pointer to the map, which
+   * keeps the keys alive while they are in use even if they are concurrently
+   * replaced. For lazily loaded keys, every key of the file is deserialized
+   * into the returned map, regardless of the resident key limit; use the
+   * overload taking automorphism indices when only some keys are needed.
+   *
+   * @return the EvalAutomorphism key map
+   */
+  static shared_ptr<std::map<usint, LPEvalKey<Element>>>
+  GetEvalAutomorphismKeyMapPtr(const string& id);
+
+  /**
+   * GetEvalAutomorphismKeyMapPtr returns a map containing at least the keys
+   * for the given automorphism indices. For lazily loaded keys, only these
+   * keys are deserialized.
+   *
+   * @param id - key ID
+   * @param indices - automorphism indices
+   * @return the EvalAutomorphism key map
+   */
+  static shared_ptr<std::map<usint, LPEvalKey<Element>>>
+  GetEvalAutomorphismKeyMapPtr(const string& id,
+                               const std::vector<usint>& indices);
+
+  /**
+   * GetEvalAutomorphismKey returns the key for a single automorphism index
+   *
+   * @param id - key ID
+   * @param autoIndex - automorphism index
+   * @return the EvalAutomorphism key
+   */
+  static LPEvalKey<Element> GetEvalAutomorphismKey(const string& id,
+                                                   usint autoIndex);
+
+  /**
+   * GetAllEvalAutomorphismKeys
+   * @return a snapshot of all the keys, including the lazily loaded ones,
+   * which are all deserialized; use InsertEvalAutomorphismKey and
+   * ClearEvalAutomorphismKeys to modify the stored keys
+   */
+  static const std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>
   GetAllEvalAutomorphismKeys();
 
   /**
@@ -2323,6 +2903,42 @@ class CryptoContextImpl : public Serializable {
   Ciphertext<Element> EvalAtIndex(ConstCiphertext<Element> ciphertext,
                                   int32_t index) const;
 
+  /**
+   * Rotates a ciphertext by several indices at once. The digit decomposition
+   * is done once and shared by all the rotations (hoisted automorphisms, see
+   * EvalFastRotationPrecompute), and the rotations run in parallel. The keys
+   * must have been generated with EvalAtIndexKeyGen.
+   *
+   * @param ciphertext - the ciphertext to rotate
+   * @param indices - the rotation indices, as in EvalAtIndex
+   * @return the rotated ciphertexts, in the order of indices
+   */
+  std::vector<Ciphertext<Element>> EvalAtIndexBatch(
+      ConstCiphertext<Element> ciphertext,
+      const std::vector<int32_t>& indices) const;
+
+  /**
+   * Chooses at most maxKeys rotation keys that all the given rotations can be
+   * composed from, see RotationKeyPlan. The plan reports the number of key
+   * switches each rotation costs with these keys; generate them with
+   * EvalAtIndexKeyGen(privateKey, plan.GetKeyIndices()) and turn on
+   * SetRotationComposition. Power-of-two cyclotomics only.
+   *
+   * @param indices - the rotation indices the program needs
+   * @param maxKeys - the key budget; 0 for one key per index
+   * @return the plan
+   */
+  RotationKeyPlan PlanRotationKeys(const std::vector<int32_t>& indices,
+                                   usint maxKeys = 0) const;
+
+ private:
+  // the rotation by automorphism autoIndex, composed from the rotation keys
+  // of the ciphertext's key tag
+  Ciphertext<Element> EvalAtIndexComposed(ConstCiphertext<Element> ciphertext,
+                                          usint autoIndex) const;
+
+ public:
+
   /**
    * Evaluates inner product in batched encoding
    *
@@ -2347,6 +2963,32 @@ class CryptoContextImpl : public Serializable {
                                        ConstPlaintext plaintext,
                                        usint batchSize) const;
 
+  /**
+   * Evaluates the sum of the products ciphertexts1[i] * ciphertexts2[i]. The
+   * products are computed without key switching and added up, and the sum is
+   * relinearized once and, for schemes with modulus switching, rescaled once,
+   * instead of once per product as with EvalMult followed by EvalAdd.
+   *
+   * @param ciphertexts1 first factors of the products.
+   * @param ciphertexts2 second factors of the products.
+   * @return resulting ciphertext
+   */
+  Ciphertext<Element> EvalSumOfProducts(
+      const vector<Ciphertext<Element>>& ciphertexts1,
+      const vector<Ciphertext<Element>>& ciphertexts2) const;
+
+  /**
+   * Evaluates the sum of the products ciphertexts[i] * plaintexts[i], with a
+   * single rescaling of the sum for schemes with modulus switching.
+   *
+   * @param ciphertexts ciphertext factors of the products.
+   * @param plaintexts plaintext weights of the products.
+   * @return resulting ciphertext
+   */
+  Ciphertext<Element> EvalSumOfProducts(
+      const vector<Ciphertext<Element>>& ciphertexts,
+      const vector<Plaintext>& plaintexts) const;
+
   /**
    * Method for polynomial evaluation for polynomials represented as power
    * series.
@@ -2359,6 +3001,7 @@ class CryptoContextImpl : public Serializable {
   virtual Ciphertext<Element> EvalPoly(
       ConstCiphertext<Element> ciphertext,
       const std::vector<double>& coefficients) const {
+    ParallelScope scope(m_executor);
     if (ciphertext == nullptr ||
         this->Mismatched(ciphertext->GetCryptoContext()))
       throw std::logic_error(
@@ -2371,6 +3014,34 @@ class CryptoContextImpl : public Serializable {
     return rv;
   }
 
+  /**
+   * Method for polynomial evaluation for polynomials represented as
+   * Chebyshev series, i.e., p(x) = sum_j c_j T_j(y), where
+   * y = (2x - (a + b)) / (b - a) maps the interval [a, b] to [-1, 1].
+   *
+   * @param &cipherText input ciphertext
+   * @param &coefficients is the vector of Chebyshev coefficients c_j; the
+   * size of the vector is the degree of the series + 1
+   * @param a lower bound of the approximation interval
+   * @param b upper bound of the approximation interval
+   * @return the result of polynomial evaluation.
+   */
+  virtual Ciphertext<Element> EvalChebyshevSeries(
+      ConstCiphertext<Element> ciphertext,
+      const std::vector<double>& coefficients, double a, double b) const {
+    ParallelScope scope(m_executor);
+    if (ciphertext == nullptr ||
+        this->Mismatched(ciphertext->GetCryptoContext()))
+      throw std::logic_error(
+          "Information passed to EvalChebyshevSeries was not generated with "
+          "this crypto context");
+
+    auto rv = std::static_pointer_cast<LPPublicKeyEncryptionScheme<Element>>(
+                  this->GetEncryptionAlgorithm())
+                  ->EvalChebyshevSeries(ciphertext, coefficients, a, b);
+    return rv;
+  }
+
   /**
    * KeySwitch - PALISADE KeySwitch method
    * @param keySwitchHint - reference to KeySwitchHint
@@ -2379,6 +3050,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> KeySwitch(const LPEvalKey<Element> keySwitchHint,
                                 ConstCiphertext<Element> ciphertext) const {
+    ParallelScope scope(m_executor);
     if (keySwitchHint == nullptr ||
         Mismatched(keySwitchHint->GetCryptoContext()))
       PALISADE_THROW(
@@ -2401,6 +3073,7 @@ class CryptoContextImpl : public Serializable {
    */
   void KeySwitchInPlace(const LPEvalKey<Element> keySwitchHint,
                         Ciphertext<Element>& ciphertext) const {
+    ParallelScope scope(m_executor);
     if (keySwitchHint == nullptr ||
         Mismatched(keySwitchHint->GetCryptoContext()))
       PALISADE_THROW(config_error,
@@ -2424,6 +3097,7 @@ class CryptoContextImpl : public Serializable {
    * @return mod reduced ciphertext
    */
   Ciphertext<Element> Rescale(ConstCiphertext<Element> ciphertext) const {
+    ParallelScope scope(m_executor);
     if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
       PALISADE_THROW(config_error,
                      "Information passed to Rescale was not generated with "
@@ -2440,6 +3114,7 @@ class CryptoContextImpl : public Serializable {
    * @param ciphertext - ciphertext to be mod-reduced in-place
    */
   void RescaleInPlace(Ciphertext<Element>& ciphertext) const {
+    ParallelScope scope(m_executor);
     if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
       PALISADE_THROW(
           config_error,
@@ -2455,6 +3130,7 @@ class CryptoContextImpl : public Serializable {
    * @return mod reduced ciphertext
    */
   Ciphertext<Element> ModReduce(ConstCiphertext<Element> ciphertext) const {
+    ParallelScope scope(m_executor);
     if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
       PALISADE_THROW(
           not_available_error,
@@ -2470,6 +3146,7 @@ class CryptoContextImpl : public Serializable {
    * @param ciphertext - ciphertext to be mod-reduced in-place
    */
   void ModReduceInPlace(Ciphertext<Element>& ciphertext) const {
+    ParallelScope scope(m_executor);
     if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
       PALISADE_THROW(
           not_available_error,
@@ -2488,6 +3165,7 @@ class CryptoContextImpl : public Serializable {
   Ciphertext<Element> LevelReduce(ConstCiphertext<Element> cipherText1,
                                   const LPEvalKey<Element> linearKeySwitchHint,
                                   size_t levels = 1) const {
+    ParallelScope scope(m_executor);
     const auto cryptoParams =
         std::dynamic_pointer_cast<LPCryptoParametersCKKS<DCRTPoly>>(
             cipherText1->GetCryptoParameters());
@@ -2513,6 +3191,7 @@ class CryptoContextImpl : public Serializable {
   Ciphertext<Element> ComposedEvalMult(
       ConstCiphertext<Element> ciphertext1,
       ConstCiphertext<Element> ciphertext2) const {
+    ParallelScope scope(m_executor);
     if (ciphertext1 == nullptr || ciphertext2 == nullptr ||
         ciphertext1->GetKeyTag() != ciphertext2->GetKeyTag() ||
         Mismatched(ciphertext1->GetCryptoContext()))
@@ -2520,14 +3199,14 @@ class CryptoContextImpl : public Serializable {
                      "Ciphertexts passed to ComposedEvalMult were not "
                      "generated with this crypto context");
 
-    auto ek = GetEvalMultKeyVector(ciphertext1->GetKeyTag());
-    if (!ek.size()) {
+    auto ek = GetEvalMultKeyVectorPtr(ciphertext1->GetKeyTag());
+    if (!ek->size()) {
       PALISADE_THROW(type_error,
                      "Evaluation key has not been generated for EvalMult");
     }
 
-    auto rv = GetEncryptionAlgorithm()->ComposedEvalMult(ciphertext1,
-                                                         ciphertext2, ek[0]);
+    auto rv = GetEncryptionAlgorithm()->ComposedEvalMult(
+        ciphertext1, ciphertext2, (*ek)[0]);
     return rv;
   }
 
@@ -2540,6 +3219,7 @@ class CryptoContextImpl : public Serializable {
    */
   Ciphertext<Element> Compress(ConstCiphertext<Element> ciphertext1,
                                uint32_t numTowers = 1) const {
+    ParallelScope scope(m_executor);
     if (ciphertext1 == nullptr)
       PALISADE_THROW(config_error, "input ciphertext is invalid (has no data)");
 
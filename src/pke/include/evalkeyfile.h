@@ -0,0 +1,154 @@
+// @file evalkeyfile.h -- Lazily loaded evaluation keys from an indexed file.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT))
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_PKE_EVALKEYFILE_H_
+#define SRC_PKE_EVALKEYFILE_H_
+
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "pubkeylp.h"
+#include "utils/indexedfile.h"
+#include "utils/lrucache.h"
+
+namespace lbcrypto {
+
+template <typename Element>
+class CryptoContextImpl;
+
+/**
+ * @brief Automorphism keys of one secret key, loaded on demand from an
+ * indexed key file
+ *
+ * The file is written by CryptoContextImpl::SerializeEvalAutomorphismKeyIndexed
+ * and holds one serialized key per automorphism index. Opening it only parses
+ * the index; each key is deserialized in place from the memory-mapped file the
+ * first time it is requested, and at most maxResidentKeys deserialized keys are
+ * kept, evicting the least recently used ones.
+ */
+template <typename Element>
+class EvalKeyFile {
+ public:
+  // deserializes a single key from a stream
+  using Loader = std::function<LPEvalKey<Element>(std::istream&)>;
+
+  /**
+   * Opens a key file; throws if it is missing or malformed
+   * @param filename path of the file
+   * @param maxResidentKeys maximum number of deserialized keys kept in
+   * memory; 0 means unbounded
+   * @param loader function deserializing a key
+   */
+  EvalKeyFile(const std::string& filename, size_t maxResidentKeys,
+              Loader loader)
+      : m_file(filename), m_cache(maxResidentKeys), m_loader(loader) {}
+
+  /**
+   * @return tag of the secret key the automorphism keys belong to
+   */
+  const std::string& GetKeyTag() const { return m_file.GetHeader(); }
+
+  /**
+   * @return automorphism indices of all the keys in the file
+   */
+  std::vector<usint> GetIndices() const {
+    return std::vector<usint>(m_file.GetIds().begin(), m_file.GetIds().end());
+  }
+
+  bool Contains(usint autoIndex) const { return m_file.Contains(autoIndex); }
+
+  /**
+   * Returns the key for an automorphism index, deserializing it if it is not
+   * resident; throws if the file has no such key
+   * @param autoIndex automorphism index
+   * @return the key
+   */
+  LPEvalKey<Element> GetKey(usint autoIndex) {
+    LPEvalKey<Element> key;
+    if (m_cache.Get(autoIndex, &key)) return key;
+
+    // concurrent misses on the same key may both deserialize it; the cache
+    // keeps the last one, and both are equal
+    auto record = m_file.GetRecord(autoIndex);
+    MemoryStreamBuf buffer(record.first, record.second);
+    std::istream stream(&buffer);
+    key = m_loader(stream);
+    m_cache.Put(autoIndex, key);
+
+    {
+      std::lock_guard<std::mutex> lock(m_contextMutex);
+      if (m_context.expired()) m_context = key->GetCryptoContext();
+    }
+
+    return key;
+  }
+
+  /**
+   * Returns the keys for a set of automorphism indices
+   * @param indices automorphism indices
+   * @return map from automorphism index to key
+   */
+  shared_ptr<std::map<usint, LPEvalKey<Element>>> GetKeys(
+      const std::vector<usint>& indices) {
+    auto keys = std::make_shared<std::map<usint, LPEvalKey<Element>>>();
+    for (auto autoIndex : indices) (*keys)[autoIndex] = GetKey(autoIndex);
+    return keys;
+  }
+
+  /**
+   * @return number of deserialized keys currently kept in memory
+   */
+  size_t GetResidentKeyCount() const { return m_cache.Size(); }
+
+  /**
+   * @return crypto context of the keys, deserializing one key if none has
+   * been loaded yet; nullptr if the file has no keys
+   */
+  shared_ptr<CryptoContextImpl<Element>> GetCryptoContext() {
+    {
+      std::lock_guard<std::mutex> lock(m_contextMutex);
+      auto context = m_context.lock();
+      if (context != nullptr) return context;
+    }
+
+    auto indices = GetIndices();
+    if (indices.empty()) return nullptr;
+    return GetKey(indices.front())->GetCryptoContext();
+  }
+
+ private:
+  IndexedFileReader m_file;
+  LRUCache<usint, LPEvalKey<Element>> m_cache;
+  Loader m_loader;
+  mutable std::mutex m_contextMutex;
+  std::weak_ptr<CryptoContextImpl<Element>> m_context;
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_PKE_EVALKEYFILE_H_
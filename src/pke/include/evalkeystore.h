@@ -0,0 +1,177 @@
+// @file evalkeystore.h -- Thread-safe storage of evaluation keys.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT))
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_PKE_EVALKEYSTORE_H_
+#define SRC_PKE_EVALKEYSTORE_H_
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace lbcrypto {
+
+/**
+ * @brief Concurrent store of evaluation keys indexed by key tag
+ *
+ * The store is split into shards selected by the hash of the key tag. Each
+ * shard publishes an immutable hash map through an atomically loaded
+ * shared_ptr, while writers serialize on the mutex of the shard, copy its
+ * map, modify the copy and publish it. A lookup never waits for a writer
+ * copying a shard; it only holds the short internal lock the standard
+ * library may use to load the shared_ptr (libstdc++ does). This suits the
+ * read-mostly access pattern of evaluation keys, which are generated once
+ * and then used by many concurrent EvalMult/EvalAtIndex calls.
+ *
+ * Values are held by shared_ptr, so a value returned by Find stays alive
+ * for as long as the caller holds it, even if it is replaced or erased
+ * concurrently.
+ *
+ * @tparam ValueType type of the stored value, e.g., the vector of
+ * relinearization keys or the map of automorphism keys of a secret key
+ */
+template <typename ValueType>
+class EvalKeyStore {
+ public:
+  using ValuePtr = std::shared_ptr<ValueType>;
+
+  EvalKeyStore() {
+    for (auto& shard : m_shards) shard.map = std::make_shared<ShardMap>();
+  }
+
+  EvalKeyStore(const EvalKeyStore&) = delete;
+  EvalKeyStore& operator=(const EvalKeyStore&) = delete;
+
+  /**
+   * Looks up the value stored for a key tag
+   *
+   * @param tag key tag
+   * @return the stored value, or nullptr if there is none
+   */
+  ValuePtr Find(const std::string& tag) const {
+    const Shard& shard = GetShard(tag);
+    auto map = std::atomic_load(&shard.map);
+    auto it = map->find(tag);
+    return (it == map->end()) ? nullptr : it->second;
+  }
+
+  /**
+   * Adds the value for a key tag, replacing the existing value if there
+   *
+   * @param tag key tag
+   * @param value value to store
+   */
+  void Insert(const std::string& tag, ValuePtr value) {
+    Update(GetShard(tag),
+           [&](ShardMap& map) { map[tag] = std::move(value); });
+  }
+
+  /**
+   * Removes the value stored for a key tag
+   *
+   * @param tag key tag
+   */
+  void Erase(const std::string& tag) {
+    Update(GetShard(tag), [&](ShardMap& map) { map.erase(tag); });
+  }
+
+  /**
+   * Removes all values matching a predicate
+   *
+   * @param pred predicate on the stored values
+   */
+  void EraseIf(const std::function<bool(const ValueType&)>& pred) {
+    for (auto& shard : m_shards) {
+      Update(shard, [&](ShardMap& map) {
+        for (auto it = map.begin(); it != map.end();) {
+          if (pred(*it->second))
+            it = map.erase(it);
+          else
+            ++it;
+        }
+      });
+    }
+  }
+
+  /**
+   * Removes all values
+   */
+  void Clear() {
+    for (auto& shard : m_shards)
+      Update(shard, [](ShardMap& map) { map.clear(); });
+  }
+
+  /**
+   * Returns a consistent copy of the contents of every shard, ordered by key
+   * tag
+   *
+   * @return map from key tag to value
+   */
+  std::map<std::string, ValuePtr> Snapshot() const {
+    std::map<std::string, ValuePtr> result;
+    for (const auto& shard : m_shards) {
+      auto map = std::atomic_load(&shard.map);
+      result.insert(map->begin(), map->end());
+    }
+    return result;
+  }
+
+ private:
+  static const size_t NUM_SHARDS = 16;
+
+  using ShardMap = std::unordered_map<std::string, ValuePtr>;
+
+  struct Shard {
+    // serializes writers of the shard
+    std::mutex mutex;
+    // current immutable contents of the shard
+    std::shared_ptr<const ShardMap> map;
+  };
+
+  Shard& GetShard(const std::string& tag) {
+    return m_shards[std::hash<std::string>()(tag) % NUM_SHARDS];
+  }
+
+  const Shard& GetShard(const std::string& tag) const {
+    return m_shards[std::hash<std::string>()(tag) % NUM_SHARDS];
+  }
+
+  template <typename Func>
+  static void Update(Shard& shard, Func func) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto updated = std::make_shared<ShardMap>(*std::atomic_load(&shard.map));
+    func(*updated);
+    std::atomic_store(&shard.map,
+                      std::shared_ptr<const ShardMap>(std::move(updated)));
+  }
+
+  std::array<Shard, NUM_SHARDS> m_shards;
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_PKE_EVALKEYSTORE_H_
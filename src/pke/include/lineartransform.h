@@ -0,0 +1,125 @@
+// @file lineartransform.h -- Pre-encoded matrices for baby-step/giant-step
+// homomorphic matrix-vector products.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT))
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_PKE_LINEARTRANSFORM_H_
+#define SRC_PKE_LINEARTRANSFORM_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "encoding/plaintext.h"
+
+namespace lbcrypto {
+
+/**
+ * @brief An n x n matrix prepared for CryptoContextImpl::EvalLinearTransform
+ *
+ * The matrix is given by its generalized diagonals diag_k[t] = M[t][t + k mod
+ * n], where n is the number of slots rotations cycle through. The product
+ * M * x is computed with the baby-step/giant-step method: with g baby steps,
+ * k = j * g + i and
+ *
+ *   M * x = sum_j rot(sum_i rot(diag_k, -j * g) * rot(x, i), j * g),
+ *
+ * so the g - 1 baby-step rotations of x share one hoisted digit
+ * decomposition and only the giant steps need full key switches, about
+ * 2 * sqrt(n) rotations instead of n. The diagonals are rotated and encoded
+ * once, when the transform is made; zero diagonals are dropped.
+ *
+ * Rotations cycle through all the slots of a ciphertext. For a smaller n, e.g.
+ * a CKKS batch, the input is first copied to slots [n, 2n) with one more
+ * rotation, and the diagonals are encoded twice over, so that rotations by
+ * less than n are cyclic on the first n slots.
+ */
+template <typename Element>
+class LinearTransformImpl {
+ public:
+  LinearTransformImpl(usint dim, usint babySteps, bool replicated = false)
+      : m_dim(dim), m_babySteps(babySteps), m_replicated(replicated) {}
+
+  /**
+   * @return the dimension n of the matrix
+   */
+  usint GetDim() const { return m_dim; }
+
+  /**
+   * @return the number of baby steps g
+   */
+  usint GetBabySteps() const { return m_babySteps; }
+
+  /**
+   * @return whether the input is copied to slots [n, 2n) before the product
+   */
+  bool IsReplicated() const { return m_replicated; }
+
+  /**
+   * @return the encoded diagonals, by diagonal index, rotated for their giant
+   * step
+   */
+  const std::map<usint, Plaintext>& GetDiagonals() const {
+    return m_diagonals;
+  }
+
+  void SetDiagonal(usint k, Plaintext diagonal) { m_diagonals[k] = diagonal; }
+
+  /**
+   * The rotation indices EvalLinearTransform uses for this matrix, to be
+   * passed to EvalAtIndexKeyGen
+   *
+   * @return the baby steps i and giant steps j * g of the nonzero diagonals,
+   * and -n if the input is replicated
+   */
+  std::vector<int32_t> GetRotationIndices() const {
+    std::vector<bool> baby(m_babySteps, false);
+    std::vector<bool> giant((m_dim + m_babySteps - 1) / m_babySteps, false);
+    for (const auto& d : m_diagonals) {
+      baby[d.first % m_babySteps] = true;
+      giant[d.first / m_babySteps] = true;
+    }
+
+    std::vector<int32_t> indices;
+    for (usint i = 1; i < baby.size(); i++) {
+      if (baby[i]) indices.push_back(i);
+    }
+    for (usint j = 1; j < giant.size(); j++) {
+      if (giant[j]) indices.push_back(j * m_babySteps);
+    }
+    if (m_replicated) indices.push_back(-static_cast<int32_t>(m_dim));
+    return indices;
+  }
+
+ private:
+  usint m_dim;
+  usint m_babySteps;
+  bool m_replicated;
+  std::map<usint, Plaintext> m_diagonals;
+};
+
+template <typename Element>
+using LinearTransform = std::shared_ptr<const LinearTransformImpl<Element>>;
+
+}  // namespace lbcrypto
+
+#endif  // SRC_PKE_LINEARTRANSFORM_H_
@@ -50,6 +50,16 @@ extern template class lbcrypto::LPPublicKeyEncryptionScheme<lbcrypto::DCRTPoly>;
 extern template class lbcrypto::LPEvalKeyImpl<lbcrypto::DCRTPoly>;
 extern template class lbcrypto::LPEvalKeyRelinImpl<lbcrypto::DCRTPoly>;
 
+CEREAL_CLASS_VERSION(
+    lbcrypto::LPEvalKeyRelinImpl<lbcrypto::Poly>,
+    lbcrypto::LPEvalKeyRelinImpl<lbcrypto::Poly>::SerializedVersion());
+CEREAL_CLASS_VERSION(
+    lbcrypto::LPEvalKeyRelinImpl<lbcrypto::NativePoly>,
+    lbcrypto::LPEvalKeyRelinImpl<lbcrypto::NativePoly>::SerializedVersion());
+CEREAL_CLASS_VERSION(
+    lbcrypto::LPEvalKeyRelinImpl<lbcrypto::DCRTPoly>,
+    lbcrypto::LPEvalKeyRelinImpl<lbcrypto::DCRTPoly>::SerializedVersion());
+
 CEREAL_REGISTER_TYPE(lbcrypto::LPCryptoParameters<lbcrypto::Poly>);
 CEREAL_REGISTER_TYPE(lbcrypto::LPCryptoParameters<lbcrypto::NativePoly>);
 
@@ -24,10 +24,14 @@
 #ifndef LBCRYPTO_CRYPTO_PUBKEYLP_H
 #define LBCRYPTO_CRYPTO_PUBKEYLP_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iomanip>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -40,10 +44,12 @@
 #include "utils/caller_info.h"
 #include "utils/hashutil.h"
 #include "utils/inttypes.h"
+#include "utils/scheduler.h"
 
 #include "math/distrgen.h"
 
 #include "encoding/encodingparams.h"
+#include "seededuniform.h"
 
 /**
  * @namespace lbcrypto
@@ -493,6 +499,33 @@ class LPEvalKeyImpl : public LPKey<Element> {
     PALISADE_THROW(not_implemented_error, "GetAinDCRT operation not supported");
   }
 
+  /**
+   * Setter function to store the seed the A vector is derived from.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @param &seed is the seed to be copied.
+   */
+  virtual void SetAVectorSeed(const std::vector<uint32_t> &seed) {
+    PALISADE_THROW(not_implemented_error,
+                   "SetAVectorSeed operation not supported");
+  }
+
+  /**
+   * Getter function to access the seed the A vector is derived from.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @return the seed.
+   */
+  virtual const std::vector<uint32_t> &GetAVectorSeed() const {
+    PALISADE_THROW(not_implemented_error,
+                   "GetAVectorSeed operation not supported");
+  }
+
+  /**
+   * @return true if the A vector is derived from a seed rather than stored.
+   */
+  virtual bool IsAVectorSeeded() const { return false; }
+
   virtual void ClearKeys() {
     PALISADE_THROW(not_implemented_error,
                    "ClearKeys operation is not supported");
@@ -551,6 +584,8 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
   explicit LPEvalKeyRelinImpl(const LPEvalKeyRelinImpl<Element> &rhs)
       : LPEvalKeyImpl<Element>(rhs.GetCryptoContext()) {
     m_rKey = rhs.m_rKey;
+    m_seed = rhs.m_seed;
+    m_aExpanded = rhs.m_aExpanded.load();
   }
 
   /**
@@ -561,6 +596,8 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
   explicit LPEvalKeyRelinImpl(LPEvalKeyRelinImpl<Element> &&rhs)
       : LPEvalKeyImpl<Element>(rhs.GetCryptoContext()) {
     m_rKey = std::move(rhs.m_rKey);
+    m_seed = std::move(rhs.m_seed);
+    m_aExpanded = rhs.m_aExpanded.load();
   }
 
   operator bool() const {
@@ -576,6 +613,8 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
       const LPEvalKeyRelinImpl<Element> &rhs) {
     this->context = rhs.context;
     this->m_rKey = rhs.m_rKey;
+    this->m_seed = rhs.m_seed;
+    this->m_aExpanded = rhs.m_aExpanded.load();
     return *this;
   }
 
@@ -589,6 +628,8 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
     this->context = rhs.context;
     rhs.context = 0;
     m_rKey = std::move(rhs.m_rKey);
+    m_seed = std::move(rhs.m_seed);
+    m_aExpanded = rhs.m_aExpanded.load();
     return *this;
   }
 
@@ -619,6 +660,7 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
    * @return Element vector A.
    */
   virtual const std::vector<Element> &GetAVector() const {
+    if (!m_seed.empty()) ExpandAVector();
     return m_rKey.at(0);
   }
 
@@ -712,19 +754,83 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
 
   virtual const DCRTPoly &GetBinDCRT() const { return m_dcrtKeys.at(1); }
 
+  /**
+   * Setter function to store the seed the A vector is derived from. The key
+   * switches to its compressed form: only the seed and the B vector are
+   * serialized. An A vector that is already stored must be the expansion of
+   * the seed and is kept as its cached copy; otherwise A is regenerated on
+   * first use.
+   * Overrides base class implementation.
+   *
+   * @param &seed is the seed to be copied.
+   */
+  virtual void SetAVectorSeed(const std::vector<uint32_t> &seed) {
+    m_seed = seed;
+    m_aExpanded = !m_rKey.empty() && !m_rKey[0].empty();
+  }
+
+  /**
+   * Getter function to access the seed the A vector is derived from.
+   * Overrides base class implementation.
+   *
+   * @return the seed; empty if A is stored explicitly.
+   */
+  virtual const std::vector<uint32_t> &GetAVectorSeed() const {
+    return m_seed;
+  }
+
+  virtual bool IsAVectorSeeded() const { return !m_seed.empty(); }
+
+  /**
+   * Regenerates the A vector of a seeded key and caches it in the key, so
+   * that later key switches do not pay for the expansion. Safe to call
+   * concurrently; GetAVector() calls it on demand.
+   */
+  void ExpandAVector() const {
+    if (m_aExpanded.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(m_expandMutex);
+    if (m_aExpanded.load(std::memory_order_relaxed)) return;
+
+    const std::vector<Element> &b = m_rKey.at(1);
+    std::vector<Element> a(b.size());
+    ParallelFor(0, b.size(), [&](size_t i) {
+      a[i] = SeededUniform<Element>::Expand(
+          m_seed, SeededUniform<Element>::EVAL_KEY, i, b[i].GetParams());
+    });
+    m_rKey[0] = std::move(a);
+    m_aExpanded.store(true, std::memory_order_release);
+  }
+
+  /**
+   * Drops the cached expansion of a seeded key to reclaim memory; the next
+   * GetAVector() regenerates it. Must not be called while other threads use
+   * the key. No-op for keys that store A explicitly.
+   */
+  void ReleaseExpandedAVector() {
+    if (m_seed.empty()) return;
+    if (m_rKey.size() < 2) m_rKey.resize(2);
+    m_rKey[0].clear();
+    m_rKey[0].shrink_to_fit();
+    m_aExpanded = false;
+  }
+
   virtual void ClearKeys() {
     m_rKey.clear();
     m_dcrtKeys.clear();
+    m_seed.clear();
+    m_aExpanded = false;
   }
 
-
   bool key_compare(const LPEvalKeyImpl<Element> &other) const {
     const auto &oth = static_cast<const LPEvalKeyRelinImpl<Element> &>(other);
 
     if (!CryptoObject<Element>::operator==(other)) return false;
 
+    if (this->m_seed != oth.m_seed) return false;
+
     if (this->m_rKey.size() != oth.m_rKey.size()) return false;
-    for (size_t i = 0; i < this->m_rKey.size(); i++) {
+    // A is a function of the seed for seeded keys, so only B is compared
+    for (size_t i = m_seed.empty() ? 0 : 1; i < this->m_rKey.size(); i++) {
       if (this->m_rKey[i].size() != oth.m_rKey[i].size()) return false;
       for (size_t j = 0; j < this->m_rKey[i].size(); j++) {
         if (this->m_rKey[i][j] != oth.m_rKey[i][j]) return false;
@@ -736,7 +842,13 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
   template <class Archive>
   void save(Archive &ar, std::uint32_t const version) const {
     ar(::cereal::base_class<LPEvalKeyImpl<Element>>(this));
-    ar(::cereal::make_nvp("k", m_rKey));
+    ar(::cereal::make_nvp("s", m_seed));
+    if (m_seed.empty()) {
+      ar(::cereal::make_nvp("k", m_rKey));
+    } else {
+      // seeded keys ship only B; A is regenerated from the seed
+      ar(::cereal::make_nvp("b", m_rKey.at(1)));
+    }
   }
 
   template <class Archive>
@@ -747,14 +859,31 @@ class LPEvalKeyRelinImpl : public LPEvalKeyImpl<Element> {
                          " is from a later version of the library");
     }
     ar(::cereal::base_class<LPEvalKeyImpl<Element>>(this));
-    ar(::cereal::make_nvp("k", m_rKey));
+    m_seed.clear();
+    m_aExpanded = false;
+    if (version > 1) ar(::cereal::make_nvp("s", m_seed));
+    if (m_seed.empty()) {
+      ar(::cereal::make_nvp("k", m_rKey));
+    } else {
+      m_rKey.resize(2);
+      m_rKey[0].clear();
+      ar(::cereal::make_nvp("b", m_rKey[1]));
+    }
   }
   std::string SerializedObjectName() const { return "EvalKeyRelin"; }
-  static uint32_t SerializedVersion() { return 1; }
+  static uint32_t SerializedVersion() { return 2; }
 
  private:
   // private member to store vector of vector of Element.
-  std::vector<std::vector<Element>> m_rKey;
+  // For seeded keys the A vector (index 0) is empty until it is expanded.
+  mutable std::vector<std::vector<Element>> m_rKey;
+
+  // seed of the A vector; empty if A is stored explicitly
+  std::vector<uint32_t> m_seed;
+
+  // set once the A vector of a seeded key has been regenerated
+  mutable std::atomic<bool> m_aExpanded{false};
+  mutable std::mutex m_expandMutex;
 
   // Used for GHS key switching
   std::vector<DCRTPoly> m_dcrtKeys;
@@ -1069,6 +1198,21 @@ class LPEncryptionAlgorithm {
     PALISADE_THROW(config_error, "Decryption to Poly is not supported");
   }
 
+  /**
+   * Method for decrypting to the RNS representation of the plaintext, without
+   * interpolating it to a single modulus
+   *
+   * @param &privateKey private key used for decryption.
+   * @param &ciphertext ciphertext id decrypted.
+   * @param *plaintext the plaintext output, in COEFFICIENT format.
+   * @return the decoding result.
+   */
+  virtual DecryptResult Decrypt(const LPPrivateKey<Element> privateKey,
+                                ConstCiphertext<Element> ciphertext,
+                                DCRTPoly *plaintext) const {
+    PALISADE_THROW(config_error, "Decryption to DCRTPoly is not supported");
+  }
+
   /**
    * Function to generate public and private keys
    *
@@ -1222,6 +1366,24 @@ class LPLeveledSHEAlgorithm {
     PALISADE_THROW(config_error, "EvalPoly is not supported for the scheme.");
   }
 
+  /**
+   * Method for polynomial evaluation for polynomials represented as
+   * Chebyshev series over the interval [a, b].
+   *
+   * @param &cipherText input ciphertext
+   * @param &coefficients is the vector of Chebyshev coefficients; the size of
+   * the vector is the degree of the series + 1
+   * @param a lower bound of the approximation interval
+   * @param b upper bound of the approximation interval
+   * @return the result of polynomial evaluation.
+   */
+  virtual Ciphertext<Element> EvalChebyshevSeries(
+      ConstCiphertext<Element> cipherText,
+      const std::vector<double> &coefficients, double a, double b) const {
+    PALISADE_THROW(config_error,
+                   "EvalChebyshevSeries is not supported for the scheme.");
+  }
+
   template <class Archive>
   void save(Archive &ar, std::uint32_t const version) const {}
 
@@ -2368,25 +2530,37 @@ class LPSHEAlgorithm {
       PALISADE_THROW(config_error, "Input ciphertext is nullptr");
     if (!evalAtIndexKeys.size())
       PALISADE_THROW(config_error, "Input index map is empty");
+
+    uint32_t autoIndex = FindAutomorphismIndex(ciphertext, index);
+
+    return EvalAutomorphism(ciphertext, autoIndex, evalAtIndexKeys);
+  }
+
+  /**
+   * Finds the automorphism index that moves the i-th slot to slot 0
+   *
+   * @param ciphertext the ciphertext to be rotated.
+   * @param index the index.
+   * @return the automorphism index
+   */
+  static uint32_t FindAutomorphismIndex(ConstCiphertext<Element> ciphertext,
+                                        int32_t index) {
     const auto cryptoParams = ciphertext->GetCryptoParameters();
     const auto encodingParams = cryptoParams->GetEncodingParams();
     const auto elementParams = cryptoParams->GetElementParams();
     uint32_t m = elementParams->GetCyclotomicOrder();
 
-    uint32_t autoIndex;
-
     // power-of-two cyclotomics
     if (IsPowerOfTwo(m)) {
       if (ciphertext->GetEncodingType() == CKKSPacked)
-        autoIndex = FindAutomorphismIndex2nComplex(index, m);
+        return FindAutomorphismIndex2nComplex(index, m);
       else
-        autoIndex = FindAutomorphismIndex2n(index, m);
-    } else {  // cyclic-group cyclotomics
-      autoIndex = FindAutomorphismIndexCyclic(
-          index, m, encodingParams->GetPlaintextGenerator());
+        return FindAutomorphismIndex2n(index, m);
     }
 
-    return EvalAutomorphism(ciphertext, autoIndex, evalAtIndexKeys);
+    // cyclic-group cyclotomics
+    return FindAutomorphismIndexCyclic(index, m,
+                                       encodingParams->GetPlaintextGenerator());
   }
 
   /**
@@ -2799,6 +2973,11 @@ class LPSHEAlgorithm {
    * single ciphertext The slot assignment is done based on the order of
    * ciphertexts in the vector
    *
+   * The ciphertexts are merged pairwise in a tree: in the round with stride
+   * s, the block holding slots [0, s) of ciphertext i + s is rotated by -s and
+   * added to ciphertext i. This takes log2(n) rounds of independent rotations,
+   * which run in parallel, and only uses the keys for -1, -2, -4, ...
+   *
    * @param ciphertextVector vector of ciphertexts to be merged.
    * @param &evalKeys - reference to the map of evaluation keys generated by
    * EvalAutomorphismKeyGen.
@@ -2812,11 +2991,6 @@ class LPSHEAlgorithm {
                      "EvalMerge: the vector of ciphertexts to be merged "
                      "cannot be empty");
 
-    const shared_ptr<LPCryptoParameters<Element>> cryptoParams =
-        ciphertextVector[0]->GetCryptoParameters();
-    Ciphertext<Element> newCiphertext(
-        std::make_shared<CiphertextImpl<Element>>(*(ciphertextVector[0])));
-
     auto cc = ciphertextVector[0]->GetCryptoContext();
 
     Plaintext plaintext;
@@ -2828,15 +3002,23 @@ class LPSHEAlgorithm {
       plaintext = cc->MakePackedPlaintext(plaintextVector);
     }
 
-    newCiphertext = EvalMult(newCiphertext, plaintext);
-
-    for (size_t i = 1; i < ciphertextVector.size(); i++) {
-      newCiphertext = EvalAdd(
-          newCiphertext, EvalAtIndex(EvalMult(ciphertextVector[i], plaintext),
-                                     -(int32_t)i, evalKeys));
+    size_t n = ciphertextVector.size();
+    std::vector<Ciphertext<Element>> merged(n);
+    ParallelFor(0, n, [&](size_t i) {
+      merged[i] = EvalMult(ciphertextVector[i], plaintext);
+    });
+
+    for (size_t stride = 1; stride < n; stride *= 2) {
+      ParallelFor(0, (n + 2 * stride - 1) / (2 * stride), [&](size_t pair) {
+        size_t i = 2 * stride * pair;
+        if (i + stride >= n) return;
+        merged[i] = EvalAdd(
+            merged[i],
+            EvalAtIndex(merged[i + stride], -(int32_t)stride, evalKeys));
+      });
     }
 
-    return newCiphertext;
+    return merged[0];
   }
 
   /* Maintenance procedure used in the exact RNS variant of CKKS
@@ -3313,6 +3495,15 @@ class LPPublicKeyEncryptionScheme {
     PALISADE_THROW(config_error, "Decrypt operation has not been enabled");
   }
 
+  virtual DecryptResult Decrypt(const LPPrivateKey<Element> privateKey,
+                                ConstCiphertext<Element> ciphertext,
+                                DCRTPoly *plaintext) const {
+    if (m_algorithmEncryption) {
+      return m_algorithmEncryption->Decrypt(privateKey, ciphertext, plaintext);
+    }
+    PALISADE_THROW(config_error, "Decrypt operation has not been enabled");
+  }
+
   virtual LPKeyPair<Element> KeyGen(CryptoContext<Element> cc,
                                     bool makeSparse) {
     if (m_algorithmEncryption) {
@@ -4407,6 +4598,32 @@ class LPPublicKeyEncryptionScheme {
     }
   }
 
+  /**
+   * Method for polynomial evaluation for polynomials represented as
+   * Chebyshev series over the interval [a, b].
+   *
+   * @param &cipherText input ciphertext
+   * @param &coefficients is the vector of Chebyshev coefficients; the size of
+   * the vector is the degree of the series + 1
+   * @param a lower bound of the approximation interval
+   * @param b upper bound of the approximation interval
+   * @return the result of polynomial evaluation.
+   */
+  Ciphertext<Element> EvalChebyshevSeries(
+      ConstCiphertext<Element> ciphertext,
+      const std::vector<double> &coefficients, double a, double b) const {
+    if (this->m_algorithmLeveledSHE) {
+      if (!ciphertext)
+        PALISADE_THROW(config_error, "Input ciphertext is nullptr");
+      auto ctm = this->m_algorithmLeveledSHE->EvalChebyshevSeries(
+          ciphertext, coefficients, a, b);
+      return ctm;
+    } else {
+      PALISADE_THROW(config_error,
+                     "EvalChebyshevSeries operation has not been enabled");
+    }
+  }
+
   /*
    * This exposes CKKS's own ParamsGen through the
    * LPPublicKeyEncryptionSchemeCKKS API. See
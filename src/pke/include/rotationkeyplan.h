@@ -0,0 +1,125 @@
+// @file rotationkeyplan.h -- Selection of rotation keys under a key budget,
+// and composition of rotations from the selected keys.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT))
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_PKE_ROTATIONKEYPLAN_H_
+#define SRC_PKE_ROTATIONKEYPLAN_H_
+
+#include <vector>
+
+#include "utils/inttypes.h"
+
+namespace lbcrypto {
+
+/**
+ * @brief A set of rotation keys and the way every rotation is composed from
+ * them.
+ *
+ * Rotations by i and j compose to a rotation by i + j, and rotations cycle
+ * through the slots, so a rotation without a key of its own can be done as
+ * several rotations with keys, one key switch each. A plan trades the number
+ * of keys, i.e., memory, against the number of key switches per rotation:
+ *
+ *   RotationKeyPlan plan = cc->PlanRotationKeys(indices, 32);
+ *   cc->EvalAtIndexKeyGen(sk, plan.GetKeyIndices());
+ *   cc->SetRotationComposition(true);
+ *   // EvalAtIndex(ct, i) now costs plan.GetCost(i) key switches
+ *
+ * Rotation indices are taken modulo the number of slots.
+ */
+class RotationKeyPlan {
+ public:
+  /**
+   * Selects at most maxKeys keys from which all the needed rotations can be
+   * composed. Within the budget, every needed index gets its own key. Below
+   * it, the plan starts from the powers of a base (two if the budget allows)
+   * and greedily adds the needed indices that save the most key switches.
+   *
+   * @param indices the rotation indices the program needs
+   * @param slots the number of slots rotations cycle through
+   * @param maxKeys the key budget; 0 for one key per needed index
+   */
+  RotationKeyPlan(const std::vector<int32_t> &indices, usint slots,
+                  usint maxKeys = 0);
+
+  /**
+   * The plan that composes rotations from a given set of keys
+   *
+   * @param keys the rotation indices keys exist for
+   * @param slots the number of slots rotations cycle through
+   */
+  static RotationKeyPlan FromKeys(const std::vector<int32_t> &keys,
+                                  usint slots);
+
+  /**
+   * The rotation indices to generate keys for, e.g., with EvalAtIndexKeyGen
+   */
+  std::vector<int32_t> GetKeyIndices() const;
+
+  /**
+   * The rotations with keys that compose the rotation by index; empty for a
+   * rotation by 0. Throws not_available_error if the keys do not generate the
+   * rotation.
+   */
+  std::vector<int32_t> GetSteps(int32_t index) const;
+
+  /**
+   * The number of key switches of the rotation by index
+   */
+  usint GetCost(int32_t index) const { return GetSteps(index).size(); }
+
+  /**
+   * The largest number of key switches of a needed rotation
+   */
+  usint GetMaxCost() const;
+
+  /**
+   * The sum of the key switches of all the needed rotations
+   */
+  usint GetTotalCost() const;
+
+  usint GetSlots() const { return m_slots; }
+
+ private:
+  explicit RotationKeyPlan(usint slots);
+
+  usint Normalize(int32_t index) const;
+  int32_t Signed(usint rotation) const;
+
+  // shortest compositions of every rotation from m_keys
+  void Compose();
+
+  usint m_slots;
+  // rotations in [1, slots) keys are generated for
+  std::vector<usint> m_keys;
+  // needed rotations in [1, slots)
+  std::vector<usint> m_targets;
+  // number of key switches of each rotation; m_slots if it is unreachable
+  std::vector<usint> m_cost;
+  // last key of the shortest composition of each rotation
+  std::vector<usint> m_lastKey;
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_PKE_ROTATIONKEYPLAN_H_
@@ -682,6 +682,36 @@ class LPAlgorithmSHEBFVrns : public LPAlgorithmSHEBFV<Element> {
   void KeySwitchInPlace(const LPEvalKey<Element> keySwitchHint,
                         Ciphertext<Element>& ciphertext) const override;
 
+  /**
+   * EvalFastRotationPrecompute implements the precomputation step of hoisted
+   * automorphisms: the CRT digit decomposition of the second ciphertext
+   * element, which KeySwitchInPlace would otherwise redo for every rotation.
+   *
+   * Please refer to Section 5 of Halevi and Shoup, "Faster Homomorphic
+   * linear transformations in HELib." for more details, link:
+   * https://eprint.iacr.org/2018/244.
+   *
+   * @param ciphertext the input ciphertext on which to do the precomputation
+   * (digit decomposition)
+   */
+  shared_ptr<vector<Element>> EvalFastRotationPrecompute(
+      ConstCiphertext<Element> ciphertext) const override;
+
+  /**
+   * EvalFastRotation implements the automorphism and key switching step of
+   * hoisted automorphisms.
+   *
+   * @param ciphertext the input ciphertext to perform the automorphism on
+   * @param index the index of the rotation. Positive indices correspond to left
+   * rotations and negative indices correspond to right rotations.
+   * @param m is the cyclotomic order
+   * @param digits the digit decomposition created by
+   * EvalFastRotationPrecompute
+   */
+  Ciphertext<Element> EvalFastRotation(
+      ConstCiphertext<Element> ciphertext, const usint index, const usint m,
+      const shared_ptr<vector<Element>> digits) const override;
+
   /**
    * Function for evaluating multiplication on ciphertext followed by
    * relinearization operation. Currently it assumes that the input arguments
@@ -697,6 +727,19 @@ class LPAlgorithmSHEBFVrns : public LPAlgorithmSHEBFV<Element> {
   Ciphertext<Element> EvalMultAndRelinearize(
       ConstCiphertext<Element> ct1, ConstCiphertext<Element> ct2,
       const vector<LPEvalKey<Element>>& ek) const override;
+
+  /**
+   * Function for relinearization of a ciphertext with more than two elements,
+   * e.g., the sum of several products computed by EvalMult without key
+   * switching.
+   *
+   * @param ciphertext input ciphertext.
+   * @param &ek are the evaluation keys for the powers of the secret key.
+   * @return relinearized ciphertext
+   */
+  Ciphertext<Element> Relinearize(
+      ConstCiphertext<Element> ciphertext,
+      const vector<LPEvalKey<Element>>& ek) const override;
 };
 
 /**
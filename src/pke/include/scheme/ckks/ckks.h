@@ -867,6 +867,19 @@ class LPAlgorithmCKKS : public LPEncryptionAlgorithm<Element> {
                         ConstCiphertext<Element> ciphertext,
                         Poly *plaintext) const;
 
+  /**
+   * Method for decrypting plaintext using CKKS, leaving the result in RNS
+   * form so it can be decoded without multiprecision arithmetic
+   *
+   * @param &privateKey private key used for decryption.
+   * @param &ciphertext ciphertext id decrypted.
+   * @param *plaintext the plaintext output, in COEFFICIENT format.
+   * @return the success/fail result
+   */
+  DecryptResult Decrypt(const LPPrivateKey<Element> privateKey,
+                        ConstCiphertext<Element> ciphertext,
+                        DCRTPoly *plaintext) const;
+
   /**
    * Function to generate public and private keys
    *
@@ -2539,6 +2552,28 @@ class LPLeveledSHEAlgorithmCKKS : public LPLeveledSHEAlgorithm<Element> {
     PALISADE_THROW(not_implemented_error, errMsg);
   }
 
+  /**
+   * Method for polynomial evaluation for polynomials represented as
+   * Chebyshev series, i.e., p(x) = sum_j c_j T_j(y), where y = (2x - (a + b))
+   * / (b - a) maps [a, b] to [-1, 1].
+   *
+   * @param &cipherText input ciphertext
+   * @param &coefficients is the vector of Chebyshev coefficients c_j; the
+   * size of the vector is the degree of the series + 1
+   * @param a lower bound of the approximation interval
+   * @param b upper bound of the approximation interval
+   * @return the result of polynomial evaluation.
+   */
+  Ciphertext<Element> EvalChebyshevSeries(
+      ConstCiphertext<Element> cipherText,
+      const std::vector<double> &coefficients, double a,
+      double b) const override {
+    std::string errMsg =
+        "LPLeveledSHEAlgorithmCKKS::EvalChebyshevSeries is only supported for "
+        "DCRTPoly.";
+    PALISADE_THROW(not_implemented_error, errMsg);
+  }
+
   template <class Archive>
   void save(Archive &ar) const {
     ar(cereal::base_class<LPLeveledSHEAlgorithm<Element>>(this));
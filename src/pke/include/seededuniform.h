@@ -0,0 +1,85 @@
+// @file seededuniform.h -- Uniform ring elements derived from short seeds.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT))
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef SRC_PKE_SEEDEDUNIFORM_H_
+#define SRC_PKE_SEEDEDUNIFORM_H_
+
+#include <memory>
+#include <vector>
+
+#include "lattice/ilelement.h"
+#include "utils/inttypes.h"
+
+namespace lbcrypto {
+
+/**
+ * @brief Uniformly random ring elements that are stored and serialized as a
+ * short seed
+ *
+ * Used for the A vectors of compressed evaluation keys and for the second
+ * element of seeded secret-key ciphertexts. An element is expanded from the
+ * seed, a domain tag that separates these uses, and a stream index that
+ * separates the elements sharing a seed. The expansion only depends on the
+ * raw output of the Blake2 PRNG (see DiscreteUniformGeneratorImpl::SetSeed),
+ * so a seed expands to the same element on every platform.
+ *
+ * @tparam Element ring element type
+ */
+template <typename Element>
+class SeededUniform {
+ public:
+  enum Domain : uint32_t {
+    EVAL_KEY = 0x4b455641,    // "AVEK"
+    CIPHERTEXT = 0x41545843,  // "CXTA"
+  };
+
+  /**
+   * Draws a fresh 256-bit seed from the thread-local PRNG
+   *
+   * @return the seed
+   */
+  static std::vector<uint32_t> GenerateSeed() {
+    return Element::DugType::GenerateSeed();
+  }
+
+  /**
+   * Deterministically derives a uniformly random element from a seed
+   *
+   * @param &seed is the seed
+   * @param domain is the use of the seed
+   * @param stream is the index of the element among those sharing the seed
+   * @param params are the element parameters
+   * @return the element in evaluation format
+   */
+  static Element Expand(
+      const std::vector<uint32_t>& seed, Domain domain, uint32_t stream,
+      const std::shared_ptr<typename Element::Params> params) {
+    typename Element::DugType dug;
+    dug.SetSeed(seed, stream, domain);
+    return Element(dug, params, Format::EVALUATION);
+  }
+};
+
+}  // namespace lbcrypto
+
+#endif  // SRC_PKE_SEEDEDUNIFORM_H_
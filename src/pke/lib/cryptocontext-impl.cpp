@@ -22,6 +22,7 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "cryptocontext.cpp"
 #include "cryptocontextfactory.cpp"
+#include "rotationkeyplan.cpp"
 
 namespace lbcrypto {
 
@@ -43,6 +44,7 @@ template <>
 DecryptResult CryptoContextImpl<DCRTPoly>::Decrypt(
     const LPPrivateKey<DCRTPoly> privateKey,
     ConstCiphertext<DCRTPoly> ciphertext, Plaintext* plaintext) {
+  ParallelScope scope(m_executor);
     if (ciphertext == nullptr)
         PALISADE_THROW(config_error, "ciphertext passed to Decrypt is empty");
     if (plaintext == nullptr)
@@ -56,20 +58,27 @@ DecryptResult CryptoContextImpl<DCRTPoly>::Decrypt(
   // Plaintext decrypted =
   // GetPlaintextForDecrypt(ciphertext->GetEncodingType(),
   // this->GetElementParams(), this->GetEncodingParams());
-  Plaintext decrypted = GetPlaintextForDecrypt(
-      ciphertext->GetEncodingType(), ciphertext->GetElements()[0].GetParams(),
-      this->GetEncodingParams());
+  Plaintext decrypted;
 
   DecryptResult result;
 
   if ((ciphertext->GetEncodingType() == CKKSPacked) &&
       (ciphertext->GetElements()[0].GetParams()->GetParams().size() >
-       1))  // only one tower in DCRTPoly
-    result = GetEncryptionAlgorithm()->Decrypt(privateKey, ciphertext,
-                                               &decrypted->GetElement<Poly>());
-  else
+       1)) {  // only one tower in DCRTPoly
+    // keep the towers: CKKSPackedEncoding::Decode reconstructs the values in
+    // native arithmetic, without interpolating to a BigInteger Poly
+    decrypted = PlaintextFactory::MakePlaintext(
+        CKKSPacked, ciphertext->GetElements()[0].GetParams(),
+        this->GetEncodingParams());
+    result = GetEncryptionAlgorithm()->Decrypt(
+        privateKey, ciphertext, &decrypted->GetElement<DCRTPoly>());
+  } else {
+    decrypted = GetPlaintextForDecrypt(
+        ciphertext->GetEncodingType(),
+        ciphertext->GetElements()[0].GetParams(), this->GetEncodingParams());
     result = GetEncryptionAlgorithm()->Decrypt(
         privateKey, ciphertext, &decrypted->GetElement<NativePoly>());
+  }
 
   if (result.isValid == false) return result;
 
@@ -100,6 +109,7 @@ template <>
 DecryptResult CryptoContextImpl<DCRTPoly>::MultipartyDecryptFusion(
     const vector<Ciphertext<DCRTPoly>>& partialCiphertextVec,
     Plaintext* plaintext) const {
+  ParallelScope scope(m_executor);
   DecryptResult result;
 
   // Make sure we're processing ciphertexts.
@@ -32,6 +32,7 @@ bool SERIALIZE_PRECOMPUTE = true;
 template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeyGen(
     const LPPrivateKey<Element> key) {
+  ParallelScope scope(m_executor);
   if (key == nullptr || Mismatched(key->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Key passed to EvalMultKeyGen were not generated with this "
@@ -39,12 +40,14 @@ void CryptoContextImpl<Element>::EvalMultKeyGen(
 
   LPEvalKey<Element> k = GetEncryptionAlgorithm()->EvalMultKeyGen(key);
 
-  GetAllEvalMultKeys()[k->GetKeyTag()] = {k};
+  evalMultKeyMap().Insert(
+      k->GetKeyTag(), std::make_shared<std::vector<LPEvalKey<Element>>>(1, k));
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeysGen(
     const LPPrivateKey<Element> key) {
+  ParallelScope scope(m_executor);
   if (key == nullptr || Mismatched(key->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Key passed to EvalMultsKeyGen were not generated with this "
@@ -53,29 +56,37 @@ void CryptoContextImpl<Element>::EvalMultKeysGen(
   const vector<LPEvalKey<Element>>& evalKeys =
       GetEncryptionAlgorithm()->EvalMultKeysGen(key);
 
-  GetAllEvalMultKeys()[evalKeys[0]->GetKeyTag()] = evalKeys;
+  InsertEvalMultKey(evalKeys);
 }
 
 template <typename Element>
-const vector<LPEvalKey<Element>>&
+const vector<LPEvalKey<Element>>
 CryptoContextImpl<Element>::GetEvalMultKeyVector(const string& keyID) {
-  auto ekv = GetAllEvalMultKeys().find(keyID);
-  if (ekv == GetAllEvalMultKeys().end())
+  return *GetEvalMultKeyVectorPtr(keyID);
+}
+
+template <typename Element>
+shared_ptr<vector<LPEvalKey<Element>>>
+CryptoContextImpl<Element>::GetEvalMultKeyVectorPtr(const string& keyID) {
+  auto ekv = evalMultKeyMap().Find(keyID);
+  if (ekv == nullptr)
     PALISADE_THROW(not_available_error,
                    "You need to use EvalMultKeyGen so that you have an "
                    "EvalMultKey available for this ID");
-  return ekv->second;
+  return ekv;
 }
 
 template <typename Element>
-std::map<string, std::vector<LPEvalKey<Element>>>&
+const std::map<string, std::vector<LPEvalKey<Element>>>
 CryptoContextImpl<Element>::GetAllEvalMultKeys() {
-  return evalMultKeyMap();
+  std::map<string, std::vector<LPEvalKey<Element>>> result;
+  for (const auto& k : evalMultKeyMap().Snapshot()) result[k.first] = *k.second;
+  return result;
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys() {
-  GetAllEvalMultKeys().clear();
+  evalMultKeyMap().Clear();
 }
 
 /**
@@ -84,8 +95,7 @@ void CryptoContextImpl<Element>::ClearEvalMultKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const string& id) {
-  auto kd = GetAllEvalMultKeys().find(id);
-  if (kd != GetAllEvalMultKeys().end()) GetAllEvalMultKeys().erase(kd);
+  evalMultKeyMap().Erase(id);
 }
 
 /**
@@ -95,26 +105,24 @@ void CryptoContextImpl<Element>::ClearEvalMultKeys(const string& id) {
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(
     const CryptoContext<Element> cc) {
-  for (auto it = GetAllEvalMultKeys().begin();
-       it != GetAllEvalMultKeys().end();) {
-    if (it->second[0]->GetCryptoContext() == cc) {
-      it = GetAllEvalMultKeys().erase(it);
-    } else {
-      ++it;
-    }
-  }
+  evalMultKeyMap().EraseIf([&](const std::vector<LPEvalKey<Element>>& keys) {
+    return keys[0]->GetCryptoContext() == cc;
+  });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::InsertEvalMultKey(
     const std::vector<LPEvalKey<Element>>& vectorToInsert) {
-  GetAllEvalMultKeys()[vectorToInsert[0]->GetKeyTag()] = vectorToInsert;
+  evalMultKeyMap().Insert(
+      vectorToInsert[0]->GetKeyTag(),
+      std::make_shared<std::vector<LPEvalKey<Element>>>(vectorToInsert));
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::EvalSumKeyGen(
     const LPPrivateKey<Element> privateKey,
     const LPPublicKey<Element> publicKey) {
+  ParallelScope scope(m_executor);
   if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext())) {
     PALISADE_THROW(config_error,
                    "Private key passed to EvalSumKeyGen were not generated "
@@ -131,7 +139,7 @@ void CryptoContextImpl<Element>::EvalSumKeyGen(
   auto evalKeys =
       GetEncryptionAlgorithm()->EvalSumKeyGen(privateKey, publicKey);
 
-  GetAllEvalSumKeys()[privateKey->GetKeyTag()] = evalKeys;
+  evalSumKeyMap().Insert(privateKey->GetKeyTag(), evalKeys);
 }
 
 template <typename Element>
@@ -139,6 +147,7 @@ shared_ptr<std::map<usint, LPEvalKey<Element>>>
 CryptoContextImpl<Element>::EvalSumRowsKeyGen(
     const LPPrivateKey<Element> privateKey,
     const LPPublicKey<Element> publicKey, usint rowSize, usint subringDim) {
+  ParallelScope scope(m_executor);
   if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext())) {
     PALISADE_THROW(config_error,
                    "Private key passed to EvalSumKeyGen were not generated "
@@ -163,6 +172,7 @@ shared_ptr<std::map<usint, LPEvalKey<Element>>>
 CryptoContextImpl<Element>::EvalSumColsKeyGen(
     const LPPrivateKey<Element> privateKey,
     const LPPublicKey<Element> publicKey) {
+  ParallelScope scope(m_executor);
   if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext())) {
     PALISADE_THROW(config_error,
                    "Private key passed to EvalSumKeyGen were not generated "
@@ -183,25 +193,31 @@ CryptoContextImpl<Element>::EvalSumColsKeyGen(
 }
 
 template <typename Element>
-const std::map<usint, LPEvalKey<Element>>&
+const std::map<usint, LPEvalKey<Element>>
 CryptoContextImpl<Element>::GetEvalSumKeyMap(const string& keyID) {
-  auto ekv = GetAllEvalSumKeys().find(keyID);
-  if (ekv == GetAllEvalSumKeys().end())
+  return *GetEvalSumKeyMapPtr(keyID);
+}
+
+template <typename Element>
+shared_ptr<std::map<usint, LPEvalKey<Element>>>
+CryptoContextImpl<Element>::GetEvalSumKeyMapPtr(const string& keyID) {
+  auto ekv = evalSumKeyMap().Find(keyID);
+  if (ekv == nullptr)
     PALISADE_THROW(not_available_error,
                    "You need to use EvalSumKeyGen so that you have EvalSumKeys "
                    "available for this ID");
-  return *ekv->second;
+  return ekv;
 }
 
 template <typename Element>
-std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>&
+const std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalSumKeys() {
-  return evalSumKeyMap();
+  return evalSumKeyMap().Snapshot();
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalSumKeys() {
-  GetAllEvalSumKeys().clear();
+  evalSumKeyMap().Clear();
 }
 
 /**
@@ -210,8 +226,7 @@ void CryptoContextImpl<Element>::ClearEvalSumKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalSumKeys(const string& id) {
-  auto kd = GetAllEvalSumKeys().find(id);
-  if (kd != GetAllEvalSumKeys().end()) GetAllEvalSumKeys().erase(kd);
+  evalSumKeyMap().Erase(id);
 }
 
 /**
@@ -221,14 +236,9 @@ void CryptoContextImpl<Element>::ClearEvalSumKeys(const string& id) {
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalSumKeys(
     const CryptoContext<Element> cc) {
-  for (auto it = GetAllEvalSumKeys().begin();
-       it != GetAllEvalSumKeys().end();) {
-    if (it->second->begin()->second->GetCryptoContext() == cc) {
-      it = GetAllEvalSumKeys().erase(it);
-    } else {
-      ++it;
-    }
-  }
+  evalSumKeyMap().EraseIf([&](const std::map<usint, LPEvalKey<Element>>& keys) {
+    return keys.begin()->second->GetCryptoContext() == cc;
+  });
 }
 
 template <typename Element>
@@ -237,7 +247,7 @@ void CryptoContextImpl<Element>::InsertEvalSumKey(
   // find the tag
   if (!mapToInsert->empty()) {
     auto onekey = mapToInsert->begin();
-    GetAllEvalSumKeys()[onekey->second->GetKeyTag()] = mapToInsert;
+    evalSumKeyMap().Insert(onekey->second->GetKeyTag(), mapToInsert);
   }
 }
 
@@ -246,6 +256,7 @@ void CryptoContextImpl<Element>::EvalAtIndexKeyGen(
     const LPPrivateKey<Element> privateKey,
     const std::vector<int32_t>& indexList,
     const LPPublicKey<Element> publicKey) {
+  ParallelScope scope(m_executor);
   if (privateKey == nullptr || Mismatched(privateKey->GetCryptoContext())) {
     PALISADE_THROW(config_error,
                    "Private key passed to EvalAtIndexKeyGen were not generated "
@@ -262,29 +273,74 @@ void CryptoContextImpl<Element>::EvalAtIndexKeyGen(
   auto evalKeys = GetEncryptionAlgorithm()->EvalAtIndexKeyGen(
       publicKey, privateKey, indexList);
 
-  evalAutomorphismKeyMap()[privateKey->GetKeyTag()] = evalKeys;
+  evalAutomorphismKeyMap().Insert(privateKey->GetKeyTag(), evalKeys);
 }
 
 template <typename Element>
-const std::map<usint, LPEvalKey<Element>>&
+const std::map<usint, LPEvalKey<Element>>
 CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(const string& keyID) {
-  auto ekv = evalAutomorphismKeyMap().find(keyID);
-  if (ekv == evalAutomorphismKeyMap().end())
+  return *GetEvalAutomorphismKeyMapPtr(keyID);
+}
+
+template <typename Element>
+shared_ptr<std::map<usint, LPEvalKey<Element>>>
+CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(const string& keyID) {
+  auto ekv = FindEvalAutomorphismKeys(keyID);
+  if (ekv != nullptr) return ekv;
+
+  PALISADE_THROW(not_available_error,
+                 "You need to use EvalAutomorphismKeyGen so that you have "
+                 "EvalAutomorphismKeys available for this ID");
+}
+
+template <typename Element>
+shared_ptr<std::map<usint, LPEvalKey<Element>>>
+CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+    const string& keyID, const std::vector<usint>& indices) {
+  auto ekv = evalAutomorphismKeyMap().Find(keyID);
+  if (ekv != nullptr) return ekv;
+
+  auto file = evalAutomorphismKeyFiles().Find(keyID);
+  if (file != nullptr) {
+    std::vector<usint> available;
+    for (auto autoIndex : indices)
+      if (file->Contains(autoIndex)) available.push_back(autoIndex);
+    return file->GetKeys(available);
+  }
+
+  PALISADE_THROW(not_available_error,
+                 "You need to use EvalAutomorphismKeyGen so that you have "
+                 "EvalAutomorphismKeys available for this ID");
+}
+
+template <typename Element>
+LPEvalKey<Element> CryptoContextImpl<Element>::GetEvalAutomorphismKey(
+    const string& keyID, usint autoIndex) {
+  auto keys = GetEvalAutomorphismKeyMapPtr(keyID, {autoIndex});
+  auto key = keys->find(autoIndex);
+  if (key == keys->end())
     PALISADE_THROW(not_available_error,
-                   "You need to use EvalAutomorphismKeyGen so that you have "
-                   "EvalAutomorphismKeys available for this ID");
-  return *ekv->second;
+                   "There is no EvalAutomorphismKey for index " +
+                       std::to_string(autoIndex) + " for this ID");
+  return key->second;
 }
 
 template <typename Element>
-std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>&
+const std::map<string, shared_ptr<std::map<usint, LPEvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys() {
-  return evalAutomorphismKeyMap();
+  auto all = evalAutomorphismKeyMap().Snapshot();
+  for (const auto& file : evalAutomorphismKeyFiles().Snapshot()) {
+    // keys in the map take precedence over a file for the same ID
+    if (all.count(file.first) == 0)
+      all[file.first] = file.second->GetKeys(file.second->GetIndices());
+  }
+  return all;
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
-  evalAutomorphismKeyMap().clear();
+  evalAutomorphismKeyMap().Clear();
+  evalAutomorphismKeyFiles().Clear();
 }
 
 /**
@@ -293,8 +349,8 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const string& id) {
-  auto kd = evalAutomorphismKeyMap().find(id);
-  if (kd != evalAutomorphismKeyMap().end()) evalAutomorphismKeyMap().erase(kd);
+  evalAutomorphismKeyMap().Erase(id);
+  evalAutomorphismKeyFiles().Erase(id);
 }
 
 /**
@@ -305,14 +361,21 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const string& id) {
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(
     const CryptoContext<Element> cc) {
-  for (auto it = evalAutomorphismKeyMap().begin();
-       it != evalAutomorphismKeyMap().end();) {
-    if (it->second->begin()->second->GetCryptoContext() == cc) {
-      it = evalAutomorphismKeyMap().erase(it);
-    } else {
-      ++it;
-    }
+  evalAutomorphismKeyMap().EraseIf(
+      [&](const std::map<usint, LPEvalKey<Element>>& keys) {
+        return keys.begin()->second->GetCryptoContext() == cc;
+      });
+
+  // the context of a file is only known once one of its keys is loaded, which
+  // is done before the store is locked for the update
+  std::set<const EvalKeyFile<Element>*> files;
+  for (const auto& file : evalAutomorphismKeyFiles().Snapshot()) {
+    if (file.second->GetCryptoContext() == cc) files.insert(file.second.get());
   }
+  if (files.empty()) return;
+  evalAutomorphismKeyFiles().EraseIf([&](const EvalKeyFile<Element>& file) {
+    return files.count(&file) > 0;
+  });
 }
 
 template <typename Element>
@@ -320,21 +383,22 @@ void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
     const shared_ptr<std::map<usint, LPEvalKey<Element>>> mapToInsert) {
   // find the tag
   auto onekey = mapToInsert->begin();
-  evalAutomorphismKeyMap()[onekey->second->GetKeyTag()] = mapToInsert;
+  evalAutomorphismKeyMap().Insert(onekey->second->GetKeyTag(), mapToInsert);
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(
     ConstCiphertext<Element> ciphertext, usint batchSize) const {
+  ParallelScope scope(m_executor);
   if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Information passed to EvalSum was not generated with this "
                    "crypto context");
 
   auto evalSumKeys =
-      CryptoContextImpl<Element>::GetEvalSumKeyMap(ciphertext->GetKeyTag());
+      CryptoContextImpl<Element>::GetEvalSumKeyMapPtr(ciphertext->GetKeyTag());
   auto rv =
-      GetEncryptionAlgorithm()->EvalSum(ciphertext, batchSize, evalSumKeys);
+      GetEncryptionAlgorithm()->EvalSum(ciphertext, batchSize, *evalSumKeys);
   return rv;
 }
 
@@ -343,6 +407,7 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumRows(
     ConstCiphertext<Element> ciphertext, usint rowSize,
     const std::map<usint, LPEvalKey<Element>>& evalSumKeys,
     usint subringDim) const {
+  ParallelScope scope(m_executor);
   if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Information passed to EvalSum was not generated with this "
@@ -357,22 +422,142 @@ template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSumCols(
     ConstCiphertext<Element> ciphertext, usint rowSize,
     const std::map<usint, LPEvalKey<Element>>& evalSumKeysRight) const {
+  ParallelScope scope(m_executor);
   if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Information passed to EvalSum was not generated with this "
                    "crypto context");
 
   auto evalSumKeys =
-      CryptoContextImpl<Element>::GetEvalSumKeyMap(ciphertext->GetKeyTag());
+      CryptoContextImpl<Element>::GetEvalSumKeyMapPtr(ciphertext->GetKeyTag());
 
   auto rv = GetEncryptionAlgorithm()->EvalSumCols(
-      ciphertext, rowSize, evalSumKeys, evalSumKeysRight);
+      ciphertext, rowSize, *evalSumKeys, evalSumKeysRight);
   return rv;
 }
 
+template <typename Element>
+std::vector<std::vector<int32_t>>
+CryptoContextImpl<Element>::RotateAndSumRounds(int32_t step, usint count,
+                                               usint radix) {
+  if (radix < 2 || !IsPowerOfTwo(radix))
+    PALISADE_THROW(config_error,
+                   "The radix of a hoisted sum must be a power of two");
+
+  usint total = 1;
+  while (total < count) total *= 2;
+
+  std::vector<std::vector<int32_t>> rounds;
+  for (usint covered = 1; covered < total;) {
+    usint terms = std::min(radix, total / covered);
+    std::vector<int32_t> indices;
+    for (usint j = 1; j < terms; j++)
+      indices.push_back(static_cast<int32_t>(j * covered) * step);
+    rounds.push_back(std::move(indices));
+    covered *= terms;
+  }
+  return rounds;
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalRotateAndSum(
+    ConstCiphertext<Element> ciphertext, int32_t step, usint count,
+    usint radix) const {
+  Ciphertext<Element> sum = ciphertext->Clone();
+  for (const auto& indices : RotateAndSumRounds(step, count, radix)) {
+    auto rotated = EvalAtIndexBatch(sum, indices);
+    for (auto& ct : rotated) EvalAddInPlace(sum, ct);
+  }
+  return sum;
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalSumHoisted(
+    ConstCiphertext<Element> ciphertext, usint batchSize, usint radix) const {
+  ParallelScope scope(m_executor);
+  if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
+    PALISADE_THROW(config_error,
+                   "Information passed to EvalSumHoisted was not generated "
+                   "with this crypto context");
+
+  return EvalRotateAndSum(ciphertext, 1, batchSize, radix);
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalSumRowsHoisted(
+    ConstCiphertext<Element> ciphertext, usint rowSize, usint radix) const {
+  ParallelScope scope(m_executor);
+  if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
+    PALISADE_THROW(config_error,
+                   "Information passed to EvalSumRowsHoisted was not "
+                   "generated with this crypto context");
+  if (rowSize == 0)
+    PALISADE_THROW(config_error, "EvalSumRowsHoisted: rowSize is 0");
+
+  usint colSize = GetCyclotomicOrder() / (4 * rowSize);
+  return EvalRotateAndSum(ciphertext, rowSize, colSize, radix);
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalSumColsHoisted(
+    ConstCiphertext<Element> ciphertext, usint batchSize, usint radix) const {
+  ParallelScope scope(m_executor);
+  if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
+    PALISADE_THROW(config_error,
+                   "Information passed to EvalSumColsHoisted was not "
+                   "generated with this crypto context");
+  if (ciphertext->GetEncodingType() != CKKSPacked)
+    PALISADE_THROW(config_error,
+                   "Matrix summation of column-vectors is only supported for "
+                   "CKKS packed encoding.");
+  if (batchSize == 0)
+    PALISADE_THROW(config_error, "EvalSumColsHoisted: batchSize is 0");
+
+  auto sum = EvalRotateAndSum(ciphertext, 1, batchSize, radix);
+
+  std::vector<std::complex<double>> mask(GetCyclotomicOrder() / 4);
+  for (size_t i = 0; i < mask.size(); i++)
+    mask[i] = (i % batchSize == 0) ? 1 : 0;
+  sum = EvalMult(sum, MakeCKKSPackedPlaintext(mask, 1));
+
+  return EvalRotateAndSum(sum, -1, batchSize, radix);
+}
+
+template <typename Element>
+std::vector<int32_t> CryptoContextImpl<Element>::GetEvalSumHoistedIndices(
+    usint batchSize, usint radix) const {
+  std::vector<int32_t> indices;
+  for (const auto& round : RotateAndSumRounds(1, batchSize, radix))
+    indices.insert(indices.end(), round.begin(), round.end());
+  return indices;
+}
+
+template <typename Element>
+std::vector<int32_t> CryptoContextImpl<Element>::GetEvalSumRowsHoistedIndices(
+    usint rowSize, usint radix) const {
+  if (rowSize == 0)
+    PALISADE_THROW(config_error, "GetEvalSumRowsHoistedIndices: rowSize is 0");
+  usint colSize = GetCyclotomicOrder() / (4 * rowSize);
+  std::vector<int32_t> indices;
+  for (const auto& round : RotateAndSumRounds(rowSize, colSize, radix))
+    indices.insert(indices.end(), round.begin(), round.end());
+  return indices;
+}
+
+template <typename Element>
+std::vector<int32_t> CryptoContextImpl<Element>::GetEvalSumColsHoistedIndices(
+    usint batchSize, usint radix) const {
+  std::vector<int32_t> indices;
+  for (int32_t step : {1, -1})
+    for (const auto& round : RotateAndSumRounds(step, batchSize, radix))
+      indices.insert(indices.end(), round.begin(), round.end());
+  return indices;
+}
+
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(
     ConstCiphertext<Element> ciphertext, int32_t index) const {
+  ParallelScope scope(m_executor);
   if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Information passed to EvalAtIndex was not generated with "
@@ -385,38 +570,232 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(
     return rv;
   }
 
+  usint autoIndex =
+      LPSHEAlgorithm<Element>::FindAutomorphismIndex(ciphertext, index);
   auto evalAutomorphismKeys =
-      CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(
-          ciphertext->GetKeyTag());
-  
+      CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+          ciphertext->GetKeyTag(), {autoIndex});
+  if (m_rotationComposition &&
+      evalAutomorphismKeys->find(autoIndex) == evalAutomorphismKeys->end())
+    return EvalAtIndexComposed(ciphertext, autoIndex);
+
   auto rv = GetEncryptionAlgorithm()->EvalAtIndex(ciphertext, index,
-                                                  evalAutomorphismKeys);
+                                                  *evalAutomorphismKeys);
   return rv;
 }
 
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndexComposed(
+    ConstCiphertext<Element> ciphertext, usint autoIndex) const {
+  usint m = GetCyclotomicOrder();
+  if (!IsPowerOfTwo(m))
+    PALISADE_THROW(not_implemented_error,
+                   "Rotations can only be composed for power-of-two "
+                   "cyclotomics");
+  usint slots = m / 4;
+
+  std::vector<usint> available;
+  auto keys = evalAutomorphismKeyMap().Find(ciphertext->GetKeyTag());
+  if (keys != nullptr) {
+    for (const auto& key : *keys) available.push_back(key.first);
+  } else {
+    auto file = evalAutomorphismKeyFiles().Find(ciphertext->GetKeyTag());
+    if (file != nullptr) available = file->GetIndices();
+  }
+
+  // the rotation by r is the automorphism 5^r mod m; row swaps and other
+  // automorphisms outside this group are not used
+  std::map<usint, int32_t> rotationOf;
+  for (auto index : available) rotationOf[index] = -1;
+  rotationOf[autoIndex] = -1;
+  uint64_t power = 1;
+  for (usint r = 0; r < slots; r++) {
+    auto it = rotationOf.find(power);
+    if (it != rotationOf.end()) it->second = r;
+    power = (power * 5) % m;
+  }
+  if (rotationOf[autoIndex] < 0)
+    PALISADE_THROW(not_available_error,
+                   "There is no EvalAutomorphismKey for index " +
+                       std::to_string(autoIndex) + " for this ID");
+
+  std::vector<int32_t> keyRotations;
+  for (auto index : available)
+    if (rotationOf[index] > 0) keyRotations.push_back(rotationOf[index]);
+
+  auto plan = RotationKeyPlan::FromKeys(keyRotations, slots);
+  Ciphertext<Element> rotated = ciphertext->Clone();
+  for (auto step : plan.GetSteps(rotationOf[autoIndex]))
+    rotated = EvalAtIndex(rotated, step);
+  return rotated;
+}
+
+template <typename Element>
+RotationKeyPlan CryptoContextImpl<Element>::PlanRotationKeys(
+    const std::vector<int32_t>& indices, usint maxKeys) const {
+  usint m = GetCyclotomicOrder();
+  if (!IsPowerOfTwo(m))
+    PALISADE_THROW(not_implemented_error,
+                   "Rotation keys can only be planned for power-of-two "
+                   "cyclotomics");
+  return RotationKeyPlan(indices, m / 4, maxKeys);
+}
+
+template <typename Element>
+std::vector<Ciphertext<Element>> CryptoContextImpl<Element>::EvalAtIndexBatch(
+    ConstCiphertext<Element> ciphertext,
+    const std::vector<int32_t>& indices) const {
+  ParallelScope scope(m_executor);
+  if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
+    PALISADE_THROW(config_error,
+                   "Information passed to EvalAtIndexBatch was not generated "
+                   "with this crypto context");
+
+  std::vector<usint> autoIndices(indices.size(), 1);
+  for (size_t i = 0; i < indices.size(); i++)
+    if (indices[i] != 0)
+      autoIndices[i] =
+          LPSHEAlgorithm<Element>::FindAutomorphismIndex(ciphertext, indices[i]);
+
+  // rotations with a key share one digit decomposition; the others fail
+  // before any work is done, or are composed
+  std::vector<bool> hoisted(indices.size(), false);
+  bool anyHoisted = false;
+  if (std::any_of(indices.begin(), indices.end(),
+                  [](int32_t index) { return index != 0; })) {
+    auto evalAutomorphismKeys =
+        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+            ciphertext->GetKeyTag(), autoIndices);
+    for (size_t i = 0; i < indices.size(); i++) {
+      if (indices[i] == 0) continue;
+      if (evalAutomorphismKeys->find(autoIndices[i]) !=
+          evalAutomorphismKeys->end()) {
+        hoisted[i] = anyHoisted = true;
+      } else if (!m_rotationComposition) {
+        PALISADE_THROW(not_available_error,
+                       "There is no EvalAutomorphismKey for index " +
+                           std::to_string(autoIndices[i]) + " for this ID");
+      }
+    }
+  }
+
+  shared_ptr<vector<Element>> digits;
+  if (anyHoisted) digits = EvalFastRotationPrecompute(ciphertext);
+
+  std::vector<Ciphertext<Element>> result(indices.size());
+  usint m = GetCyclotomicOrder();
+  ParallelFor(0, indices.size(), [&](size_t i) {
+    if (indices[i] == 0)
+      result[i] = ciphertext->Clone();
+    else if (hoisted[i])
+      result[i] = EvalFastRotation(ciphertext, indices[i], m, digits);
+    else
+      result[i] = EvalAtIndexComposed(ciphertext, autoIndices[i]);
+  });
+  return result;
+}
+
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
     const vector<Ciphertext<Element>>& ciphertextVector) const {
+  ParallelScope scope(m_executor);
   if (ciphertextVector[0] == nullptr ||
       Mismatched(ciphertextVector[0]->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Information passed to EvalMerge was not generated with "
                    "this crypto context");
 
+  // the merge only rotates by -stride for strides 1, 2, 4, ..., so only those
+  // keys are loaded
+  std::vector<usint> autoIndices;
+  for (size_t stride = 1; stride < ciphertextVector.size(); stride *= 2)
+    autoIndices.push_back(LPSHEAlgorithm<Element>::FindAutomorphismIndex(
+        ciphertextVector[0], -static_cast<int32_t>(stride)));
+
   auto evalAutomorphismKeys =
-      CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(
-          ciphertextVector[0]->GetKeyTag());
+      CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+          ciphertextVector[0]->GetKeyTag(), autoIndices);
 
   auto rv = GetEncryptionAlgorithm()->EvalMerge(ciphertextVector,
-                                                evalAutomorphismKeys);
+                                                *evalAutomorphismKeys);
 
   return rv;
 }
 
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalLinearTransform(
+    ConstCiphertext<Element> ciphertext,
+    const LinearTransform<Element>& transform) const {
+  ParallelScope scope(m_executor);
+  if (ciphertext == nullptr || Mismatched(ciphertext->GetCryptoContext()))
+    PALISADE_THROW(config_error,
+                   "Information passed to EvalLinearTransform was not "
+                   "generated with this crypto context");
+  if (transform == nullptr || transform->GetDiagonals().empty())
+    PALISADE_THROW(config_error,
+                   "EvalLinearTransform needs a matrix with a nonzero "
+                   "diagonal");
+
+  const auto& diagonals = transform->GetDiagonals();
+  usint babySteps = transform->GetBabySteps();
+  usint giantSteps = (transform->GetDim() + babySteps - 1) / babySteps;
+
+  std::vector<bool> babyUsed(babySteps, false);
+  for (const auto& d : diagonals) babyUsed[d.first % babySteps] = true;
+
+  // copies the n slots to [n, 2n) so that the rotations below are cyclic on
+  // the first n slots
+  int32_t dim = static_cast<int32_t>(transform->GetDim());
+  ConstCiphertext<Element> input =
+      transform->IsReplicated()
+          ? EvalAdd(ciphertext, EvalAtIndex(ciphertext, -dim))
+          : ciphertext;
+
+  // baby steps: all rotations of the input share one digit decomposition
+  std::vector<Ciphertext<Element>> baby(babySteps);
+  shared_ptr<vector<Element>> digits;
+  if (std::find(babyUsed.begin() + 1, babyUsed.end(), true) != babyUsed.end())
+    digits = EvalFastRotationPrecompute(input);
+  usint m = GetCyclotomicOrder();
+  ParallelFor(0, babySteps, [&](size_t i) {
+    if (!babyUsed[i]) return;
+    baby[i] = (i == 0) ? input->Clone()
+                       : EvalFastRotation(input, i, m, digits);
+  });
+
+  // giant steps: one key switch per group of babySteps diagonals
+  std::vector<Ciphertext<Element>> giant(giantSteps);
+  ParallelFor(0, giantSteps, [&](size_t j) {
+    Ciphertext<Element> sum;
+    for (usint i = 0; i < babySteps; i++) {
+      auto it = diagonals.find(j * babySteps + i);
+      if (it == diagonals.end()) continue;
+      auto product = EvalMult(baby[i], it->second);
+      if (sum)
+        EvalAddInPlace(sum, product);
+      else
+        sum = product;
+    }
+    if (sum && j > 0) sum = EvalAtIndex(sum, j * babySteps);
+    giant[j] = sum;
+  });
+
+  Ciphertext<Element> result;
+  for (auto& g : giant) {
+    if (!g) continue;
+    if (result)
+      EvalAddInPlace(result, g);
+    else
+      result = g;
+  }
+  return result;
+}
+
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(
     ConstCiphertext<Element> ct1, ConstCiphertext<Element> ct2,
     usint batchSize) const {
+  ParallelScope scope(m_executor);
   if (ct1 == nullptr || ct2 == nullptr ||
       ct1->GetKeyTag() != ct2->GetKeyTag() ||
       Mismatched(ct1->GetCryptoContext()))
@@ -425,30 +804,96 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(
                    "with this crypto context");
 
   auto evalSumKeys =
-      CryptoContextImpl<Element>::GetEvalSumKeyMap(ct1->GetKeyTag());
-  auto ek = GetEvalMultKeyVector(ct1->GetKeyTag());
+      CryptoContextImpl<Element>::GetEvalSumKeyMapPtr(ct1->GetKeyTag());
+  auto ek = GetEvalMultKeyVectorPtr(ct1->GetKeyTag());
 
   auto rv = GetEncryptionAlgorithm()->EvalInnerProduct(ct1, ct2, batchSize,
-                                                       evalSumKeys, ek[0]);
+                                                       *evalSumKeys, (*ek)[0]);
   return rv;
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(
     ConstCiphertext<Element> ct1, ConstPlaintext ct2, usint batchSize) const {
+  ParallelScope scope(m_executor);
   if (ct1 == nullptr || ct2 == nullptr || Mismatched(ct1->GetCryptoContext()))
     PALISADE_THROW(config_error,
                    "Information passed to EvalInnerProduct was not generated "
                    "with this crypto context");
 
   auto evalSumKeys =
-      CryptoContextImpl<Element>::GetEvalSumKeyMap(ct1->GetKeyTag());
+      CryptoContextImpl<Element>::GetEvalSumKeyMapPtr(ct1->GetKeyTag());
 
   auto rv = GetEncryptionAlgorithm()->EvalInnerProduct(ct1, ct2, batchSize,
-                                                       evalSumKeys);
+                                                       *evalSumKeys);
   return rv;
 }
 
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalSumOfProducts(
+    const vector<Ciphertext<Element>>& ciphertexts1,
+    const vector<Ciphertext<Element>>& ciphertexts2) const {
+  ParallelScope scope(m_executor);
+  if (ciphertexts1.empty())
+    PALISADE_THROW(type_error, "Empty input ciphertext vector");
+  if (ciphertexts1.size() != ciphertexts2.size())
+    PALISADE_THROW(config_error,
+                   "EvalSumOfProducts: the vectors of factors have different "
+                   "sizes");
+  for (size_t i = 0; i < ciphertexts1.size(); i++) {
+    TypeCheck(ciphertexts1[0], ciphertexts1[i]);
+    TypeCheck(ciphertexts1[i], ciphertexts2[i]);
+  }
+
+  auto algo = GetEncryptionAlgorithm();
+
+  // the products keep all their elements; key switching is deferred to the sum
+  vector<Ciphertext<Element>> products(ciphertexts1.size());
+  ParallelFor(0, products.size(), [&](size_t i) {
+    products[i] = algo->EvalMult(ciphertexts1[i], ciphertexts2[i]);
+  });
+  auto sum = algo->EvalAddManyInPlace(products);
+
+  const auto ek = GetEvalMultKeyVectorPtr(sum->GetKeyTag());
+  if (ek->size() < (sum->GetElements().size() - 2)) {
+    PALISADE_THROW(type_error,
+                   "Insufficient value was used for maxDepth to generate "
+                   "keys for EvalMult");
+  }
+  sum = algo->Relinearize(sum, *ek);
+
+  if (algo->GetEnabled() & LEVELEDSHE) algo->ModReduceInPlace(sum);
+  return sum;
+}
+
+template <typename Element>
+Ciphertext<Element> CryptoContextImpl<Element>::EvalSumOfProducts(
+    const vector<Ciphertext<Element>>& ciphertexts,
+    const vector<Plaintext>& plaintexts) const {
+  ParallelScope scope(m_executor);
+  if (ciphertexts.empty())
+    PALISADE_THROW(type_error, "Empty input ciphertext vector");
+  if (ciphertexts.size() != plaintexts.size())
+    PALISADE_THROW(config_error,
+                   "EvalSumOfProducts: the vectors of factors have different "
+                   "sizes");
+  for (size_t i = 0; i < ciphertexts.size(); i++) {
+    TypeCheck(ciphertexts[0], ciphertexts[i]);
+    TypeCheck(ciphertexts[i], plaintexts[i]);
+  }
+
+  auto algo = GetEncryptionAlgorithm();
+
+  vector<Ciphertext<Element>> products(ciphertexts.size());
+  ParallelFor(0, products.size(), [&](size_t i) {
+    products[i] = algo->EvalMult(ciphertexts[i], plaintexts[i]);
+  });
+  auto sum = algo->EvalAddManyInPlace(products);
+
+  if (algo->GetEnabled() & LEVELEDSHE) algo->ModReduceInPlace(sum);
+  return sum;
+}
+
 template <typename Element>
 Plaintext CryptoContextImpl<Element>::GetPlaintextForDecrypt(
     PlaintextEncodings pte, shared_ptr<ParmType> evp, EncodingParams ep) {
@@ -464,6 +909,7 @@ template <typename Element>
 DecryptResult CryptoContextImpl<Element>::Decrypt(
     const LPPrivateKey<Element> privateKey, ConstCiphertext<Element> ciphertext,
     Plaintext* plaintext) {
+  ParallelScope scope(m_executor);
   if (ciphertext == nullptr)
     PALISADE_THROW(config_error, "ciphertext passed to Decrypt is empty");
   if (plaintext == nullptr)
@@ -521,6 +967,7 @@ template <typename Element>
 DecryptResult CryptoContextImpl<Element>::MultipartyDecryptFusion(
     const vector<Ciphertext<Element>>& partialCiphertextVec,
     Plaintext* plaintext) const {
+  ParallelScope scope(m_executor);
   DecryptResult result;
 
   // Make sure we're processing ciphertexts.
@@ -0,0 +1,181 @@
+// @file rotationkeyplan.cpp -- Selection of rotation keys under a key budget,
+// and composition of rotations from the selected keys.
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include "rotationkeyplan.h"
+
+#include <algorithm>
+#include <string>
+
+#include "utils/exception.h"
+
+namespace lbcrypto {
+
+RotationKeyPlan::RotationKeyPlan(usint slots) : m_slots(slots) {
+  if (slots < 2)
+    PALISADE_THROW(config_error,
+                   "A rotation key plan needs at least two slots");
+}
+
+RotationKeyPlan::RotationKeyPlan(const std::vector<int32_t> &indices,
+                                 usint slots, usint maxKeys)
+    : RotationKeyPlan(slots) {
+  for (auto index : indices) {
+    usint rotation = Normalize(index);
+    if (rotation != 0) m_targets.push_back(rotation);
+  }
+  std::sort(m_targets.begin(), m_targets.end());
+  m_targets.erase(std::unique(m_targets.begin(), m_targets.end()),
+                  m_targets.end());
+
+  if (maxKeys == 0 || m_targets.size() <= maxKeys) {
+    m_keys = m_targets;
+    Compose();
+    return;
+  }
+
+  // the powers of the smallest base that fit in the budget generate every
+  // rotation
+  uint64_t base = 2;
+  while (true) {
+    usint numPowers = 0;
+    for (uint64_t power = 1; power < m_slots; power *= base) numPowers++;
+    if (numPowers <= maxKeys) break;
+    base++;
+  }
+  for (uint64_t power = 1; power < m_slots; power *= base)
+    m_keys.push_back(power);
+  Compose();
+
+  // spend the rest of the budget on the needed rotations that save the most
+  // key switches
+  while (m_keys.size() < maxKeys) {
+    usint best = 0;
+    uint64_t bestGain = 0;
+    for (auto candidate : m_targets) {
+      if (m_cost[candidate] <= 1) continue;
+      uint64_t gain = 0;
+      for (auto target : m_targets) {
+        usint cost = m_cost[target];
+        usint newCost = cost;
+        // using the new key t times and the old keys for the rest
+        for (usint t = 1; t < newCost; t++) {
+          usint rest = (target + m_slots -
+                        static_cast<usint>((uint64_t(t) * candidate) %
+                                           m_slots)) %
+                       m_slots;
+          newCost = std::min(newCost, m_cost[rest] + t);
+        }
+        gain += cost - newCost;
+      }
+      if (gain > bestGain) {
+        bestGain = gain;
+        best = candidate;
+      }
+    }
+    if (bestGain == 0) break;
+    m_keys.push_back(best);
+    Compose();
+  }
+  std::sort(m_keys.begin(), m_keys.end());
+}
+
+RotationKeyPlan RotationKeyPlan::FromKeys(const std::vector<int32_t> &keys,
+                                          usint slots) {
+  RotationKeyPlan plan(slots);
+  for (auto key : keys) {
+    usint rotation = plan.Normalize(key);
+    if (rotation != 0) plan.m_keys.push_back(rotation);
+  }
+  std::sort(plan.m_keys.begin(), plan.m_keys.end());
+  plan.m_keys.erase(std::unique(plan.m_keys.begin(), plan.m_keys.end()),
+                    plan.m_keys.end());
+  plan.Compose();
+  return plan;
+}
+
+std::vector<int32_t> RotationKeyPlan::GetKeyIndices() const {
+  std::vector<int32_t> indices;
+  for (auto key : m_keys) indices.push_back(Signed(key));
+  return indices;
+}
+
+std::vector<int32_t> RotationKeyPlan::GetSteps(int32_t index) const {
+  usint rotation = Normalize(index);
+  if (m_cost[rotation] == m_slots)
+    PALISADE_THROW(not_available_error,
+                   "The rotation by " + std::to_string(index) +
+                       " cannot be composed from the rotation keys");
+
+  std::vector<int32_t> steps;
+  while (rotation != 0) {
+    usint key = m_lastKey[rotation];
+    steps.push_back(Signed(key));
+    rotation = (rotation + m_slots - key) % m_slots;
+  }
+  return steps;
+}
+
+usint RotationKeyPlan::GetMaxCost() const {
+  usint maxCost = 0;
+  for (auto target : m_targets) maxCost = std::max(maxCost, m_cost[target]);
+  return maxCost;
+}
+
+usint RotationKeyPlan::GetTotalCost() const {
+  usint totalCost = 0;
+  for (auto target : m_targets) totalCost += m_cost[target];
+  return totalCost;
+}
+
+usint RotationKeyPlan::Normalize(int32_t index) const {
+  int64_t rotation = int64_t(index) % int64_t(m_slots);
+  if (rotation < 0) rotation += m_slots;
+  return static_cast<usint>(rotation);
+}
+
+int32_t RotationKeyPlan::Signed(usint rotation) const {
+  if (rotation > m_slots / 2)
+    return static_cast<int32_t>(rotation) - static_cast<int32_t>(m_slots);
+  return static_cast<int32_t>(rotation);
+}
+
+void RotationKeyPlan::Compose() {
+  // breadth-first search over the rotations; every key is one key switch
+  m_cost.assign(m_slots, m_slots);
+  m_lastKey.assign(m_slots, 0);
+  m_cost[0] = 0;
+  std::vector<usint> queue(1, 0);
+  for (size_t next = 0; next < queue.size(); next++) {
+    usint rotation = queue[next];
+    for (auto key : m_keys) {
+      usint reached = (rotation + key) % m_slots;
+      if (m_cost[reached] != m_slots) continue;
+      m_cost[reached] = m_cost[rotation] + 1;
+      m_lastKey[reached] = key;
+      queue.push_back(reached);
+    }
+  }
+}
+
+}  // namespace lbcrypto
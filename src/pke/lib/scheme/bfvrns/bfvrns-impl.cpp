@@ -232,6 +232,33 @@ void LPAlgorithmSHEBFVrns<NativePoly>::KeySwitchInPlace(
   NONATIVEPOLY
 }
 
+template <>
+shared_ptr<vector<Poly>> LPAlgorithmSHEBFVrns<Poly>::EvalFastRotationPrecompute(
+    ConstCiphertext<Poly> ciphertext) const {
+  NOPOLY
+}
+
+template <>
+shared_ptr<vector<NativePoly>>
+LPAlgorithmSHEBFVrns<NativePoly>::EvalFastRotationPrecompute(
+    ConstCiphertext<NativePoly> ciphertext) const {
+  NONATIVEPOLY
+}
+
+template <>
+Ciphertext<Poly> LPAlgorithmSHEBFVrns<Poly>::EvalFastRotation(
+    ConstCiphertext<Poly> ciphertext, const usint index, const usint m,
+    const shared_ptr<vector<Poly>> digits) const {
+  NOPOLY
+}
+
+template <>
+Ciphertext<NativePoly> LPAlgorithmSHEBFVrns<NativePoly>::EvalFastRotation(
+    ConstCiphertext<NativePoly> ciphertext, const usint index, const usint m,
+    const shared_ptr<vector<NativePoly>> digits) const {
+  NONATIVEPOLY
+}
+
 template <>
 Ciphertext<Poly> LPAlgorithmSHEBFVrns<Poly>::EvalMultAndRelinearize(
     ConstCiphertext<Poly> ct1, ConstCiphertext<Poly> ct,
@@ -246,6 +273,19 @@ Ciphertext<NativePoly> LPAlgorithmSHEBFVrns<NativePoly>::EvalMultAndRelinearize(
   NONATIVEPOLY
 }
 
+template <>
+Ciphertext<Poly> LPAlgorithmSHEBFVrns<Poly>::Relinearize(
+    ConstCiphertext<Poly> ciphertext, const vector<LPEvalKey<Poly>> &ek) const {
+  NOPOLY
+}
+
+template <>
+Ciphertext<NativePoly> LPAlgorithmSHEBFVrns<NativePoly>::Relinearize(
+    ConstCiphertext<NativePoly> ciphertext,
+    const vector<LPEvalKey<NativePoly>> &ek) const {
+  NONATIVEPOLY
+}
+
 template <>
 DecryptResult LPAlgorithmMultipartyBFVrns<Poly>::MultipartyDecryptFusion(
     const vector<Ciphertext<Poly>> &ciphertextVec,
@@ -978,11 +1018,21 @@ Ciphertext<DCRTPoly> LPAlgorithmBFVrns<DCRTPoly>::Encrypt(
   ptxt.SwitchFormat();
 
   const DggType &dgg = cryptoParams->GetDiscreteGaussianGenerator();
-  DugType dug;
 
   const std::vector<NativeInteger> &delta = cryptoParams->GetDelta();
 
-  DCRTPoly a(dug, elementParams, Format::EVALUATION);
+  // a seeded encryption derives the mask from a seed that is shipped in
+  // place of the second element
+  std::vector<uint32_t> seed;
+  DCRTPoly a;
+  if (privateKey->GetCryptoContext()->GetCiphertextCompression()) {
+    seed = SeededUniform<DCRTPoly>::GenerateSeed();
+    a = SeededUniform<DCRTPoly>::Expand(
+        seed, SeededUniform<DCRTPoly>::CIPHERTEXT, 0, elementParams);
+  } else {
+    DugType dug;
+    a = DCRTPoly(dug, elementParams, Format::EVALUATION);
+  }
   const DCRTPoly &s = privateKey->GetPrivateElement();
   DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
@@ -991,6 +1041,7 @@ Ciphertext<DCRTPoly> LPAlgorithmBFVrns<DCRTPoly>::Encrypt(
   c1 -= a;
 
   ciphertext->SetElements({std::move(c0), std::move(c1)});
+  if (!seed.empty()) ciphertext->SetSeed(seed);
 
   return ciphertext;
 }
@@ -1349,19 +1400,77 @@ void LPAlgorithmSHEBFVrns<DCRTPoly>::KeySwitchInPlace(
 }
 
 template <>
-Ciphertext<DCRTPoly> LPAlgorithmSHEBFVrns<DCRTPoly>::EvalMultAndRelinearize(
-    ConstCiphertext<DCRTPoly> ciphertext1,
-    ConstCiphertext<DCRTPoly> ciphertext2,
-    const vector<LPEvalKey<DCRTPoly>> &ek) const {
-  Ciphertext<DCRTPoly> cipherText = this->EvalMult(ciphertext1, ciphertext2);
-
+shared_ptr<vector<DCRTPoly>>
+LPAlgorithmSHEBFVrns<DCRTPoly>::EvalFastRotationPrecompute(
+    ConstCiphertext<DCRTPoly> ciphertext) const {
   const auto cryptoParamsLWE =
       std::static_pointer_cast<LPCryptoParametersBFVrns<DCRTPoly>>(
-          ek[0]->GetCryptoParameters());
+          ciphertext->GetCryptoParameters());
+  uint32_t relinWindow = cryptoParamsLWE->GetRelinWindow();
 
-  Ciphertext<DCRTPoly> newCiphertext = cipherText->CloneEmpty();
+  const std::vector<DCRTPoly> &c = ciphertext->GetElements();
+  if (c.size() != 2)
+    PALISADE_THROW(config_error,
+                   "EvalFastRotationPrecompute needs a relinearized "
+                   "ciphertext");
+
+  return std::make_shared<vector<DCRTPoly>>(c[1].CRTDecompose(relinWindow));
+}
+
+template <>
+Ciphertext<DCRTPoly> LPAlgorithmSHEBFVrns<DCRTPoly>::EvalFastRotation(
+    ConstCiphertext<DCRTPoly> ciphertext, const usint index, const usint m,
+    const shared_ptr<vector<DCRTPoly>> digits) const {
+  /*
+   * The automorphism commutes with the digit decomposition, so the digits of
+   * psi(c1) are the automorphed digits of c1:
+   * c'_0 = psi(c0) + Sum_k( psi(d_k) * B_k )
+   * c'_1 = Sum_k( psi(d_k) * A_k )
+   */
+  if (index == 0) return ciphertext->Clone();
+
+  const auto cryptoParams = ciphertext->GetCryptoParameters();
+  usint autoIndex;
+  if (IsPowerOfTwo(m))
+    autoIndex = FindAutomorphismIndex2n(index, m);
+  else
+    autoIndex = FindAutomorphismIndexCyclic(
+        index, m, cryptoParams->GetEncodingParams()->GetPlaintextGenerator());
+
+  LPEvalKeyRelin<DCRTPoly> evalKey =
+      std::static_pointer_cast<LPEvalKeyRelinImpl<DCRTPoly>>(
+          ciphertext->GetCryptoContext()->GetEvalAutomorphismKey(
+              ciphertext->GetKeyTag(), autoIndex));
+
+  const std::vector<DCRTPoly> &b = evalKey->GetAVector();
+  const std::vector<DCRTPoly> &a = evalKey->GetBVector();
+
+  DCRTPoly c0 = ciphertext->GetElements()[0];
+  c0.SetFormat(Format::EVALUATION);
+  c0 = c0.AutomorphismTransform(autoIndex);
 
-  std::vector<DCRTPoly> c = cipherText->GetElements();
+  DCRTPoly digit = (*digits)[0].AutomorphismTransform(autoIndex);
+  DCRTPoly c1 = digit * a[0];
+  c0 += digit * b[0];
+
+  for (usint i = 1; i < digits->size(); ++i) {
+    digit = (*digits)[i].AutomorphismTransform(autoIndex);
+    c0 += digit * b[i];
+    c1 += digit * a[i];
+  }
+
+  Ciphertext<DCRTPoly> result = ciphertext->CloneEmpty();
+  result->SetElements({std::move(c0), std::move(c1)});
+  return result;
+}
+
+template <>
+Ciphertext<DCRTPoly> LPAlgorithmSHEBFVrns<DCRTPoly>::Relinearize(
+    ConstCiphertext<DCRTPoly> ciphertext,
+    const vector<LPEvalKey<DCRTPoly>> &ek) const {
+  Ciphertext<DCRTPoly> newCiphertext = ciphertext->CloneEmpty();
+
+  std::vector<DCRTPoly> c = ciphertext->GetElements();
 
   // Do not change the format of the elements to decompose
   if (c[0].GetFormat() == Format::COEFFICIENT) {
@@ -1374,8 +1483,7 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBFVrns<DCRTPoly>::EvalMultAndRelinearize(
   // it until it reaches to 2 elements.
   // TODO: Maybe we can change the number of keyswitching and terminate early.
   // For instance; perform keyswitching until 4 elements left.
-  for (size_t j = 0; j <= cipherText->GetDepth() - 2; j++) {
-    size_t index = cipherText->GetDepth() - 2 - j;
+  for (size_t index = 0; index + 2 < c.size(); index++) {
     LPEvalKeyRelin<DCRTPoly> evalKey =
         std::static_pointer_cast<LPEvalKeyRelinImpl<DCRTPoly>>(ek[index]);
 
@@ -1395,6 +1503,14 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBFVrns<DCRTPoly>::EvalMultAndRelinearize(
   return newCiphertext;
 }
 
+template <>
+Ciphertext<DCRTPoly> LPAlgorithmSHEBFVrns<DCRTPoly>::EvalMultAndRelinearize(
+    ConstCiphertext<DCRTPoly> ciphertext1,
+    ConstCiphertext<DCRTPoly> ciphertext2,
+    const vector<LPEvalKey<DCRTPoly>> &ek) const {
+  return Relinearize(this->EvalMult(ciphertext1, ciphertext2), ek);
+}
+
 template <>
 LPEvalKey<DCRTPoly> LPAlgorithmPREBFVrns<DCRTPoly>::ReKeyGen(
     const LPPublicKey<DCRTPoly> newPK,
@@ -43,6 +43,7 @@ schemes for finite fields. Cryptology ePrint Archive, Report 2021/204,
 
 #include "bgvrns.cpp"
 #include "cryptocontext.h"
+#include "utils/scheduler.h"
 
 namespace lbcrypto {
 
@@ -817,8 +818,18 @@ Ciphertext<DCRTPoly> LPAlgorithmBGVrns<DCRTPoly>::Encrypt(
   uint32_t sizeQl = ptxtParams->GetParams().size();
   uint32_t sizeQ = s.GetParams()->GetParams().size();
 
-  DugType dug;
-  DCRTPoly a(dug, ptxtParams, Format::EVALUATION);
+  // a seeded encryption derives the mask from a seed that is shipped in
+  // place of the second element
+  std::vector<uint32_t> seed;
+  DCRTPoly a;
+  if (privateKey->GetCryptoContext()->GetCiphertextCompression()) {
+    seed = SeededUniform<DCRTPoly>::GenerateSeed();
+    a = SeededUniform<DCRTPoly>::Expand(
+        seed, SeededUniform<DCRTPoly>::CIPHERTEXT, 0, ptxtParams);
+  } else {
+    DugType dug;
+    a = DCRTPoly(dug, ptxtParams, Format::EVALUATION);
+  }
 
   DCRTPoly c0, c1;
   if (sizeQl != sizeQ) {
@@ -839,6 +850,7 @@ Ciphertext<DCRTPoly> LPAlgorithmBGVrns<DCRTPoly>::Encrypt(
   cv.push_back(std::move(c1));
 
   ciphertext->SetElements(std::move(cv));
+  if (!seed.empty()) ciphertext->SetSeed(seed);
 
   // Ciphertext depth, level, and scaling factor should be
   // equal to that of the plaintext. However, Encrypt does
@@ -1043,8 +1055,17 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchBVGen(
   // Get the plaintext modulus
   const auto t = cryptoParams->GetPlaintextModulus();
 
-#pragma omp parallel for
-  for (usint i = 0; i < sizeSOld; i++) {
+  // A vectors of seeded (compressed) keys are derived from a seed; a
+  // threshold key inherits the seed of the key it extends
+  std::vector<uint32_t> seed;
+  if (ekPrev == nullptr) {
+    if (newKey->GetCryptoContext()->GetEvalKeyCompression())
+      seed = SeededUniform<DCRTPoly>::GenerateSeed();
+  } else if (ekPrev->IsAVectorSeeded()) {
+    seed = ekPrev->GetAVectorSeed();
+  }
+
+  ParallelFor(0, sizeSOld, [&](size_t i) {
     DugType dug;
 
     if (relinWindow > 0) {
@@ -1057,7 +1078,11 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchBVGen(
 
         filtered.SetElementAtIndex(i, sOldDecomposed[k]);
 
-        if (ekPrev == nullptr) {  // single-key HE
+        if (!seed.empty()) {  // seeded key
+          av[k + arrWindows[i]] = SeededUniform<DCRTPoly>::Expand(
+              seed, SeededUniform<DCRTPoly>::EVAL_KEY, k + arrWindows[i],
+              elementParams);
+        } else if (ekPrev == nullptr) {  // single-key HE
           // Generate a_i vectors
           DCRTPoly a(dug, elementParams, Format::EVALUATION);
           av[k + arrWindows[i]] = a;
@@ -1076,7 +1101,10 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchBVGen(
 
       filtered.SetElementAtIndex(i, sOld.GetElementAtIndex(i));
 
-      if (ekPrev == nullptr) {  // single-key HE
+      if (!seed.empty()) {  // seeded key
+        av[i] = SeededUniform<DCRTPoly>::Expand(
+            seed, SeededUniform<DCRTPoly>::EVAL_KEY, i, elementParams);
+      } else if (ekPrev == nullptr) {  // single-key HE
         // Generate a_i vectors
         DCRTPoly a(dug, elementParams, Format::EVALUATION);
         av[i] = a;
@@ -1088,10 +1116,11 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchBVGen(
       DCRTPoly e(dgg, elementParams, Format::EVALUATION);
       bv[i] = filtered - (av[i] * sNew + t * e);
     }
-  }
+  });
 
   ek->SetAVector(std::move(av));
   ek->SetBVector(std::move(bv));
+  if (!seed.empty()) ek->SetAVectorSeed(seed);
 
   return ek;
 }
@@ -1428,6 +1457,16 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchHybridGen(
   const DggType &dgg = cryptoParams->GetDiscreteGaussianGenerator();
   DugType dug;
 
+  // A vectors of seeded (compressed) keys are derived from a seed; a
+  // threshold key inherits the seed of the key it extends
+  std::vector<uint32_t> seed;
+  if (ekPrev == nullptr) {
+    if (newKey->GetCryptoContext()->GetEvalKeyCompression())
+      seed = SeededUniform<DCRTPoly>::GenerateSeed();
+  } else if (ekPrev->IsAVectorSeeded()) {
+    seed = ekPrev->GetAVectorSeed();
+  }
+
   auto numPartQ = cryptoParams->GetNumPartQ();
   vector<DCRTPoly> av(numPartQ);
   vector<DCRTPoly> bv(numPartQ);
@@ -1440,7 +1479,10 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchHybridGen(
 
   for (usint part = 0; part < numPartQ; part++) {
     DCRTPoly a;
-    if (ekPrev == nullptr) {  // single-key HE
+    if (!seed.empty()) {  // seeded key
+      a = SeededUniform<DCRTPoly>::Expand(
+          seed, SeededUniform<DCRTPoly>::EVAL_KEY, part, paramsQP);
+    } else if (ekPrev == nullptr) {  // single-key HE
       a = DCRTPoly(dug, paramsQP, Format::EVALUATION);
     } else {  // threshold HE
       a = ekPrev->GetAVector()[part];
@@ -1473,6 +1515,7 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchHybridGen(
 
   ek->SetAVector(std::move(av));
   ek->SetBVector(std::move(bv));
+  if (!seed.empty()) ek->SetAVectorSeed(seed);
 
   return ek;
 }
@@ -1603,28 +1646,9 @@ void LPAlgorithmSHEBGVrns<DCRTPoly>::KeySwitchHybridInPlace(
   DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
   DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
-  for (uint32_t j = 0; j < numPartQl; j++) {
-    const DCRTPoly &cj = partsCtExt[j];
-    const DCRTPoly &bj = bv[j];
-    const DCRTPoly &aj = av[j];
-
-    for (usint i = 0; i < sizeQl; i++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(i);
-      const auto &bji = bj.GetElementAtIndex(i);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-    for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(idx);
-      const auto &bji = bj.GetElementAtIndex(idx);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-  }
+  DCRTPoly::KeySwitchInnerProduct(
+      partsCtExt, bv, av, sizeQ, cryptoParams->GetModqBarrettMu(),
+      cryptoParams->GetModpBarrettMu(), &cTilda0, &cTilda1);
 
   //cTilda0.SetFormat(Format::COEFFICIENT);
   //cTilda1.SetFormat(Format::COEFFICIENT);
@@ -2423,7 +2447,7 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::EvalFastRotationBV(
   const std::vector<DCRTPoly> &cv = ciphertext->GetElements();
 
   // Find the automorphism index that corresponds to rotation index index.
-  usint autoIndex = FindAutomorphismIndex2nComplex(index, m);
+  usint autoIndex = FindAutomorphismIndex2n(index, m);
 
   // Get the parts of the automorphism key
   std::vector<DCRTPoly> bv(evalKey->GetBVector());
@@ -2545,7 +2569,7 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::EvalFastRotationGHS(
     const shared_ptr<vector<DCRTPoly>> expandedCiphertext,
     LPEvalKey<DCRTPoly> evalKey) const {
   // Find the automorphism index that corresponds to rotation index index.
-  usint autoIndex = FindAutomorphismIndex2nComplex(index, m);
+  usint autoIndex = FindAutomorphismIndex2n(index, m);
 
   // Apply the automorphism to the first component of the ciphertext.
   DCRTPoly psiC0(ciphertext->GetElements()[0].AutomorphismTransform(autoIndex));
@@ -2774,7 +2798,7 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::EvalFastRotationHybrid(
     const shared_ptr<vector<DCRTPoly>> expandedCiphertext,
     LPEvalKey<DCRTPoly> evalKey) const {
   // Find the automorphism index that corresponds to rotation index index.
-  usint autoIndex = FindAutomorphismIndex2nComplex(index, m);
+  usint autoIndex = FindAutomorphismIndex2n(index, m);
 
   // Apply the automorphism to the first component of the ciphertext.
   DCRTPoly psiC0(ciphertext->GetElements()[0].AutomorphismTransform(autoIndex));
@@ -2785,43 +2809,28 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::EvalFastRotationHybrid(
 
   Ciphertext<DCRTPoly> result = ciphertext->CloneEmpty();
 
-  std::vector<DCRTPoly> bv = evalKey->GetBVector();
-  std::vector<DCRTPoly> av = evalKey->GetAVector();
+  const std::vector<DCRTPoly> &bv = evalKey->GetBVector();
+  const std::vector<DCRTPoly> &av = evalKey->GetAVector();
 
   const shared_ptr<ParmType> paramsQl = psiC0.GetParams();
   const shared_ptr<ParmType> paramsP = cryptoParams->GetParamsP();
   const shared_ptr<ParmType> paramsQlP = (*expandedCiphertext)[0].GetParams();
 
-  size_t sizeQl = paramsQl->GetParams().size();
-  size_t sizeQlP = paramsQlP->GetParams().size();
   size_t sizeQ = cryptoParams->GetElementParams()->GetParams().size();
 
   DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
   DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
+  std::vector<DCRTPoly> digits;
+  digits.reserve(expandedCiphertext->size());
   for (uint32_t j = 0; j < expandedCiphertext->size(); j++) {
-    DCRTPoly cj((*expandedCiphertext)[j].AutomorphismTransform(autoIndex));
-    const DCRTPoly &bj = bv[j];
-    const DCRTPoly &aj = av[j];
-
-    for (usint i = 0; i < sizeQl; i++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(i);
-      const auto &bji = bj.GetElementAtIndex(i);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-    for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(idx);
-      const auto &bji = bj.GetElementAtIndex(idx);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
+    digits.push_back((*expandedCiphertext)[j].AutomorphismTransform(autoIndex));
   }
 
+  DCRTPoly::KeySwitchInnerProduct(
+      digits, bv, av, sizeQ, cryptoParams->GetModqBarrettMu(),
+      cryptoParams->GetModpBarrettMu(), &cTilda0, &cTilda1);
+
   //cTilda0.SetFormat(Format::COEFFICIENT);
   //cTilda1.SetFormat(Format::COEFFICIENT);
 
@@ -2915,13 +2924,11 @@ Ciphertext<DCRTPoly> LPAlgorithmSHEBGVrns<DCRTPoly>::EvalFastRotation(
   }
 
   // Find the automorphism index that corresponds to rotation index index.
-  usint autoIndex = FindAutomorphismIndex2nComplex(index, m);
+  usint autoIndex = FindAutomorphismIndex2n(index, m);
 
   // Retrieve the automorphism key that corresponds to the auto index.
-  auto autok = ciphertext->GetCryptoContext()
-                   ->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag())
-                   .find(autoIndex)
-                   ->second;
+  auto autok = ciphertext->GetCryptoContext()->GetEvalAutomorphismKey(
+      ciphertext->GetKeyTag(), autoIndex);
 
   if (cryptoParams->GetKeySwitchTechnique() == BV) {
     return EvalFastRotationBV(ciphertext, index, m, precomp, autok);
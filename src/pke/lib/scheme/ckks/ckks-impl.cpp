@@ -840,8 +840,18 @@ Ciphertext<DCRTPoly> LPAlgorithmCKKS<DCRTPoly>::Encrypt(
   uint32_t sizeQl = ptxtParams->GetParams().size();
   uint32_t sizeQ = s.GetParams()->GetParams().size();
 
-  DugType dug;
-  DCRTPoly a(dug, ptxtParams, Format::EVALUATION);
+  // a seeded encryption derives the mask from a seed that is shipped in
+  // place of the second element
+  std::vector<uint32_t> seed;
+  DCRTPoly a;
+  if (privateKey->GetCryptoContext()->GetCiphertextCompression()) {
+    seed = SeededUniform<DCRTPoly>::GenerateSeed();
+    a = SeededUniform<DCRTPoly>::Expand(
+        seed, SeededUniform<DCRTPoly>::CIPHERTEXT, 0, ptxtParams);
+  } else {
+    DugType dug;
+    a = DCRTPoly(dug, ptxtParams, Format::EVALUATION);
+  }
 
   DCRTPoly c0, c1;
   if (sizeQl != sizeQ) {
@@ -862,6 +872,7 @@ Ciphertext<DCRTPoly> LPAlgorithmCKKS<DCRTPoly>::Encrypt(
   cv.push_back(std::move(c1));
 
   ciphertext->SetElements(std::move(cv));
+  if (!seed.empty()) ciphertext->SetSeed(seed);
 
   // Ciphertext depth, level, and scaling factor should be
   // equal to that of the plaintext. However, Encrypt does
@@ -976,19 +987,40 @@ DecryptResult LPAlgorithmCKKS<NativePoly>::Decrypt(
   return DecryptResult(plaintext->GetLength());
 }
 
+template <>
+DecryptResult LPAlgorithmCKKS<NativePoly>::Decrypt(
+    const LPPrivateKey<NativePoly> privateKey,
+    ConstCiphertext<NativePoly> ciphertext, DCRTPoly *plaintext) const {
+  PALISADE_THROW(not_available_error,
+                 "CKKS: Decryption to DCRTPoly is only supported for DCRTPoly "
+                 "ciphertexts.");
+}
+
+template <>
+DecryptResult LPAlgorithmCKKS<Poly>::Decrypt(const LPPrivateKey<Poly> privateKey,
+                                             ConstCiphertext<Poly> ciphertext,
+                                             DCRTPoly *plaintext) const {
+  PALISADE_THROW(not_available_error,
+                 "CKKS: Decryption to DCRTPoly is only supported for DCRTPoly "
+                 "ciphertexts.");
+}
+
 template <>
 DecryptResult LPAlgorithmCKKS<DCRTPoly>::Decrypt(
     const LPPrivateKey<DCRTPoly> privateKey,
-    ConstCiphertext<DCRTPoly> ciphertext, Poly *plaintext) const {
-  const shared_ptr<LPCryptoParameters<DCRTPoly>> cryptoParams =
-      privateKey->GetCryptoParameters();
-
+    ConstCiphertext<DCRTPoly> ciphertext, DCRTPoly *plaintext) const {
   const std::vector<DCRTPoly> &cv = ciphertext->GetElements();
   const DCRTPoly &s = privateKey->GetPrivateElement();
 
   size_t sizeQl = cv[0].GetParams()->GetParams().size();
   size_t sizeQ = s.GetParams()->GetParams().size();
 
+  if (sizeQl == 0) {
+    PALISADE_THROW(
+        math_error,
+        "Decryption failure: No towers left; consider increasing the depth.");
+  }
+
   size_t diffQl = sizeQ - sizeQl;
 
   auto scopy(s);
@@ -1010,14 +1042,22 @@ DecryptResult LPAlgorithmCKKS<DCRTPoly>::Decrypt(
 
   b.SetFormat(Format::COEFFICIENT);
 
-  if (sizeQl > 1) {
+  *plaintext = std::move(b);
+
+  return DecryptResult(plaintext->GetLength());
+}
+
+template <>
+DecryptResult LPAlgorithmCKKS<DCRTPoly>::Decrypt(
+    const LPPrivateKey<DCRTPoly> privateKey,
+    ConstCiphertext<DCRTPoly> ciphertext, Poly *plaintext) const {
+  DCRTPoly b;
+  Decrypt(privateKey, ciphertext, &b);
+
+  if (b.GetNumOfElements() > 1) {
     *plaintext = b.CRTInterpolate();
-  } else if (sizeQl == 1) {
-    *plaintext = Poly(b.GetElementAtIndex(0), Format::COEFFICIENT);
   } else {
-    PALISADE_THROW(
-        math_error,
-        "Decryption failure: No towers left; consider increasing the depth.");
+    *plaintext = Poly(b.GetElementAtIndex(0), Format::COEFFICIENT);
   }
 
   return DecryptResult(plaintext->GetLength());
@@ -1145,6 +1185,16 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchHybridGen(
   const DggType &dgg = cryptoParams->GetDiscreteGaussianGenerator();
   DugType dug;
 
+  // A vectors of seeded (compressed) keys are derived from a seed; a
+  // threshold key inherits the seed of the key it extends
+  std::vector<uint32_t> seed;
+  if (ekPrev == nullptr) {
+    if (newKey->GetCryptoContext()->GetEvalKeyCompression())
+      seed = SeededUniform<DCRTPoly>::GenerateSeed();
+  } else if (ekPrev->IsAVectorSeeded()) {
+    seed = ekPrev->GetAVectorSeed();
+  }
+
   auto numPartQ = cryptoParams->GetNumPartQ();
   vector<DCRTPoly> av(numPartQ);
   vector<DCRTPoly> bv(numPartQ);
@@ -1154,7 +1204,10 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchHybridGen(
 
   for (usint part = 0; part < numPartQ; part++) {
     DCRTPoly a;
-    if (ekPrev == nullptr) {  // single-key HE
+    if (!seed.empty()) {  // seeded key
+      a = SeededUniform<DCRTPoly>::Expand(
+          seed, SeededUniform<DCRTPoly>::EVAL_KEY, part, paramsQP);
+    } else if (ekPrev == nullptr) {  // single-key HE
       a = DCRTPoly(dug, paramsQP, Format::EVALUATION);
     } else {  // threshold HE
       a = ekPrev->GetAVector()[part];
@@ -1187,6 +1240,7 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchHybridGen(
 
   ek->SetAVector(std::move(av));
   ek->SetBVector(std::move(bv));
+  if (!seed.empty()) ek->SetAVectorSeed(seed);
 
   return ek;
 }
@@ -1305,29 +1359,9 @@ void LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchHybridInPlace(
   DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
   DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
-  for (uint32_t j = 0; j < numPartQl; j++) {
-    const DCRTPoly &cj = partsCtExt[j];
-    const DCRTPoly &bj = bv[j];
-    const DCRTPoly &aj = av[j];
-
-    for (usint i = 0; i < sizeQl; i++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(i);
-      const auto &bji = bj.GetElementAtIndex(i);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-
-    for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(idx);
-      const auto &bji = bj.GetElementAtIndex(idx);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-  }
+  DCRTPoly::KeySwitchInnerProduct(
+      partsCtExt, bv, av, sizeQ, cryptoParams->GetModqBarrettMu(),
+      cryptoParams->GetModpBarrettMu(), &cTilda0, &cTilda1);
 
   // cTilda0.SetFormat(Format::COEFFICIENT);
   // cTilda1.SetFormat(Format::COEFFICIENT);
@@ -1565,8 +1599,17 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchBVGen(
   std::vector<DCRTPoly> av(nWindows);
   std::vector<DCRTPoly> bv(nWindows);
 
-#pragma omp parallel for
-  for (usint i = 0; i < sizeSOld; i++) {
+  // A vectors of seeded (compressed) keys are derived from a seed; a
+  // threshold key inherits the seed of the key it extends
+  std::vector<uint32_t> seed;
+  if (ekPrev == nullptr) {
+    if (newKey->GetCryptoContext()->GetEvalKeyCompression())
+      seed = SeededUniform<DCRTPoly>::GenerateSeed();
+  } else if (ekPrev->IsAVectorSeeded()) {
+    seed = ekPrev->GetAVectorSeed();
+  }
+
+  ParallelFor(0, sizeSOld, [&](size_t i) {
     DugType dug;
 
     if (relinWindow > 0) {
@@ -1579,7 +1622,11 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchBVGen(
 
         filtered.SetElementAtIndex(i, sOldDecomposed[k]);
 
-        if (ekPrev == nullptr) {  // single-key HE
+        if (!seed.empty()) {  // seeded key
+          av[k + arrWindows[i]] = SeededUniform<DCRTPoly>::Expand(
+              seed, SeededUniform<DCRTPoly>::EVAL_KEY, k + arrWindows[i],
+              elementParams);
+        } else if (ekPrev == nullptr) {  // single-key HE
           // Generate a_i vectors
           DCRTPoly a(dug, elementParams, Format::EVALUATION);
           av[k + arrWindows[i]] = a;
@@ -1597,7 +1644,10 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchBVGen(
 
       filtered.SetElementAtIndex(i, sOld.GetElementAtIndex(i));
 
-      if (ekPrev == nullptr) {  // single-key HE
+      if (!seed.empty()) {  // seeded key
+        av[i] = SeededUniform<DCRTPoly>::Expand(
+            seed, SeededUniform<DCRTPoly>::EVAL_KEY, i, elementParams);
+      } else if (ekPrev == nullptr) {  // single-key HE
         // Generate a_i vectors
         DCRTPoly a(dug, elementParams, Format::EVALUATION);
         av[i] = a;
@@ -1609,10 +1659,11 @@ LPEvalKey<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::KeySwitchBVGen(
       DCRTPoly e(dgg, elementParams, Format::EVALUATION);
       bv[i] = filtered - (av[i] * sNew + e);
     }
-  }
+  });
 
   ek->SetAVector(std::move(av));
   ek->SetBVector(std::move(bv));
+  if (!seed.empty()) ek->SetAVectorSeed(seed);
 
   return ek;
 }
@@ -1904,107 +1955,216 @@ Ciphertext<DCRTPoly> LPLeveledSHEAlgorithmCKKS<DCRTPoly>::LevelReduce(
   return std::make_shared<CiphertextImpl<DCRTPoly>>(*ciphertext);
 }
 
-template <>
-Ciphertext<DCRTPoly> LPLeveledSHEAlgorithmCKKS<DCRTPoly>::EvalPoly(
-    ConstCiphertext<DCRTPoly> x,
-    const std::vector<double> &coefficients) const {
-  if (coefficients[coefficients.size() - 1] == 0)
-    PALISADE_THROW(
-        math_error,
-        "EvalPoly: The highest-order coefficient cannot be set to 0.");
+/**
+ * Adds a real constant to a ciphertext, using subtraction for negative
+ * constants.
+ */
+static Ciphertext<DCRTPoly> EvalAddConstant(ConstCiphertext<DCRTPoly> x,
+                                            double constant) {
+  auto cc = x->GetCryptoContext();
+  if (constant < 0) return cc->EvalSub(x, std::fabs(constant));
+  return cc->EvalAdd(x, constant);
+}
 
-  std::vector<Ciphertext<DCRTPoly>> powers(coefficients.size() - 1);
-  std::vector<int32_t> indices(coefficients.size() - 1, 0);
-
-  // set the indices for the powers of x that need to be computed to 1
-  for (size_t i = coefficients.size() - 1; i > 0; i--) {
-    if (IsPowerOfTwo(i)) {
-      indices[i - 1] = 1;
-    } else {  // non-power of 2
-      if (coefficients[i] != 0) {
-        indices[i - 1] = 1;
-        int64_t powerOf2 = 1 << (int64_t)std::floor(std::log2(i));
-        int64_t rem = i % powerOf2;
-        if (indices[rem - 1] == 0) indices[rem - 1] = 1;
-        // while rem is not a power of 2, set indices required to compute rem to
-        // 1
-        while (!IsPowerOfTwo(rem)) {
-          powerOf2 = 1 << (int64_t)std::floor(std::log2(rem));
-          rem = rem % powerOf2;
-          if (indices[rem - 1] == 0) indices[rem - 1] = 1;
-        }
-      }
-    }
-  }
+/**
+ * Computes the baby steps of the Paterson-Stockmeyer evaluation: x^1..x^k
+ * for the power basis or T_1(x)..T_k(x) for the Chebyshev basis. Each x^j
+ * (T_j) is obtained from the largest power of two h < j as
+ * x^h * x^(j-h) (2 T_h T_(j-h) - T_(2h-j)), so it consumes ceil(log2(j))
+ * levels. Element 0 is left empty.
+ */
+static std::vector<Ciphertext<DCRTPoly>> EvalPSBabySteps(
+    ConstCiphertext<DCRTPoly> x, uint32_t k, bool chebyshev) {
+  auto cc = x->GetCryptoContext();
 
-  powers[0] = Ciphertext<DCRTPoly>(new CiphertextImpl<DCRTPoly>(*x));
+  std::vector<Ciphertext<DCRTPoly>> baby(k + 1);
+  baby[1] = Ciphertext<DCRTPoly>(new CiphertextImpl<DCRTPoly>(*x));
 
-  auto cc = x->GetCryptoContext();
+  for (uint32_t j = 2; j <= k; j++) {
+    uint32_t hi = 1;
+    while (2 * hi < j) hi <<= 1;
+    uint32_t lo = j - hi;
 
-  // computes all powers for x
-  for (size_t i = 2; i < coefficients.size(); i++) {
-    if (IsPowerOfTwo(i)) {
-      powers[i - 1] = cc->EvalMult(powers[i / 2 - 1], powers[i / 2 - 1]);
-      cc->ModReduceInPlace(powers[i - 1]);
-    } else {  // non-power of 2
-      if (indices[i - 1] == 1) {
-        int64_t powerOf2 = 1 << (int64_t)std::floor(std::log2(i));
-        int64_t rem = i % powerOf2;
-
-        int levelDiff =
-            powers[powerOf2 - 1]->GetElements()[0].GetNumOfElements() -
-            powers[rem - 1]->GetElements()[0].GetNumOfElements();
-        for (int idx = 0; idx < levelDiff; idx++) {
-          powers[rem - 1] = cc->LevelReduce(powers[rem - 1], nullptr);
-        }
+    baby[j] = cc->EvalMult(baby[hi], baby[lo]);
+    cc->ModReduceInPlace(baby[j]);
+    if (chebyshev) {
+      baby[j] = cc->EvalAdd(baby[j], baby[j]);
+      if (hi == lo)
+        baby[j] = cc->EvalSub(baby[j], 1.0);
+      else
+        baby[j] = cc->EvalSub(baby[j], baby[hi - lo]);
+    }
+  }
 
-        powers[i - 1] = cc->EvalMult(powers[powerOf2 - 1], powers[rem - 1]);
-        cc->ModReduceInPlace(powers[i - 1]);
-      }
+  return baby;
+}
+
+/**
+ * Computes the giant steps x^(k*2^i) (T_(k*2^i)) for i = 0..m-1 by
+ * repeated squaring of the last baby step.
+ */
+static std::vector<Ciphertext<DCRTPoly>> EvalPSGiantSteps(
+    const std::vector<Ciphertext<DCRTPoly>> &baby, uint32_t m,
+    bool chebyshev) {
+  if (m == 0) return std::vector<Ciphertext<DCRTPoly>>();
+
+  auto cc = baby.back()->GetCryptoContext();
+
+  std::vector<Ciphertext<DCRTPoly>> giant(m);
+  giant[0] = baby.back();
+  for (uint32_t i = 1; i < m; i++) {
+    giant[i] = cc->EvalMult(giant[i - 1], giant[i - 1]);
+    cc->ModReduceInPlace(giant[i]);
+    if (chebyshev) {
+      giant[i] = cc->EvalAdd(giant[i], giant[i]);
+      giant[i] = cc->EvalSub(giant[i], 1.0);
     }
   }
 
-  // gets the highest depth (lowest number of CRT limbs)
-  int64_t limbs =
-      powers[coefficients.size() - 2]->GetElements()[0].GetNumOfElements();
+  return giant;
+}
 
-  // brings all powers of x to the same level
-  for (size_t i = 1; i < coefficients.size() - 1; i++) {
-    if (indices[i - 1] == 1) {
-      int levelDiff =
-          limbs - powers[i - 1]->GetElements()[0].GetNumOfElements();
-      for (int idx = 0; idx < levelDiff; idx++) {
-        powers[i - 1] = cc->LevelReduce(powers[i - 1], nullptr);
-      }
+/**
+ * Recursive step of the Paterson-Stockmeyer evaluation. A polynomial of
+ * degree d <= k*2^m is split by the giant step n = k*2^(m-1) as
+ * p = q * x^n + r (p = q * T_n + r in the Chebyshev basis), with deg(q) <= n
+ * and deg(r) < n, down to polynomials of degree <= k, which are linear
+ * combinations of the baby steps.
+ *
+ * @return the evaluated polynomial, or nullptr if the polynomial is a
+ * constant (the caller then uses coefficients[0] directly).
+ */
+static Ciphertext<DCRTPoly> EvalPSRecursive(
+    const std::vector<double> &coefficients,
+    const std::vector<Ciphertext<DCRTPoly>> &baby,
+    const std::vector<Ciphertext<DCRTPoly>> &giant, uint32_t m,
+    bool chebyshev) {
+  auto cc = baby[1]->GetCryptoContext();
+
+  uint32_t k = baby.size() - 1;
+  size_t degree = coefficients.size() - 1;
+  while (degree > 0 && coefficients[degree] == 0) degree--;
+
+  if (degree <= k) {
+    Ciphertext<DCRTPoly> result;
+    for (size_t j = 1; j <= degree; j++) {
+      if (coefficients[j] == 0) continue;
+      auto term = cc->EvalMult(baby[j], coefficients[j]);
+      result = result ? cc->EvalAdd(result, term) : term;
     }
+    if (!result) return nullptr;
+
+    result = cc->ModReduce(result);
+    if (coefficients[0] != 0) result = EvalAddConstant(result, coefficients[0]);
+    return result;
   }
 
-  // perform scalar multiplication for the highest-order term
-  auto result = cc->EvalMult(powers[coefficients.size() - 2],
-                             coefficients[coefficients.size() - 1]);
+  // the smallest giant step the polynomial can be split on
+  size_t n = static_cast<size_t>(k) << (m - 1);
+  while (degree <= n) {
+    m--;
+    n >>= 1;
+  }
 
-  // perform scalar multiplication for all other terms and sum them up
-  for (size_t i = 0; i < coefficients.size() - 2; i++) {
-    if (coefficients[i + 1] != 0) {
-      result =
-          cc->EvalAdd(result, cc->EvalMult(powers[i], coefficients[i + 1]));
+  std::vector<double> q(degree - n + 1, 0.0);
+  std::vector<double> r(n, 0.0);
+  std::copy(coefficients.begin(), coefficients.begin() + n, r.begin());
+  if (chebyshev) {
+    // T_j = 2 T_(j-n) T_n - T_(2n-j) for n < j <= 2n
+    q[0] = coefficients[n];
+    for (size_t j = n + 1; j <= degree; j++) {
+      q[j - n] = 2 * coefficients[j];
+      r[2 * n - j] -= coefficients[j];
     }
+  } else {
+    std::copy(coefficients.begin() + n, coefficients.begin() + degree + 1,
+              q.begin());
   }
 
-  // Do rescaling after scalar multiplication
-  result = cc->ModReduce(result);
+  Ciphertext<DCRTPoly> result;
+  auto qct = EvalPSRecursive(q, baby, giant, m - 1, chebyshev);
+  if (qct) {
+    result = cc->EvalMult(qct, giant[m - 1]);
+  } else {
+    result = cc->EvalMult(giant[m - 1], q[0]);
+  }
+  cc->ModReduceInPlace(result);
 
-  // adds the free term (at x^0)
-  if (coefficients[0] != 0) {
-    if (coefficients[0] < 0)
-      result = cc->EvalSub(result, std::fabs(coefficients[0]));
-    else
-      result = cc->EvalAdd(result, coefficients[0]);
+  auto rct = EvalPSRecursive(r, baby, giant, m - 1, chebyshev);
+  if (rct) {
+    result = cc->EvalAdd(result, rct);
+  } else if (r[0] != 0) {
+    result = EvalAddConstant(result, r[0]);
   }
 
   return result;
 }
 
+/**
+ * Paterson-Stockmeyer evaluation of a polynomial in the power or Chebyshev
+ * basis. With d = deg(p), the baby-step size k is chosen as the power of two
+ * nearest to sqrt(d), so that about 2*sqrt(d) + log2(d) non-scalar
+ * multiplications are needed; the multiplicative depth is ceil(log2(d)) + 1.
+ */
+static Ciphertext<DCRTPoly> EvalPS(ConstCiphertext<DCRTPoly> x,
+                                   const std::vector<double> &coefficients,
+                                   bool chebyshev) {
+  size_t degree = coefficients.size() - 1;
+
+  uint32_t logDegree = 0;
+  while ((static_cast<size_t>(1) << logDegree) < degree) logDegree++;
+  uint32_t logK = (logDegree + 1) / 2;
+  uint32_t m = logDegree - logK;
+
+  auto baby = EvalPSBabySteps(x, 1 << logK, chebyshev);
+  auto giant = EvalPSGiantSteps(baby, m, chebyshev);
+
+  return EvalPSRecursive(coefficients, baby, giant, m, chebyshev);
+}
+
+template <>
+Ciphertext<DCRTPoly> LPLeveledSHEAlgorithmCKKS<DCRTPoly>::EvalPoly(
+    ConstCiphertext<DCRTPoly> x,
+    const std::vector<double> &coefficients) const {
+  if (coefficients.size() < 2)
+    PALISADE_THROW(math_error,
+                   "EvalPoly: The polynomial should be at least of degree 1.");
+  if (coefficients[coefficients.size() - 1] == 0)
+    PALISADE_THROW(
+        math_error,
+        "EvalPoly: The highest-order coefficient cannot be set to 0.");
+
+  return EvalPS(x, coefficients, false);
+}
+
+template <>
+Ciphertext<DCRTPoly> LPLeveledSHEAlgorithmCKKS<DCRTPoly>::EvalChebyshevSeries(
+    ConstCiphertext<DCRTPoly> x, const std::vector<double> &coefficients,
+    double a, double b) const {
+  if (coefficients.size() < 2)
+    PALISADE_THROW(
+        math_error,
+        "EvalChebyshevSeries: The series should be at least of degree 1.");
+  if (coefficients[coefficients.size() - 1] == 0)
+    PALISADE_THROW(math_error,
+                   "EvalChebyshevSeries: The highest-order coefficient "
+                   "cannot be set to 0.");
+  if (!(a < b))
+    PALISADE_THROW(math_error,
+                   "EvalChebyshevSeries: The interval [a, b] is empty.");
+
+  if (a == -1.0 && b == 1.0) return EvalPS(x, coefficients, true);
+
+  // maps [a, b] to [-1, 1]; this costs one level
+  auto cc = x->GetCryptoContext();
+  auto y = cc->EvalMult(x, 2.0 / (b - a));
+  cc->ModReduceInPlace(y);
+  double shift = -(a + b) / (b - a);
+  if (shift != 0) y = EvalAddConstant(y, shift);
+
+  return EvalPS(y, coefficients, true);
+}
+
 #if NATIVEINT == 128
 template <>
 vector<DCRTPoly::Integer>
@@ -3911,43 +4071,21 @@ Ciphertext<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::EvalFastRotationHybrid(
 
   Ciphertext<DCRTPoly> result = ciphertext->CloneEmpty();
 
-  std::vector<DCRTPoly> bv = evalKey->GetBVector();
-  std::vector<DCRTPoly> av = evalKey->GetAVector();
+  const std::vector<DCRTPoly> &bv = evalKey->GetBVector();
+  const std::vector<DCRTPoly> &av = evalKey->GetAVector();
 
   const shared_ptr<ParmType> paramsQl = psiC0.GetParams();
   const shared_ptr<ParmType> paramsP = cryptoParams->GetParamsP();
   const shared_ptr<ParmType> paramsQlP = (*expandedCiphertext)[0].GetParams();
 
-  size_t sizeQl = paramsQl->GetParams().size();
-  size_t sizeQlP = paramsQlP->GetParams().size();
   size_t sizeQ = cryptoParams->GetElementParams()->GetParams().size();
 
   DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
   DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
-  for (uint32_t j = 0; j < expandedCiphertext->size(); j++) {
-    // DCRTPoly cj((*expandedCiphertext)[j].AutomorphismTransform(autoIndex));
-    DCRTPoly cj((*expandedCiphertext)[j]);
-    const DCRTPoly &bj = bv[j];
-    const DCRTPoly &aj = av[j];
-
-    for (usint i = 0; i < sizeQl; i++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(i);
-      const auto &bji = bj.GetElementAtIndex(i);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-    for (usint i = sizeQl, idx = sizeQ; i < sizeQlP; i++, idx++) {
-      const auto &cji = cj.GetElementAtIndex(i);
-      const auto &aji = aj.GetElementAtIndex(idx);
-      const auto &bji = bj.GetElementAtIndex(idx);
-
-      cTilda0.SetElementAtIndex(i, cTilda0.GetElementAtIndex(i) + cji * bji);
-      cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
-    }
-  }
+  DCRTPoly::KeySwitchInnerProduct(
+      *expandedCiphertext, bv, av, sizeQ, cryptoParams->GetModqBarrettMu(),
+      cryptoParams->GetModpBarrettMu(), &cTilda0, &cTilda1);
 
   // cTilda0.SetFormat(Format::COEFFICIENT);
   // cTilda1.SetFormat(Format::COEFFICIENT);
@@ -4202,10 +4340,8 @@ Ciphertext<DCRTPoly> LPAlgorithmSHECKKS<DCRTPoly>::EvalFastRotation(
   usint autoIndex = FindAutomorphismIndex2nComplex(index, m);
 
   // Retrieve the automorphism key that corresponds to the auto index.
-  auto autok = ciphertext->GetCryptoContext()
-                   ->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag())
-                   .find(autoIndex)
-                   ->second;
+  auto autok = ciphertext->GetCryptoContext()->GetEvalAutomorphismKey(
+      ciphertext->GetKeyTag(), autoIndex);
 
   switch (cryptoParams->GetKeySwitchTechnique()) {
     case BV:
@@ -45,6 +45,7 @@ Archive, Report 2020/1118, 2020. https://eprint.iacr.org/2020/
 #define LBCRYPTO_CRYPTO_CKKS_C
 
 #include "scheme/ckks/ckks.h"
+#include "utils/scheduler.h"
 
 namespace lbcrypto {
 
@@ -814,8 +815,7 @@ LPAlgorithmSHECKKS<Element>::EvalAutomorphismKeyGen(
 
   if (indexList.size() > n - 1)
     PALISADE_THROW(math_error, "size exceeds the ring dimension");
-#pragma omp parallel for if (indexList.size() >= 4)
-  for (usint i = 0; i < indexList.size(); i++) {
+  auto keyGen = [&](size_t i) {
     LPPrivateKey<Element> privateKeyPermuted(
         std::make_shared<LPPrivateKeyImpl<Element>>(
             privateKey->GetCryptoContext()));
@@ -828,6 +828,13 @@ LPAlgorithmSHECKKS<Element>::EvalAutomorphismKeyGen(
     privateKeyPermuted->SetPrivateElement(sPermuted);
 
     keysVector[i] = this->KeySwitchGen(privateKey, privateKeyPermuted);
+  };
+  // a few keys are generated one after the other, leaving the threads to the
+  // tower loops of KeySwitchGen
+  if (indexList.size() >= 4) {
+    ParallelFor(0, indexList.size(), keyGen);
+  } else {
+    for (size_t i = 0; i < indexList.size(); i++) keyGen(i);
   }
 
   auto evalKeys = std::make_shared<std::map<usint, LPEvalKey<Element>>>();
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <set>
 #include <vector>
 #include "UnitTestUtils.h"
 #include "gtest/gtest.h"
@@ -1033,3 +1034,236 @@ TEST_F(UTAUTOMORPHISM, Test_BGVrns_EvalSum_NO_KEY_GEN_CALL) {
   }
 }
 //================================================================================================
+//================================================================================================
+// Checks that every ciphertext returned by EvalAtIndexBatch decrypts to the
+// same vector as the corresponding EvalAtIndex.
+template <typename Element>
+void EvalAtIndexBatchMatchesEvalAtIndex(CryptoContext<Element> cc,
+                                        const Plaintext& plaintext) {
+  static const std::vector<int32_t> indices {0, 1, 2, -1, -3, 2};
+
+  cc->Enable(ENCRYPTION);
+  cc->Enable(SHE);
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+  cc->EvalAtIndexKeyGen(kp.secretKey, {1, 2, -1, -3});
+
+  Ciphertext<Element> ciphertext = cc->Encrypt(kp.publicKey, plaintext);
+  auto rotated = cc->EvalAtIndexBatch(ciphertext, indices);
+  ASSERT_EQ(indices.size(), rotated.size());
+
+  for (size_t i = 0; i < indices.size(); i++) {
+    Plaintext expected;
+    Plaintext result;
+    cc->Decrypt(kp.secretKey, cc->EvalAtIndex(ciphertext, indices[i]),
+                &expected);
+    cc->Decrypt(kp.secretKey, rotated[i], &result);
+    expected->SetLength(plaintext->GetLength());
+    result->SetLength(plaintext->GetLength());
+    if (plaintext->GetEncodingType() == CKKSPacked) {
+      auto a = expected->GetCKKSPackedValue();
+      auto b = result->GetCKKSPackedValue();
+      EXPECT_TRUE(checkEquality(a, b)) << "index " << indices[i];
+    } else {
+      auto a = expected->GetPackedValue();
+      auto b = result->GetPackedValue();
+      EXPECT_TRUE(checkEquality(a, b)) << "index " << indices[i];
+    }
+  }
+
+  // a missing key is reported before any rotation is done; 3 is not
+  // congruent to a generated index even with 8 slots, where 5 is -3
+  std::vector<int32_t> missing {1, 3};
+  EXPECT_THROW(cc->EvalAtIndexBatch(ciphertext, missing), not_available_error);
+}
+
+TEST_F(UTAUTOMORPHISM, Test_CKKS_EvalAtIndexBatch) {
+  PackedEncoding::Destroy();
+
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextCKKS(
+          1, 50, 8, HEStd_NotSet, 16);
+  EvalAtIndexBatchMatchesEvalAtIndex(cc,
+                                     cc->MakeCKKSPackedPlaintext(vector8Complex));
+}
+
+TEST_F(UTAUTOMORPHISM, Test_BGVrns_EvalAtIndexBatch) {
+  PackedEncoding::Destroy();
+
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextBGVrns(1, 65537);
+  EvalAtIndexBatchMatchesEvalAtIndex(cc, cc->MakePackedPlaintext(vector8));
+}
+
+TEST_F(UTAUTOMORPHISM, Test_BFVrns_EvalAtIndexBatch) {
+  PackedEncoding::Destroy();
+
+  EncodingParams encodingParams(std::make_shared<EncodingParamsImpl>(65537));
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextBFVrns(
+          encodingParams, 1.006, 4, 0, 1, 0, OPTIMIZED, 2);
+  EvalAtIndexBatchMatchesEvalAtIndex(cc, cc->MakePackedPlaintext(vector8));
+}
+//================================================================================================
+static bool ApproximatelyEqual(const std::vector<std::complex<double>>& a,
+                               const std::vector<std::complex<double>>& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); i++)
+    if (std::abs(a[i] - b[i]) > 0.0001) return false;
+  return true;
+}
+
+TEST_F(UTAUTOMORPHISM, Test_CKKS_EvalSumHoisted) {
+  PackedEncoding::Destroy();
+
+  usint batchSize = 8;
+  usint rowSize = 2;
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextCKKS(
+          1, 50, batchSize, HEStd_NotSet, 16);
+  cc->Enable(ENCRYPTION);
+  cc->Enable(SHE);
+
+  LPKeyPair<DCRTPoly> kp = cc->KeyGen();
+  cc->EvalSumKeyGen(kp.secretKey);
+  auto rowKeys = cc->EvalSumRowsKeyGen(kp.secretKey, nullptr, rowSize);
+  auto colKeys = cc->EvalSumColsKeyGen(kp.secretKey);
+
+  std::set<int32_t> indices;
+  for (usint radix : {2, 4}) {
+    for (auto index : cc->GetEvalSumHoistedIndices(batchSize, radix))
+      indices.insert(index);
+    for (auto index : cc->GetEvalSumRowsHoistedIndices(rowSize, radix))
+      indices.insert(index);
+    for (auto index : cc->GetEvalSumColsHoistedIndices(rowSize, radix))
+      indices.insert(index);
+  }
+  cc->EvalAtIndexKeyGen(kp.secretKey,
+                        std::vector<int32_t>(indices.begin(), indices.end()));
+
+  auto ciphertext =
+      cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vector8Complex));
+
+  auto decrypt = [&](ConstCiphertext<DCRTPoly> ct) {
+    Plaintext result;
+    cc->Decrypt(kp.secretKey, ct, &result);
+    result->SetLength(batchSize);
+    return result->GetCKKSPackedValue();
+  };
+
+  auto sum = decrypt(cc->EvalSum(ciphertext, batchSize));
+  auto rows = decrypt(cc->EvalSumRows(ciphertext, rowSize, *rowKeys));
+  auto cols = decrypt(cc->EvalSumCols(ciphertext, rowSize, *colKeys));
+  for (usint radix : {2, 4}) {
+    EXPECT_TRUE(ApproximatelyEqual(
+        sum, decrypt(cc->EvalSumHoisted(ciphertext, batchSize, radix))))
+        << "EvalSumHoisted fails for radix " << radix;
+    EXPECT_TRUE(ApproximatelyEqual(
+        rows, decrypt(cc->EvalSumRowsHoisted(ciphertext, rowSize, radix))))
+        << "EvalSumRowsHoisted fails for radix " << radix;
+    EXPECT_TRUE(ApproximatelyEqual(
+        cols, decrypt(cc->EvalSumColsHoisted(ciphertext, rowSize, radix))))
+        << "EvalSumColsHoisted fails for radix " << radix;
+  }
+
+  EXPECT_THROW(cc->EvalSumHoisted(ciphertext, batchSize, 3), config_error);
+}
+
+TEST_F(UTAUTOMORPHISM, Test_BGVrns_EvalSumHoisted) {
+  PackedEncoding::Destroy();
+
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextBGVrns(1, 65537);
+  cc->Enable(ENCRYPTION);
+  cc->Enable(SHE);
+
+  LPKeyPair<DCRTPoly> kp = cc->KeyGen();
+  uint32_t batchSize = 8;
+  cc->EvalAtIndexKeyGen(kp.secretKey, cc->GetEvalSumHoistedIndices(batchSize));
+
+  auto ciphertext =
+      cc->Encrypt(kp.publicKey, cc->MakePackedPlaintext(vector8));
+  Plaintext result;
+  cc->Decrypt(kp.secretKey, cc->EvalSumHoisted(ciphertext, batchSize),
+              &result);
+
+  EXPECT_TRUE(checkEquality(result->GetPackedValue()[0], vector8Sum));
+}
+//================================================================================================
+TEST_F(UTAUTOMORPHISM, Test_RotationKeyPlan) {
+  const usint slots = 64;
+  std::vector<int32_t> indices {1, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, -1, -9};
+
+  for (usint maxKeys : {0, 2, 6, 9}) {
+    RotationKeyPlan plan(indices, slots, maxKeys);
+    auto keys = plan.GetKeyIndices();
+    if (maxKeys == 0)
+      EXPECT_EQ(indices.size(), keys.size());
+    else
+      EXPECT_LE(keys.size(), maxKeys);
+
+    usint maxCost = 0;
+    for (auto index : indices) {
+      auto steps = plan.GetSteps(index);
+      int64_t sum = 0;
+      for (auto step : steps) {
+        EXPECT_NE(keys.end(), std::find(keys.begin(), keys.end(), step));
+        sum += step;
+      }
+      EXPECT_EQ(0, ((sum - index) % slots + slots) % slots);
+      EXPECT_EQ(steps.size(), plan.GetCost(index));
+      maxCost = std::max<usint>(maxCost, steps.size());
+    }
+    EXPECT_EQ(maxCost, plan.GetMaxCost());
+  }
+
+  // fewer keys never make a rotation cheaper
+  EXPECT_LE(RotationKeyPlan(indices, slots, 9).GetTotalCost(),
+            RotationKeyPlan(indices, slots, 6).GetTotalCost());
+
+  EXPECT_EQ(0U, RotationKeyPlan::FromKeys({2}, slots).GetCost(0));
+  EXPECT_THROW(RotationKeyPlan::FromKeys({2}, slots).GetSteps(1),
+               not_available_error);
+}
+
+TEST_F(UTAUTOMORPHISM, Test_CKKS_EvalAtIndexComposed) {
+  PackedEncoding::Destroy();
+
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextCKKS(
+          1, 50, 8, HEStd_NotSet, 16);
+  cc->Enable(ENCRYPTION);
+  cc->Enable(SHE);
+
+  std::vector<int32_t> indices {1, 2, 3, 5, 6, 7, -3};
+  auto plan = cc->PlanRotationKeys(indices, 3);
+  EXPECT_EQ(3U, plan.GetKeyIndices().size());
+
+  LPKeyPair<DCRTPoly> kp = cc->KeyGen();
+  cc->EvalAtIndexKeyGen(kp.secretKey, plan.GetKeyIndices());
+  auto ciphertext =
+      cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vector8Complex));
+
+  int32_t missing = -1;
+  for (auto index : indices)
+    if (plan.GetCost(index) > 1) missing = index;
+  ASSERT_NE(-1, missing);
+  EXPECT_ANY_THROW(cc->EvalAtIndex(ciphertext, missing));
+
+  cc->SetRotationComposition(true);
+  auto batch = cc->EvalAtIndexBatch(ciphertext, indices);
+  for (size_t i = 0; i < indices.size(); i++) {
+    std::vector<std::complex<double>> expected(8);
+    for (int32_t j = 0; j < 8; j++)
+      expected[j] = vector8Complex[((j + indices[i]) % 8 + 8) % 8];
+
+    for (auto rotated : {cc->EvalAtIndex(ciphertext, indices[i]), batch[i]}) {
+      Plaintext result;
+      cc->Decrypt(kp.secretKey, rotated, &result);
+      result->SetLength(8);
+      EXPECT_TRUE(ApproximatelyEqual(expected, result->GetCKKSPackedValue()))
+          << "rotation by " << indices[i] << " fails";
+    }
+  }
+  cc->SetRotationComposition(false);
+}
@@ -439,6 +439,67 @@ GENERATE_TEST_CASES_FUNC_GHS(UTBGVrns, UnitTest_EvalAtIndex, ORDER, PTM,
 GENERATE_TEST_CASES_FUNC_HYBRID(UTBGVrns, UnitTest_EvalAtIndex, ORDER, PTM,
                                 SIZEMODULI, NUMPRIME, RELIN, BATCH)
 
+/**
+ * Tests whether EvalLinearTransform for BGVrns matches the plain product.
+ */
+template <class Element>
+static void UnitTest_EvalLinearTransform(const CryptoContext<Element> cc,
+                                         const string& failmsg) {
+  usint n = cc->GetRingDimension() / 2;
+
+  // a dense matrix with one zero diagonal
+  std::vector<std::vector<int64_t>> matrix(n, std::vector<int64_t>(n));
+  for (usint r = 0; r < n; r++) {
+    for (usint c = 0; c < n; c++) {
+      matrix[r][c] =
+          ((c + n - r) % n == 3) ? 0 : int64_t((3 * r + c) % 7) - 3;
+    }
+  }
+  std::vector<std::vector<int64_t>> diagonals(n, std::vector<int64_t>(n));
+  for (usint k = 0; k < n; k++) {
+    for (usint t = 0; t < n; t++) diagonals[k][t] = matrix[t][(t + k) % n];
+  }
+  diagonals[3].clear();
+
+  std::vector<int64_t> x(n);
+  for (usint c = 0; c < n; c++) x[c] = int64_t(c % 5) - 2;
+  std::vector<int64_t> expected(n);
+  for (usint r = 0; r < n; r++) {
+    for (usint c = 0; c < n; c++) expected[r] += matrix[r][c] * x[c];
+  }
+
+  auto transform = cc->MakePackedLinearTransform(diagonals);
+  EXPECT_EQ(transform->GetDiagonals().size(), n - 1) << failmsg;
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+  cc->EvalMultKeyGen(kp.secretKey);
+  cc->EvalAtIndexKeyGen(kp.secretKey, transform->GetRotationIndices());
+
+  Ciphertext<Element> ct =
+      cc->Encrypt(kp.publicKey, cc->MakePackedPlaintext(x));
+  Ciphertext<Element> cOnes = cc->Encrypt(
+      kp.publicKey, cc->MakePackedPlaintext(std::vector<int64_t>(n, 1)));
+  // as in EvalAtIndex, multiply first to hide the rotation noise in BV
+  ct *= cOnes;
+  auto result = cc->EvalLinearTransform(ct, transform);
+
+  Plaintext plaintext;
+  cc->Decrypt(kp.secretKey, result, &plaintext);
+  plaintext->SetLength(n);
+  auto decrypted = plaintext->GetPackedValue();
+  checkEquality(expected, decrypted, failmsg + " EvalLinearTransform fails");
+
+  EXPECT_THROW(cc->MakePackedLinearTransform(
+                   std::vector<std::vector<int64_t>>(n - 1)),
+               config_error)
+      << failmsg;
+}
+
+GENERATE_TEST_CASES_FUNC_BV(UTBGVrns, UnitTest_EvalLinearTransform, ORDER, PTM,
+                            SIZEMODULI, NUMPRIME, RELIN, BATCH)
+GENERATE_TEST_CASES_FUNC_HYBRID(UTBGVrns, UnitTest_EvalLinearTransform, ORDER,
+                                PTM, SIZEMODULI, NUMPRIME, RELIN, BATCH)
+
 /**
  * Tests whether EvalMerge for BGVrns works properly.
  */
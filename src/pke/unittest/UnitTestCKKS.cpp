@@ -1570,6 +1570,202 @@ GENERATE_TEST_CASES_FUNC_GHS(UTCKKS, UnitTest_EvalPoly, 1024, 35, 6, 20, BATCH)
 GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_EvalPoly, 1024, 35, 6, 20,
                                 BATCH)
 
+/**
+ * Tests whether EvalChebyshevSeries for CKKS works properly.
+ */
+template <class Element>
+static void UnitTest_EvalChebyshevSeries(const CryptoContext<Element> cc,
+                                         const string& failmsg) {
+  // The precision after which we consider two values equal.
+  double eps = 0.001;
+
+  // sum_j c_j T_j(y) for y = (2x - (a + b)) / (b - a), computed in the clear
+  auto chebyshevSeries = [](const std::vector<double>& coefficients,
+                            double a, double b, double x) {
+    double y = (2 * x - (a + b)) / (b - a);
+    double tPrev = 1;
+    double tCurr = y;
+    double result = coefficients[0] + coefficients[1] * y;
+    for (size_t j = 2; j < coefficients.size(); j++) {
+      double tNext = 2 * y * tCurr - tPrev;
+      result += coefficients[j] * tNext;
+      tPrev = tCurr;
+      tCurr = tNext;
+    }
+    return result;
+  };
+
+  // degree 12 over [-1, 1]
+  std::vector<double> input1({-0.9, -0.35, 0.1, 0.5, 0.95});
+  std::vector<double> coefficients1(
+      {0.25, 0.5, -0.75, 0.3, 0, 0.2, -0.1, 0.05, 0, -0.15, 0.1, 0, 0.4});
+  // degree 8 over [0, 4], with a zero free term
+  std::vector<double> input2({0.2, 1.1, 2, 3.3, 3.9});
+  std::vector<double> coefficients2({0, -1, 0.5, 0.25, 0, 0, -0.5, 0.1, 1});
+
+  size_t encodedLength = input1.size();
+
+  std::vector<std::complex<double>> output1(encodedLength);
+  std::vector<std::complex<double>> output2(encodedLength);
+  for (size_t i = 0; i < encodedLength; i++) {
+    output1[i] = chebyshevSeries(coefficients1, -1, 1, input1[i]);
+    output2[i] = chebyshevSeries(coefficients2, 0, 4, input2[i]);
+  }
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+  cc->EvalMultKeyGen(kp.secretKey);
+
+  Ciphertext<Element> ciphertext1 = cc->Encrypt(
+      kp.publicKey,
+      cc->MakeCKKSPackedPlaintext(
+          std::vector<std::complex<double>>(input1.begin(), input1.end())));
+  Ciphertext<Element> ciphertext2 = cc->Encrypt(
+      kp.publicKey,
+      cc->MakeCKKSPackedPlaintext(
+          std::vector<std::complex<double>>(input2.begin(), input2.end())));
+
+  Plaintext results1, results2;
+
+  auto cResult1 = cc->EvalChebyshevSeries(ciphertext1, coefficients1, -1, 1);
+  cc->Decrypt(kp.secretKey, cResult1, &results1);
+  results1->SetLength(encodedLength);
+  auto tmp = results1->GetCKKSPackedValue();
+  checkApproximateEquality(
+      output1, tmp, encodedLength, eps,
+      failmsg + " EvalChebyshevSeries over [-1, 1] failed");
+
+  auto cResult2 = cc->EvalChebyshevSeries(ciphertext2, coefficients2, 0, 4);
+  cc->Decrypt(kp.secretKey, cResult2, &results2);
+  results2->SetLength(encodedLength);
+  tmp = results2->GetCKKSPackedValue();
+  checkApproximateEquality(
+      output2, tmp, encodedLength, eps,
+      failmsg + " EvalChebyshevSeries over [0, 4] failed");
+}
+
+GENERATE_TEST_CASES_FUNC_BV(UTCKKS, UnitTest_EvalChebyshevSeries, 1024, 35, 6,
+                            20, BATCH)
+GENERATE_TEST_CASES_FUNC_GHS(UTCKKS, UnitTest_EvalChebyshevSeries, 1024, 35, 6,
+                             20, BATCH)
+GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_EvalChebyshevSeries, 1024, 35,
+                                6, 20, BATCH)
+
+/**
+ * Tests whether seed-compressed evaluation keys for CKKS work properly.
+ */
+template <class Element>
+static void UnitTest_SeededEvalKeys(const CryptoContext<Element> cc,
+                                    const string& failmsg) {
+  double eps = 0.0001;
+
+  std::vector<std::complex<double>> vectorOfInts1 = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<std::complex<double>> vectorOfInts2 = {2, 1, 0, 1, 2, 1, 0, 1};
+  std::vector<std::complex<double>> vectorOfIntsMultRotate(8);
+  for (size_t i = 0; i < 8; i++) {
+    vectorOfIntsMultRotate[i] =
+        (i < 7) ? vectorOfInts1[i + 1] * vectorOfInts2[i + 1] : 0;
+  }
+
+  cc->SetEvalKeyCompression(true);
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+  cc->EvalMultKeyGen(kp.secretKey);
+  cc->EvalAtIndexKeyGen(kp.secretKey, {1});
+
+  auto evalKey = std::static_pointer_cast<LPEvalKeyRelinImpl<Element>>(
+      cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0]);
+  EXPECT_TRUE(evalKey->IsAVectorSeeded())
+      << failmsg << " relinearization key is not seeded";
+
+  // dropping the cached A and regenerating it from the seed is lossless
+  std::vector<Element> a = evalKey->GetAVector();
+  evalKey->ReleaseExpandedAVector();
+  EXPECT_TRUE(a == evalKey->GetAVector())
+      << failmsg << " A vector is not reproduced from the seed";
+
+  // a key that stores A explicitly differs only in the stored representation
+  LPEvalKeyRelinImpl<Element> plainKey(cc);
+  plainKey.SetKeyTag(evalKey->GetKeyTag());
+  plainKey.SetAVector(a);
+  plainKey.SetBVector(evalKey->GetBVector());
+  EXPECT_FALSE(plainKey.IsAVectorSeeded());
+  EXPECT_FALSE(plainKey == *evalKey)
+      << failmsg << " seeded and explicit keys compare equal";
+  plainKey.SetAVectorSeed(evalKey->GetAVectorSeed());
+  EXPECT_TRUE(plainKey == *evalKey)
+      << failmsg << " seeded keys with the same seed compare unequal";
+
+  for (auto& key : *cc->GetEvalAutomorphismKeyMapPtr(
+           kp.secretKey->GetKeyTag())) {
+    auto rotKey =
+        std::static_pointer_cast<LPEvalKeyRelinImpl<Element>>(key.second);
+    EXPECT_TRUE(rotKey->IsAVectorSeeded())
+        << failmsg << " rotation key is not seeded";
+    rotKey->ReleaseExpandedAVector();
+  }
+
+  Ciphertext<Element> ciphertext1 = cc->Encrypt(
+      kp.publicKey, cc->MakeCKKSPackedPlaintext(vectorOfInts1));
+  Ciphertext<Element> ciphertext2 = cc->Encrypt(
+      kp.publicKey, cc->MakeCKKSPackedPlaintext(vectorOfInts2));
+
+  auto cResult = cc->EvalAtIndex(cc->EvalMult(ciphertext1, ciphertext2), 1);
+  Plaintext results;
+  cc->Decrypt(kp.secretKey, cResult, &results);
+  results->SetLength(7);
+  auto tmp = results->GetCKKSPackedValue();
+  checkApproximateEquality(vectorOfIntsMultRotate, tmp, 7, eps,
+                           failmsg + " EvalMult + EvalAtIndex with seeded "
+                                     "keys failed");
+
+  cc->SetEvalKeyCompression(false);
+}
+
+GENERATE_TEST_CASES_FUNC_BV(UTCKKS, UnitTest_SeededEvalKeys, ORDER, SCALE,
+                            NUMPRIME, RELIN, BATCH)
+GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_SeededEvalKeys, ORDER, SCALE,
+                                NUMPRIME, RELIN, BATCH)
+
+/**
+ * Tests whether seeded secret-key encryption for CKKS works properly.
+ */
+template <class Element>
+static void UnitTest_SeededEncryption(const CryptoContext<Element> cc,
+                                      const string& failmsg) {
+  double eps = 0.0001;
+
+  std::vector<std::complex<double>> vectorOfInts = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+
+  cc->SetCiphertextCompression(true);
+  // at the top level and after dropping a tower
+  for (uint32_t level = 0; level < 2; level++) {
+    Plaintext plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts, 1, level);
+    Ciphertext<Element> ciphertext = cc->Encrypt(kp.secretKey, plaintext);
+    EXPECT_TRUE(ciphertext->IsSeeded())
+        << failmsg << " encryption not seeded at level " << level;
+
+    ConstCiphertext<Element> constCiphertext = ciphertext;
+    const auto& elements = constCiphertext->GetElements();
+    EXPECT_TRUE(-SeededUniform<Element>::Expand(
+                    ciphertext->GetSeed(), SeededUniform<Element>::CIPHERTEXT,
+                    0, elements[0].GetParams()) == elements[1])
+        << failmsg << " second element is not reproduced at level " << level;
+
+    Plaintext results;
+    cc->Decrypt(kp.secretKey, ciphertext, &results);
+    results->SetLength(vectorOfInts.size());
+    auto tmp = results->GetCKKSPackedValue();
+    checkApproximateEquality(vectorOfInts, tmp, vectorOfInts.size(), eps,
+                             failmsg + " seeded encrypt/decrypt failed");
+  }
+  cc->SetCiphertextCompression(false);
+}
+
+GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_SeededEncryption, ORDER,
+                                SCALE, NUMPRIME, RELIN, BATCH)
+
 /**
  * Tests whether metadata is carried over for several operations in CKKS
  */
@@ -1729,3 +1925,156 @@ GENERATE_TEST_CASES_FUNC_GHS(UTCKKS, UnitTest_Metadata, ORDER, SCALE, NUMPRIME,
                              RELIN, BATCH)
 GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_Metadata, ORDER, SCALE,
                                 NUMPRIME, RELIN, BATCH)
+
+/**
+ * Tests whether batch encoding and batch decryption for CKKS work properly.
+ */
+template <class Element>
+static void UnitTest_Batch_Encode_Decrypt(const CryptoContext<Element> cc,
+                                          const string& failmsg) {
+  int vecSize = 8;
+  size_t numVectors = 16;
+
+  double eps = 0.0001;
+
+  std::vector<std::vector<std::complex<double>>> values(numVectors);
+  for (size_t j = 0; j < numVectors; j++) {
+    values[j].resize(vecSize);
+    for (int i = 0; i < vecSize; i++) {
+      values[j][i] = static_cast<double>(j) - i;
+    }
+  }
+
+  auto plaintexts = cc->MakeCKKSPackedPlaintexts(values);
+  EXPECT_EQ(plaintexts.size(), numVectors)
+      << failmsg << " MakeCKKSPackedPlaintexts - wrong number of plaintexts";
+
+  // Generate encryption keys
+  LPKeyPair<Element> kp = cc->KeyGen();
+
+  std::vector<Ciphertext<Element>> ciphertexts(numVectors);
+  for (size_t j = 0; j < numVectors; j++) {
+    // the batch encoding must match encoding the vectors one by one
+    Plaintext single = cc->MakeCKKSPackedPlaintext(values[j]);
+    EXPECT_TRUE(plaintexts[j]->template GetElement<Element>() ==
+                single->template GetElement<Element>())
+        << failmsg << " MakeCKKSPackedPlaintexts - encoding " << j;
+
+    ciphertexts[j] = cc->Encrypt(kp.publicKey, plaintexts[j]);
+  }
+
+  std::vector<Plaintext> results;
+  auto decryptResults = cc->Decrypt(kp.secretKey, ciphertexts, &results);
+  EXPECT_EQ(results.size(), numVectors)
+      << failmsg << " batch Decrypt - wrong number of plaintexts";
+
+  for (size_t j = 0; j < numVectors; j++) {
+    EXPECT_TRUE(decryptResults[j].isValid)
+        << failmsg << " batch Decrypt - result " << j << " is not valid";
+    results[j]->SetLength(vecSize);
+    auto tmp_b = results[j]->GetCKKSPackedValue();
+    checkApproximateEquality(values[j], tmp_b, vecSize, eps,
+                             failmsg + " batch Decrypt fails");
+  }
+}
+
+GENERATE_TEST_CASES_FUNC_BV(UTCKKS, UnitTest_Batch_Encode_Decrypt, ORDER,
+                            SCALE, NUMPRIME, RELIN, BATCH)
+GENERATE_TEST_CASES_FUNC_GHS(UTCKKS, UnitTest_Batch_Encode_Decrypt, ORDER,
+                             SCALE, NUMPRIME, RELIN, BATCH)
+GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_Batch_Encode_Decrypt, ORDER,
+                                SCALE, NUMPRIME, RELIN, BATCH)
+
+template <class Element>
+static void UnitTest_Context_Executor(const CryptoContext<Element> cc,
+                                      const string& failmsg) {
+  int vecSize = 8;
+  double eps = 0.0001;
+
+  std::vector<std::complex<double>> a = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<std::complex<double>> b = {7, 6, 5, 4, 3, 2, 1, 0};
+  std::vector<std::complex<double>> ab = {0, 6, 10, 12, 12, 10, 6, 0};
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+  cc->EvalMultKeyGen(kp.secretKey);
+  cc->EvalAtIndexKeyGen(kp.secretKey, {1});
+
+  auto ct1 = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(a));
+  auto ct2 = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(b));
+  auto expected = cc->EvalAtIndex(cc->EvalMult(ct1, ct2), 1);
+
+  // the same operations on a two-thread budget give the same ciphertext
+  cc->SetExecutor(std::make_shared<WorkStealingExecutor>(2));
+  auto result = cc->EvalAtIndex(cc->EvalMult(ct1, ct2), 1);
+  Plaintext plaintext;
+  cc->Decrypt(kp.secretKey, result, &plaintext);
+  cc->SetExecutor(nullptr);
+
+  EXPECT_TRUE(expected->GetElements() == result->GetElements())
+      << failmsg << " EvalMult/EvalAtIndex differ under a thread budget";
+  plaintext->SetLength(vecSize);
+  std::vector<std::complex<double>> rotated(ab.begin() + 1, ab.end());
+  rotated.push_back(0);
+  auto decrypted = plaintext->GetCKKSPackedValue();
+  checkApproximateEquality(rotated, decrypted, vecSize, eps,
+                           failmsg + " Decrypt under a thread budget");
+}
+
+GENERATE_TEST_CASES_FUNC_BV(UTCKKS, UnitTest_Context_Executor, ORDER, SCALE,
+                            NUMPRIME, RELIN, BATCH)
+GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_Context_Executor, ORDER,
+                                SCALE, NUMPRIME, RELIN, BATCH)
+
+template <class Element>
+static void UnitTest_EvalLinearTransform(const CryptoContext<Element> cc,
+                                         const string& failmsg) {
+  usint n = BATCH;
+  double eps = 0.0001;
+
+  // a dense matrix with one zero diagonal
+  std::vector<std::vector<double>> matrix(n, std::vector<double>(n));
+  for (usint r = 0; r < n; r++) {
+    for (usint c = 0; c < n; c++) {
+      matrix[r][c] = ((c + n - r) % n == 3) ? 0 : 0.1 * ((3 * r + c) % 7) - 0.3;
+    }
+  }
+  std::vector<std::vector<double>> diagonals(n, std::vector<double>(n));
+  for (usint k = 0; k < n; k++) {
+    for (usint t = 0; t < n; t++) diagonals[k][t] = matrix[t][(t + k) % n];
+  }
+  diagonals[3].clear();
+
+  std::vector<double> x = {1, -2, 3, -4, 0.5, 0.25, -1, 2};
+  std::vector<std::complex<double>> expected(n);
+  for (usint r = 0; r < n; r++) {
+    for (usint c = 0; c < n; c++) expected[r] += matrix[r][c] * x[c];
+  }
+
+  auto transform = cc->MakeCKKSLinearTransform(diagonals);
+  EXPECT_EQ(transform->GetDiagonals().size(), n - 1) << failmsg;
+  std::vector<int32_t> indices = transform->GetRotationIndices();
+  EXPECT_EQ(indices, std::vector<int32_t>({1, 2, 3, 6, -8})) << failmsg;
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+  cc->EvalAtIndexKeyGen(kp.secretKey, indices);
+
+  auto ct = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(x));
+  auto result = cc->EvalLinearTransform(ct, transform);
+
+  Plaintext plaintext;
+  cc->Decrypt(kp.secretKey, result, &plaintext);
+  plaintext->SetLength(n);
+  auto decrypted = plaintext->GetCKKSPackedValue();
+  checkApproximateEquality(expected, decrypted, n, eps,
+                           failmsg + " EvalLinearTransform fails");
+
+  EXPECT_THROW(cc->MakeCKKSLinearTransform(
+                   std::vector<std::vector<double>>(n - 1)),
+               config_error)
+      << failmsg;
+}
+
+GENERATE_TEST_CASES_FUNC_BV(UTCKKS, UnitTest_EvalLinearTransform, ORDER,
+                            SCALE, NUMPRIME, RELIN, BATCH)
+GENERATE_TEST_CASES_FUNC_HYBRID(UTCKKS, UnitTest_EvalLinearTransform, ORDER,
+                                SCALE, NUMPRIME, RELIN, BATCH)
@@ -136,3 +136,61 @@ void EncryptionCoefPacked(const CryptoContext<Element> cc,
 }
 
 GENERATE_TEST_CASES_FUNC(Encrypt_Decrypt, EncryptionCoefPacked, 128, 512)
+
+#define GENERATE_TEST_CASES_FUNC_SEEDED(x, y, ORD, PTM)         \
+  GENERATE_PKE_TEST_CASE(x, y, DCRTPoly, BGVrns_rlwe, ORD, PTM) \
+  GENERATE_PKE_TEST_CASE(x, y, DCRTPoly, BFVrns_rlwe, ORD, PTM)
+
+template <typename Element>
+void EncryptionSeeded(const CryptoContext<Element> cc, const string& failmsg) {
+  size_t intSize = cc->GetRingDimension();
+  auto ptm = cc->GetCryptoParameters()->GetPlaintextModulus();
+  int half = ptm / 2;
+
+  vector<int64_t> intvec;
+  for (size_t ii = 0; ii < intSize; ii++) intvec.push_back(rand() % half);
+  Plaintext plaintext = cc->MakeCoefPackedPlaintext(intvec);
+
+  LPKeyPair<Element> kp = cc->KeyGen();
+
+  cc->SetCiphertextCompression(true);
+  Ciphertext<Element> ciphertext = cc->Encrypt(kp.secretKey, plaintext);
+  cc->SetCiphertextCompression(false);
+
+  EXPECT_TRUE(ciphertext->IsSeeded()) << failmsg << " encryption not seeded";
+
+  // the second element is reproduced from the seed
+  ConstCiphertext<Element> constCiphertext = ciphertext;
+  const auto& elements = constCiphertext->GetElements();
+  Element mask = SeededUniform<Element>::Expand(
+      ciphertext->GetSeed(), SeededUniform<Element>::CIPHERTEXT, 0,
+      elements[0].GetParams());
+  EXPECT_TRUE(-mask == elements[1])
+      << failmsg << " second element is not reproduced from the seed";
+
+  Plaintext plaintextNew;
+  cc->Decrypt(kp.secretKey, ciphertext, &plaintextNew);
+  EXPECT_EQ(*plaintextNew, *plaintext)
+      << failmsg << " seeded encrypt/decrypt failed";
+
+  EXPECT_TRUE(ciphertext->Clone()->IsSeeded())
+      << failmsg << " clone lost the seed";
+  EXPECT_FALSE(cc->EvalAdd(ciphertext, ciphertext)->IsSeeded())
+      << failmsg << " derived ciphertext is seeded";
+
+  // the seed is only invalidated by modifying the second element
+  ciphertext->GetElements();
+  EXPECT_TRUE(ciphertext->IsSeeded())
+      << failmsg << " mutable access dropped the seed";
+  ciphertext->GetElements()[0] += ciphertext->GetElements()[0];
+  EXPECT_TRUE(ciphertext->IsSeeded())
+      << failmsg << " modifying the first element dropped the seed";
+  ciphertext->GetElements()[1] += ciphertext->GetElements()[1];
+  EXPECT_FALSE(ciphertext->IsSeeded())
+      << failmsg << " modifying the second element kept the seed";
+
+  EXPECT_FALSE(cc->Encrypt(kp.secretKey, plaintext)->IsSeeded())
+      << failmsg << " encryption seeded with compression disabled";
+}
+
+GENERATE_TEST_CASES_FUNC_SEEDED(Encrypt_Decrypt, EncryptionSeeded, 128, 512)
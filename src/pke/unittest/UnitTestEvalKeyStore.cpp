@@ -0,0 +1,147 @@
+// @file
+// @author TPOC: contact@palisade-crypto.org
+//
+// @copyright Copyright (c) 2019, New Jersey Institute of Technology (NJIT)
+// All rights reserved.
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+// 1. Redistributions of source code must retain the above copyright notice,
+// this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution. THIS SOFTWARE IS
+// PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+// EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cryptocontext.h"
+#include "evalkeystore.h"
+
+using namespace lbcrypto;
+
+TEST(UTEvalKeyStore, insert_find_erase) {
+  EvalKeyStore<int> store;
+
+  for (int i = 0; i < 100; i++)
+    store.Insert(std::to_string(i), std::make_shared<int>(i));
+
+  auto value = store.Find("42");
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 42);
+  EXPECT_EQ(store.Find("100"), nullptr);
+
+  // replacing a value does not invalidate the one held by a reader
+  store.Insert("42", std::make_shared<int>(-42));
+  EXPECT_EQ(*value, 42);
+  EXPECT_EQ(*store.Find("42"), -42);
+
+  store.Erase("42");
+  EXPECT_EQ(store.Find("42"), nullptr);
+  EXPECT_EQ(store.Snapshot().size(), 99U);
+
+  store.EraseIf([](const int& v) { return v % 2 == 0; });
+  auto snapshot = store.Snapshot();
+  EXPECT_EQ(snapshot.size(), 50U);
+  for (const auto& kv : snapshot) EXPECT_EQ(*kv.second % 2, 1);
+
+  store.Clear();
+  EXPECT_EQ(store.Snapshot().size(), 0U);
+}
+
+TEST(UTEvalKeyStore, concurrent_readers_and_writers) {
+  EvalKeyStore<int> store;
+  const int numKeys = 256;
+  const int numWriters = 2;
+  const int numReaders = 4;
+
+  for (int i = 0; i < numKeys; i++)
+    store.Insert("r" + std::to_string(i), std::make_shared<int>(i));
+
+  std::atomic<int> errors(0);
+  std::vector<std::thread> threads;
+  for (int w = 0; w < numWriters; w++) {
+    threads.emplace_back([&store, w]() {
+      for (int i = 0; i < numKeys; i++)
+        store.Insert("w" + std::to_string(w) + "_" + std::to_string(i),
+                     std::make_shared<int>(i));
+    });
+  }
+  for (int r = 0; r < numReaders; r++) {
+    threads.emplace_back([&store, &errors]() {
+      for (int iter = 0; iter < 8; iter++) {
+        for (int i = 0; i < numKeys; i++) {
+          auto value = store.Find("r" + std::to_string(i));
+          if (value == nullptr || *value != i) errors++;
+        }
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  EXPECT_EQ(errors, 0);
+  EXPECT_EQ(store.Snapshot().size(),
+            static_cast<size_t>(numKeys * (numWriters + 1)));
+}
+
+TEST(UTEvalKeyStore, concurrent_EvalAtIndex) {
+  CryptoContext<DCRTPoly> cc =
+      CryptoContextFactory<DCRTPoly>::genCryptoContextCKKS(
+          2, 40, 8, HEStd_NotSet, 512);
+  cc->Enable(ENCRYPTION);
+  cc->Enable(SHE);
+
+  auto kp = cc->KeyGen();
+  cc->EvalAtIndexKeyGen(kp.secretKey, {1, 2, 3});
+
+  std::vector<std::complex<double>> input({0, 1, 2, 3, 4, 5, 6, 7});
+  auto ciphertext =
+      cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(input));
+
+  // keys for other secret keys are generated while rotations are running
+  std::thread writer([&cc]() {
+    for (int i = 0; i < 4; i++) {
+      auto other = cc->KeyGen();
+      cc->EvalAtIndexKeyGen(other.secretKey, {1});
+    }
+  });
+
+  const int numThreads = 4;
+  std::vector<Ciphertext<DCRTPoly>> results(numThreads);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < numThreads; t++) {
+    readers.emplace_back([&, t]() {
+      for (int iter = 0; iter < 4; iter++)
+        results[t] = cc->EvalAtIndex(ciphertext, t % 3 + 1);
+    });
+  }
+  for (auto& t : readers) t.join();
+  writer.join();
+
+  for (int t = 0; t < numThreads; t++) {
+    Plaintext result;
+    cc->Decrypt(kp.secretKey, results[t], &result);
+    result->SetLength(4);
+    auto values = result->GetCKKSPackedValue();
+    for (size_t i = 0; i < 4; i++)
+      EXPECT_NEAR(values[i].real(), input[i + t % 3 + 1].real(), 0.01);
+  }
+
+  cc->ClearEvalAutomorphismKeys();
+  CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
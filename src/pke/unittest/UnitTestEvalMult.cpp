@@ -652,6 +652,98 @@ namespace {
 
          }
 
+    template <typename Element>
+        static void RunSumOfProductsTest(CryptoContext<Element> cryptoContext) {
+            auto keyPair = cryptoContext->KeyGen();
+            ASSERT_TRUE(keyPair.good()) << "Key generation failed!";
+            cryptoContext->EvalMultKeyGen(keyPair.secretKey);
+
+            // sum of (i + 2) * (i + 1, 1, 0, 2) for i = 0, ..., 3
+            std::vector<int64_t> vectorOfIntsResult = { 40, 14, 0, 28 };
+            Plaintext plaintextResult =
+                cryptoContext->MakeCoefPackedPlaintext(vectorOfIntsResult);
+
+            vector<Ciphertext<Element>> ciphertexts1;
+            vector<Ciphertext<Element>> ciphertexts2;
+            vector<Plaintext> plaintexts2;
+            for (int64_t i = 0; i < 4; i++) {
+                std::vector<int64_t> vectorOfInts1 = { i + 1, 1, 0, 2 };
+                std::vector<int64_t> vectorOfInts2 = { i + 2 };
+                Plaintext plaintext1 = cryptoContext->MakeCoefPackedPlaintext(vectorOfInts1);
+                Plaintext plaintext2 = cryptoContext->MakeCoefPackedPlaintext(vectorOfInts2);
+                ciphertexts1.push_back(cryptoContext->Encrypt(keyPair.publicKey, plaintext1));
+                ciphertexts2.push_back(cryptoContext->Encrypt(keyPair.publicKey, plaintext2));
+                plaintexts2.push_back(plaintext2);
+            }
+
+            auto ciphertextSum = cryptoContext->EvalSumOfProducts(ciphertexts1, ciphertexts2);
+            EXPECT_EQ(ciphertextSum->GetElements().size(), 2U)
+                << ".EvalSumOfProducts did not relinearize the sum.\n";
+
+            Plaintext plaintextSum;
+            cryptoContext->Decrypt(keyPair.secretKey, ciphertextSum, &plaintextSum);
+            plaintextResult->SetLength(plaintextSum->GetLength());
+            EXPECT_EQ(*plaintextSum, *plaintextResult)
+                << ".EvalSumOfProducts gives incorrect results.\n";
+
+            ciphertextSum = cryptoContext->EvalSumOfProducts(ciphertexts1, plaintexts2);
+            cryptoContext->Decrypt(keyPair.secretKey, ciphertextSum, &plaintextSum);
+            plaintextResult->SetLength(plaintextSum->GetLength());
+            EXPECT_EQ(*plaintextSum, *plaintextResult)
+                << ".EvalSumOfProducts with plaintext weights gives incorrect results.\n";
+
+            UT_EXPECT_THROW_SIMPLE(cryptoContext->EvalSumOfProducts(
+                ciphertexts1, vector<Ciphertext<Element>>(ciphertexts2.begin() + 1,
+                                                          ciphertexts2.end())));
+        }
+
+    template <typename Element>
+        static void RunSumOfProductsTestCKKS(CryptoContext<Element> cryptoContext) {
+            auto keyPair = cryptoContext->KeyGen();
+            ASSERT_TRUE(keyPair.good()) << "Key generation failed!";
+            cryptoContext->EvalMultKeyGen(keyPair.secretKey);
+
+            std::vector<std::complex<double>> vectorOfIntsResult(8);
+            vector<Ciphertext<Element>> ciphertexts1;
+            vector<Ciphertext<Element>> ciphertexts2;
+            vector<Plaintext> plaintexts2;
+            for (size_t i = 0; i < 3; i++) {
+                std::vector<std::complex<double>> vectorOfInts1(8);
+                std::vector<std::complex<double>> vectorOfInts2(8);
+                for (size_t j = 0; j < 8; j++) {
+                    vectorOfInts1[j] = double(i + j);
+                    vectorOfInts2[j] = double(7 - j + i);
+                    vectorOfIntsResult[j] += vectorOfInts1[j] * vectorOfInts2[j];
+                }
+                Plaintext plaintext1 = cryptoContext->MakeCKKSPackedPlaintext(vectorOfInts1);
+                Plaintext plaintext2 = cryptoContext->MakeCKKSPackedPlaintext(vectorOfInts2);
+                ciphertexts1.push_back(cryptoContext->Encrypt(keyPair.publicKey, plaintext1));
+                ciphertexts2.push_back(cryptoContext->Encrypt(keyPair.publicKey, plaintext2));
+                plaintexts2.push_back(plaintext2);
+            }
+
+            Plaintext plaintextResult =
+                cryptoContext->MakeCKKSPackedPlaintext(vectorOfIntsResult);
+
+            auto ciphertextSum = cryptoContext->EvalSumOfProducts(ciphertexts1, ciphertexts2);
+            EXPECT_EQ(ciphertextSum->GetElements().size(), 2U)
+                << ".EvalSumOfProducts did not relinearize the sum.\n";
+
+            Plaintext plaintextSum;
+            cryptoContext->Decrypt(keyPair.secretKey, ciphertextSum, &plaintextSum);
+            plaintextSum->SetLength(plaintextResult->GetLength());
+            EXPECT_TRUE(checkEquality(plaintextSum->GetCKKSPackedValue(),
+                        plaintextResult->GetCKKSPackedValue()))
+                << ".EvalSumOfProducts gives incorrect results.\n";
+
+            ciphertextSum = cryptoContext->EvalSumOfProducts(ciphertexts1, plaintexts2);
+            cryptoContext->Decrypt(keyPair.secretKey, ciphertextSum, &plaintextSum);
+            plaintextSum->SetLength(plaintextResult->GetLength());
+            EXPECT_TRUE(checkEquality(plaintextSum->GetCKKSPackedValue(),
+                        plaintextResult->GetCKKSPackedValue()))
+                << ".EvalSumOfProducts with plaintext weights gives incorrect results.\n";
+        }
+
 
 } // anonymous namespace
 
@@ -807,3 +899,13 @@ TEST_F(UnitTestEvalMult, Test_CKKS_Relin) {
     PackedEncoding::Destroy();
     RunRelinTestCKKS(MakeCKKSDCRTPolyCC());
 }
+//===================================================================
+TEST_F(UnitTestEvalMult, Test_BFVrns_SumOfProducts) {
+    RunSumOfProductsTest(MakeBFVrnsDCRTPolyCC());
+}
+TEST_F(UnitTestEvalMult, Test_BGVrns_SumOfProducts) {
+    RunSumOfProductsTest(MakeBGVrnsDCRTPolyCC());
+}
+TEST_F(UnitTestEvalMult, Test_CKKS_SumOfProducts) {
+    RunSumOfProductsTestCKKS(MakeCKKSDCRTPolyCC());
+}
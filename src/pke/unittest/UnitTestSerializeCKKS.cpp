@@ -21,6 +21,7 @@
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <cstdio>
 #include <iostream>
 #include "gtest/gtest.h"
 
@@ -442,6 +443,186 @@ static void TestDecryptionSerNoCRTTables(CryptoContext<T> cc, const ST& sertype,
   SERIALIZE_PRECOMPUTE = true;
 }
 
+template <typename T, typename ST>
+static void TestSeededEvalKeys(CryptoContext<T> cc, const ST& sertype,
+                               const string& failmsg) {
+  CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+
+  LPKeyPair<DCRTPoly> kp = cc->KeyGen();
+  string keyTag = kp.secretKey->GetKeyTag();
+
+  cc->EvalMultKeyGen(kp.secretKey);
+  LPEvalKey<DCRTPoly> plainKey = cc->GetEvalMultKeyVector(keyTag)[0];
+
+  cc->SetEvalKeyCompression(true);
+  cc->EvalMultKeyGen(kp.secretKey);
+  cc->SetEvalKeyCompression(false);
+  LPEvalKey<DCRTPoly> seededKey = cc->GetEvalMultKeyVector(keyTag)[0];
+  ASSERT_TRUE(seededKey->IsAVectorSeeded()) << failmsg << " key not seeded";
+
+  stringstream plainStream;
+  stringstream seededStream;
+  Serial::Serialize(plainKey, plainStream, sertype);
+  Serial::Serialize(seededKey, seededStream, sertype);
+  // A and B have the same size, and only B is written for a seeded key
+  EXPECT_LT(10 * seededStream.str().size(), 6 * plainStream.str().size())
+      << failmsg << " seeded key does not shrink";
+
+  LPEvalKey<DCRTPoly> newKey;
+  Serial::Deserialize(newKey, seededStream, sertype);
+  ASSERT_TRUE(newKey) << failmsg << " seeded key deserialization fails";
+  EXPECT_TRUE(newKey->IsAVectorSeeded()) << failmsg << " seed lost";
+  EXPECT_EQ(*seededKey, *newKey) << failmsg << " seeded key mismatch";
+  EXPECT_TRUE(seededKey->GetAVector() == newKey->GetAVector())
+      << failmsg << " A vector is not reproduced after deserialization";
+
+  CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+}
+
+template <typename T>
+static void UnitTestSeededEvalKeys(CryptoContext<T> cc,
+                                   const string& failmsg) {
+  TestSeededEvalKeys(cc, SerType::JSON, "json");
+  TestSeededEvalKeys(cc, SerType::BINARY, "binary");
+}
+
+template <typename T, typename ST>
+static void TestSeededCiphertexts(CryptoContext<T> cc, const ST& sertype,
+                                  const string& failmsg) {
+  int vecSize = 8;
+  double eps = 0.0001;
+
+  std::vector<std::complex<double>> vectorOfInts = {1, 2, 3, 4, 5, 6, 7, 8};
+  Plaintext plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+
+  LPKeyPair<DCRTPoly> kp = cc->KeyGen();
+
+  Ciphertext<DCRTPoly> plainCiphertext = cc->Encrypt(kp.secretKey, plaintext);
+  cc->SetCiphertextCompression(true);
+  Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.secretKey, plaintext);
+  cc->SetCiphertextCompression(false);
+  ASSERT_TRUE(ciphertext->IsSeeded()) << failmsg << " encryption not seeded";
+
+  stringstream plainStream;
+  stringstream seededStream;
+  Serial::Serialize(plainCiphertext, plainStream, sertype);
+  Serial::Serialize(ciphertext, seededStream, sertype);
+  // only the first of the two elements is written for a seeded ciphertext
+  EXPECT_LT(10 * seededStream.str().size(), 6 * plainStream.str().size())
+      << failmsg << " seeded ciphertext does not shrink";
+
+  Ciphertext<DCRTPoly> newC;
+  Serial::Deserialize(newC, seededStream, sertype);
+  ASSERT_TRUE(newC) << failmsg << " seeded ciphertext deserialization fails";
+  EXPECT_TRUE(newC->IsSeeded()) << failmsg << " seed lost";
+  EXPECT_EQ(*ciphertext, *newC) << failmsg << " seeded ciphertext mismatch";
+
+  Plaintext result;
+  cc->Decrypt(kp.secretKey, newC, &result);
+  result->SetLength(vecSize);
+  checkApproximateEquality(vectorOfInts, result->GetCKKSPackedValue(),
+                           vecSize, eps,
+                           failmsg + " decryption after deserialization fails");
+
+  // once the second element is modified the ciphertext is written in full
+  newC->GetElements()[1] += newC->GetElements()[1];
+  stringstream modifiedStream;
+  Serial::Serialize(newC, modifiedStream, sertype);
+  Ciphertext<DCRTPoly> modified;
+  Serial::Deserialize(modified, modifiedStream, sertype);
+  ASSERT_TRUE(modified) << failmsg << " modified ciphertext deserialization";
+  EXPECT_FALSE(modified->IsSeeded()) << failmsg << " stale seed written";
+  EXPECT_EQ(*newC, *modified) << failmsg << " modified ciphertext mismatch";
+}
+
+template <typename T>
+static void UnitTestSeededCiphertexts(CryptoContext<T> cc,
+                                      const string& failmsg) {
+  TestSeededCiphertexts(cc, SerType::JSON, "json");
+  TestSeededCiphertexts(cc, SerType::BINARY, "binary");
+}
+
+template <typename T, typename ST>
+static void TestLazyAutomorphismKeys(CryptoContext<T> cc, const ST& sertype,
+                                     const string& failmsg) {
+  CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+  CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+  int vecSize = 8;
+  double eps = 0.000000001;
+  std::vector<int32_t> indices = {1, 2, -1, -2};
+  string filename = "lazy-autokeys-" + failmsg + ".bin";
+
+  // vectorOfInts = { 1,2,3,4,5,6,7,8 };
+  std::vector<std::complex<double>> vectorOfInts(vecSize);
+  std::vector<std::complex<double>> vOnes(vecSize, 1);
+  for (int i = 0; i < vecSize; i++) vectorOfInts[i] = i + 1;
+
+  LPKeyPair<DCRTPoly> kp = cc->KeyGen();
+  cc->EvalMultKeyGen(kp.secretKey);
+  cc->EvalAtIndexKeyGen(kp.secretKey, indices);
+  string keyTag = kp.secretKey->GetKeyTag();
+
+  // one multiplication hides the rotation noise, see UnitTest_EvalAtIndex
+  Ciphertext<DCRTPoly> ciphertext =
+      cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vectorOfInts));
+  ciphertext *= cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vOnes));
+
+  ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKeyIndexed(
+      filename, sertype, keyTag))
+      << failmsg << " indexed serialization fails";
+  CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+
+  // a single resident key: every rotation evicts the key of the previous one
+  ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyLazy(
+      filename, sertype, 1))
+      << failmsg << " lazy deserialization fails";
+
+  for (size_t pass = 0; pass < 2; pass++) {
+    for (int32_t index : indices) {
+      Plaintext result;
+      cc->Decrypt(kp.secretKey, cc->EvalAtIndex(ciphertext, index), &result);
+      result->SetLength(vecSize);
+
+      std::vector<std::complex<double>> expected(vecSize);
+      for (int i = 0; i < vecSize; i++) {
+        int j = i + index;
+        expected[i] = (j >= 0 && j < vecSize) ? vectorOfInts[j] : 0;
+      }
+      checkApproximateEquality(
+          expected, result->GetCKKSPackedValue(), vecSize, eps,
+          failmsg + " lazy EvalAtIndex(" + std::to_string(index) + ") fails");
+    }
+  }
+
+  // the lazily loaded keys are visible to the other key accessors
+  auto all = CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys();
+  ASSERT_EQ(all.size(), 1U) << failmsg << " lazy keys missing";
+  EXPECT_EQ(all[keyTag]->size(), indices.size()) << failmsg;
+  stringstream s;
+  EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey(
+      s, sertype, keyTag))
+      << failmsg << " serialization of lazy keys fails";
+
+  // clearing by context also drops files none of whose keys were loaded
+  ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKeyLazy(
+      filename, sertype, 1));
+  CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(cc);
+  EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys().size(),
+            0U)
+      << failmsg << " lazy keys not cleared";
+
+  CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+  std::remove(filename.c_str());
+}
+
+template <typename T>
+static void UnitTestLazyAutomorphismKeys(CryptoContext<T> cc,
+                                         const string& failmsg) {
+  TestLazyAutomorphismKeys(cc, SerType::JSON, "json");
+  TestLazyAutomorphismKeys(cc, SerType::BINARY, "binary");
+}
+
 template <typename T>
 static void UnitTestKeysAndCiphertextsRelin0JSON(CryptoContext<T> cc,
                                                  const string& failmsg) {
@@ -492,3 +673,12 @@ GENERATE_TEST_CASES_FUNC(UTCKKSSer, UnitTestDecryptionSerNoCRTTablesJSON, ORDER,
                          SCALE, NUMPRIME, 0, BATCH)
 GENERATE_TEST_CASES_FUNC(UTCKKSSer, UnitTestDecryptionSerNoCRTTablesBINARY,
                          ORDER, SCALE, NUMPRIME, 0, BATCH)
+
+GENERATE_TEST_CASES_FUNC(UTCKKSSer, UnitTestLazyAutomorphismKeys, ORDER, SCALE,
+                         NUMPRIME, RELIN, BATCH)
+
+GENERATE_TEST_CASES_FUNC(UTCKKSSer, UnitTestSeededEvalKeys, ORDER, SCALE,
+                         NUMPRIME, RELIN, BATCH)
+
+GENERATE_TEST_CASES_FUNC(UTCKKSSer, UnitTestSeededCiphertexts, ORDER, SCALE,
+                         NUMPRIME, RELIN, BATCH)